@@ -0,0 +1,451 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * Benchmarks of the main document operations on generated documents
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "SyntheticDocument.h"
+
+#include "control/SearchControl.h"
+#include "control/jobs/ImageExport.h"
+#include "control/jobs/ProgressListener.h"
+#include "control/tools/Selection.h"
+#include "control/xojfile/LoadHandler.h"
+#include "control/xojfile/SaveHandler.h"
+#include "gui/Redrawable.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+#include "model/eraser/EraseableStroke.h"
+#include "pdf/base/XojPdfExport.h"
+#include "pdf/base/XojPdfExportFactory.h"
+#include "view/DocumentView.h"
+#include "view/PdfView.h"
+
+#include <PageRange.h>
+#include <Range.h>
+
+#include <benchmark/benchmark.h>
+
+#include <glib/gstdio.h>
+
+#include <cmath>
+#include <map>
+
+/**
+ * The document presets, selected by the first benchmark argument
+ */
+enum DocumentPreset
+{
+	PRESET_HANDWRITING, PRESET_ANNOTATED_PDF, PRESET_DENSE
+};
+
+/**
+ * Documents are generated once and shared by all benchmarks
+ */
+static SyntheticDocument* getDocument(benchmark::State& state)
+{
+	static std::map<int, SyntheticDocument*> documents;
+
+	int preset = state.range(0);
+	SyntheticDocument* doc = documents[preset];
+	if (doc == NULL)
+	{
+		switch (preset)
+		{
+		case PRESET_ANNOTATED_PDF:
+			doc = new SyntheticDocument(SyntheticDocument::annotatedPdf());
+			break;
+		case PRESET_DENSE:
+			doc = new SyntheticDocument(SyntheticDocument::dense());
+			break;
+		default:
+			doc = new SyntheticDocument(SyntheticDocument::handwriting());
+			break;
+		}
+		documents[preset] = doc;
+	}
+
+	state.SetLabel(doc->getParams().name);
+	return doc;
+}
+
+/**
+ * The selection needs a view to repaint, nothing is painted in the benchmark
+ */
+class NullRedrawable : public Redrawable
+{
+public:
+	virtual void repaintArea(double x1, double y1, double x2, double y2) { }
+	virtual void repaintPage() { }
+	virtual void rerenderPage() { }
+	virtual void rerenderRect(double x, double y, double width, double height) { }
+	virtual GtkColorWrapper getSelectionColor() { return GtkColorWrapper(); }
+	virtual void deleteViewBuffer() { }
+	virtual int getX() const { return 0; }
+	virtual int getY() const { return 0; }
+};
+
+/**
+ * Renders the page the same way as the RenderJob does
+ */
+static void renderPage(Document* doc, PageRef page, cairo_t* cr, double zoom)
+{
+	if (page->getBackgroundType().isPdfPage())
+	{
+		XojPdfPageSPtr popplerPage = doc->getPdfPage(page->getPdfPageNr());
+		PdfView::drawPage(NULL, popplerPage, cr, zoom, page->getWidth(), page->getHeight());
+	}
+
+	DocumentView view;
+	view.drawPage(page, cr, false);
+}
+
+/**
+ * Labels the benchmark with the file format, selected by the second benchmark argument
+ */
+static bool useBinaryStrokes(benchmark::State& state, SyntheticDocument* doc)
+{
+	bool binaryStrokes = state.range(1) != 0;
+	if (binaryStrokes)
+	{
+		state.SetLabel(doc->getParams().name + ", binary strokes");
+	}
+	return binaryStrokes;
+}
+
+/**
+ * @return The size of the file in bytes, 0 if it does not exist
+ */
+static double getFileSize(Path file)
+{
+	GStatBuf st;
+	if (g_stat(file.c_str(), &st) != 0)
+	{
+		return 0;
+	}
+	return st.st_size;
+}
+
+static void BM_Load(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	bool binaryStrokes = useBinaryStrokes(state, doc);
+	Path file = doc->save(binaryStrokes ? "load-binary.xopp" : "load.xopp", binaryStrokes);
+
+	for (auto _ : state)
+	{
+		LoadHandler handler;
+		Document* loaded = handler.loadDocument(file.str());
+		if (loaded == NULL)
+		{
+			state.SkipWithError(handler.getLastError().c_str());
+			break;
+		}
+		benchmark::DoNotOptimize(loaded->getPageCount());
+	}
+
+	state.counters["points"] = doc->getPointCount();
+	state.counters["bytes"] = getFileSize(file);
+	state.SetItemsProcessed(state.iterations() * doc->getStrokeCount());
+}
+BENCHMARK(BM_Load)->Args({PRESET_HANDWRITING, 0})->Args({PRESET_HANDWRITING, 1})
+	->Args({PRESET_ANNOTATED_PDF, 0})->Args({PRESET_ANNOTATED_PDF, 1})
+	->Args({PRESET_DENSE, 0})->Args({PRESET_DENSE, 1})->Unit(benchmark::kMillisecond);
+
+static void BM_Save(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	bool binaryStrokes = useBinaryStrokes(state, doc);
+	Path file = doc->getTempFile("save.xopp");
+
+	for (auto _ : state)
+	{
+		SaveHandler handler;
+		handler.setBinaryStrokes(binaryStrokes);
+		handler.prepareSave(doc->getDocument());
+		handler.saveTo(file);
+		if (!handler.getErrorMessage().empty())
+		{
+			state.SkipWithError(handler.getErrorMessage().c_str());
+			break;
+		}
+	}
+
+	state.counters["points"] = doc->getPointCount();
+	state.counters["bytes"] = getFileSize(file);
+	state.SetItemsProcessed(state.iterations() * doc->getStrokeCount());
+}
+BENCHMARK(BM_Save)->Args({PRESET_HANDWRITING, 0})->Args({PRESET_HANDWRITING, 1})
+	->Args({PRESET_ANNOTATED_PDF, 0})->Args({PRESET_ANNOTATED_PDF, 1})
+	->Args({PRESET_DENSE, 0})->Args({PRESET_DENSE, 1})->Unit(benchmark::kMillisecond);
+
+/**
+ * Full render of the first page, the second argument is the zoom in percent
+ */
+static void BM_RenderPage(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	PageRef page = doc->getDocument()->getPage(0);
+	double zoom = state.range(1) / 100.0;
+
+	cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+			ceil(page->getWidth() * zoom), ceil(page->getHeight() * zoom));
+
+	for (auto _ : state)
+	{
+		cairo_t* cr = cairo_create(surface);
+		cairo_scale(cr, zoom, zoom);
+		renderPage(doc->getDocument(), page, cr, zoom);
+		cairo_destroy(cr);
+		cairo_surface_flush(surface);
+	}
+
+	cairo_surface_destroy(surface);
+}
+BENCHMARK(BM_RenderPage)->Args({PRESET_HANDWRITING, 100})->Args({PRESET_HANDWRITING, 200})
+	->Args({PRESET_ANNOTATED_PDF, 100})->Args({PRESET_DENSE, 100})->Unit(benchmark::kMillisecond);
+
+/**
+ * Rerender of a small rectangle, like RenderJob::rerenderRectangle after a change
+ */
+static void BM_RerenderRect(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	PageRef page = doc->getDocument()->getPage(0);
+	double zoom = 1.5;
+
+	double x = page->getWidth() / 2 - 50;
+	double y = page->getHeight() / 2 - 50;
+	double size = 100;
+
+	cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size * zoom, size * zoom);
+
+	for (auto _ : state)
+	{
+		cairo_t* cr = cairo_create(surface);
+		cairo_translate(cr, -x * zoom, -y * zoom);
+		cairo_scale(cr, zoom, zoom);
+
+		if (page->getBackgroundType().isPdfPage())
+		{
+			XojPdfPageSPtr popplerPage = doc->getDocument()->getPdfPage(page->getPdfPageNr());
+			PdfView::drawPage(NULL, popplerPage, cr, zoom, page->getWidth(), page->getHeight());
+		}
+
+		DocumentView view;
+		view.limitArea(x, y, size, size);
+		view.drawPage(page, cr, false);
+
+		cairo_destroy(cr);
+		cairo_surface_flush(surface);
+	}
+
+	cairo_surface_destroy(surface);
+}
+BENCHMARK(BM_RerenderRect)->Arg(PRESET_HANDWRITING)->Arg(PRESET_ANNOTATED_PDF)->Arg(PRESET_DENSE)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Standard eraser dragged over the first page, as the EraseHandler does it
+ */
+static void BM_Erase(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	PageRef page = doc->getDocument()->getPage(0);
+	Layer* layer = page->getSelectedLayer();
+	double halfEraserSize = 3;
+
+	vector<Stroke*> strokes;
+	for (Element* e : *layer->getElements())
+	{
+		if (e->getType() == ELEMENT_STROKE)
+		{
+			strokes.push_back((Stroke*) e);
+		}
+	}
+
+	int eraseEvents = 0;
+	for (auto _ : state)
+	{
+		vector<EraseableStroke*> eraseable(strokes.size(), NULL);
+
+		for (double y = 50; y < page->getHeight(); y += 120)
+		{
+			for (double x = 20; x < page->getWidth() - 20; x += 1.5)
+			{
+				double ey = y + 40 * sin(x * 0.02);
+				Range range(x, ey);
+
+				for (size_t i = 0; i < strokes.size(); i++)
+				{
+					if (!strokes[i]->intersects(x, ey, halfEraserSize))
+					{
+						continue;
+					}
+					if (eraseable[i] == NULL)
+					{
+						eraseable[i] = new EraseableStroke(strokes[i]);
+					}
+					eraseable[i]->erase(x, ey, halfEraserSize, &range);
+				}
+				eraseEvents++;
+			}
+		}
+
+		for (EraseableStroke* e : eraseable)
+		{
+			delete e;
+		}
+	}
+
+	state.counters["events"] = benchmark::Counter(eraseEvents, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Erase)->Arg(PRESET_HANDWRITING)->Arg(PRESET_DENSE)->Unit(benchmark::kMillisecond);
+
+/**
+ * Rectangle selection over the upper half of the first page
+ */
+static void BM_Selection(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	PageRef page = doc->getDocument()->getPage(0);
+	NullRedrawable view;
+
+	int selected = 0;
+	for (auto _ : state)
+	{
+		RectSelection selection(10, 10, &view);
+		selection.currentPos(page->getWidth() - 10, page->getHeight() / 2);
+		if (selection.finalize(page))
+		{
+			selected++;
+		}
+	}
+
+	benchmark::DoNotOptimize(selected);
+}
+BENCHMARK(BM_Selection)->Arg(PRESET_HANDWRITING)->Arg(PRESET_DENSE)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Text search over all pages, in the texts and the PDF background
+ */
+static void BM_Search(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	Document* document = doc->getDocument();
+
+	int found = 0;
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < document->getPageCount(); i++)
+		{
+			PageRef page = document->getPage(i);
+			XojPdfPageSPtr pdf;
+			if (page->getBackgroundType().isPdfPage())
+			{
+				pdf = document->getPdfPage(page->getPdfPageNr());
+			}
+
+			SearchControl search(page, pdf);
+			int occures = 0;
+			double top = 0;
+			search.search(SyntheticDocument::SEARCH_WORD, &occures, &top);
+			found += occures;
+		}
+	}
+
+	benchmark::DoNotOptimize(found);
+}
+BENCHMARK(BM_Search)->Arg(PRESET_HANDWRITING)->Arg(PRESET_ANNOTATED_PDF)->Unit(benchmark::kMillisecond);
+
+static void BM_ExportPdf(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	Path file = doc->getTempFile("export.pdf");
+
+	for (auto _ : state)
+	{
+		XojPdfExport* pdfe = XojPdfExportFactory::createExport(doc->getDocument(), NULL);
+		if (!pdfe->createPdf(file))
+		{
+			state.SkipWithError(pdfe->getLastError().c_str());
+			delete pdfe;
+			break;
+		}
+		delete pdfe;
+	}
+
+	state.SetItemsProcessed(state.iterations() * doc->getDocument()->getPageCount());
+}
+BENCHMARK(BM_ExportPdf)->Arg(PRESET_HANDWRITING)->Arg(PRESET_ANNOTATED_PDF)->Unit(benchmark::kMillisecond);
+
+static void BM_ExportPng(benchmark::State& state)
+{
+	SyntheticDocument* doc = getDocument(state);
+	Path file = doc->getTempFile("export.png");
+	DummyProgressListener progress;
+
+	for (auto _ : state)
+	{
+		PageRangeVector range = PageRange::parse("1");
+
+		ImageExport imgExport(doc->getDocument(), file, EXPORT_GRAPHICS_PNG, false, range);
+		imgExport.exportGraphics(&progress);
+
+		for (PageRangeEntry* e : range)
+		{
+			delete e;
+		}
+	}
+}
+BENCHMARK(BM_ExportPng)->Arg(PRESET_HANDWRITING)->Arg(PRESET_ANNOTATED_PDF)->Unit(benchmark::kMillisecond);
+
+/**
+ * Runs the benchmarks, or writes a generated document with
+ * --generate=<file.xopp> [--preset=handwriting|annotated-pdf|dense]
+ */
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+
+	string generate;
+	SyntheticDocumentParams params = SyntheticDocument::handwriting();
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (arg.find("--generate=") == 0)
+		{
+			generate = arg.substr(11);
+		}
+		else if (arg == "--preset=annotated-pdf")
+		{
+			params = SyntheticDocument::annotatedPdf();
+		}
+		else if (arg == "--preset=dense")
+		{
+			params = SyntheticDocument::dense();
+		}
+		else if (arg != "--preset=handwriting")
+		{
+			benchmark::ReportUnrecognizedArguments(argc, argv);
+			return 1;
+		}
+	}
+
+	if (!generate.empty())
+	{
+		params.attachPdf = true;
+		SyntheticDocument doc(params);
+		return doc.saveTo(Path(generate)) ? 0 : 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	return 0;
+}
@@ -0,0 +1,327 @@
+#include "SyntheticDocument.h"
+
+#include "control/xojfile/SaveHandler.h"
+#include "model/Image.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "model/Text.h"
+#include "model/XojPage.h"
+
+#include <cairo-pdf.h>
+
+#include <cmath>
+
+#define PAGE_WIDTH 595.275591
+#define PAGE_HEIGHT 841.889764
+
+const char* SyntheticDocument::SEARCH_WORD = "benchmark";
+
+SyntheticDocument::SyntheticDocument(SyntheticDocumentParams params)
+ : params(params)
+{
+	this->rand = g_rand_new_with_seed(params.seed);
+
+	gchar* folder = g_dir_make_tmp("xournalpp-benchmark-XXXXXX", NULL);
+	this->tmpFolder = Path(folder);
+	g_free(folder);
+
+	this->doc = new Document(&this->handler);
+
+	createImageData();
+
+	if (params.pdfBackground)
+	{
+		createPdf();
+	}
+
+	for (int i = 0; i < params.pages; i++)
+	{
+		PageRef page = new XojPage(PAGE_WIDTH, PAGE_HEIGHT);
+
+		if (params.pdfBackground)
+		{
+			page->setBackgroundType(PageType(PageTypeFormat::Pdf));
+			page->setBackgroundPdfPageNr(i);
+		}
+		else
+		{
+			page->setBackgroundType(PageType(PageTypeFormat::Lined));
+		}
+
+		fillPage(page, i);
+		this->doc->addPage(page);
+	}
+}
+
+SyntheticDocument::~SyntheticDocument()
+{
+	delete this->doc;
+	this->doc = NULL;
+
+	for (Path& p : this->tmpFiles)
+	{
+		p.deleteFile();
+	}
+	g_rmdir(this->tmpFolder.c_str());
+
+	g_rand_free(this->rand);
+	this->rand = NULL;
+}
+
+SyntheticDocumentParams SyntheticDocument::handwriting()
+{
+	SyntheticDocumentParams params;
+	params.name = "handwriting";
+	return params;
+}
+
+SyntheticDocumentParams SyntheticDocument::annotatedPdf()
+{
+	SyntheticDocumentParams params;
+	params.name = "annotated-pdf";
+	params.strokesPerPage = 40;
+	params.pointsPerStroke = 60;
+	params.pressure = false;
+	params.textsPerPage = 10;
+	params.imagesPerPage = 0;
+	params.pdfBackground = true;
+	return params;
+}
+
+SyntheticDocumentParams SyntheticDocument::dense()
+{
+	SyntheticDocumentParams params;
+	params.name = "dense";
+	params.pages = 2;
+	params.strokesPerPage = 1500;
+	params.pointsPerStroke = 250;
+	params.textsPerPage = 2;
+	params.imagesPerPage = 2;
+	return params;
+}
+
+Document* SyntheticDocument::getDocument()
+{
+	return this->doc;
+}
+
+const SyntheticDocumentParams& SyntheticDocument::getParams()
+{
+	return this->params;
+}
+
+int SyntheticDocument::getStrokeCount()
+{
+	return this->strokeCount;
+}
+
+int SyntheticDocument::getPointCount()
+{
+	return this->pointCount;
+}
+
+Path SyntheticDocument::getTempFile(string filename)
+{
+	Path file = this->tmpFolder / filename;
+	this->tmpFiles.push_back(file);
+	return file;
+}
+
+Path SyntheticDocument::save(string filename, bool binaryStrokes)
+{
+	Path file = getTempFile(filename);
+	if (this->params.pdfBackground && this->params.attachPdf)
+	{
+		getTempFile(filename + ".bg.pdf");
+	}
+
+	if (!saveTo(file, binaryStrokes))
+	{
+		return Path();
+	}
+
+	return file;
+}
+
+bool SyntheticDocument::saveTo(Path file, bool binaryStrokes)
+{
+	// The attached PDF is written next to the document
+	this->doc->setFilename(file);
+
+	SaveHandler handler;
+	handler.setBinaryStrokes(binaryStrokes);
+	handler.prepareSave(this->doc);
+	handler.saveTo(file);
+
+	if (!handler.getErrorMessage().empty())
+	{
+		g_warning("Could not save benchmark document: %s", handler.getErrorMessage().c_str());
+		return false;
+	}
+
+	return true;
+}
+
+double SyntheticDocument::random(double min, double max)
+{
+	return g_rand_double_range(this->rand, min, max);
+}
+
+/**
+ * A PDF with some lines of text on each page, so there is something to render and to search
+ */
+void SyntheticDocument::createPdf()
+{
+	Path file = getTempFile("background.pdf");
+
+	cairo_surface_t* surface = cairo_pdf_surface_create(file.c_str(), PAGE_WIDTH, PAGE_HEIGHT);
+	cairo_t* cr = cairo_create(surface);
+
+	cairo_select_font_face(cr, "Serif", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+	cairo_set_font_size(cr, 11);
+
+	for (int i = 0; i < this->params.pages; i++)
+	{
+		for (int line = 0; line < 55; line++)
+		{
+			cairo_move_to(cr, 60, 60 + line * 13);
+			string text = "Page " + std::to_string(i + 1) + ", line " + std::to_string(line + 1) +
+						  ": the quick brown fox jumps over the lazy dog, " + SEARCH_WORD;
+			cairo_show_text(cr, text.c_str());
+		}
+
+		cairo_rectangle(cr, 60, 780, PAGE_WIDTH - 120, 20);
+		cairo_stroke(cr);
+
+		cairo_show_page(cr);
+	}
+
+	cairo_destroy(cr);
+	cairo_surface_destroy(surface);
+
+	if (!this->doc->readPdf(file, false, this->params.attachPdf))
+	{
+		g_warning("Could not read benchmark PDF: %s", this->doc->getLastErrorMsg().c_str());
+	}
+}
+
+static cairo_status_t writePngData(string* data, const unsigned char* buffer, unsigned int length)
+{
+	data->append((const char*) buffer, length);
+	return CAIRO_STATUS_SUCCESS;
+}
+
+void SyntheticDocument::createImageData()
+{
+	cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 256, 256);
+	cairo_t* cr = cairo_create(surface);
+
+	cairo_pattern_t* pattern = cairo_pattern_create_linear(0, 0, 256, 256);
+	cairo_pattern_add_color_stop_rgb(pattern, 0, 0.9, 0.3, 0.1);
+	cairo_pattern_add_color_stop_rgb(pattern, 1, 0.1, 0.3, 0.9);
+	cairo_set_source(cr, pattern);
+	cairo_paint(cr);
+	cairo_pattern_destroy(pattern);
+
+	cairo_destroy(cr);
+
+	cairo_surface_write_to_png_stream(surface, (cairo_write_func_t) &writePngData, &this->imageData);
+	cairo_surface_destroy(surface);
+}
+
+void SyntheticDocument::fillPage(PageRef page, int pageNr)
+{
+	Layer* layer = new Layer();
+	page->addLayer(layer);
+
+	// Write line by line, like handwriting
+	double lineHeight = 24;
+	int lines = (PAGE_HEIGHT - 100) / lineHeight;
+	int strokesPerLine = MAX(1, (this->params.strokesPerPage + lines - 1) / lines);
+
+	for (int i = 0; i < this->params.strokesPerPage; i++)
+	{
+		int line = (i / strokesPerLine) % lines;
+		double x = 40 + (i % strokesPerLine) * (PAGE_WIDTH - 80) / strokesPerLine;
+		double y = 60 + line * lineHeight;
+
+		Stroke* s = createStroke(x + random(-2, 2), y + random(-2, 2));
+		if (this->params.highlighterEvery > 0 && i % this->params.highlighterEvery == 0)
+		{
+			s->setToolType(STROKE_TOOL_HIGHLIGHTER);
+			s->setColor(0xffff00);
+			s->setWidth(8.5);
+			s->clearPressure();
+		}
+		layer->addElement(s);
+	}
+
+	for (int i = 0; i < this->params.textsPerPage; i++)
+	{
+		layer->addElement(createText(random(40, PAGE_WIDTH - 240), random(40, PAGE_HEIGHT - 40), pageNr * 100 + i));
+	}
+
+	for (int i = 0; i < this->params.imagesPerPage; i++)
+	{
+		layer->addElement(createImage(random(40, PAGE_WIDTH - 200), random(40, PAGE_HEIGHT - 200)));
+	}
+}
+
+/**
+ * A cursive like stroke: loops moving to the right, with varying pressure
+ */
+Stroke* SyntheticDocument::createStroke(double x, double y)
+{
+	Stroke* s = new Stroke();
+	s->setToolType(STROKE_TOOL_PEN);
+	s->setColor(0x000000);
+	s->setWidth(1.41);
+
+	double frequency = random(1.6, 2.6);
+	double amplitude = random(3, 7);
+	double phase = random(0, 2 * M_PI);
+
+	for (int i = 0; i < this->params.pointsPerStroke; i++)
+	{
+		double t = i * 0.1;
+		double px = x + t * 0.8 + 3 * cos(t * frequency + phase);
+		double py = y + amplitude * sin(t * frequency + phase) + sin(t * 0.37);
+
+		if (this->params.pressure)
+		{
+			s->addPoint(Point(px, py, 1.41 * (0.6 + 0.4 * sin(t * 0.5 + phase))));
+		}
+		else
+		{
+			s->addPoint(Point(px, py));
+		}
+	}
+
+	this->strokeCount++;
+	this->pointCount += this->params.pointsPerStroke;
+
+	return s;
+}
+
+Text* SyntheticDocument::createText(double x, double y, int nr)
+{
+	Text* t = new Text();
+	t->setX(x);
+	t->setY(y);
+	t->setColor(0x3333cc);
+	t->setText("Note " + std::to_string(nr) + ": " + SEARCH_WORD + " text\nwith a second line");
+
+	return t;
+}
+
+Image* SyntheticDocument::createImage(double x, double y)
+{
+	Image* img = new Image();
+	img->setX(x);
+	img->setY(y);
+	img->setWidth(160);
+	img->setHeight(160);
+	img->setImage(this->imageData);
+
+	return img;
+}
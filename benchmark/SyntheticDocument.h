@@ -0,0 +1,142 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal Benchmarks
+ *
+ * Generates documents with a configurable amount of content
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "model/Document.h"
+#include "model/DocumentHandler.h"
+
+#include <Path.h>
+
+class Image;
+class Stroke;
+class Text;
+
+/**
+ * Parameters of a generated document
+ */
+class SyntheticDocumentParams
+{
+public:
+	string name = "default";
+
+	int pages = 4;
+	int strokesPerPage = 200;
+	int pointsPerStroke = 120;
+
+	/**
+	 * Strokes with pressure information, else with a fixed width
+	 */
+	bool pressure = true;
+
+	/**
+	 * Every n-th stroke is a highlighter stroke, 0 for none
+	 */
+	int highlighterEvery = 10;
+
+	int textsPerPage = 5;
+	int imagesPerPage = 1;
+
+	/**
+	 * Generate a PDF and use its pages as background
+	 */
+	bool pdfBackground = false;
+
+	/**
+	 * Attach the generated PDF, so a saved document does not depend on the temporary folder
+	 */
+	bool attachPdf = false;
+
+	/**
+	 * Seed of the random generator, the same parameters always generate the same document
+	 */
+	guint32 seed = 1;
+};
+
+class SyntheticDocument
+{
+public:
+	SyntheticDocument(SyntheticDocumentParams params);
+	virtual ~SyntheticDocument();
+
+public:
+	/**
+	 * Presets used by the benchmarks
+	 */
+	static SyntheticDocumentParams handwriting();
+	static SyntheticDocumentParams annotatedPdf();
+	static SyntheticDocumentParams dense();
+
+	/**
+	 * A word which is contained in every text and on every PDF page
+	 */
+	static const char* SEARCH_WORD;
+
+public:
+	Document* getDocument();
+	const SyntheticDocumentParams& getParams();
+
+	/**
+	 * Saves the document as .xopp into the temporary folder
+	 *
+	 * @param binaryStrokes Write the points with BinaryStrokeFormat
+	 * @return The path of the saved file, empty on error
+	 */
+	Path save(string filename, bool binaryStrokes = false);
+
+	/**
+	 * Saves the document as .xopp
+	 *
+	 * @param binaryStrokes Write the points with BinaryStrokeFormat
+	 * @return true on success
+	 */
+	bool saveTo(Path file, bool binaryStrokes = false);
+
+	/**
+	 * @return A file in the temporary folder of this document, deleted with the document
+	 */
+	Path getTempFile(string filename);
+
+	int getStrokeCount();
+	int getPointCount();
+
+private:
+	void createPdf();
+	void createImageData();
+	void fillPage(PageRef page, int pageNr);
+
+	Stroke* createStroke(double x, double y);
+	Text* createText(double x, double y, int nr);
+	Image* createImage(double x, double y);
+
+	double random(double min, double max);
+
+private:
+	SyntheticDocumentParams params;
+
+	DocumentHandler handler;
+	Document* doc = NULL;
+
+	GRand* rand = NULL;
+
+	Path tmpFolder;
+	vector<Path> tmpFiles;
+
+	/**
+	 * PNG data shared by all images
+	 */
+	string imageData;
+
+	int strokeCount = 0;
+	int pointCount = 0;
+};
@@ -1,6 +1,10 @@
 #include "AudioController.h"
 #include "Util.h"
 
+#include <gui/PageView.h>
+#include <gui/XournalView.h>
+#include <model/AudioElement.h>
+
 #include <i18n.h>
 #include <XojMsgBox.h>
 
@@ -9,14 +13,18 @@ AudioController::AudioController(Settings* settings, Control* control)
 	XOJ_INIT_TYPE(AudioController);
 	this->settings = settings;
 	this->control = control;
-	this->audioRecorder = new AudioRecorder(settings);
-	this->audioPlayer = new AudioPlayer(control, settings);
 }
 
 AudioController::~AudioController()
 {
 	XOJ_CHECK_TYPE(AudioController);
 
+	if (this->highlightTimeout)
+	{
+		g_source_remove(this->highlightTimeout);
+		this->highlightTimeout = 0;
+	}
+
 	delete this->audioRecorder;
 	this->audioRecorder = nullptr;
 
@@ -26,6 +34,32 @@ AudioController::~AudioController()
 	XOJ_RELEASE_TYPE(AudioController);
 }
 
+/**
+ * The recorder and the player initialize PortAudio, which takes a while,
+ * so they are only created once audio is used
+ */
+AudioRecorder* AudioController::getAudioRecorder()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (this->audioRecorder == nullptr)
+	{
+		this->audioRecorder = new AudioRecorder(this->settings);
+	}
+	return this->audioRecorder;
+}
+
+AudioPlayer* AudioController::getAudioPlayer()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (this->audioPlayer == nullptr)
+	{
+		this->audioPlayer = new AudioPlayer(this->control, this->settings);
+	}
+	return this->audioPlayer;
+}
+
 bool AudioController::startRecording()
 {
 	XOJ_CHECK_TYPE(AudioController);
@@ -52,7 +86,7 @@ bool AudioController::startRecording()
 
 		g_message("Start recording");
 
-		bool isRecording = this->audioRecorder->start(getAudioFolder().str() + "/" + data);
+		bool isRecording = getAudioRecorder()->start(getAudioFolder().str() + "/" + data);
 
 		if (!isRecording)
 		{
@@ -69,14 +103,14 @@ bool AudioController::stopRecording()
 {
 	XOJ_CHECK_TYPE(AudioController);
 
-	if (this->audioRecorder->isRecording())
+	if (isRecording())
 	{
 		audioFilename = "";
 		this->timestamp = 0;
 
 		g_message("Stop recording");
 
-		this->audioRecorder->stop();
+		getAudioRecorder()->stop();
 	}
 	return true;
 }
@@ -85,25 +119,28 @@ bool AudioController::isRecording()
 {
 	XOJ_CHECK_TYPE(AudioController);
 
-	return this->audioRecorder->isRecording();
+	return this->audioRecorder != nullptr && this->audioRecorder->isRecording();
 }
 
 bool AudioController::isPlaying()
 {
 	XOJ_CHECK_TYPE(AudioController);
 
-	return this->audioPlayer->isPlaying();
+	return this->audioPlayer != nullptr && this->audioPlayer->isPlaying();
 }
 
-bool AudioController::startPlayback(string filename, unsigned int timestamp)
+bool AudioController::startPlayback(string recording, unsigned int timestamp)
 {
 	XOJ_CHECK_TYPE(AudioController);
 
-	this->audioPlayer->stop();
-	bool status = this->audioPlayer->start(std::move(filename), timestamp);
+	getAudioPlayer()->stop();
+	bool status = getAudioPlayer()->start(getRecordingPath(recording), timestamp);
 	if (status)
 	{
+		this->playbackRecording = recording;
+		this->followedPage = NULL;
 		this->control->getWindow()->getToolMenuHandler()->enableAudioPlaybackButtons();
+		startHighlighting();
 	}
 	return status;
 }
@@ -114,7 +151,14 @@ void AudioController::pausePlayback()
 
 	this->control->getWindow()->getToolMenuHandler()->setAudioPlaybackPaused(true);
 
-	this->audioPlayer->pause();
+	getAudioPlayer()->pause();
+
+	// Keep the highlights while paused
+	if (this->highlightTimeout)
+	{
+		g_source_remove(this->highlightTimeout);
+		this->highlightTimeout = 0;
+	}
 }
 
 void AudioController::continuePlayback()
@@ -123,7 +167,8 @@ void AudioController::continuePlayback()
 
 	this->control->getWindow()->getToolMenuHandler()->setAudioPlaybackPaused(false);
 
-	this->audioPlayer->play();
+	getAudioPlayer()->play();
+	startHighlighting();
 }
 
 void AudioController::stopPlayback()
@@ -131,7 +176,181 @@ void AudioController::stopPlayback()
 	XOJ_CHECK_TYPE(AudioController);
 
 	this->control->getWindow()->getToolMenuHandler()->disableAudioPlaybackButtons();
-	this->audioPlayer->stop();
+	if (this->audioPlayer)
+	{
+		this->audioPlayer->stop();
+	}
+	stopHighlighting();
+}
+
+vector<AudioHighlight>& AudioController::getHighlights()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	return this->highlights;
+}
+
+string AudioController::getRecordingPath(string recording)
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (recording.rfind(G_DIR_SEPARATOR, 0) == 0)
+	{
+		return recording;
+	}
+
+	Path path = Path::fromUri(this->settings->getAudioFolder());
+	path /= recording;
+
+	return path.str();
+}
+
+void AudioController::startHighlighting()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (this->highlightTimeout == 0)
+	{
+		this->highlightTimeout = g_timeout_add(AUDIO_HIGHLIGHT_INTERVAL, (GSourceFunc) highlightCallback, this);
+	}
+	updateHighlights();
+}
+
+void AudioController::stopHighlighting()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (this->highlightTimeout)
+	{
+		g_source_remove(this->highlightTimeout);
+		this->highlightTimeout = 0;
+	}
+
+	repaintHighlights();
+	this->highlights.clear();
+	this->followedPage = NULL;
+}
+
+gboolean AudioController::highlightCallback(AudioController* controller)
+{
+	XOJ_CHECK_TYPE_OBJ(controller, AudioController);
+
+	if (!controller->isPlaying())
+	{
+		// Finished, removed by returning false
+		controller->highlightTimeout = 0;
+		controller->repaintHighlights();
+		controller->highlights.clear();
+		return false;
+	}
+
+	controller->updateHighlights();
+	return true;
+}
+
+/**
+ * Only the elements written shortly before the playback position are looked
+ * up in the timeline of the document, nothing is scanned
+ */
+void AudioController::updateHighlights()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	size_t position = getAudioPlayer()->getPlaybackTime();
+	size_t from = position > AUDIO_HIGHLIGHT_DURATION ? position - AUDIO_HIGHLIGHT_DURATION : 0;
+
+	vector<AudioTimelineEntry> entries;
+	vector<AudioHighlight> updated;
+	PageRef current;
+
+	Document* doc = this->control->getDocument();
+	doc->lock();
+	AudioTimeline* timeline = doc->getAudioTimeline();
+	timeline->findInRange(this->playbackRecording, from, position + 1, entries);
+
+	const AudioTimelineEntry* last = timeline->findAt(this->playbackRecording, position);
+	if (last != NULL)
+	{
+		current = last->page;
+	}
+
+	for (AudioTimelineEntry& e : entries)
+	{
+		Element* elem = e.element;
+		AudioHighlight h = { e.page, e.element,
+							 Rectangle(elem->getX(), elem->getY(), elem->getElementWidth(), elem->getElementHeight()) };
+		updated.push_back(h);
+	}
+	doc->unlock();
+
+	followPlayback(current);
+
+	bool changed = updated.size() != this->highlights.size();
+	for (size_t i = 0; !changed && i < updated.size(); i++)
+	{
+		changed = updated[i].element != this->highlights[i].element;
+	}
+
+	if (!changed)
+	{
+		return;
+	}
+
+	repaintHighlights();
+	this->highlights.swap(updated);
+	repaintHighlights();
+}
+
+/**
+ * Scrolls to the page of the element written last before the playback position, only if
+ * this page changes, so the user can still scroll around on the page while it is played
+ */
+void AudioController::followPlayback(PageRef page)
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (!page.isValid() || (XojPage*) page == this->followedPage || this->control->getWindow() == NULL)
+	{
+		return;
+	}
+	this->followedPage = page;
+
+	Document* doc = this->control->getDocument();
+	doc->lock();
+	size_t pageNr = doc->indexOf(page);
+	doc->unlock();
+
+	if (pageNr != size_t_npos && pageNr != this->control->getCurrentPageNo())
+	{
+		this->control->getScrollHandler()->scrollToPage(pageNr);
+	}
+}
+
+void AudioController::repaintHighlights()
+{
+	XOJ_CHECK_TYPE(AudioController);
+
+	if (this->highlights.empty() || this->control->getWindow() == NULL)
+	{
+		return;
+	}
+
+	Document* doc = this->control->getDocument();
+	XournalView* xournal = this->control->getWindow()->getXournal();
+
+	for (AudioHighlight& h : this->highlights)
+	{
+		// The page may have been deleted meanwhile
+		doc->lock();
+		size_t pageNr = doc->indexOf(h.page);
+		doc->unlock();
+
+		XojPageView* view = pageNr == size_t_npos ? NULL : xournal->getViewFor(pageNr);
+		if (view)
+		{
+			view->repaintArea(h.rect.x, h.rect.y, h.rect.x + h.rect.width, h.rect.y + h.rect.height);
+		}
+	}
 }
 
 string AudioController::getAudioFilename()
@@ -170,12 +389,12 @@ vector<DeviceInfo> AudioController::getOutputDevices()
 {
 	XOJ_CHECK_TYPE(AudioController);
 
-	return this->audioPlayer->getOutputDevices();
+	return getAudioPlayer()->getOutputDevices();
 }
 
 vector<DeviceInfo> AudioController::getInputDevices()
 {
 	XOJ_CHECK_TYPE(AudioController);
 
-	return this->audioRecorder->getInputDevices();
+	return getAudioRecorder()->getInputDevices();
 }
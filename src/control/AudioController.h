@@ -18,6 +18,28 @@
 #include <util/audio/AudioRecorder.h>
 #include <util/audio/AudioPlayer.h>
 #include <gui/toolbarMenubar/ToolMenuHandler.h>
+#include <model/AudioTimeline.h>
+#include <Rectangle.h>
+
+/**
+ * Interval of the highlight update while playing, in milliseconds
+ */
+#define AUDIO_HIGHLIGHT_INTERVAL 50
+
+/**
+ * Elements written up to this time before the playback position are highlighted, in milliseconds
+ */
+#define AUDIO_HIGHLIGHT_DURATION 1500
+
+/**
+ * An element of the playing recording, which is drawn highlighted
+ */
+struct AudioHighlight
+{
+	PageRef page;
+	AudioElement* element;
+	Rectangle rect;
+};
 
 class AudioController
 {
@@ -31,24 +53,63 @@ public:
 	bool isRecording();
 
 	bool isPlaying();
-	bool startPlayback(string filename, unsigned int timestamp);
+
+	/**
+	 * @param recording The audio filename as stored in the elements
+	 * @param timestamp Start position in milliseconds
+	 */
+	bool startPlayback(string recording, unsigned int timestamp);
 	void pausePlayback();
 	void continuePlayback();
 	void stopPlayback();
 
+	/**
+	 * @return The elements written just before the current playback position
+	 */
+	vector<AudioHighlight>& getHighlights();
+
 	string getAudioFilename();
 	Path getAudioFolder();
 	size_t getStartTime();
 	vector<DeviceInfo> getOutputDevices();
 	vector<DeviceInfo> getInputDevices();
 
+protected:
+	/**
+	 * @return The path of a recording, relative names are in the audio folder
+	 */
+	string getRecordingPath(string recording);
+
+	AudioRecorder* getAudioRecorder();
+	AudioPlayer* getAudioPlayer();
+
+	void startHighlighting();
+	void stopHighlighting();
+	void updateHighlights();
+	void followPlayback(PageRef page);
+	void repaintHighlights();
+	static gboolean highlightCallback(AudioController* controller);
+
 protected:
 	string audioFilename;
 	size_t timestamp = 0;
 	Settings* settings;
 	Control* control;
-	AudioRecorder* audioRecorder;
-	AudioPlayer* audioPlayer;
+	AudioRecorder* audioRecorder = nullptr;
+	AudioPlayer* audioPlayer = nullptr;
+
+	/**
+	 * The recording which is playing, as stored in the elements
+	 */
+	string playbackRecording;
+
+	vector<AudioHighlight> highlights;
+	guint highlightTimeout = 0;
+
+	/**
+	 * The page of the element written last before the playback position, only compared
+	 */
+	XojPage* followedPage = NULL;
 
 private:
 	XOJ_TYPE_ATTRIB;
@@ -28,6 +28,7 @@
 #include "jobs/BlockingJob.h"
 #include "jobs/CustomExportJob.h"
 #include "jobs/PdfExportJob.h"
+#include "jobs/PdfPageSizeJob.h"
 #include "jobs/SaveJob.h"
 #include "model/BackgroundImage.h"
 #include "model/FormatDefinitions.h"
@@ -49,6 +50,7 @@
 #include "CrashHandler.h"
 #include "PathUtil.h"
 #include "Stacktrace.h"
+#include "StartupTimeline.h"
 #include "StringUtils.h"
 #include "Util.h"
 #include "XojMsgBox.h"
@@ -95,6 +97,7 @@ Control::Control(GladeSearchpath* gladeSearchPath)
 	name /= SETTINGS_XML_FILE;
 	this->settings = new Settings(name);
 	this->settings->load();
+	StartupTimeline::mark("settings loaded");
 
 	TextView::setDpi(settings->getDisplayDpi());
 
@@ -132,8 +135,8 @@ Control::Control(GladeSearchpath* gladeSearchPath)
 
 	this->fullscreenHandler = new FullscreenHandler(settings);
 
+	// The plugins are loaded after the main window was drawn the first time
 	this->pluginController = new PluginController(this);
-	this->pluginController->registerToolbar();
 }
 
 Control::~Control()
@@ -143,6 +146,12 @@ Control::~Control()
 	g_source_remove(this->changeTimout);
 	this->enableAutosave(false);
 
+	if (this->deferredInitSource)
+	{
+		g_source_remove(this->deferredInitSource);
+		this->deferredInitSource = 0;
+	}
+
 	deleteLastAutosaveFile("");
 
 	this->scheduler->stop();
@@ -383,12 +392,42 @@ void Control::initWindow(MainWindow* win)
 
 	win->setFontButtonFont(settings->getFont());
 
-	this->pluginController->registerMenu();
+	this->firstDrawHandler = g_signal_connect_after(win->getWindow(), "draw", G_CALLBACK(firstDrawCallback), this);
 
 	fireActionSelected(GROUP_SNAPPING, settings->isSnapRotation() ? ACTION_ROTATION_SNAPPING : ACTION_NONE);
 	fireActionSelected(GROUP_GRID_SNAPPING, settings->isSnapGrid() ? ACTION_GRID_SNAPPING : ACTION_NONE);
 }
 
+/**
+ * Everything not needed for the first frame is initialized once it is on screen
+ */
+gboolean Control::firstDrawCallback(GtkWidget* widget, cairo_t* cr, Control* control)
+{
+	XOJ_CHECK_TYPE_OBJ(control, Control);
+
+	g_signal_handler_disconnect(widget, control->firstDrawHandler);
+	control->firstDrawHandler = 0;
+
+	StartupTimeline::mark("first frame");
+
+	control->deferredInitSource = g_idle_add((GSourceFunc) deferredInitCallback, control);
+
+	return false;
+}
+
+bool Control::deferredInitCallback(Control* control)
+{
+	XOJ_CHECK_TYPE_OBJ(control, Control);
+
+	control->deferredInitSource = 0;
+
+	control->pluginController->loadPlugins();
+	StartupTimeline::mark("plugins loaded");
+
+	// Do not call again!
+	return false;
+}
+
 bool Control::autosaveCallback(Control* control)
 {
 	XOJ_CHECK_TYPE_OBJ(control, Control);
@@ -2565,7 +2604,18 @@ bool Control::annotatePdf(Path filename, bool attachPdf, bool attachToDocument)
 
 		this->doc->lock();
 		Path file = this->doc->getEvMetadataFilename();
+		size_t sizesRead = this->doc->getPdfPageSizesRead();
+		bool readSizes = sizesRead > 0 && sizesRead < this->doc->getPdfPageCount();
 		this->doc->unlock();
+
+		// The remaining page sizes are read in the background
+		if (readSizes)
+		{
+			PdfPageSizeJob* job = new PdfPageSizeJob(this, sizesRead);
+			this->scheduler->addJob(job, JOB_PRIORITY_NONE);
+			job->unref();
+		}
+
 		MetadataEntry md = metadata->getForFile(file.str());
 		loadMetadata(md);
 	}
@@ -2591,12 +2641,30 @@ void Control::print()
 {
 	XOJ_CHECK_TYPE(Control);
 
+	readPdfPageSizes();
+
 	PrintHandler print;
 	this->doc->lock();
 	print.print(this->doc, getCurrentPageNo());
 	this->doc->unlock();
 }
 
+void Control::readPdfPageSizes()
+{
+	XOJ_CHECK_TYPE(Control);
+
+	std::vector<size_t> changed;
+
+	this->doc->lock();
+	this->doc->readPdfPageSizes(changed);
+	this->doc->unlock();
+
+	if (!changed.empty())
+	{
+		firePageSizesChanged(changed);
+	}
+}
+
 void Control::block(string name)
 {
 	XOJ_CHECK_TYPE(Control);
@@ -2673,6 +2741,8 @@ bool Control::save(bool synchron)
 		}
 	}
 
+	readPdfPageSizes();
+
 	auto* job = new SaveJob(this);
 	bool result = true;
 	if (synchron)
@@ -2816,6 +2886,7 @@ void Control::exportBase(BaseExportJob* job)
 {
 	if (job->showFilechooser())
 	{
+		readPdfPageSizes();
 		this->scheduler->addJob(job, JOB_PRIORITY_NONE);
 	}
 	else
@@ -77,6 +77,12 @@ public:
 	void exportBase(BaseExportJob* job);
 	void quit(bool allowCancel = true);
 
+	/**
+	 * Reads the PDF page sizes which are not read yet by PdfPageSizeJob,
+	 * so the pages are saved, exported and printed with their real size
+	 */
+	void readPdfPageSizes();
+
 	/**
 	 * Save the current document.
 	 *
@@ -303,6 +309,9 @@ protected:
 	static bool checkChangedDocument(Control* control);
 	static bool autosaveCallback(Control* control);
 
+	static gboolean firstDrawCallback(GtkWidget* widget, cairo_t* cr, Control* control);
+	static bool deferredInitCallback(Control* control);
+
 	void fontChanged();
 	/**
 	 * Load metadata later, md will be deleted
@@ -361,6 +370,12 @@ private:
 	 */
 	int changeTimout;
 
+	/**
+	 * Handler of the first "draw" of the main window, and the idle source which finishes the startup afterwards
+	 */
+	gulong firstDrawHandler = 0;
+	guint deferredInitSource = 0;
+
 	/**
 	 * The pages wihch has changed since the last update (for preview update)
 	 */
@@ -1,5 +1,7 @@
 #include "PdfCache.h"
 
+#include <Tracer.h>
+
 #include <stdio.h>
 
 class PdfCacheEntry
@@ -11,6 +13,7 @@ public:
 
 		this->popplerPage = popplerPage;
 		this->rendered = img;
+		this->lastUse = g_get_monotonic_time();
 	}
 
 	~PdfCacheEntry()
@@ -26,8 +29,18 @@ public:
 
 	XOJ_TYPE_ATTRIB;
 
+	size_t getBytes()
+	{
+		return (size_t) cairo_image_surface_get_stride(this->rendered) * cairo_image_surface_get_height(this->rendered);
+	}
+
 	XojPdfPageSPtr popplerPage;
 	cairo_surface_t* rendered;
+
+	/**
+	 * Monotonic time of the last render
+	 */
+	gint64 lastUse;
 };
 
 PdfCache::PdfCache(int size)
@@ -37,12 +50,16 @@ PdfCache::PdfCache(int size)
 	this->size = size;
 
 	g_mutex_init(&this->renderMutex);
+
+	RenderMemoryManager::getInstance().addClient(this);
 }
 
 PdfCache::~PdfCache()
 {
 	XOJ_CHECK_TYPE(PdfCache);
 
+	RenderMemoryManager::getInstance().removeClient(this);
+
 	clearCache();
 	this->size = 0;
 
@@ -71,17 +88,25 @@ void PdfCache::clearCache()
 		delete e;
 	}
 	this->data.clear();
+
+	updateMemoryUsage();
 }
 
 cairo_surface_t* PdfCache::lookup(XojPdfPageSPtr popplerPage)
 {
 	XOJ_CHECK_TYPE(PdfCache);
 
-	for (PdfCacheEntry* e : this->data)
+	for (auto it = this->data.begin(); it != this->data.end(); it++)
 	{
+		PdfCacheEntry* e = *it;
 		XOJ_CHECK_TYPE_OBJ(e, PdfCacheEntry);
 		if (e->popplerPage->getPageId() == popplerPage->getPageId())
 		{
+			// Keep the list ordered by the last use
+			e->lastUse = g_get_monotonic_time();
+			this->data.splice(this->data.begin(), this->data, it);
+			updateMemoryUsage();
+
 			return e->rendered;
 		}
 	}
@@ -98,15 +123,92 @@ void PdfCache::cache(XojPdfPageSPtr popplerPage, cairo_surface_t* img)
 	
 	while (this->data.size() > this->size)
 	{
-		delete this->data.back();
-		this->data.pop_back();
+		removeLast();
+	}
+
+	updateMemoryUsage();
+	RenderMemoryManager::getInstance().bufferAllocated();
+}
+
+void PdfCache::removeLast()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	delete this->data.back();
+	this->data.pop_back();
+}
+
+void PdfCache::updateMemoryUsage()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	size_t bytes = 0;
+	for (PdfCacheEntry* e : this->data)
+	{
+		bytes += e->getBytes();
 	}
+
+	this->memoryBytes = bytes;
+	this->memoryLastUse = this->data.empty() ? 0 : this->data.back()->lastUse;
+}
+
+size_t PdfCache::getRenderMemoryBytes()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	return this->memoryBytes;
+}
+
+bool PdfCache::isRenderMemoryInUse()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	return false;
+}
+
+gint64 PdfCache::getRenderMemoryLastUse()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	return this->memoryLastUse;
+}
+
+double PdfCache::getRenderMemoryCost()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	// Poppler is slower than drawing the strokes of a typical page
+	return 2;
+}
+
+size_t PdfCache::freeRenderMemory()
+{
+	XOJ_CHECK_TYPE(PdfCache);
+
+	if (!g_mutex_trylock(&this->renderMutex))
+	{
+		return 0;
+	}
+
+	size_t bytes = 0;
+	if (!this->data.empty())
+	{
+		bytes = this->data.back()->getBytes();
+		removeLast();
+		updateMemoryUsage();
+	}
+
+	g_mutex_unlock(&this->renderMutex);
+
+	return bytes;
 }
 
 void PdfCache::render(cairo_t* cr, XojPdfPageSPtr popplerPage, double zoom)
 {
 	XOJ_CHECK_TYPE(PdfCache);
 
+	TRACE_ZONE("PdfCache::render");
+
 	g_mutex_lock(&this->renderMutex);
 
 	this->setZoom(zoom);
@@ -11,16 +11,19 @@
 
 #pragma once
 
+#include "RenderMemoryManager.h"
+
 #include "pdf/base/XojPdfPage.h"
 #include <XournalType.h>
 
 #include <cairo/cairo.h>
+#include <atomic>
 #include <list>
 using std::list;
 
 class PdfCacheEntry;
 
-class PdfCache
+class PdfCache : public RenderMemoryClient
 {
 public:
 	PdfCache(int size);
@@ -33,11 +36,28 @@ private:
 public:
 	void render(cairo_t* cr, XojPdfPageSPtr popplerPage, double zoom);
 
+public: // RenderMemoryClient
+	size_t getRenderMemoryBytes();
+	bool isRenderMemoryInUse();
+	gint64 getRenderMemoryLastUse();
+	double getRenderMemoryCost();
+
+	/**
+	 * Frees the least recently used page, the cache may be busy rendering
+	 */
+	size_t freeRenderMemory();
+
 private:
 	void setZoom(double zoom);
 	void clearCache();
 	cairo_surface_t* lookup(XojPdfPageSPtr popplerPage);
 	void cache(XojPdfPageSPtr popplerPage, cairo_surface_t* img);
+	void removeLast();
+
+	/**
+	 * Updates the values read by the RenderMemoryManager, called with renderMutex locked
+	 */
+	void updateMemoryUsage();
 
 private:
 	XOJ_TYPE_ATTRIB;
@@ -48,4 +68,10 @@ private:
 	list<PdfCacheEntry*>::size_type size = 0;
 
 	double zoom = -1;
+
+	/**
+	 * Updated while locked, so the RenderMemoryManager does not need to wait for a render
+	 */
+	std::atomic<size_t> memoryBytes{0};
+	std::atomic<gint64> memoryLastUse{0};
 };
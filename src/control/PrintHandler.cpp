@@ -50,6 +50,8 @@ void PrintHandler::drawPage(GtkPrintOperation* operation, GtkPrintContext* conte
 	}
 
 	DocumentView view;
+	// Printers may not use a vector surface, print the exact strokes anyway
+	view.setLevelOfDetail(false);
 	view.drawPage(page, cr, true /* dont render eraseable */);
 }
 
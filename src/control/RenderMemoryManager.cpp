@@ -0,0 +1,255 @@
+#include "RenderMemoryManager.h"
+
+#include <Tracer.h>
+
+#include <algorithm>
+
+RenderMemoryClient::~RenderMemoryClient() { }
+
+double RenderMemoryClient::getRenderMemoryCost()
+{
+	return 1;
+}
+
+static RenderMemoryManager* instance = NULL;
+
+RenderMemoryManager& RenderMemoryManager::getInstance()
+{
+	if (instance == NULL)
+	{
+		instance = new RenderMemoryManager();
+	}
+
+	return *instance;
+}
+
+void RenderMemoryManager::freeInstance()
+{
+	delete instance;
+	instance = NULL;
+}
+
+RenderMemoryManager::RenderMemoryManager()
+{
+	XOJ_INIT_TYPE(RenderMemoryManager);
+
+	g_mutex_init(&this->clientMutex);
+	g_mutex_init(&this->checkMutex);
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+	this->memoryMonitor = g_memory_monitor_dup_default();
+	g_signal_connect(this->memoryMonitor, "low-memory-warning", G_CALLBACK(lowMemoryWarning), this);
+#endif
+}
+
+RenderMemoryManager::~RenderMemoryManager()
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+	g_signal_handlers_disconnect_by_data(this->memoryMonitor, this);
+	g_object_unref(this->memoryMonitor);
+	this->memoryMonitor = NULL;
+#endif
+
+	if (this->checkSourceId)
+	{
+		g_source_remove(this->checkSourceId);
+		this->checkSourceId = 0;
+	}
+
+	if (!this->clients.empty())
+	{
+		g_warning("RenderMemoryManager: %i clients not removed", (int) this->clients.size());
+	}
+
+	g_mutex_clear(&this->clientMutex);
+	g_mutex_clear(&this->checkMutex);
+
+	XOJ_RELEASE_TYPE(RenderMemoryManager);
+}
+
+void RenderMemoryManager::addClient(RenderMemoryClient* client)
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	g_mutex_lock(&this->clientMutex);
+	this->clients.push_back(client);
+	g_mutex_unlock(&this->clientMutex);
+}
+
+void RenderMemoryManager::removeClient(RenderMemoryClient* client)
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	g_mutex_lock(&this->clientMutex);
+	auto it = std::find(this->clients.begin(), this->clients.end(), client);
+	if (it != this->clients.end())
+	{
+		this->clients.erase(it);
+	}
+	g_mutex_unlock(&this->clientMutex);
+}
+
+void RenderMemoryManager::setBudget(size_t budget)
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	this->budget = budget;
+	bufferAllocated();
+}
+
+size_t RenderMemoryManager::getBudget()
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	return this->budget;
+}
+
+void RenderMemoryManager::bufferAllocated()
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	g_mutex_lock(&this->checkMutex);
+	if (this->checkSourceId == 0)
+	{
+		this->checkSourceId = g_idle_add((GSourceFunc) checkBudgetCallback, this);
+	}
+	g_mutex_unlock(&this->checkMutex);
+}
+
+gboolean RenderMemoryManager::checkBudgetCallback(RenderMemoryManager* manager)
+{
+	XOJ_CHECK_TYPE_OBJ(manager, RenderMemoryManager);
+
+	g_mutex_lock(&manager->checkMutex);
+	manager->checkSourceId = 0;
+	g_mutex_unlock(&manager->checkMutex);
+
+	if (manager->freeUntil(manager->budget) > 0 && Tracer::isEnabled())
+	{
+		manager->logUsage("budget exceeded");
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+void RenderMemoryManager::lowMemoryWarning(GMemoryMonitor* monitor, GMemoryMonitorWarningLevel level,
+                                           RenderMemoryManager* manager)
+{
+	XOJ_CHECK_TYPE_OBJ(manager, RenderMemoryManager);
+
+	if (level >= G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL)
+	{
+		manager->freeUntil(0);
+	}
+	else if (level >= G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM)
+	{
+		manager->freeUntil(manager->budget / 4);
+	}
+	else
+	{
+		manager->freeUntil(manager->budget / 2);
+	}
+
+	manager->logUsage("low memory warning");
+}
+#endif
+
+/**
+ * A client which may be freed
+ */
+struct RenderMemoryCandidate
+{
+	RenderMemoryClient* client;
+	size_t bytes;
+	double score;
+};
+
+static double evictionScore(RenderMemoryClient* client, size_t bytes, gint64 now)
+{
+	double age = (double) (now - client->getRenderMemoryLastUse()) / G_USEC_PER_SEC;
+	double cost = std::max(client->getRenderMemoryCost(), 0.01);
+
+	return bytes * (std::max(age, 0.0) + 1) / cost;
+}
+
+size_t RenderMemoryManager::freeUntil(size_t limit)
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	TRACE_ZONE("RenderMemoryManager::freeUntil");
+
+	g_mutex_lock(&this->clientMutex);
+
+	gint64 now = g_get_monotonic_time();
+	size_t usage = 0;
+	std::vector<RenderMemoryCandidate> candidates;
+
+	for (RenderMemoryClient* c : this->clients)
+	{
+		size_t bytes = c->getRenderMemoryBytes();
+		usage += bytes;
+
+		if (bytes > 0 && !c->isRenderMemoryInUse())
+		{
+			RenderMemoryCandidate candidate = { c, bytes, evictionScore(c, bytes, now) };
+			candidates.push_back(candidate);
+		}
+	}
+
+	size_t freed = 0;
+	while (usage > limit && !candidates.empty())
+	{
+		auto best = std::max_element(candidates.begin(), candidates.end(),
+		                             [](const RenderMemoryCandidate& a, const RenderMemoryCandidate& b)
+		                             {
+			                             return a.score < b.score;
+		                             });
+
+		size_t released = std::min(best->client->freeRenderMemory(), usage);
+		usage -= released;
+		freed += released;
+
+		// A client may free only a part, e.g. one entry of a cache
+		best->bytes = best->client->getRenderMemoryBytes();
+		if (released == 0 || best->bytes == 0)
+		{
+			candidates.erase(best);
+		}
+		else
+		{
+			best->score = evictionScore(best->client, best->bytes, now);
+		}
+	}
+
+	g_mutex_unlock(&this->clientMutex);
+
+	return freed;
+}
+
+size_t RenderMemoryManager::getUsage()
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	g_mutex_lock(&this->clientMutex);
+
+	size_t usage = 0;
+	for (RenderMemoryClient* c : this->clients)
+	{
+		usage += c->getRenderMemoryBytes();
+	}
+
+	g_mutex_unlock(&this->clientMutex);
+
+	return usage;
+}
+
+void RenderMemoryManager::logUsage(const char* reason)
+{
+	XOJ_CHECK_TYPE(RenderMemoryManager);
+
+	g_message("Render memory (%s): %.1f MiB of %.1f MiB used by %i clients", reason,
+	          getUsage() / (1024.0 * 1024.0), this->budget / (1024.0 * 1024.0), (int) this->clients.size());
+}
@@ -0,0 +1,133 @@
+/*
+ * Xournal++
+ *
+ * Keeps the memory used by rendered buffers within a budget
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <XournalType.h>
+
+#include <gio/gio.h>
+
+#include <vector>
+
+/**
+ * Default budget in MiB
+ */
+#define RENDER_MEMORY_DEFAULT_BUDGET 256
+
+/**
+ * Something holding rendered buffers which can be rendered again if needed,
+ * e.g. a page view, a preview or the PDF cache
+ */
+class RenderMemoryClient
+{
+public:
+	virtual ~RenderMemoryClient();
+
+	/**
+	 * @return The bytes currently held by the buffers
+	 */
+	virtual size_t getRenderMemoryBytes() = 0;
+
+	/**
+	 * @return true if the buffers are needed right now, e.g. they are visible
+	 */
+	virtual bool isRenderMemoryInUse() = 0;
+
+	/**
+	 * @return The monotonic time in microseconds of the last use
+	 */
+	virtual gint64 getRenderMemoryLastUse() = 0;
+
+	/**
+	 * @return How expensive it is to render the buffers again, relative to an empty page
+	 */
+	virtual double getRenderMemoryCost();
+
+	/**
+	 * Frees all or a part of the buffers
+	 *
+	 * @return The bytes freed, 0 if nothing can be freed at the moment
+	 */
+	virtual size_t freeRenderMemory() = 0;
+};
+
+/**
+ * Tracks the memory of all registered clients. If the budget is exceeded,
+ * the buffers which are not in use are freed, the largest, least recently
+ * used and cheapest to render again first.
+ *
+ * The budget is checked in the UI thread, after a buffer was allocated and
+ * if the system reports low memory.
+ */
+class RenderMemoryManager
+{
+private:
+	RenderMemoryManager();
+	virtual ~RenderMemoryManager();
+
+public:
+	static RenderMemoryManager& getInstance();
+	static void freeInstance();
+
+public:
+	void addClient(RenderMemoryClient* client);
+	void removeClient(RenderMemoryClient* client);
+
+	/**
+	 * @param budget The budget in bytes
+	 */
+	void setBudget(size_t budget);
+	size_t getBudget();
+
+	/**
+	 * A client allocated a buffer, can be called from any thread
+	 */
+	void bufferAllocated();
+
+	/**
+	 * Frees buffers which are not in use until at most limit bytes are used
+	 *
+	 * @return The bytes freed
+	 */
+	size_t freeUntil(size_t limit);
+
+	/**
+	 * @return The bytes held by all clients
+	 */
+	size_t getUsage();
+
+	/**
+	 * Logs the current usage
+	 */
+	void logUsage(const char* reason);
+
+private:
+	static gboolean checkBudgetCallback(RenderMemoryManager* manager);
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+	static void lowMemoryWarning(GMemoryMonitor* monitor, GMemoryMonitorWarningLevel level, RenderMemoryManager* manager);
+#endif
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	GMutex clientMutex;
+	std::vector<RenderMemoryClient*> clients;
+
+	size_t budget = (size_t) RENDER_MEMORY_DEFAULT_BUDGET * 1024 * 1024;
+
+	GMutex checkMutex;
+	guint checkSourceId = 0;
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+	GMemoryMonitor* memoryMonitor = NULL;
+#endif
+};
@@ -1,6 +1,7 @@
 #include "XournalMain.h"
 
 #include "Control.h"
+#include "RenderMemoryManager.h"
 
 #include "control/jobs/ImageExport.h"
 #include "control/jobs/ProgressListener.h"
@@ -11,6 +12,7 @@
 #include "pdf/base/XojPdfExport.h"
 #include "pdf/base/XojPdfExportFactory.h"
 #include "undo/EmergencySaveRestore.h"
+#include "view/TextView.h"
 #include "xojfile/LoadHandler.h"
 
 
@@ -19,7 +21,9 @@
 #include "config-paths.h"
 #include "i18n.h"
 #include "Stacktrace.h"
+#include "StartupTimeline.h"
 #include "StringUtils.h"
+#include "Tracer.h"
 #include "XojMsgBox.h"
 #include "util/cpp14memory.h"
 
@@ -297,10 +301,36 @@ int XournalMain::exportPdf(const char* input, const char* output)
 	return 0; // no error
 }
 
+/**
+ * Writes the recorded trace, if tracing is enabled. Without a filename
+ * (enabled by the setting) the trace is written to the config folder.
+ */
+void XournalMain::writeTrace(const char* traceFilename)
+{
+	XOJ_CHECK_TYPE(XournalMain);
+
+	if (!Tracer::isEnabled())
+	{
+		return;
+	}
+
+	string filename = traceFilename ? traceFilename : Util::getConfigFile("trace.json").str();
+	if (Tracer::writeChromeTrace(filename))
+	{
+		g_message("Performance trace written to %s", filename.c_str());
+	}
+	else
+	{
+		g_warning("Could not write performance trace to %s", filename.c_str());
+	}
+}
+
 int XournalMain::run(int argc, char* argv[])
 {
 	XOJ_CHECK_TYPE(XournalMain);
 
+	StartupTimeline::start();
+
 	this->initLocalisation();
 
 	GError* error = NULL;
@@ -309,16 +339,22 @@ int XournalMain::run(int argc, char* argv[])
 	gchar** optFilename = NULL;
 	gchar* pdfFilename = NULL;
 	gchar* imgFilename = NULL;
+	gchar* traceFilename = NULL;
 	int openAtPageNumber = -1;
+	gboolean startupTimeline = false;
 
 	string create_pdf = _("PDF output filename");
 	string create_img = _("Image output filename (.png / .svg)");
 	string page_jump = _("Jump to Page (first Page: 1)");
 	string audio_folder = _("Absolute path for the audio files playback");
+	string trace_file = _("Record a performance trace (Chrome trace format) and write it to FILE on exit");
+	string startup_timeline = _("Print the time needed for each phase of the startup");
 	GOptionEntry options[] = {
 		{ "create-pdf",      'p', 0, G_OPTION_ARG_FILENAME,       &pdfFilename,      create_pdf.c_str(), NULL },
 		{ "create-img",      'i', 0, G_OPTION_ARG_FILENAME,       &imgFilename,      create_img.c_str(), NULL },
 		{ "page",            'n', 0, G_OPTION_ARG_INT,            &openAtPageNumber, page_jump.c_str(), "N" },
+		{ "trace",             0, 0, G_OPTION_ARG_FILENAME,       &traceFilename,    trace_file.c_str(), "FILE" },
+		{ "startup-timeline",  0, 0, G_OPTION_ARG_NONE,           &startupTimeline,  startup_timeline.c_str(), NULL },
 		{G_OPTION_REMAINING,   0, 0, G_OPTION_ARG_FILENAME_ARRAY, &optFilename,      "<input>", NULL },
 		{NULL}
 	};
@@ -337,13 +373,28 @@ int XournalMain::run(int argc, char* argv[])
 	}
 	g_option_context_free(context);
 
+	Tracer::setThreadName("main");
+	if (traceFilename)
+	{
+		Tracer::enable();
+	}
+
+	if (startupTimeline)
+	{
+		StartupTimeline::enable();
+	}
+
 	if (pdfFilename && optFilename && *optFilename)
 	{
-		return exportPdf(*optFilename, pdfFilename);
+		int result = exportPdf(*optFilename, pdfFilename);
+		writeTrace(traceFilename);
+		return result;
 	}
 	if (imgFilename && optFilename && *optFilename)
 	{
-		return exportImg(*optFilename, imgFilename);
+		int result = exportImg(*optFilename, imgFilename);
+		writeTrace(traceFilename);
+		return result;
 	}
 
 	// Checks for input method compatibility
@@ -367,6 +418,15 @@ int XournalMain::run(int argc, char* argv[])
 	ToolbarColorNames::getInstance().loadFile(colorNameFile);
 
 	Control* control = new Control(gladePath);
+	StartupTimeline::mark("control created");
+
+	if (control->getSettings()->isPerformanceTracing() && !Tracer::isEnabled())
+	{
+		Tracer::enable();
+	}
+
+	int renderMemoryBudget = std::max(control->getSettings()->getRenderMemoryBudget(), 0);
+	RenderMemoryManager::getInstance().setBudget((size_t) renderMemoryBudget * 1024 * 1024);
 
 	if (control->getSettings()->isDarkTheme())
 	{
@@ -379,6 +439,7 @@ int XournalMain::run(int argc, char* argv[])
 
 	MainWindow* win = new MainWindow(gladePath, control);
 	control->initWindow(win);
+	StartupTimeline::mark("main window created");
 
 	win->show(NULL);
 
@@ -426,6 +487,8 @@ int XournalMain::run(int argc, char* argv[])
 
 	gtk_main();
 
+	writeTrace(traceFilename);
+
 	control->saveSettings();
 
 	win->getXournal()->clearSelection();
@@ -439,6 +502,9 @@ int XournalMain::run(int argc, char* argv[])
 	ToolbarColorNames::getInstance().saveFile(colorNameFile);
 	ToolbarColorNames::freeInstance();
 
+	RenderMemoryManager::freeInstance();
+	TextView::freeCache();
+
 	return 0;
 }
 
@@ -35,6 +35,8 @@ private:
 	int exportPdf(const char* input, const char* output);
 	int exportImg(const char* input, const char* output);
 
+	void writeTrace(const char* traceFilename);
+
 	void initSettingsPath();
 	void initResourcePath(GladeSearchpath* gladePath);
 	void initResourcePath(GladeSearchpath* gladePath, const gchar* relativePathAndFile, bool failIfNotFound = true);
@@ -37,6 +37,8 @@ void AutosaveJob::run()
 
 	Document* doc = control->getDocument();
 
+	handler.setBinaryStrokes(control->getSettings()->isBinaryStrokeEncoding());
+
 	doc->lock();
 	handler.prepareSave(doc);
 	Path filename = doc->getFilename();
@@ -59,6 +61,7 @@ void AutosaveJob::run()
 
 	g_message("%s", FS(_F("Autosaving to {1}") % filename.str()).c_str());
 
+	handler.setCompressionLevel(control->getSettings()->getAutosaveCompressionLevel());
 	handler.saveTo(filename);
 
 	this->error = handler.getErrorMessage();
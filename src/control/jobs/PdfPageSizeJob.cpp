@@ -0,0 +1,81 @@
+#include "PdfPageSizeJob.h"
+
+#include "control/Control.h"
+
+/**
+ * The number of pages read by one job, the pages are resized between the jobs
+ */
+#define PDF_PAGE_SIZE_JOB_PAGES 200
+
+PdfPageSizeJob::PdfPageSizeJob(Control* control, size_t firstPage)
+ : control(control),
+   firstPage(firstPage)
+{
+	XOJ_INIT_TYPE(PdfPageSizeJob);
+
+	Document* doc = control->getDocument();
+	doc->lock();
+	this->pdf = doc->getPdfDocument();
+	doc->unlock();
+}
+
+PdfPageSizeJob::~PdfPageSizeJob()
+{
+	XOJ_RELEASE_TYPE(PdfPageSizeJob);
+}
+
+void PdfPageSizeJob::run()
+{
+	XOJ_CHECK_TYPE(PdfPageSizeJob);
+
+	size_t count = std::min(this->pdf.getPageCount(), this->firstPage + PDF_PAGE_SIZE_JOB_PAGES);
+	for (size_t i = this->firstPage; i < count; i++)
+	{
+		XojPdfPageSPtr page = this->pdf.getPage(i);
+		this->sizes.push_back(page->getWidth());
+		this->sizes.push_back(page->getHeight());
+	}
+
+	callAfterRun();
+}
+
+void PdfPageSizeJob::afterRun()
+{
+	XOJ_CHECK_TYPE(PdfPageSizeJob);
+
+	Document* doc = control->getDocument();
+	doc->lock();
+
+	if (!(doc->getPdfDocument() == this->pdf))
+	{
+		// Another document was opened
+		doc->unlock();
+		return;
+	}
+
+	// The pages are laid out once for the whole chunk
+	std::vector<size_t> changed;
+	doc->setPdfPageSizes(this->firstPage, this->sizes, changed);
+
+	size_t nextPage = doc->getPdfPageSizesRead();
+	bool finished = nextPage >= this->pdf.getPageCount();
+	doc->unlock();
+
+	if (!changed.empty())
+	{
+		control->firePageSizesChanged(changed);
+	}
+
+	if (!finished)
+	{
+		PdfPageSizeJob* job = new PdfPageSizeJob(control, nextPage);
+		control->getScheduler()->addJob(job, JOB_PRIORITY_NONE);
+		job->unref();
+	}
+}
+
+JobType PdfPageSizeJob::getType()
+{
+	XOJ_CHECK_TYPE(PdfPageSizeJob);
+	return JOB_TYPE_PDF_PAGE_SIZE;
+}
@@ -0,0 +1,57 @@
+/*
+ * Xournal++
+ *
+ * Reads the sizes of the PDF pages which were not read while opening the PDF
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "Job.h"
+
+#include "pdf/base/XojPdfDocument.h"
+
+#include <XournalType.h>
+
+#include <vector>
+
+class Control;
+
+class PdfPageSizeJob : public Job
+{
+public:
+	/**
+	 * @param firstPage The first PDF page to read
+	 */
+	PdfPageSizeJob(Control* control, size_t firstPage);
+
+protected:
+	virtual ~PdfPageSizeJob();
+
+public:
+	virtual void run();
+	void afterRun();
+
+	virtual JobType getType();
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	Control* control = NULL;
+
+	/**
+	 * The PDF of the document when the job was created, nothing is changed if another PDF was opened since
+	 */
+	XojPdfDocument pdf;
+
+	size_t firstPage = 0;
+
+	/**
+	 * The sizes read, width and height of each page from firstPage on
+	 */
+	std::vector<double> sizes;
+};
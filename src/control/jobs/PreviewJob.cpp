@@ -1,11 +1,14 @@
 #include "PreviewJob.h"
 
 #include "control/Control.h"
+#include "control/RenderMemoryManager.h"
 #include "gui/Shadow.h"
 #include "gui/sidebar/previews/base/SidebarPreviewBaseEntry.h"
 #include "gui/sidebar/previews/base/SidebarPreviewBase.h"
 #include "gui/sidebar/previews/layer/SidebarPreviewLayerEntry.h"
+#include "gui/sidebar/previews/layer/SidebarPreviewLayers.h"
 #include "model/Document.h"
+#include "model/PageSnapshot.h"
 #include "view/PdfView.h"
 #include "view/DocumentView.h"
 
@@ -38,6 +41,20 @@ JobType PreviewJob::getType()
 	return JOB_TYPE_PREVIEW;
 }
 
+bool PreviewJob::isLayerPreviewUpToDate(int revision)
+{
+	XOJ_CHECK_TYPE(PreviewJob);
+
+	SidebarPreviewLayerEntry* entry = (SidebarPreviewLayerEntry*) this->sidebarPreview;
+
+	g_mutex_lock(&entry->drawingMutex);
+	bool upToDate = entry->crBuffer != NULL && entry->revision == revision &&
+					entry->revisionZoom == entry->sidebar->getZoom();
+	g_mutex_unlock(&entry->drawingMutex);
+
+	return upToDate;
+}
+
 void PreviewJob::initGraphics()
 {
 	GtkAllocation alloc;
@@ -63,6 +80,13 @@ void PreviewJob::finishPaint()
 	}
 	this->sidebarPreview->crBuffer = crBuffer;
 
+	if (RENDER_TYPE_PAGE_LAYER == this->sidebarPreview->getRenderType())
+	{
+		SidebarPreviewLayerEntry* entry = (SidebarPreviewLayerEntry*) this->sidebarPreview;
+		entry->revision = this->revision;
+		entry->revisionZoom = zoom;
+	}
+
 	// Make sure the Job does not get deleted until the
 	// Repaint is also finished in UI Thread
 	ref();
@@ -75,20 +99,22 @@ void PreviewJob::finishPaint()
 	});
 
 	g_mutex_unlock(&this->sidebarPreview->drawingMutex);
+
+	RenderMemoryManager::getInstance().bufferAllocated();
 }
 
 void PreviewJob::drawBackgroundPdf(Document* doc)
 {
-	int pgNo = this->sidebarPreview->page->getPdfPageNr();
+	int pgNo = this->page->getPdfPageNr();
 	XojPdfPageSPtr popplerPage = doc->getPdfPage(pgNo);
 	PdfView::drawPage(this->sidebarPreview->sidebar->getCache(), popplerPage, cr2, zoom,
-					  this->sidebarPreview->page->getWidth(), this->sidebarPreview->page->getHeight());
+					  this->page->getWidth(), this->page->getHeight());
 }
 
 void PreviewJob::drawPage(int layer)
 {
 	DocumentView view;
-	PageRef page = this->sidebarPreview->page;
+	PageRef page = this->page;
 
 	if (layer == -100)
 	{
@@ -119,28 +145,49 @@ void PreviewJob::run()
 {
 	XOJ_CHECK_TYPE(PreviewJob);
 
-	initGraphics();
-	drawBorder();
-
 	Document* doc = this->sidebarPreview->sidebar->getControl()->getDocument();
-	doc->lock();
 
 	PreviewRenderType type = this->sidebarPreview->getRenderType();
 	int layer = -100; // all layer
 
+	PageSnapshot pageSnapshot;
+	PageSnapshot* snapshot = &pageSnapshot;
+
 	if (RENDER_TYPE_PAGE_LAYER == type)
 	{
 		layer = ((SidebarPreviewLayerEntry*)this->sidebarPreview)->getLayer();
+
+		// The previews of the layers share one copy, so they know which layers changed since they were drawn
+		snapshot = &((SidebarPreviewLayers*) this->sidebarPreview->sidebar)->snapshot;
 	}
 
-	if (this->sidebarPreview->page->getBackgroundType().isPdfPage())
+	// Hidden layers are needed for the layer previews
+	doc->lock();
+	this->page = snapshot->update(this->sidebarPreview->page, RENDER_TYPE_PAGE_LAYER == type);
+	doc->unlock();
+
+	if (RENDER_TYPE_PAGE_LAYER == type)
+	{
+		// Layer ID 0 is the background
+		this->revision = snapshot->getLayerRevision(layer + 1);
+		if (isLayerPreviewUpToDate(this->revision))
+		{
+			this->page = NULL;
+			return;
+		}
+	}
+
+	initGraphics();
+	drawBorder();
+
+	if (this->page->getBackgroundType().isPdfPage())
 	{
 		drawBackgroundPdf(doc);
 	}
 
 	drawPage(layer);
 
-	doc->unlock();
-
 	finishPaint();
+
+	this->page = NULL;
 }
@@ -13,6 +13,8 @@
 
 #include "Job.h"
 
+#include "model/PageRef.h"
+
 #include <XournalType.h>
 
 #include <gtk/gtk.h>
@@ -39,6 +41,11 @@ public:
 	virtual JobType getType();
 
 private:
+	/**
+	 * @return true if the buffer of the layer preview already shows this revision of the layer
+	 */
+	bool isLayerPreviewUpToDate(int revision);
+
 	void initGraphics();
 	void drawBorder();
 	void finishPaint();
@@ -67,4 +74,14 @@ private:
 	 * Sidebar preview
 	 */
 	SidebarPreviewBaseEntry* sidebarPreview = NULL;
+
+	/**
+	 * Copy of the page of the preview, drawn without the document lock
+	 */
+	PageRef page;
+
+	/**
+	 * The revision of the layer drawn by a layer preview
+	 */
+	int revision = -1;
 };
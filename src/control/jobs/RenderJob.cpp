@@ -1,17 +1,21 @@
 #include "RenderJob.h"
 
 #include "control/Control.h"
+#include "control/RenderMemoryManager.h"
 #include "control/ToolHandler.h"
 #include "gui/PageView.h"
 #include "gui/XournalView.h"
 #include "model/Document.h"
+#include "model/Layer.h"
 #include "view/DocumentView.h"
 #include "view/PdfView.h"
 
 #include <Rectangle.h>
+#include <Tracer.h>
 #include <Util.h>
 #include <config-features.h>
 
+#include <cmath>
 #include <list>
 
 RenderJob::RenderJob(XojPageView* view)
@@ -36,17 +40,11 @@ void* RenderJob::getSource()
 	return this->view;
 }
 
-void RenderJob::rerenderRectangle(Rectangle* rect)
+void RenderJob::rerenderRectangle(Rectangle* rect, PageRef page)
 {
 	XOJ_CHECK_TYPE(RenderJob);
 
 	double zoom = view->xournal->getZoom();
-	Document* doc = view->xournal->getDocument();
-
-	doc->lock();
-	double pageWidth = view->page->getWidth();
-	double pageHeight = view->page->getHeight();
-	doc->unlock();
 
 	int x = rect->x * zoom;
 	int y = rect->y * zoom;
@@ -63,18 +61,13 @@ void RenderJob::rerenderRectangle(Rectangle* rect)
 	v.setMarkAudioStroke(control->getToolHandler()->getToolType() == TOOL_PLAY_OBJECT);
 	v.limitArea(rect->x, rect->y, rect->width, rect->height);
 
-	bool backgroundVisible = view->page->isLayerVisible(0);
-	if (backgroundVisible && view->page->getBackgroundType().isPdfPage())
+	int firstLayer = drawLayerCache(crRect, page, zoom);
+	if (firstLayer == 0)
 	{
-		int pgNo = view->page->getPdfPageNr();
-		XojPdfPageSPtr popplerPage = doc->getPdfPage(pgNo);
-		PdfCache* cache = view->xournal->getCache();
-		PdfView::drawPage(cache, popplerPage, crRect, zoom, pageWidth, pageHeight);
+		drawPdfBackground(crRect, page, zoom);
 	}
 
-	doc->lock();
-	v.drawPage(view->page, crRect, false);
-	doc->unlock();
+	v.drawLayers(page, crRect, firstLayer, page->getLayerCount(), false);
 
 	cairo_destroy(crRect);
 
@@ -94,10 +87,121 @@ void RenderJob::rerenderRectangle(Rectangle* rect)
 	g_mutex_unlock(&view->drawingMutex);
 }
 
+void RenderJob::drawPdfBackground(cairo_t* cr, PageRef page, double zoom)
+{
+	XOJ_CHECK_TYPE(RenderJob);
+
+	if (!page->isLayerVisible(0) || !page->getBackgroundType().isPdfPage())
+	{
+		return;
+	}
+
+	Document* doc = view->xournal->getDocument();
+	XojPdfPageSPtr popplerPage = doc->getPdfPage(page->getPdfPageNr());
+	PdfView::drawPage(view->xournal->getCache(), popplerPage, cr, zoom, page->getWidth(), page->getHeight());
+}
+
+bool RenderJob::isLayerCacheUseful(PageRef page, int layerId)
+{
+	XOJ_CHECK_TYPE(RenderJob);
+
+	// The cached strokes would not show the audio marks
+	Control* control = view->getXournal()->getControl();
+	if (control->getToolHandler()->getToolType() == TOOL_PLAY_OBJECT)
+	{
+		return false;
+	}
+
+	vector<Layer*>* layers = page->getLayers();
+	for (int i = 0; i < layerId - 1 && i < (int) layers->size(); i++)
+	{
+		Layer* l = (*layers)[i];
+		if (l->isVisible() && !l->getElements()->empty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int RenderJob::drawLayerCache(cairo_t* cr, PageRef page, double zoom)
+{
+	XOJ_CHECK_TYPE(RenderJob);
+
+	int layerId = page->getSelectedLayerId();
+	if (!isLayerCacheUseful(page, layerId))
+	{
+		this->view->layerCache.clear();
+		return 0;
+	}
+
+	cairo_surface_t* buffer = this->view->layerCache.get(this->view->snapshot, layerId, zoom);
+	if (buffer == NULL)
+	{
+		TRACE_ZONE("RenderJob::drawLayerCache");
+
+		buffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, std::ceil(page->getWidth() * zoom),
+											std::ceil(page->getHeight() * zoom));
+		cairo_t* crCache = cairo_create(buffer);
+		cairo_scale(crCache, zoom, zoom);
+
+		drawPdfBackground(crCache, page, zoom);
+
+		DocumentView v;
+		v.drawLayers(page, crCache, 0, layerId - 1, false);
+
+		cairo_destroy(crCache);
+
+		this->view->layerCache.set(buffer, this->view->snapshot, layerId, zoom);
+		RenderMemoryManager::getInstance().bufferAllocated();
+	}
+
+	// The buffer has the resolution of the device
+	cairo_save(cr);
+	cairo_scale(cr, 1 / zoom, 1 / zoom);
+	cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+	cairo_set_source_surface(cr, buffer, 0, 0);
+	cairo_paint(cr);
+	cairo_restore(cr);
+
+	cairo_surface_destroy(buffer);
+
+	return layerId;
+}
+
+/**
+ * Check if the zoom was changed since the rendering was started,
+ * in this case the result is not needed anymore
+ */
+bool RenderJob::isZoomOutdated(double zoom)
+{
+	XOJ_CHECK_TYPE(RenderJob);
+
+	return this->view->xournal->getZoom() != zoom;
+}
+
+/**
+ * Check if the current buffer is rendered with the current zoom, else
+ * a rectangle cannot be rendered into it
+ */
+bool RenderJob::bufferMatchesZoom()
+{
+	XOJ_CHECK_TYPE(RenderJob);
+
+	g_mutex_lock(&this->view->drawingMutex);
+	bool matches = this->view->bufferMatchesZoom();
+	g_mutex_unlock(&this->view->drawingMutex);
+
+	return matches;
+}
+
 void RenderJob::run()
 {
 	XOJ_CHECK_TYPE(RenderJob);
 
+	TRACE_ZONE("RenderJob::run");
+
 	double zoom = this->view->xournal->getZoom();
 
 	g_mutex_lock(&this->view->repaintRectMutex);
@@ -108,50 +212,80 @@ void RenderJob::run()
 
 	this->view->rerenderComplete = false;
 
+	bool lowResolution = rerenderComplete && this->view->rerenderLowResolution;
+	this->view->rerenderLowResolution = false;
+
+	bool contentsChanged = this->view->contentsChanged;
+	this->view->contentsChanged = false;
+
 	g_mutex_unlock(&this->view->repaintRectMutex);
 
 	int dpiScaleFactor = this->view->xournal->getDpiScaleFactor();
 
-	if (rerenderComplete || dpiScaleFactor > 1)
+	if (rerenderComplete || dpiScaleFactor > 1 || !bufferMatchesZoom())
 	{
 		Document* doc = this->view->xournal->getDocument();
 
-		int dispWidth = this->view->getDisplayWidth();
-		int dispHeight = this->view->getDisplayHeight();
+		double renderScale = dpiScaleFactor;
+		if (lowResolution)
+		{
+			renderScale *= RENDER_LOW_RESOLUTION_FACTOR;
+		}
 
-		dispWidth *= dpiScaleFactor;
-		dispHeight *= dpiScaleFactor;
-		zoom *= dpiScaleFactor;
+		int dispWidth = std::ceil(this->view->getDisplayWidth() * renderScale);
+		int dispHeight = std::ceil(this->view->getDisplayHeight() * renderScale);
+		double renderZoom = zoom * renderScale;
 
 		cairo_surface_t* crBuffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dispWidth, dispHeight);
 		cairo_t* cr2 = cairo_create(crBuffer);
-		cairo_scale(cr2, zoom, zoom);
-
-		XojPdfPageSPtr popplerPage;
+		cairo_scale(cr2, renderZoom, renderZoom);
 
+		// Only the copy of the page is drawn, so the document can be changed while rendering
 		doc->lock();
-
-		if (this->view->page->getBackgroundType().isPdfPage())
-		{
-			int pgNo = this->view->page->getPdfPageNr();
-			popplerPage = doc->getPdfPage(pgNo);
-		}
+		PageRef page = this->view->snapshot.update(this->view->page, false, contentsChanged);
+		doc->unlock();
 
 		Control* control = view->getXournal()->getControl();
 		DocumentView view;
 		view.setMarkAudioStroke(control->getToolHandler()->getToolType() == TOOL_PLAY_OBJECT);
-		int width = this->view->page->getWidth();
-		int height = this->view->page->getHeight();
 
-		bool backgroundVisible = this->view->page->isLayerVisible(0);
-		if (backgroundVisible)
+		// The low resolution preview is replaced soon, it is not worth a cache
+		int firstLayer = lowResolution ? 0 : drawLayerCache(cr2, page, renderZoom);
+
+		bool backgroundVisible = page->isLayerVisible(0);
+		if (firstLayer == 0 && backgroundVisible)
 		{
-			PdfView::drawPage(this->view->xournal->getCache(), popplerPage, cr2, zoom, width, height);
+			XojPdfPageSPtr popplerPage;
+			if (page->getBackgroundType().isPdfPage())
+			{
+				int pgNo = page->getPdfPageNr();
+				popplerPage = doc->getPdfPage(pgNo);
+			}
+
+			PdfView::drawPage(this->view->xournal->getCache(), popplerPage, cr2, renderZoom, page->getWidth(), page->getHeight());
+		}
+
+		// The zoom was changed while rendering the background, a new job renders the page with the new zoom
+		bool outdated = isZoomOutdated(zoom);
+		if (!outdated)
+		{
+			view.drawLayers(page, cr2, firstLayer, page->getLayerCount(), false);
+			outdated = isZoomOutdated(zoom);
 		}
-		view.drawPage(this->view->page, cr2, false);
 
 		cairo_destroy(cr2);
 
+		if (outdated)
+		{
+			cairo_surface_destroy(crBuffer);
+
+			for (Rectangle* rect : rerenderRects)
+			{
+				delete rect;
+			}
+			return;
+		}
+
 		g_mutex_lock(&this->view->drawingMutex);
 
 		if (this->view->crBuffer)
@@ -161,13 +295,26 @@ void RenderJob::run()
 		this->view->crBuffer = crBuffer;
 
 		g_mutex_unlock(&this->view->drawingMutex);
-		doc->unlock();
+
+		RenderMemoryManager::getInstance().bufferAllocated();
+
+		if (lowResolution)
+		{
+			// The low resolution preview is done, now render the page with the full resolution
+			this->view->rerenderPageUnchanged();
+		}
 	}
-	else
+	else if (!rerenderRects.empty())
 	{
+		Document* doc = this->view->xournal->getDocument();
+
+		doc->lock();
+		PageRef page = this->view->snapshot.update(this->view->page, false, contentsChanged);
+		doc->unlock();
+
 		for (Rectangle* rect : rerenderRects)
 		{
-			rerenderRectangle(rect);
+			rerenderRectangle(rect, page);
 		}
 	}
 
@@ -13,6 +13,8 @@
 
 #include "Job.h"
 
+#include "model/PageRef.h"
+
 #include <XournalType.h>
 
 #include <gtk/gtk.h>
@@ -20,6 +22,11 @@
 class Rectangle;
 class XojPageView;
 
+/**
+ * Buffer scale of the first, fast rendering pass after zooming, relative to the DPI scale
+ */
+#define RENDER_LOW_RESOLUTION_FACTOR 0.5
+
 class RenderJob : public Job
 {
 public:
@@ -41,7 +48,33 @@ private:
 	 */
 	void repaintWidget(GtkWidget* widget);
 
-	void rerenderRectangle(Rectangle* rect);
+	/**
+	 * @param page Snapshot of the page, drawn without the document lock
+	 */
+	void rerenderRectangle(Rectangle* rect, PageRef page);
+
+	bool isZoomOutdated(double zoom);
+	bool bufferMatchesZoom();
+
+	/**
+	 * @return true if something is drawn below the selected layer, so the
+	 * layers below are worth a buffer
+	 */
+	bool isLayerCacheUseful(PageRef page, int layerId);
+
+	/**
+	 * Draws the background and the layers below the selected layer from the
+	 * layer cache of the view, the cache is drawn first if it is outdated
+	 *
+	 * @param zoom The scale from the page to the device pixels of cr
+	 * @return The first layer ID which still needs to be drawn, 0 if the cache is not used
+	 */
+	int drawLayerCache(cairo_t* cr, PageRef page, double zoom);
+
+	/**
+	 * Draws the PDF page of the background, if it is visible
+	 */
+	void drawPdfBackground(cairo_t* cr, PageRef page, double zoom);
 
 private:
 	XOJ_TYPE_ATTRIB;
@@ -112,6 +112,8 @@ bool SaveJob::save()
 
 	SaveHandler h;
 
+	h.setBinaryStrokes(control->getSettings()->isBinaryStrokeEncoding());
+
 	doc->lock();
 	h.prepareSave(doc);
 	Path filename = doc->getFilename();
@@ -134,6 +136,7 @@ bool SaveJob::save()
 
 	doc->lock();
 
+	h.setCompressionLevel(control->getSettings()->getSaveCompressionLevel());
 	h.saveTo(filename, this->control);
 	doc->setFilename(filename);
 	doc->unlock();
@@ -1,5 +1,6 @@
 #include "Scheduler.h"
 #include <config-debug.h>
+#include <Tracer.h>
 
 #include <inttypes.h>
 
@@ -242,6 +243,8 @@ gpointer Scheduler::jobThreadCallback(Scheduler* scheduler)
 {
 	XOJ_CHECK_TYPE_OBJ(scheduler, Scheduler);
 
+	Tracer::setThreadName(scheduler->name.c_str());
+
 	while (scheduler->threadRunning)
 	{
 		// lock the whole scheduler
@@ -292,7 +295,10 @@ gpointer Scheduler::jobThreadCallback(Scheduler* scheduler)
 				scheduler->jobRenderThreadTimerId = g_timeout_add(diff, (GSourceFunc) jobRenderThreadTimer, scheduler);
 			}
 
-			g_cond_wait(&scheduler->jobQueueCond, &scheduler->jobQueueMutex);
+			{
+				TRACE_ZONE_CATEGORY("Scheduler wait", "wait");
+				g_cond_wait(&scheduler->jobQueueCond, &scheduler->jobQueueMutex);
+			}
 			g_mutex_unlock(&scheduler->jobQueueMutex);
 
 			continue;
@@ -304,7 +310,10 @@ gpointer Scheduler::jobThreadCallback(Scheduler* scheduler)
 
 		g_mutex_lock(&scheduler->jobRunningMutex);
 
-		job->execute();
+		{
+			TRACE_ZONE("Scheduler job");
+			job->execute();
+		}
 
 		job->unref();
 		g_mutex_unlock(&scheduler->jobRunningMutex);
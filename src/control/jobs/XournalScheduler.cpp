@@ -28,6 +28,7 @@ void XournalScheduler::removePage(XojPageView* view)
 	XOJ_CHECK_TYPE(XournalScheduler);
 
 	removeSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_URGENT);
+	removeSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_LOW);
 }
 
 void XournalScheduler::removeAllJobs()
@@ -57,6 +58,31 @@ void XournalScheduler::removeAllJobs()
 
 }
 
+void XournalScheduler::removePrerenderJobs()
+{
+	XOJ_CHECK_TYPE(XournalScheduler);
+
+	g_mutex_lock(&this->jobQueueMutex);
+
+	GQueue* queue = this->jobQueue[JOB_PRIORITY_LOW];
+	for (GList* l = queue->head; l != NULL;)
+	{
+		Job* job = (Job*) l->data;
+		GList* next = l->next;
+
+		if (job->getType() == JOB_TYPE_RENDER)
+		{
+			job->deleteJob();
+			g_queue_delete_link(queue, l);
+			job->unref();
+		}
+
+		l = next;
+	}
+
+	g_mutex_unlock(&this->jobQueueMutex);
+}
+
 void XournalScheduler::finishTask()
 {
 	XOJ_CHECK_TYPE(XournalScheduler);
@@ -149,3 +175,17 @@ void XournalScheduler::addRerenderPage(XojPageView* view)
 	addJob(job, JOB_PRIORITY_URGENT);
 	job->unref();
 }
+
+void XournalScheduler::addPrerenderPage(XojPageView* view)
+{
+	XOJ_CHECK_TYPE(XournalScheduler);
+
+	if (existsSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_URGENT) || existsSource(view, JOB_TYPE_RENDER, JOB_PRIORITY_LOW))
+	{
+		return;
+	}
+
+	RenderJob* job = new RenderJob(view);
+	addJob(job, JOB_PRIORITY_LOW);
+	job->unref();
+}
@@ -40,6 +40,16 @@ public:
 	void addRepaintSidebar(SidebarPreviewBaseEntry* preview);
 	void addRerenderPage(XojPageView* view);
 
+	/**
+	 * Renders a page which is not visible yet with a low priority
+	 */
+	void addPrerenderPage(XojPageView* view);
+
+	/**
+	 * Removes all RenderJob%s added by addPrerenderPage() which are not running yet
+	 */
+	void removePrerenderJobs();
+
 	/**
 	 * Blocks until all currently running Job%s have been executed
 	 */
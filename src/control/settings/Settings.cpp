@@ -1,6 +1,7 @@
 #include "Settings.h"
 
 #include "ButtonConfig.h"
+#include "control/RenderMemoryManager.h"
 #include "model/FormatDefinitions.h"
 
 #include <config.h>
@@ -8,6 +9,9 @@
 #include <Util.h>
 #include <util/DeviceListHelper.h>
 
+#include <cstring>
+#include <unordered_map>
+
 #define DEFAULT_FONT "Sans"
 #define DEFAULT_FONT_SIZE 12
 
@@ -88,6 +92,9 @@ void Settings::loadDefault()
 	//Set this for autosave frequency in minutes.
 	this->autosaveTimeout = 3;
 	this->autosaveEnabled = true;
+	this->saveCompressionLevel = 6;
+	this->autosaveCompressionLevel = 1;
+	this->binaryStrokeEncoding = false;
 
 	this->addHorizontalSpace = false;
 	this->addHorizontalSpaceAmount = 150;
@@ -106,6 +113,8 @@ void Settings::loadDefault()
 
 	this->touchWorkaround = false;
 
+	this->performanceTracing = false;
+
 	this->defaultSaveName = _("%F-Note-%H-%M");
 
 	// Eraser
@@ -127,6 +136,7 @@ void Settings::loadDefault()
 	this->presentationHideElements = "mainMenubar,sidebarContents";
 
 	this->pdfPageCacheSize = 10;
+	this->renderMemoryBudget = RENDER_MEMORY_DEFAULT_BUDGET;
 
 	this->selectionBorderColor = 0xff0000; // red
 	this->selectionMarkerColor = 0x729FCF; // light blue
@@ -240,6 +250,76 @@ void Settings::parseData(xmlNodePtr cur, SElement& elem)
 
 }
 
+/**
+ * A setting which is stored as plain value in the settings file.
+ * The value is parsed the same way for all properties of a type.
+ */
+struct SettingsProperty
+{
+	enum Type
+	{
+		PROPERTY_BOOL, PROPERTY_INT, PROPERTY_DOUBLE, PROPERTY_STRING, PROPERTY_PATH
+	};
+
+	SettingsProperty(bool Settings::* member) : type(PROPERTY_BOOL)
+	{
+		this->member.b = member;
+	}
+
+	SettingsProperty(int Settings::* member) : type(PROPERTY_INT)
+	{
+		this->member.i = member;
+	}
+
+	SettingsProperty(double Settings::* member) : type(PROPERTY_DOUBLE)
+	{
+		this->member.d = member;
+	}
+
+	SettingsProperty(string Settings::* member) : type(PROPERTY_STRING)
+	{
+		this->member.s = member;
+	}
+
+	SettingsProperty(Path Settings::* member) : type(PROPERTY_PATH)
+	{
+		this->member.p = member;
+	}
+
+	void parse(Settings* settings, const char* value) const
+	{
+		switch (this->type)
+		{
+		case PROPERTY_BOOL:
+			settings->*(this->member.b) = strcmp(value, "true") == 0;
+			break;
+		case PROPERTY_INT:
+			settings->*(this->member.i) = g_ascii_strtoll(value, NULL, 10);
+			break;
+		case PROPERTY_DOUBLE:
+			settings->*(this->member.d) = tempg_ascii_strtod(value, NULL);
+			break;
+		case PROPERTY_STRING:
+			settings->*(this->member.s) = value;
+			break;
+		case PROPERTY_PATH:
+			settings->*(this->member.p) = value;
+			break;
+		}
+	}
+
+	Type type;
+
+	union
+	{
+		bool Settings::* b;
+		int Settings::* i;
+		double Settings::* d;
+		string Settings::* s;
+		Path Settings::* p;
+	} member;
+};
+
 void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur)
 {
 	XOJ_CHECK_TYPE(Settings);
@@ -314,235 +394,90 @@ void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur)
 		return;
 	}
 
+	/**
+	 * The properties which are stored as plain value, created on the first call
+	 */
+	static const std::unordered_map<string, SettingsProperty> properties = {
+		{ "zoomGesturesEnabled", SettingsProperty(&Settings::zoomGesturesEnabled) },
+		{ "selectedToolbar", SettingsProperty(&Settings::selectedToolbar) },
+		{ "lastSavePath", SettingsProperty(&Settings::lastSavePath) },
+		{ "lastOpenPath", SettingsProperty(&Settings::lastOpenPath) },
+		{ "lastImagePath", SettingsProperty(&Settings::lastImagePath) },
+		{ "zoomStep", SettingsProperty(&Settings::zoomStep) },
+		{ "zoomStepScroll", SettingsProperty(&Settings::zoomStepScroll) },
+		{ "displayDpi", SettingsProperty(&Settings::displayDpi) },
+		{ "mainWndWidth", SettingsProperty(&Settings::mainWndWidth) },
+		{ "mainWndHeight", SettingsProperty(&Settings::mainWndHeight) },
+		{ "maximized", SettingsProperty(&Settings::maximized) },
+		{ "showSidebar", SettingsProperty(&Settings::showSidebar) },
+		{ "sidebarWidth", SettingsProperty(&Settings::sidebarWidth) },
+		{ "sidebarOnRight", SettingsProperty(&Settings::sidebarOnRight) },
+		{ "scrollbarOnLeft", SettingsProperty(&Settings::scrollbarOnLeft) },
+		{ "menubarVisible", SettingsProperty(&Settings::menubarVisible) },
+		{ "numColumns", SettingsProperty(&Settings::numColumns) },
+		{ "numRows", SettingsProperty(&Settings::numRows) },
+		{ "viewFixedRows", SettingsProperty(&Settings::viewFixedRows) },
+		{ "layoutVertical", SettingsProperty(&Settings::layoutVertical) },
+		{ "layoutRightToLeft", SettingsProperty(&Settings::layoutRightToLeft) },
+		{ "layoutBottomToTop", SettingsProperty(&Settings::layoutBottomToTop) },
+		{ "showPairedPages", SettingsProperty(&Settings::showPairedPages) },
+		{ "numPairsOffset", SettingsProperty(&Settings::numPairsOffset) },
+		{ "presentationMode", SettingsProperty(&Settings::presentationMode) },
+		{ "autoloadPdfXoj", SettingsProperty(&Settings::autoloadPdfXoj) },
+		{ "showBigCursor", SettingsProperty(&Settings::showBigCursor) },
+		{ "highlightPosition", SettingsProperty(&Settings::highlightPosition) },
+		{ "darkTheme", SettingsProperty(&Settings::darkTheme) },
+		{ "defaultSaveName", SettingsProperty(&Settings::defaultSaveName) },
+		{ "pluginEnabled", SettingsProperty(&Settings::pluginEnabled) },
+		{ "pluginDisabled", SettingsProperty(&Settings::pluginDisabled) },
+		{ "pageTemplate", SettingsProperty(&Settings::pageTemplate) },
+		{ "sizeUnit", SettingsProperty(&Settings::sizeUnit) },
+		{ "audioFolder", SettingsProperty(&Settings::audioFolder) },
+		{ "autosaveEnabled", SettingsProperty(&Settings::autosaveEnabled) },
+		{ "autosaveTimeout", SettingsProperty(&Settings::autosaveTimeout) },
+		{ "saveCompressionLevel", SettingsProperty(&Settings::saveCompressionLevel) },
+		{ "autosaveCompressionLevel", SettingsProperty(&Settings::autosaveCompressionLevel) },
+		{ "binaryStrokeEncoding", SettingsProperty(&Settings::binaryStrokeEncoding) },
+		{ "fullscreenHideElements", SettingsProperty(&Settings::fullscreenHideElements) },
+		{ "presentationHideElements", SettingsProperty(&Settings::presentationHideElements) },
+		{ "pdfPageCacheSize", SettingsProperty(&Settings::pdfPageCacheSize) },
+		{ "renderMemoryBudget", SettingsProperty(&Settings::renderMemoryBudget) },
+		{ "selectionBorderColor", SettingsProperty(&Settings::selectionBorderColor) },
+		{ "selectionMarkerColor", SettingsProperty(&Settings::selectionMarkerColor) },
+		{ "backgroundColor", SettingsProperty(&Settings::backgroundColor) },
+		{ "addHorizontalSpace", SettingsProperty(&Settings::addHorizontalSpace) },
+		{ "addHorizontalSpaceAmount", SettingsProperty(&Settings::addHorizontalSpaceAmount) },
+		{ "addVerticalSpace", SettingsProperty(&Settings::addVerticalSpace) },
+		{ "addVerticalSpaceAmount", SettingsProperty(&Settings::addVerticalSpaceAmount) },
+		{ "drawDirModsEnabled", SettingsProperty(&Settings::drawDirModsEnabled) },
+		{ "drawDirModsRadius", SettingsProperty(&Settings::drawDirModsRadius) },
+		{ "snapRotation", SettingsProperty(&Settings::snapRotation) },
+		{ "snapRotationTolerance", SettingsProperty(&Settings::snapRotationTolerance) },
+		{ "snapGrid", SettingsProperty(&Settings::snapGrid) },
+		{ "snapGridTolerance", SettingsProperty(&Settings::snapGridTolerance) },
+		{ "touchWorkaround", SettingsProperty(&Settings::touchWorkaround) },
+		{ "performanceTracing", SettingsProperty(&Settings::performanceTracing) },
+		{ "audioSampleRate", SettingsProperty(&Settings::audioSampleRate) },
+		{ "audioGain", SettingsProperty(&Settings::audioGain) },
+		{ "audioInputDevice", SettingsProperty(&Settings::audioInputDevice) },
+		{ "audioOutputDevice", SettingsProperty(&Settings::audioOutputDevice) },
+		{ "experimentalInputSystemEnabled", SettingsProperty(&Settings::experimentalInputSystemEnabled) },
+		{ "inputSystemTPCButton", SettingsProperty(&Settings::inputSystemTPCButton) },
+		{ "inputSystemDrawOutsideWindow", SettingsProperty(&Settings::inputSystemDrawOutsideWindow) },
+		{ "strokeFilterIgnoreTime", SettingsProperty(&Settings::strokeFilterIgnoreTime) },
+		{ "strokeFilterIgnoreLength", SettingsProperty(&Settings::strokeFilterIgnoreLength) },
+		{ "strokeFilterSuccessiveTime", SettingsProperty(&Settings::strokeFilterSuccessiveTime) },
+		{ "strokeFilterEnabled", SettingsProperty(&Settings::strokeFilterEnabled) },
+		{ "doActionOnStrokeFiltered", SettingsProperty(&Settings::doActionOnStrokeFiltered) },
+		{ "trySelectOnStrokeFiltered", SettingsProperty(&Settings::trySelectOnStrokeFiltered) }
+	};
+
 	// TODO: remove this typo fix in 2-3 release cycles
-	if (xmlStrcmp(name, (const xmlChar*) "presureSensitivity") == 0)
-	{
-		setPressureSensitivity(xmlStrcmp(value, (const xmlChar*) "true") ? false : true);
-	}
-	if (xmlStrcmp(name, (const xmlChar*) "pressureSensitivity") == 0)
+	if (xmlStrcmp(name, (const xmlChar*) "presureSensitivity") == 0 ||
+		xmlStrcmp(name, (const xmlChar*) "pressureSensitivity") == 0)
 	{
 		setPressureSensitivity(xmlStrcmp(value, (const xmlChar*) "true") ? false : true);
 	}
-	else if (xmlStrcmp(name, (const xmlChar*) "zoomGesturesEnabled") == 0)
-	{
-		this->zoomGesturesEnabled = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "selectedToolbar") == 0)
-	{
-		this->selectedToolbar = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "lastSavePath") == 0)
-	{
-		this->lastSavePath = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "lastOpenPath") == 0)
-	{
-		this->lastOpenPath = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "lastImagePath") == 0)
-	{
-		this->lastImagePath = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "zoomStep") == 0)
-	{
-		this->zoomStep = tempg_ascii_strtod((const char*) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "zoomStepScroll") == 0)
-	{
-		this->zoomStepScroll = tempg_ascii_strtod((const char*) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "displayDpi") == 0)
-	{
-		this->displayDpi = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "mainWndWidth") == 0)
-	{
-		this->mainWndWidth = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "mainWndHeight") == 0)
-	{
-		this->mainWndHeight = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "maximized") == 0)
-	{
-		this->maximized = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "showSidebar") == 0)
-	{
-		this->showSidebar = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "sidebarWidth") == 0)
-	{
-		this->sidebarWidth = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "sidebarOnRight") == 0)
-	{
-		this->sidebarOnRight = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "scrollbarOnLeft") == 0)
-	{
-		this->scrollbarOnLeft = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "menubarVisible") == 0)
-	{
-		this->menubarVisible = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "numColumns") == 0)
-	{
-		this->numColumns = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "numRows") == 0)
-	{
-		this->numRows = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "viewFixedRows") == 0)
-	{
-		this->viewFixedRows = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "layoutVertical") == 0)
-	{
-		this->layoutVertical = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "layoutRightToLeft") == 0)
-	{
-		this->layoutRightToLeft = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "layoutBottomToTop") == 0)
-	{
-		this->layoutBottomToTop = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "showPairedPages") == 0)
-	{
-		this->showPairedPages = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "numPairsOffset") == 0)
-	{
-		this->numPairsOffset = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "presentationMode") == 0)
-	{
-		this->presentationMode = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "autoloadPdfXoj") == 0)
-	{
-		this->autoloadPdfXoj = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "showBigCursor") == 0)
-	{
-		this->showBigCursor = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "highlightPosition") == 0)
-	{
-		this->highlightPosition = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "darkTheme") == 0)
-	{
-		this->darkTheme = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "defaultSaveName") == 0)
-	{
-		this->defaultSaveName = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "pluginEnabled") == 0)
-	{
-		this->pluginEnabled = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "pluginDisabled") == 0)
-	{
-		this->pluginDisabled = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "pageTemplate") == 0)
-	{
-		this->pageTemplate = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "sizeUnit") == 0)
-	{
-		this->sizeUnit = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "audioFolder") == 0)
-	{
-		this->audioFolder = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "autosaveEnabled") == 0)
-	{
-		this->autosaveEnabled = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "autosaveTimeout") == 0)
-	{
-		this->autosaveTimeout = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "fullscreenHideElements") == 0)
-	{
-		this->fullscreenHideElements = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "presentationHideElements") == 0)
-	{
-		this->presentationHideElements = (const char*) value;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "pdfPageCacheSize") == 0)
-	{
-		this->pdfPageCacheSize = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "selectionBorderColor") == 0)
-	{
-		this->selectionBorderColor = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "selectionMarkerColor") == 0)
-	{
-		this->selectionMarkerColor = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "backgroundColor") == 0)
-	{
-		this->backgroundColor = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "addHorizontalSpace") == 0)
-	{
-		this->addHorizontalSpace = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "addHorizontalSpaceAmount") == 0)
-	{
-		this->addHorizontalSpaceAmount = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "addVerticalSpace") == 0)
-	{
-		this->addVerticalSpace = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "addVerticalSpaceAmount") == 0)
-	{
-		this->addVerticalSpaceAmount = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "drawDirModsEnabled") == 0)
-	{
-		this->drawDirModsEnabled = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "drawDirModsRadius") == 0)
-	{
-		this->drawDirModsRadius = g_ascii_strtoll((const char*) value, NULL, 10);
-	}	
-	else if (xmlStrcmp(name, (const xmlChar*) "snapRotation") == 0)
-	{
-		this->snapRotation = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "snapRotationTolerance") == 0)
-	{
-		this->snapRotationTolerance = tempg_ascii_strtod((const char*) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "snapGrid") == 0)
-	{
-		this->snapGrid = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "snapGrid") == 0)
-	{
-		this->snapGrid = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "snapGridTolerance") == 0)
-	{
-		this->snapGridTolerance = tempg_ascii_strtod((const char*) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "touchWorkaround") == 0)
-	{
-		this->touchWorkaround = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
 	else if (xmlStrcmp(name, (const xmlChar*) "scrollbarHideType") == 0)
 	{
 		if (xmlStrcmp(value, (const xmlChar*) "both") == 0)
@@ -562,57 +497,13 @@ void Settings::parseItem(xmlDocPtr doc, xmlNodePtr cur)
 			this->scrollbarHideType = SCROLLBAR_HIDE_NONE;
 		}
 	}
-	else if (xmlStrcmp(name, (const xmlChar*) "audioSampleRate") == 0)
-	{
-		this->audioSampleRate = tempg_ascii_strtod((const char *) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "audioGain") == 0)
-	{
-		this->audioGain = tempg_ascii_strtod((const char *) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "audioInputDevice") == 0)
-	{
-		this->audioInputDevice = g_ascii_strtoll((const char *) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "audioOutputDevice") == 0)
-	{
-		this->audioOutputDevice = g_ascii_strtoll((const char *) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "experimentalInputSystemEnabled") == 0)
-	{
-		this->experimentalInputSystemEnabled = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "inputSystemTPCButton") == 0)
-	{
-		this->inputSystemTPCButton = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "inputSystemDrawOutsideWindow") == 0)
-	{
-		this->inputSystemDrawOutsideWindow = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "strokeFilterIgnoreTime") == 0)
-	{
-		this->strokeFilterIgnoreTime = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "strokeFilterIgnoreLength") == 0)
-	{
-		this->strokeFilterIgnoreLength = tempg_ascii_strtod((const char*) value, NULL);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "strokeFilterSuccessiveTime") == 0)
-	{
-		this->strokeFilterSuccessiveTime = g_ascii_strtoll((const char*) value, NULL, 10);
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "strokeFilterEnabled") == 0)
-	{
-		this->strokeFilterEnabled = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "doActionOnStrokeFiltered") == 0)
-	{
-		this->doActionOnStrokeFiltered = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
-	}
-	else if (xmlStrcmp(name, (const xmlChar*) "trySelectOnStrokeFiltered") == 0)
+	else
 	{
-		this->trySelectOnStrokeFiltered = xmlStrcmp(value, (const xmlChar*) "true") ? false : true;
+		auto it = properties.find((const char*) name);
+		if (it != properties.end())
+		{
+			it->second.parse(this, (const char*) value);
+		}
 	}
 
 	xmlFree(name);
@@ -988,6 +879,13 @@ void Settings::save()
 	WRITE_BOOL_PROP(autosaveEnabled);
 	WRITE_INT_PROP(autosaveTimeout);
 
+	WRITE_INT_PROP(saveCompressionLevel);
+	WRITE_INT_PROP(autosaveCompressionLevel);
+	WRITE_COMMENT("gzip compression level from 0 (fastest) to 9 (smallest file), autosave uses a faster level by default");
+
+	WRITE_BOOL_PROP(binaryStrokeEncoding);
+	WRITE_COMMENT("Store stroke points in a compact binary format, files saved with it cannot be opened by older versions");
+
 	WRITE_BOOL_PROP(addHorizontalSpace);
 	WRITE_INT_PROP(addHorizontalSpaceAmount);	
 	WRITE_BOOL_PROP(addVerticalSpace);
@@ -1003,6 +901,7 @@ void Settings::save()
 	WRITE_DOUBLE_PROP(snapGridTolerance);
 
 	WRITE_BOOL_PROP(touchWorkaround);
+	WRITE_BOOL_PROP(performanceTracing);
 
 	WRITE_INT_PROP(selectionBorderColor);
 	WRITE_INT_PROP(backgroundColor);
@@ -1011,6 +910,9 @@ void Settings::save()
 	WRITE_INT_PROP(pdfPageCacheSize);
 	WRITE_COMMENT("The count of rendered PDF pages which will be cached.");
 
+	WRITE_INT_PROP(renderMemoryBudget);
+	WRITE_COMMENT("The memory in MiB for rendered pages, previews and the PDF cache. Buffers which are not visible are freed if more is used.");
+
 	WRITE_COMMENT("Config for new pages");
 	WRITE_STRING_PROP(pageTemplate);
 
@@ -1267,6 +1169,69 @@ void Settings::setAutosaveEnabled(bool autosave)
 	save();
 }
 
+int Settings::getSaveCompressionLevel()
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	return this->saveCompressionLevel;
+}
+
+void Settings::setSaveCompressionLevel(int level)
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	if (this->saveCompressionLevel == level)
+	{
+		return;
+	}
+
+	this->saveCompressionLevel = level;
+
+	save();
+}
+
+int Settings::getAutosaveCompressionLevel()
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	return this->autosaveCompressionLevel;
+}
+
+void Settings::setAutosaveCompressionLevel(int level)
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	if (this->autosaveCompressionLevel == level)
+	{
+		return;
+	}
+
+	this->autosaveCompressionLevel = level;
+
+	save();
+}
+
+bool Settings::isBinaryStrokeEncoding()
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	return this->binaryStrokeEncoding;
+}
+
+void Settings::setBinaryStrokeEncoding(bool binary)
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	if (this->binaryStrokeEncoding == binary)
+	{
+		return;
+	}
+
+	this->binaryStrokeEncoding = binary;
+
+	save();
+}
+
 bool Settings::getAddVerticalSpace()
 {
 	XOJ_CHECK_TYPE(Settings);
@@ -1503,6 +1468,13 @@ void Settings::setTouchWorkaround(bool b)
 	save();
 }
 
+bool Settings::isPerformanceTracing()
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	return this->performanceTracing;
+}
+
 ScrollbarHideType Settings::getScrollbarHideType()
 {
 	XOJ_CHECK_TYPE(Settings);
@@ -2199,6 +2171,25 @@ void Settings::setPdfPageCacheSize(int size)
 	save();
 }
 
+int Settings::getRenderMemoryBudget()
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	return this->renderMemoryBudget;
+}
+
+void Settings::setRenderMemoryBudget(int budget)
+{
+	XOJ_CHECK_TYPE(Settings);
+
+	if (this->renderMemoryBudget == budget)
+	{
+		return;
+	}
+	this->renderMemoryBudget = budget;
+	save();
+}
+
 int Settings::getBorderColor()
 {
 	XOJ_CHECK_TYPE(Settings);
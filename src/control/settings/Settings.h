@@ -271,6 +271,13 @@ public:
 	bool isAutosaveEnabled();
 	void setAutosaveEnabled(bool autosave);
 
+	int getSaveCompressionLevel();
+	void setSaveCompressionLevel(int level);
+	int getAutosaveCompressionLevel();
+	void setAutosaveCompressionLevel(int level);
+	bool isBinaryStrokeEncoding();
+	void setBinaryStrokeEncoding(bool binary);
+
 	bool getAddVerticalSpace();
 	void setAddVerticalSpace(bool space);
 	int  getAddVerticalSpaceAmount();
@@ -289,6 +296,11 @@ public:
 	bool isTouchWorkaround();
 	void setTouchWorkaround(bool b);
 
+	/**
+	 * Only read on startup, there is no UI for it: the trace is written to trace.json in the config folder on exit
+	 */
+	bool isPerformanceTracing();
+
 	bool isSnapRotation();
 	void setSnapRotation(bool b);
 	double getSnapRotationTolerance();
@@ -339,6 +351,9 @@ public:
 	int getPdfPageCacheSize();
 	void setPdfPageCacheSize(int size);
 
+	int getRenderMemoryBudget();
+	void setRenderMemoryBudget(int budget);
+
 	string getPageTemplate();
 	void setPageTemplate(string pageTemplate);
 
@@ -662,6 +677,21 @@ private:
 	 */
 	bool autosaveEnabled;
 
+	/**
+	 * gzip compression level of saved files, 0 (fastest) to 9 (smallest)
+	 */
+	int saveCompressionLevel;
+
+	/**
+	 * gzip compression level of autosave files, usually faster than the normal one
+	 */
+	int autosaveCompressionLevel;
+
+	/**
+	 * Save the points of strokes in a compact binary format, the files cannot be opened by older versions
+	 */
+	bool binaryStrokeEncoding;
+
 	/**
 	 * Allow scroll outside the page display area (horizontal)
 	 */
@@ -731,6 +761,11 @@ private:
 	 */
 	int pdfPageCacheSize;
 
+	/**
+	 * The memory in MiB used for rendered pages, previews and the PDF cache
+	 */
+	int renderMemoryBudget;
+
 	/**
 	 * The color to draw borders on selected elements
 	 * (Page, insert image selection etc.)
@@ -777,6 +812,11 @@ private:
 	 */
 	bool touchWorkaround;
 
+	/**
+	 * Record a performance trace, written to the config folder on exit
+	 */
+	bool performanceTracing;
+
 	/**
 	 * The index of the audio device used for recording
 	 */
@@ -22,9 +22,9 @@ private:
 
 public:
 	static Stroke* recognize(Stroke* s);
+	static Stroke* makeCircleShape(Stroke* originalStroke, Inertia& inertia);
 
 private:
-	static Stroke* makeCircleShape(Stroke* originalStroke, Inertia& inertia);
 	static double scoreCircle(Stroke* s, Inertia& inertia);
 
 };
@@ -0,0 +1,160 @@
+#include "IncrementalShapeRecognizer.h"
+
+#include "CircleRecognizer.h"
+#include "RecoSegment.h"
+#include "ShapeRecognizer.h"
+
+#include "model/Stroke.h"
+
+#include <cmath>
+
+IncrementalShapeRecognizer::IncrementalShapeRecognizer()
+{
+	XOJ_INIT_TYPE(IncrementalShapeRecognizer);
+}
+
+IncrementalShapeRecognizer::~IncrementalShapeRecognizer()
+{
+	XOJ_RELEASE_TYPE(IncrementalShapeRecognizer);
+}
+
+void IncrementalShapeRecognizer::reset()
+{
+	XOJ_CHECK_TYPE(IncrementalShapeRecognizer);
+
+	this->total = Inertia();
+	for (int i = 0; i < MAX_POLYGON_SIDES; i++)
+	{
+		this->segments[i] = Inertia();
+	}
+	this->segmentCount = 0;
+	this->tooManySegments = false;
+	this->pointCount = 0;
+}
+
+/**
+ * Standard deviation of the points perpendicular to the main axis,
+ * this filters jitter of short segments, which have a bad det()
+ */
+double IncrementalShapeRecognizer::lineDeviation(Inertia& s)
+{
+	double a = s.xx();
+	double b = s.xy();
+	double c = s.yy();
+
+	// smallest eigenvalue of the inertia matrix
+	double minor = (a + c) / 2 - sqrt((a - c) * (a - c) / 4 + b * b);
+	return minor > 0 ? sqrt(minor) : 0;
+}
+
+void IncrementalShapeRecognizer::addPoint(const Point& p)
+{
+	XOJ_CHECK_TYPE(IncrementalShapeRecognizer);
+
+	if (this->pointCount == 0)
+	{
+		this->firstPoint = p;
+		this->lastPoint = p;
+		this->segmentStart[0] = p;
+		this->segmentEnd[0] = p;
+		this->segmentCount = 1;
+		this->pointCount = 1;
+		return;
+	}
+
+	this->total.increase(this->lastPoint, p, 1);
+
+	if (!this->tooManySegments)
+	{
+		Inertia& current = this->segments[this->segmentCount - 1];
+		Inertia grown = current;
+		grown.increase(this->lastPoint, p, 1);
+
+		if (grown.det() < LINE_MAX_DET || current.getMass() < LIVE_SEGMENT_MIN_LENGTH ||
+		    lineDeviation(grown) < LIVE_SEGMENT_MAX_DEVIATION)
+		{
+			current = grown;
+			this->segmentEnd[this->segmentCount - 1] = p;
+		}
+		else if (this->segmentCount == MAX_POLYGON_SIDES)
+		{
+			// No polygon with that many sides is recognized, only a circle is still possible
+			this->tooManySegments = true;
+		}
+		else
+		{
+			// The last point is a corner, start a new segment there
+			this->segmentCount++;
+			this->segments[this->segmentCount - 1] = Inertia();
+			this->segments[this->segmentCount - 1].increase(this->lastPoint, p, 1);
+			this->segmentStart[this->segmentCount - 1] = this->lastPoint;
+			this->segmentEnd[this->segmentCount - 1] = p;
+		}
+	}
+
+	this->lastPoint = p;
+	this->pointCount++;
+}
+
+Stroke* IncrementalShapeRecognizer::recognize(Stroke* style)
+{
+	XOJ_CHECK_TYPE(IncrementalShapeRecognizer);
+
+	if (this->pointCount < 3)
+	{
+		return NULL;
+	}
+
+	if (!this->tooManySegments)
+	{
+		RecoSegment rs[MAX_POLYGON_SIDES];
+		for (int i = 0; i < this->segmentCount; i++)
+		{
+			rs[i].calcSegmentGeometry(this->segmentStart[i], this->segmentEnd[i], &this->segments[i]);
+		}
+
+		if (this->segmentCount == 1)
+		{
+			return ShapeRecognizer::makeLine(rs, style);
+		}
+
+		if (this->segmentCount == 4)
+		{
+			Stroke* s = ShapeRecognizer::makeRectangle(rs, style);
+			if (s)
+			{
+				return s;
+			}
+		}
+	}
+
+	// maybe a circle: curved (more segments than a polygon), round, closed and about as long as the circumference
+	if (this->tooManySegments && this->total.det() > CIRCLE_MIN_DET)
+	{
+		double radius = this->total.rad();
+		double gap = hypot(this->lastPoint.x - this->firstPoint.x, this->lastPoint.y - this->firstPoint.y);
+		double circumference = 2 * M_PI * radius;
+
+		if (radius > 0 && gap < LIVE_CIRCLE_MAX_GAP * radius &&
+		    fabs(this->total.getMass() / circumference - 1) < LIVE_CIRCLE_LENGTH_TOLERANCE)
+		{
+			return CircleRecognizer::makeCircleShape(style, this->total);
+		}
+	}
+
+	return NULL;
+}
+
+int IncrementalShapeRecognizer::getPointCount()
+{
+	XOJ_CHECK_TYPE(IncrementalShapeRecognizer);
+
+	return this->pointCount;
+}
+
+int IncrementalShapeRecognizer::getSegmentCount()
+{
+	XOJ_CHECK_TYPE(IncrementalShapeRecognizer);
+
+	return this->segmentCount;
+}
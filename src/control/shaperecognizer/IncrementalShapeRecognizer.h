@@ -0,0 +1,84 @@
+/*
+ * Xournal++
+ *
+ * Shape recognizer which is updated while the stroke is drawn
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "Inertia.h"
+#include "ShapeRecognizerConfig.h"
+
+#include "model/Point.h"
+
+#include <XournalType.h>
+
+class Stroke;
+
+/**
+ * The segments are fitted while the points arrive, adding a point
+ * and recognizing the current shape runs in constant time, independent
+ * of the length of the stroke. It is used for the live preview while
+ * drawing, the final recognition is still done by the ShapeRecognizer.
+ */
+class IncrementalShapeRecognizer
+{
+public:
+	IncrementalShapeRecognizer();
+	virtual ~IncrementalShapeRecognizer();
+
+public:
+	/**
+	 * Start a new stroke
+	 */
+	void reset();
+
+	/**
+	 * Add the next point of the stroke
+	 */
+	void addPoint(const Point& p);
+
+	/**
+	 * Recognize the shape of the points added until now
+	 *
+	 * @param style The stroke to copy the style from
+	 * @return The recognized shape (owned by the caller), or NULL
+	 */
+	Stroke* recognize(Stroke* style);
+
+	int getPointCount();
+	int getSegmentCount();
+
+private:
+	static double lineDeviation(Inertia& s);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	/**
+	 * Inertia of the whole stroke, used for circles
+	 */
+	Inertia total;
+
+	/**
+	 * Inertia of the finished segments and the current one (the last)
+	 */
+	Inertia segments[MAX_POLYGON_SIDES];
+	Point segmentStart[MAX_POLYGON_SIDES];
+	Point segmentEnd[MAX_POLYGON_SIDES];
+	int segmentCount = 0;
+
+	/**
+	 * There are more segments than any recognized polygon has
+	 */
+	bool tooManySegments = false;
+
+	Point firstPoint;
+	Point lastPoint;
+	int pointCount = 0;
+};
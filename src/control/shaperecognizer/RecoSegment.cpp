@@ -2,6 +2,7 @@
 
 #include "Inertia.h"
 
+#include <algorithm>
 #include <cmath>
 #include <stdlib.h>
 
@@ -42,10 +43,7 @@ Point RecoSegment::calcEdgeIsect(RecoSegment* r2)
 	return Point(x, y);
 }
 
-/**
- * Find the geometry of a recognized segment
- */
-void RecoSegment::calcSegmentGeometry(const Point* pt, int start, int end, Inertia* s)
+void RecoSegment::calcCenterAndAngle(Inertia* s)
 {
 	XOJ_CHECK_TYPE(RecoSegment);
 
@@ -58,6 +56,26 @@ void RecoSegment::calcSegmentGeometry(const Point* pt, int start, int end, Inert
 	// max angle for inertia quadratic form solves: tan(2t) = 2b/(a-c)
 	this->angle = atan2(2 * b, a - c) / 2;
 	this->radius = sqrt(3 * (a + c));
+}
+
+void RecoSegment::setExtent(double lmin, double lmax)
+{
+	XOJ_CHECK_TYPE(RecoSegment);
+
+	this->x1 = this->xcenter + lmin * cos(this->angle);
+	this->y1 = this->ycenter + lmin * sin(this->angle);
+	this->x2 = this->xcenter + lmax * cos(this->angle);
+	this->y2 = this->ycenter + lmax * sin(this->angle);
+}
+
+/**
+ * Find the geometry of a recognized segment
+ */
+void RecoSegment::calcSegmentGeometry(const Point* pt, int start, int end, Inertia* s)
+{
+	XOJ_CHECK_TYPE(RecoSegment);
+
+	calcCenterAndAngle(s);
 
 	double lmin = 0;
 	double lmax = 0;
@@ -76,8 +94,21 @@ void RecoSegment::calcSegmentGeometry(const Point* pt, int start, int end, Inert
 		}
 	}
 
-	this->x1 = this->xcenter + lmin * cos(this->angle);
-	this->y1 = this->ycenter + lmin * sin(this->angle);
-	this->x2 = this->xcenter + lmax * cos(this->angle);
-	this->y2 = this->ycenter + lmax * sin(this->angle);
+	setExtent(lmin, lmax);
+}
+
+/**
+ * Find the geometry of a recognized segment, only the first and the last point
+ * of the segment are used for the extent, so this runs in constant time
+ */
+void RecoSegment::calcSegmentGeometry(const Point& first, const Point& last, Inertia* s)
+{
+	XOJ_CHECK_TYPE(RecoSegment);
+
+	calcCenterAndAngle(s);
+
+	double l1 = (first.x - this->xcenter) * cos(this->angle) + (first.y - this->ycenter) * sin(this->angle);
+	double l2 = (last.x - this->xcenter) * cos(this->angle) + (last.y - this->ycenter) * sin(this->angle);
+
+	setExtent(std::min(0.0, std::min(l1, l2)), std::max(0.0, std::max(l1, l2)));
 }
@@ -32,6 +32,16 @@ public:
 	 */
 	void calcSegmentGeometry(const Point* pt, int start, int end, Inertia* s);
 
+	/**
+	 * Find the geometry of a recognized segment, only the first and the last point
+	 * of the segment are used for the extent, so this runs in constant time
+	 */
+	void calcSegmentGeometry(const Point& first, const Point& last, Inertia* s);
+
+private:
+	void calcCenterAndAngle(Inertia* s);
+	void setExtent(double lmin, double lmax);
+
 public:
 	XOJ_TYPE_ATTRIB;
 
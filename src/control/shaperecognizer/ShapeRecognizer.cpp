@@ -61,6 +61,14 @@ Stroke* ShapeRecognizer::tryRectangle()
 		return NULL;
 	}
 
+	return makeRectangle(rs, this->stroke);
+}
+
+/**
+ * Test if four segments form a rectangle, and create it
+ */
+Stroke* ShapeRecognizer::makeRectangle(RecoSegment* rs, Stroke* style)
+{
 	// check edges make angles ~= Pi/2 and vertices roughly match
 	double avgAngle = 0.;
 	for (int i = 0; i <= 3; i++)
@@ -109,7 +117,7 @@ Stroke* ShapeRecognizer::tryRectangle()
 	}
 
 	Stroke* s = new Stroke();
-	s->applyStyleFrom(this->stroke);
+	s->applyStyleFrom(style);
 
 	for (int i = 0; i <= 3; i++)
 	{
@@ -127,6 +135,31 @@ Stroke* ShapeRecognizer::tryRectangle()
 	return s;
 }
 
+/**
+ * Create a line from a single segment, nearly horizontal and vertical lines are snapped
+ */
+Stroke* ShapeRecognizer::makeLine(RecoSegment* rs, Stroke* style)
+{
+	if (fabs(rs->angle) < SLANT_TOLERANCE) // nearly horizontal
+	{
+		rs->angle = 0.0;
+		rs->y1 = rs->y2 = rs->ycenter;
+	}
+	if (fabs(rs->angle) > M_PI / 2 - SLANT_TOLERANCE) // nearly vertical
+	{
+		rs->angle = (rs->angle > 0) ? (M_PI / 2) : (-M_PI / 2);
+		rs->x1 = rs->x2 = rs->xcenter;
+	}
+
+	Stroke* s = new Stroke();
+	s->applyStyleFrom(style);
+
+	s->addPoint(Point(rs->x1, rs->y1));
+	s->addPoint(Point(rs->x2, rs->y2));
+
+	return s;
+}
+
 Stroke* ShapeRecognizer::tryArrow()
 {
 	XOJ_CHECK_TYPE(ShapeRecognizer);
@@ -631,22 +664,7 @@ ShapeRecognizerResult* ShapeRecognizer::recognizePatterns(Stroke* stroke)
 
 		if (n == 1) // current stroke is a line
 		{
-			if (fabs(rs->angle) < SLANT_TOLERANCE) // nearly horizontal
-			{
-				rs->angle = 0.0;
-				rs->y1 = rs->y2 = rs->ycenter;
-			}
-			if (fabs(rs->angle) > M_PI / 2 - SLANT_TOLERANCE) // nearly vertical
-			{
-				rs->angle = (rs->angle > 0) ? (M_PI / 2) : (-M_PI / 2);
-				rs->x1 = rs->x2 = rs->xcenter;
-			}
-
-			Stroke* s = new Stroke();
-			s->applyStyleFrom(this->stroke);
-
-			s->addPoint(Point(rs->x1, rs->y1));
-			s->addPoint(Point(rs->x2, rs->y2));
+			Stroke* s = makeLine(rs, this->stroke);
 			rs->stroke = s;
 			ShapeRecognizerResult* result = new ShapeRecognizerResult(s);
 			RDEBUG("return line");
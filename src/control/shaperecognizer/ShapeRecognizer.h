@@ -29,6 +29,19 @@ public:
 
 	ShapeRecognizerResult* recognizePatterns(Stroke* stroke);
 	void resetRecognizer();
+
+	/**
+	 * Test if four segments form a rectangle
+	 *
+	 * @return The rectangle with the style of "style", or NULL
+	 */
+	static Stroke* makeRectangle(RecoSegment* rs, Stroke* style);
+
+	/**
+	 * @return A (snapped) line with the style of "style"
+	 */
+	static Stroke* makeLine(RecoSegment* rs, Stroke* style);
+
 private:
 	Stroke* tryRectangle();
 	Stroke* tryArrow();
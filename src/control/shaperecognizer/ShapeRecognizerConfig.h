@@ -32,6 +32,14 @@
 #define ARROW_MAIN_LINEAR_GAP_MIN -0.3			// gap tolerance on main segment
 #define ARROW_MAIN_LINEAR_GAP_MAX +0.7			// gap tolerance on main segment
 
+// Incremental (live) recognizer
+#define LIVE_SEGMENT_MIN_LENGTH 8.0				// a segment is not split before it has this length (pt)
+#define LIVE_SEGMENT_MAX_DEVIATION 1.0			// deviation (pt) from a line which is still jitter
+#define LIVE_CIRCLE_MAX_GAP 0.35				// max gap between start and end of a circle, relative to radius
+#define LIVE_CIRCLE_LENGTH_TOLERANCE 0.25		// stroke length compared to the circumference
+#define LIVE_HOLD_TIME 600						// ms the pen has to rest until the shape snaps
+#define LIVE_HOLD_MOVE_TOLERANCE 2.0			// movement (pt) which is still counted as resting
+
 
 #ifdef DEBUG_RECOGNIZER
 #define RDEBUG(msg, ...) g_message("ShapeReco::" msg, ##__VA_ARGS__)
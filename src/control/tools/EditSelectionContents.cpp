@@ -50,6 +50,8 @@ EditSelectionContents::EditSelectionContents(double x, double y, double width, d
 	this->sourcePage = sourcePage;
 	this->sourceLayer = sourceLayer;
 	this->sourceView = sourceView;
+
+	RenderMemoryManager::getInstance().addClient(this);
 }
 
 EditSelectionContents::~EditSelectionContents()
@@ -62,6 +64,7 @@ EditSelectionContents::~EditSelectionContents()
 		this->rescaleId = 0;
 	}
 
+	RenderMemoryManager::getInstance().removeClient(this);
 	deleteViewBuffer();
 
 	XOJ_RELEASE_TYPE(EditSelectionContents);
@@ -366,6 +369,42 @@ void EditSelectionContents::deleteViewBuffer()
 	}
 }
 
+size_t EditSelectionContents::getRenderMemoryBytes()
+{
+	XOJ_CHECK_TYPE(EditSelectionContents);
+
+	if (this->crBuffer == NULL)
+	{
+		return 0;
+	}
+
+	return (size_t) cairo_image_surface_get_stride(this->crBuffer) * cairo_image_surface_get_height(this->crBuffer);
+}
+
+bool EditSelectionContents::isRenderMemoryInUse()
+{
+	XOJ_CHECK_TYPE(EditSelectionContents);
+
+	return true;
+}
+
+gint64 EditSelectionContents::getRenderMemoryLastUse()
+{
+	XOJ_CHECK_TYPE(EditSelectionContents);
+
+	return g_get_monotonic_time();
+}
+
+size_t EditSelectionContents::freeRenderMemory()
+{
+	XOJ_CHECK_TYPE(EditSelectionContents);
+
+	size_t bytes = getRenderMemoryBytes();
+	deleteViewBuffer();
+
+	return bytes;
+}
+
 /**
  * Gets the original width of the contents
  */
@@ -560,6 +599,8 @@ void EditSelectionContents::paint(cairo_t* cr, double x, double y, double rotati
 		view.drawSelection(cr2, this);
 
 		cairo_destroy(cr2);
+
+		RenderMemoryManager::getInstance().bufferAllocated();
 	}
 
 	cairo_save(cr);
@@ -13,6 +13,8 @@
 
 #include "CursorSelectionType.h"
 
+#include "control/RenderMemoryManager.h"
+
 #include "control/Tool.h"
 #include "model/Element.h"
 #include "model/Font.h"
@@ -30,7 +32,7 @@ class UndoAction;
 class EditSelectionContents;
 class DeleteUndoAction;
 
-class EditSelectionContents : public ElementContainer, public Serializeable
+class EditSelectionContents : public ElementContainer, public Serializeable, public RenderMemoryClient
 {
 public:
 	EditSelectionContents(double x, double y, double width, double height,
@@ -143,6 +145,13 @@ public:
 	void serialize(ObjectOutputStream& out);
 	void readSerialized(ObjectInputStream& in);
 
+public:
+	// RenderMemoryClient interface, the buffer is in use while the selection exists
+	size_t getRenderMemoryBytes();
+	bool isRenderMemoryInUse();
+	gint64 getRenderMemoryLastUse();
+	size_t freeRenderMemory();
+
 private:
 	XOJ_TYPE_ATTRIB;
 
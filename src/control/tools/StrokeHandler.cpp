@@ -3,6 +3,7 @@
 #include "control/Control.h"
 #include "control/layer/LayerController.h"
 #include "control/settings/Settings.h"
+#include "control/shaperecognizer/IncrementalShapeRecognizer.h"
 #include "control/shaperecognizer/ShapeRecognizerResult.h"
 #include "gui/PageView.h"
 #include "gui/XournalView.h"
@@ -36,6 +37,10 @@ StrokeHandler::~StrokeHandler()
 	delete reco;
 	reco = nullptr;
 
+	resetShapePreview();
+	delete liveReco;
+	liveReco = nullptr;
+
 	XOJ_RELEASE_TYPE(StrokeHandler);
 }
 
@@ -48,6 +53,28 @@ void StrokeHandler::draw(cairo_t* cr)
 		return;
 	}
 
+	if (shapePreview)
+	{
+		double zoom = xournal->getZoom() * xournal->getDpiScaleFactor();
+
+		cairo_save(cr);
+		cairo_scale(cr, zoom, zoom);
+
+		if (shapeSnapped)
+		{
+			// The snapped shape replaces the drawn stroke
+			view.drawStroke(cr, shapePreview);
+			cairo_restore(cr);
+			return;
+		}
+
+		cairo_push_group(cr);
+		view.drawStroke(cr, shapePreview);
+		cairo_pop_group_to_source(cr);
+		cairo_paint_with_alpha(cr, 0.4);
+		cairo_restore(cr);
+	}
+
 	view.applyColor(cr, stroke);
 
 	if (stroke->getToolType() == STROKE_TOOL_HIGHLIGHTER) {
@@ -84,6 +111,12 @@ bool StrokeHandler::onMotionNotifyEvent(const PositionInputData& pos)
 
 	Point currentPoint(x, y);
 
+	if (shapeSnapped)
+	{
+		// The shape is fixed until the pen is released
+		return true;
+	}
+
 	if (pointCount > 0)
 	{
 		if (!validMotion(currentPoint, stroke->getPoint(pointCount - 1)))
@@ -92,6 +125,11 @@ bool StrokeHandler::onMotionNotifyEvent(const PositionInputData& pos)
 		}
 	}
 
+	if (liveReco)
+	{
+		updateShapePreview(currentPoint);
+	}
+
 	if (Point::NO_PRESSURE != pos.pressure && stroke->getToolType() == STROKE_TOOL_PEN)
 	{
 		stroke->setLastPressure(pos.pressure * stroke->getWidth());
@@ -180,6 +218,7 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos)
 				                               stroke->getElementWidth(),
 				                               stroke->getElementHeight());  // clear onMotionNotifyEvent drawing //!
 
+				resetShapePreview();
 				delete stroke;
 				stroke = nullptr;
 				this->userTapped = true;
@@ -225,7 +264,19 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos)
 			reco = new ShapeRecognizer();
 		}
 
-		ShapeRecognizerResult* result = reco->recognizePatterns(stroke);
+		ShapeRecognizerResult* result = nullptr;
+		if (shapeSnapped)
+		{
+			// The user already accepted the previewed shape
+			result = new ShapeRecognizerResult(shapePreview);
+			shapePreview = nullptr;
+			reco->resetRecognizer();
+		}
+		else
+		{
+			result = reco->recognizePatterns(stroke);
+		}
+		resetShapePreview();
 
 		if (result)
 		{
@@ -239,6 +290,8 @@ void StrokeHandler::onButtonReleaseEvent(const PositionInputData& pos)
 		}
 	}
 
+	resetShapePreview();
+
 	if (stroke->getFill() != -1 && stroke->getToolType() == STROKE_TOOL_HIGHLIGHTER)
 	{
 		// The stroke is not filled on drawing time
@@ -333,6 +386,103 @@ void StrokeHandler::onButtonPressEvent(const PositionInputData& pos)
 	}
 
 	this->startStrokeTime = pos.timestamp;
+
+	resetShapePreview();
+	if (xournal->getControl()->getToolHandler()->getDrawingType() == DRAWING_TYPE_STROKE_RECOGNIZER)
+	{
+		if (liveReco == nullptr)
+		{
+			liveReco = new IncrementalShapeRecognizer();
+		}
+		liveReco->reset();
+		liveReco->addPoint(this->buttonDownPoint);
+		this->holdPoint = this->buttonDownPoint;
+	}
+	else
+	{
+		delete liveReco;
+		liveReco = nullptr;
+	}
+}
+
+void StrokeHandler::updateShapePreview(const Point& p)
+{
+	XOJ_CHECK_TYPE(StrokeHandler);
+
+	liveReco->addPoint(p);
+
+	// Clear the old preview, and paint the new one
+	repaintShapePreview();
+	delete shapePreview;
+	shapePreview = liveReco->recognize(stroke);
+	repaintShapePreview();
+
+	// Restart the resting detection, if the pen really moved
+	if (holdTimeoutId == 0 || hypot(p.x - holdPoint.x, p.y - holdPoint.y) > LIVE_HOLD_MOVE_TOLERANCE)
+	{
+		removeHoldTimeout();
+		holdPoint = p;
+		holdTimeoutId = g_timeout_add(LIVE_HOLD_TIME, (GSourceFunc) holdTimeout, this);
+	}
+}
+
+bool StrokeHandler::holdTimeout(StrokeHandler* handler)
+{
+	XOJ_CHECK_TYPE_OBJ(handler, StrokeHandler);
+
+	handler->holdTimeoutId = 0;
+
+	if (handler->stroke && handler->shapePreview)
+	{
+		handler->shapeSnapped = true;
+
+		const double w = handler->stroke->getWidth();
+		handler->redrawable->repaintRect(handler->stroke->getX() - w,
+		                                 handler->stroke->getY() - w,
+		                                 handler->stroke->getElementWidth() + 2 * w,
+		                                 handler->stroke->getElementHeight() + 2 * w);
+	}
+
+	return false;
+}
+
+void StrokeHandler::repaintShapePreview()
+{
+	XOJ_CHECK_TYPE(StrokeHandler);
+
+	if (shapePreview == nullptr)
+	{
+		return;
+	}
+
+	const double w = shapePreview->getWidth();
+	this->redrawable->repaintRect(shapePreview->getX() - w,
+	                              shapePreview->getY() - w,
+	                              shapePreview->getElementWidth() + 2 * w,
+	                              shapePreview->getElementHeight() + 2 * w);
+}
+
+void StrokeHandler::removeHoldTimeout()
+{
+	XOJ_CHECK_TYPE(StrokeHandler);
+
+	if (holdTimeoutId)
+	{
+		g_source_remove(holdTimeoutId);
+		holdTimeoutId = 0;
+	}
+}
+
+void StrokeHandler::resetShapePreview()
+{
+	XOJ_CHECK_TYPE(StrokeHandler);
+
+	removeHoldTimeout();
+	repaintShapePreview();
+
+	delete shapePreview;
+	shapePreview = nullptr;
+	shapeSnapped = false;
 }
 
 void StrokeHandler::destroySurface()
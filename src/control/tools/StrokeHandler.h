@@ -15,6 +15,7 @@
 
 #include "view/DocumentView.h"
 
+class IncrementalShapeRecognizer;
 class ShapeRecognizer;
 
 /**
@@ -48,6 +49,20 @@ protected:
 	void strokeRecognizerDetected(ShapeRecognizerResult* result, Layer* layer);
 	void destroySurface();
 
+private:
+	/**
+	 * Update the live preview of the shape recognizer
+	 */
+	void updateShapePreview(const Point& p);
+	void repaintShapePreview();
+	void removeHoldTimeout();
+	void resetShapePreview();
+
+	/**
+	 * The pen rested long enough, snap the stroke to the previewed shape
+	 */
+	static bool holdTimeout(StrokeHandler* handler);
+
 protected:
 		Point buttonDownPoint;	// used for tapSelect and filtering - never snapped to grid.
 private:
@@ -67,6 +82,26 @@ private:
 
 	ShapeRecognizer* reco;
 
+	/**
+	 * Recognizer for the live preview, updated with every point
+	 */
+	IncrementalShapeRecognizer* liveReco = nullptr;
+
+	/**
+	 * The currently previewed shape, or nullptr
+	 */
+	Stroke* shapePreview = nullptr;
+
+	/**
+	 * The pen rested, the stroke snapped to the previewed shape
+	 */
+	bool shapeSnapped = false;
+
+	/**
+	 * Timeout to detect resting of the pen, and where it rests
+	 */
+	guint holdTimeoutId = 0;
+	Point holdPoint;
 	
 	// to filter out short strokes (usually the user tapping on the page to select it)
 	guint32 startStrokeTime;
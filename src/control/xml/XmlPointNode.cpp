@@ -1,8 +1,12 @@
 #include "XmlPointNode.h"
 
+#include "control/xojfile/BinaryStrokeFormat.h"
+
 XmlPointNode::XmlPointNode(const char* tag)
  : XmlAudioNode(tag),
-   points(NULL)
+   points(NULL),
+   binary(false),
+   binaryPressure(false)
 {
 	XOJ_INIT_TYPE(XmlPointNode);
 }
@@ -29,6 +33,32 @@ void XmlPointNode::addPoint(const Point* point)
 	this->points = g_list_append(this->points, new Point(*point));
 }
 
+void XmlPointNode::setBinaryEncoding(bool pressure)
+{
+	XOJ_CHECK_TYPE(XmlPointNode);
+
+	this->binary = true;
+	this->binaryPressure = pressure;
+	setAttrib("encoding", "binary");
+}
+
+void XmlPointNode::writeBinaryPoints(OutputStream* out)
+{
+	XOJ_CHECK_TYPE(XmlPointNode);
+
+	vector<Point> data;
+	for (GList* l = this->points; l != NULL; l = l->next)
+	{
+		data.push_back(*(Point*) l->data);
+	}
+
+	string encoded = BinaryStrokeFormat::encode(data, this->binaryPressure);
+
+	gchar* base64 = g_base64_encode((const guchar*) encoded.c_str(), encoded.length());
+	out->write(base64);
+	g_free(base64);
+}
+
 void XmlPointNode::writeOut(OutputStream* out)
 {
 	XOJ_CHECK_TYPE(XmlPointNode);
@@ -40,22 +70,29 @@ void XmlPointNode::writeOut(OutputStream* out)
 
 	out->write(">");
 
-	for (GList* l = this->points; l != NULL; l = l->next)
+	if (this->binary)
 	{
-		Point* p = (Point*) l->data;
-		if (l != this->points)
+		writeBinaryPoints(out);
+	}
+	else
+	{
+		for (GList* l = this->points; l != NULL; l = l->next)
 		{
-			out->write(" ");
-		}
-		char tmpX[G_ASCII_DTOSTR_BUF_SIZE];
-		g_ascii_dtostr( tmpX, G_ASCII_DTOSTR_BUF_SIZE, p->x);
-		char tmpY[G_ASCII_DTOSTR_BUF_SIZE];
-		g_ascii_dtostr( tmpY, G_ASCII_DTOSTR_BUF_SIZE, p->y);
-
-		char* tmp = g_strdup_printf("%s %s", tmpX, tmpY);
-		out->write(tmp);
-		g_free(tmp);
+			Point* p = (Point*) l->data;
+			if (l != this->points)
+			{
+				out->write(" ");
+			}
+			char tmpX[G_ASCII_DTOSTR_BUF_SIZE];
+			g_ascii_dtostr( tmpX, G_ASCII_DTOSTR_BUF_SIZE, p->x);
+			char tmpY[G_ASCII_DTOSTR_BUF_SIZE];
+			g_ascii_dtostr( tmpY, G_ASCII_DTOSTR_BUF_SIZE, p->y);
+
+			char* tmp = g_strdup_printf("%s %s", tmpX, tmpY);
+			out->write(tmp);
+			g_free(tmp);
 		
+		}
 	}
 
 	out->write("</");
@@ -26,10 +26,24 @@ private:
 
 public:
 	void addPoint(const Point* point);
+
+	/**
+	 * Write the points with BinaryStrokeFormat instead of decimal text
+	 *
+	 * @param pressure Also write the z values of the points as segment widths
+	 */
+	void setBinaryEncoding(bool pressure);
+
 	virtual void writeOut(OutputStream* out);
 
+private:
+	void writeBinaryPoints(OutputStream* out);
+
 private:
 	XOJ_TYPE_ATTRIB;
 
 	GList* points;
+
+	bool binary;
+	bool binaryPressure;
 };
@@ -16,7 +16,7 @@
 class XmlTexNode : public XmlNode
 {
 public:
-	XmlTexNode(const char* tag, string& binaryData);
+	XmlTexNode(const char* tag, const string& binaryData);
 	virtual ~XmlTexNode();
 
 public:
@@ -28,5 +28,5 @@ private:
 	/**
 	 * Binary .PNG or .PDF
 	 */
-	string& binaryData;
+	const string& binaryData;
 };
@@ -0,0 +1,173 @@
+#include "BinaryStrokeFormat.h"
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Larger values (in units) are clamped, this keeps the differences in 64 bit
+ */
+#define BINARY_STROKE_MAX_VALUE 1e15
+
+static int64_t toUnits(double value)
+{
+	double units = value * BinaryStrokeFormat::BINARY_STROKE_UNITS;
+	if (std::isnan(units))
+	{
+		return 0;
+	}
+	if (units > BINARY_STROKE_MAX_VALUE)
+	{
+		units = BINARY_STROKE_MAX_VALUE;
+	}
+	else if (units < -BINARY_STROKE_MAX_VALUE)
+	{
+		units = -BINARY_STROKE_MAX_VALUE;
+	}
+
+	return std::llround(units);
+}
+
+static void writeVarint(string& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out += (char) ((value & 0x7f) | 0x80);
+		value >>= 7;
+	}
+	out += (char) value;
+}
+
+static void writeDelta(string& out, int64_t value, int64_t& last)
+{
+	int64_t delta = value - last;
+	last = value;
+
+	// Zigzag, small negative differences get small codes, too
+	writeVarint(out, ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63));
+}
+
+static bool readVarint(const string& data, size_t& pos, uint64_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		if (pos >= data.size())
+		{
+			return false;
+		}
+
+		unsigned char c = (unsigned char) data[pos++];
+		value |= (uint64_t) (c & 0x7f) << shift;
+		if ((c & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool readDelta(const string& data, size_t& pos, int64_t& last)
+{
+	uint64_t zigzag = 0;
+	if (!readVarint(data, pos, zigzag))
+	{
+		return false;
+	}
+
+	int64_t delta = (int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1);
+	last = (int64_t) ((uint64_t) last + (uint64_t) delta);
+	return true;
+}
+
+string BinaryStrokeFormat::encode(const vector<Point>& points, bool pressure)
+{
+	string out;
+	// Usually one or two bytes per coordinate
+	out.reserve(8 + points.size() * (pressure ? 6 : 4));
+
+	writeVarint(out, BINARY_STROKE_VERSION);
+	writeVarint(out, pressure ? BINARY_STROKE_PRESSURE : 0);
+	writeVarint(out, points.size());
+
+	int64_t x = 0;
+	int64_t y = 0;
+	for (const Point& p : points)
+	{
+		writeDelta(out, toUnits(p.x), x);
+		writeDelta(out, toUnits(p.y), y);
+	}
+
+	if (pressure)
+	{
+		int64_t z = 0;
+		for (size_t i = 0; i + 1 < points.size(); i++)
+		{
+			writeDelta(out, toUnits(points[i].z), z);
+		}
+	}
+
+	return out;
+}
+
+bool BinaryStrokeFormat::decode(const string& data, vector<Point>& points, vector<double>& pressure)
+{
+	points.clear();
+	pressure.clear();
+
+	size_t pos = 0;
+	uint64_t version = 0;
+	uint64_t flags = 0;
+	uint64_t count = 0;
+	if (!readVarint(data, pos, version) || version != BINARY_STROKE_VERSION ||
+		!readVarint(data, pos, flags) || !readVarint(data, pos, count))
+	{
+		return false;
+	}
+
+	// Each point needs at least two bytes, this rejects invalid counts before allocating
+	if (count > (data.size() - pos) / 2)
+	{
+		return false;
+	}
+
+	points.reserve(count);
+
+	int64_t x = 0;
+	int64_t y = 0;
+	for (uint64_t i = 0; i < count; i++)
+	{
+		if (!readDelta(data, pos, x) || !readDelta(data, pos, y))
+		{
+			points.clear();
+			return false;
+		}
+		points.push_back(Point((double) x / BINARY_STROKE_UNITS, (double) y / BINARY_STROKE_UNITS));
+	}
+
+	if ((flags & BINARY_STROKE_PRESSURE) && count > 1)
+	{
+		pressure.reserve(count - 1);
+
+		int64_t z = 0;
+		for (uint64_t i = 0; i + 1 < count; i++)
+		{
+			if (!readDelta(data, pos, z))
+			{
+				points.clear();
+				pressure.clear();
+				return false;
+			}
+			pressure.push_back((double) z / BINARY_STROKE_UNITS);
+		}
+	}
+
+	if (pos != data.size())
+	{
+		points.clear();
+		pressure.clear();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,63 @@
+/*
+ * Xournal++
+ *
+ * Compact binary encoding of the points of a stroke
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "model/Point.h"
+
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+
+/**
+ * The points of a stroke as an alternative to the decimal text in the stroke
+ * element. The payload is written base64 encoded, the stroke element is marked
+ * with encoding="binary".
+ *
+ * Layout, all numbers are little endian base 128 varints:
+ *
+ *  - Format version (BINARY_STROKE_VERSION)
+ *  - Flags, BINARY_STROKE_PRESSURE if pressure values follow the points
+ *  - Point count
+ *  - For each point the zigzag encoded difference of x and y to the previous
+ *    point, in units of 1 / BINARY_STROKE_UNITS point
+ *  - With pressure, the zigzag encoded differences of the widths of the
+ *    segments (point count - 1 values), in the same unit
+ *
+ * Coordinates are rounded to 1 / BINARY_STROKE_UNITS point, far below the
+ * resolution of any screen or printer.
+ */
+class BinaryStrokeFormat
+{
+private:
+	BinaryStrokeFormat();
+	~BinaryStrokeFormat();
+
+public:
+	/**
+	 * Encodes the points, with pressure the z values are the widths of the segments
+	 */
+	static string encode(const vector<Point>& points, bool pressure);
+
+	/**
+	 * Decodes a payload created by encode
+	 *
+	 * @param pressure Filled with the widths of the segments, empty if the payload has none
+	 * @return false if the data is truncated, corrupt or of an unknown version
+	 */
+	static bool decode(const string& data, vector<Point>& points, vector<double>& pressure);
+
+public:
+	static const int BINARY_STROKE_VERSION = 1;
+	static const int BINARY_STROKE_PRESSURE = 1;
+	static const int BINARY_STROKE_UNITS = 1000;
+};
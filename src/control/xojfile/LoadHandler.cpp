@@ -3,18 +3,25 @@
 #include "model/XojPage.h"
 #include "model/BackgroundImage.h"
 #include "model/StrokeStyle.h"
+#include "BinaryStrokeFormat.h"
 #include "LoadHandlerHelper.h"
 #include "control/pagetype/PageTypeHandler.h"
 
 #include <config.h>
 #include <GzUtil.h>
 #include <i18n.h>
+#include <Tracer.h>
 
 #include <glib/gstdio.h>
 #include <gtk/gtk.h>
 
 #include <stdlib.h>
 
+/**
+ * Size of the blocks in which attachments are copied to temporary files
+ */
+#define ZIP_ATTACHMENT_BLOCK_SIZE (64 * 1024)
+
 #define error2(var, ...)																	\
 	if (var == NULL)																		\
 	{																						\
@@ -550,15 +557,18 @@ void LoadHandler::parseBgPdf()
 					g_free(tmpFilename);
 				} else
 				{
-					gpointer data = nullptr;
-					gsize dataLength;
-					bool success = readZipAttachment(pdfFilename, data, dataLength);
-					if (!success)
+					// Poppler reads the pages from the file when needed, instead of keeping
+					// the whole PDF in memory
+					string tmpFilename;
+					if (!extractZipAttachment(pdfFilename, "xournal_background_XXXXXX.pdf", tmpFilename))
 					{
 						return;
 					}
 
-					doc.readPdf(pdfFilename, false, attachToDocument, data, dataLength);
+					doc.readPdf(pdfFilename, false, attachToDocument, tmpFilename);
+
+					// The open document keeps the data, this fails on Windows and leaves the file to the OS
+					g_unlink(tmpFilename.c_str());
 
 					if (!doc.getLastErrorMsg().empty())
 					{
@@ -684,6 +694,21 @@ void LoadHandler::parseStroke()
 		this->pressureBuffer.push_back(val);
 	}
 
+	this->binaryStroke = false;
+	const char* encoding = LoadHandlerHelper::getAttrib("encoding", true, this);
+	if (encoding != NULL)
+	{
+		if (strcmp("binary", encoding) != 0)
+		{
+			error("%s", FC(_F("Unknown stroke encoding: {1}") % encoding));
+			return;
+		}
+
+		// The width attribute contains only the width, the pressure is part of the points
+		this->binaryStroke = true;
+		this->pressureBuffer.clear();
+	}
+
 	int color = 0;
 	const char* sColor = LoadHandlerHelper::getAttrib("color", false, this);
 	if (!LoadHandlerHelper::parseColor(sColor, color, this))
@@ -941,70 +966,13 @@ void LoadHandler::parseAudio()
 	XOJ_CHECK_TYPE(LoadHandler);
 	const char* filename = LoadHandlerHelper::getAttrib("fn", false, this);
 
-	GFileIOStream* fileStream;
-	GFile* tmpFile = g_file_new_tmp("xournal_audio_XXXXXX.tmp", &fileStream, nullptr);
-	if (!tmpFile)
-	{
-		g_warning("Unable to create temporary file for audio attachment.");
-		return;
-	}
-
-	GOutputStream* outputStream = g_io_stream_get_output_stream(G_IO_STREAM(fileStream));
-
-	zip_stat_t attachmentFileStat;
-	int statStatus = zip_stat(this->zipFp, filename, 0, &attachmentFileStat);
-	if (statStatus != 0)
-	{
-		error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename % zip_error_strerror(zip_get_error(this->zipFp))));
-		return;
-	}
-
-	gsize length;
-	if (attachmentFileStat.valid & ZIP_STAT_SIZE)
-	{
-		length = attachmentFileStat.size;
-	} else
-	{
-		error("%s", FC(_F("Could not open attachment: {1}. Error message: No valid file size provided") % filename));
-		return;
-	}
-
-	zip_file_t* attachmentFile = zip_fopen(this->zipFp, filename, 0);
-
-	if (!attachmentFile)
+	string tmpFilename;
+	if (!extractZipAttachment(filename, "xournal_audio_XXXXXX.tmp", tmpFilename))
 	{
-		error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename % zip_error_strerror(zip_get_error(this->zipFp))));
 		return;
 	}
 
-	gpointer data = g_malloc(1024);
-	zip_uint64_t readBytes = 0;
-	while (readBytes < length)
-	{
-		zip_int64_t read = zip_fread(attachmentFile, data, 1024);
-		if (read == -1)
-		{
-			g_object_unref(tmpFile);
-			g_free(data);
-			error("%s", FC(_F("Could not open attachment: {1}. Error message: Could not read file") % filename));
-			return;
-		}
-
-		gboolean writeSuccessful = g_output_stream_write_all(outputStream, data, static_cast<gsize>(read), nullptr, nullptr, nullptr);
-		if (!writeSuccessful)
-		{
-			g_object_unref(tmpFile);
-			g_free(data);
-			error("%s", FC(_F("Could not open attachment: {1}. Error message: Could not write file") % filename));
-			return;
-		}
-
-		readBytes += read;
-	}
-
-	zip_fclose(attachmentFile);
-
-	g_hash_table_insert(this->audioFiles, g_strdup(filename), g_file_get_path(tmpFile));
+	g_hash_table_insert(this->audioFiles, g_strdup(filename), g_strdup(tmpFilename.c_str()));
 }
 
 void LoadHandler::parserStartElement(GMarkupParseContext* context, const gchar* elementName, const gchar** attributeNames,
@@ -1121,7 +1089,28 @@ void LoadHandler::parserText(GMarkupParseContext* context, const gchar* text,
 	XOJ_CHECK_TYPE_OBJ(handler, LoadHandler);
 
 
-	if (handler->pos == PARSER_POS_IN_STROKE)
+	if (handler->pos == PARSER_POS_IN_STROKE && handler->binaryStroke)
+	{
+		vector<Point> points;
+		vector<double> pressure;
+		if (!BinaryStrokeFormat::decode(handler->parseBase64(text, textLen), points, pressure) || points.size() < 2)
+		{
+			error2(*error, "%s", _("Invalid binary stroke data"));
+			return;
+		}
+
+		for (const Point& p : points)
+		{
+			handler->stroke->addPoint(p);
+		}
+		handler->stroke->freeUnusedPointItems();
+
+		if (!pressure.empty())
+		{
+			handler->stroke->setPressure(pressure);
+		}
+	}
+	else if (handler->pos == PARSER_POS_IN_STROKE)
 	{
 		const char* ptr = text;
 		int n = 0;
@@ -1240,6 +1229,8 @@ Document* LoadHandler::loadDocument(string filename)
 {
 	XOJ_CHECK_TYPE(LoadHandler);
 
+	TRACE_ZONE("LoadHandler::loadDocument");
+
 	initAttributes();
 	doc.clearDocument();
 
@@ -1309,9 +1300,10 @@ bool LoadHandler::readZipAttachment(string filename, gpointer& data, gsize& leng
 	zip_uint64_t readBytes = 0;
 	while (readBytes < length)
 	{
-		zip_int64_t read = zip_fread(attachmentFile, data, attachmentFileStat.size);
-		if (read == -1)
+		zip_int64_t read = zip_fread(attachmentFile, (char*) data + readBytes, length - readBytes);
+		if (read <= 0)
 		{
+			zip_fclose(attachmentFile);
 			g_free(data);
 			error("%s", FC(_F("Could not open attachment: {1}. Error message: No valid file size provided") % filename));
 			return false;
@@ -1325,6 +1317,89 @@ bool LoadHandler::readZipAttachment(string filename, gpointer& data, gsize& leng
 	return true;
 }
 
+bool LoadHandler::extractZipAttachment(string filename, const char* tmpl, string& tmpFilename)
+{
+	zip_stat_t attachmentFileStat;
+	int statStatus = zip_stat(this->zipFp, filename.c_str(), 0, &attachmentFileStat);
+	if (statStatus != 0)
+	{
+		error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename % zip_error_strerror(zip_get_error(this->zipFp))));
+		return false;
+	}
+
+	if (!(attachmentFileStat.valid & ZIP_STAT_SIZE))
+	{
+		error("%s", FC(_F("Could not open attachment: {1}. Error message: No valid file size provided") % filename));
+		return false;
+	}
+	zip_uint64_t length = attachmentFileStat.size;
+
+	zip_file_t* attachmentFile = zip_fopen(this->zipFp, filename.c_str(), 0);
+	if (!attachmentFile)
+	{
+		error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename % zip_error_strerror(zip_get_error(this->zipFp))));
+		return false;
+	}
+
+	GFileIOStream* fileStream = NULL;
+	GFile* tmpFile = g_file_new_tmp(tmpl, &fileStream, nullptr);
+	if (!tmpFile)
+	{
+		zip_fclose(attachmentFile);
+		g_warning("Unable to create temporary file for attachment %s.", filename.c_str());
+		return false;
+	}
+
+	GOutputStream* outputStream = g_io_stream_get_output_stream(G_IO_STREAM(fileStream));
+
+	// Copied in blocks, large attachments are never completely in memory
+	gpointer data = g_malloc(ZIP_ATTACHMENT_BLOCK_SIZE);
+	string errorMessage;
+	zip_uint64_t readBytes = 0;
+	while (readBytes < length)
+	{
+		zip_int64_t read = zip_fread(attachmentFile, data, ZIP_ATTACHMENT_BLOCK_SIZE);
+		if (read <= 0)
+		{
+			errorMessage = _("Could not read file");
+			break;
+		}
+
+		gboolean writeSuccessful = g_output_stream_write_all(outputStream, data, static_cast<gsize>(read), nullptr, nullptr, nullptr);
+		if (!writeSuccessful)
+		{
+			errorMessage = _("Could not write file");
+			break;
+		}
+
+		readBytes += read;
+	}
+
+	g_free(data);
+	zip_fclose(attachmentFile);
+
+	if (!g_io_stream_close(G_IO_STREAM(fileStream), nullptr, nullptr) && errorMessage.empty())
+	{
+		errorMessage = _("Could not write file");
+	}
+	g_object_unref(fileStream);
+
+	char* path = g_file_get_path(tmpFile);
+	tmpFilename = path;
+	g_free(path);
+
+	if (!errorMessage.empty())
+	{
+		g_file_delete(tmpFile, nullptr, nullptr);
+		g_object_unref(tmpFile);
+		error("%s", FC(_F("Could not open attachment: {1}. Error message: {2}") % filename % errorMessage));
+		return false;
+	}
+
+	g_object_unref(tmpFile);
+	return true;
+}
+
 string LoadHandler::getTempFileForPath(string filename)
 {
 	gpointer tmpFilename = g_hash_table_lookup(this->audioFiles, filename.c_str());
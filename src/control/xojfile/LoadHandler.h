@@ -98,6 +98,13 @@ private:
 private:
 	string parseBase64(const gchar* base64, gsize lenght);
 	bool readZipAttachment(string filename, gpointer& data, gsize& length);
+
+	/**
+	 * Copies an attachment to a new temporary file
+	 *
+	 * @param tmpl The template for the name of the temporary file, see g_file_new_tmp
+	 */
+	bool extractZipAttachment(string filename, const char* tmpl, string& tmpFilename);
 	string getTempFileForPath(string filename);
 
 private:
@@ -128,6 +135,11 @@ private:
 
 	vector<double> pressureBuffer;
 
+	/**
+	 * The points of the current stroke are in BinaryStrokeFormat
+	 */
+	bool binaryStroke = false;
+
 	PageRef page;
 	Layer* layer;
 	Stroke* stroke;
@@ -18,6 +18,7 @@
 
 #include <config.h>
 #include <i18n.h>
+#include <Tracer.h>
 
 SaveHandler::SaveHandler()
 {
@@ -26,6 +27,8 @@ SaveHandler::SaveHandler()
 	this->root = NULL;
 	this->firstPdfPageVisited = false;
 	this->attachBgId = 1;
+	this->compressionLevel = Z_DEFAULT_COMPRESSION;
+	this->binaryStrokes = false;
 	this->backgroundImages = NULL;
 }
 
@@ -153,7 +156,12 @@ void SaveHandler::visitStroke(XmlPointNode* stroke, Stroke* s)
 		stroke->addPoint(&p);
 	}
 
-	if (s->hasPressure())
+	if (this->binaryStrokes)
+	{
+		stroke->setBinaryEncoding(s->hasPressure());
+		stroke->setAttrib("width", s->getWidth());
+	}
+	else if (s->hasPressure())
 	{
 		double* values = new double[pointCount + 1];
 		values[0] = s->getWidth();
@@ -367,9 +375,23 @@ void SaveHandler::writeSolidBackground(XmlNode* background, PageRef p)
 	}
 }
 
+void SaveHandler::setCompressionLevel(int level)
+{
+	XOJ_CHECK_TYPE(SaveHandler);
+
+	this->compressionLevel = level;
+}
+
+void SaveHandler::setBinaryStrokes(bool binaryStrokes)
+{
+	XOJ_CHECK_TYPE(SaveHandler);
+
+	this->binaryStrokes = binaryStrokes;
+}
+
 void SaveHandler::saveTo(Path filename, ProgressListener* listener)
 {
-	GzOutputStream out(filename);
+	GzOutputStream out(filename, this->compressionLevel);
 
 	if (!out.getLastError().empty())
 	{
@@ -391,6 +413,8 @@ void SaveHandler::saveTo(OutputStream* out, Path filename, ProgressListener* lis
 {
 	XOJ_CHECK_TYPE(SaveHandler);
 
+	TRACE_ZONE("SaveHandler::saveTo");
+
 	// XMLNode should be locale-safe ( store doubles using Locale 'C' format
 
 	out->write("<?xml version=\"1.0\" standalone=\"no\"?>\n");
@@ -31,6 +31,17 @@ public:
 
 public:
 	void prepareSave(Document* doc);
+
+	/**
+	 * zlib compression level used by saveTo(Path), 0 (fastest) to 9 (smallest)
+	 */
+	void setCompressionLevel(int level);
+
+	/**
+	 * Write the points of strokes with BinaryStrokeFormat, which older versions
+	 * cannot read. Has to be set before prepareSave.
+	 */
+	void setBinaryStrokes(bool binaryStrokes);
 	void saveTo(Path filename, ProgressListener* listener = NULL);
 	void saveTo(OutputStream* out, Path filename, ProgressListener* listener = NULL);
 	string getErrorMessage();
@@ -57,6 +68,8 @@ protected:
 	XmlNode* root;
 	bool firstPdfPageVisited;
 	int attachBgId;
+	int compressionLevel;
+	bool binaryStrokes;
 
 	string errorMessage;
 
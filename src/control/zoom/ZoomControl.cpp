@@ -6,6 +6,8 @@
 #include "gui/widgets/XournalWidget.h"
 #include "gui/XournalView.h"
 
+#include <algorithm>
+
 ZoomControl::ZoomControl()
 {
 	XOJ_INIT_TYPE(ZoomControl);
@@ -20,6 +22,12 @@ ZoomControl::~ZoomControl()
 {
 	XOJ_CHECK_TYPE(ZoomControl);
 
+	if (this->zoomScrollTimeoutId)
+	{
+		g_source_remove(this->zoomScrollTimeoutId);
+		this->zoomScrollTimeoutId = 0;
+	}
+
 	XOJ_RELEASE_TYPE(ZoomControl);
 }
 
@@ -84,6 +92,30 @@ void ZoomControl::zoomScroll(bool zoomIn, double x, double y)
 		newZoom = this->zoom - this->zoomStepScroll;
 	}
 	this->zoomSequnceChange(newZoom, false);
+
+	// Ctrl + Scroll has no end event, the sequence ends if there are no more scroll events
+	endZoomSequenceDelayed();
+}
+
+void ZoomControl::endZoomSequenceDelayed()
+{
+	XOJ_CHECK_TYPE(ZoomControl);
+
+	if (this->zoomScrollTimeoutId)
+	{
+		g_source_remove(this->zoomScrollTimeoutId);
+	}
+	this->zoomScrollTimeoutId = g_timeout_add(ZOOM_SCROLL_SEQUENCE_TIMEOUT, (GSourceFunc) zoomScrollTimeout, this);
+}
+
+bool ZoomControl::zoomScrollTimeout(ZoomControl* zoom)
+{
+	XOJ_CHECK_TYPE_OBJ(zoom, ZoomControl);
+
+	zoom->zoomScrollTimeoutId = 0;
+	zoom->endZoomSequence();
+
+	return false;
 }
 
 /**
@@ -139,10 +171,24 @@ void ZoomControl::endZoomSequence()
 {
 	XOJ_CHECK_TYPE(ZoomControl);
 
+	bool wasActive = isZoomSequenceActive();
+
 	scrollPositionX = -1;
 	scrollPositionY = -1;
 
 	zoomSequenceStart = -1;
+
+	if (wasActive)
+	{
+		fireZoomSequenceFinished();
+	}
+}
+
+bool ZoomControl::isZoomSequenceActive()
+{
+	XOJ_CHECK_TYPE(ZoomControl);
+
+	return this->zoomSequenceStart != -1;
 }
 
 /**
@@ -231,6 +277,16 @@ void ZoomControl::fireZoomRangeValueChanged()
 	}
 }
 
+void ZoomControl::fireZoomSequenceFinished()
+{
+	XOJ_CHECK_TYPE(ZoomControl);
+
+	for (ZoomListener* z : this->listener)
+	{
+		z->zoomSequenceFinished();
+	}
+}
+
 double ZoomControl::getZoom()
 {
 	XOJ_CHECK_TYPE(ZoomControl);
@@ -522,6 +578,18 @@ void ZoomControl::pageSizeChanged(size_t page)
 	updateZoomFitValue(page);
 }
 
+void ZoomControl::pageSizesChanged(const std::vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(ZoomControl);
+
+	// Only the current page is used for the zoom values
+	size_t current = view->getCurrentPage();
+	if (std::find(pages.begin(), pages.end(), current) != pages.end())
+	{
+		pageSizeChanged(current);
+	}
+}
+
 void ZoomControl::pageSelected(size_t page)
 {
 	XOJ_CHECK_TYPE(ZoomControl);
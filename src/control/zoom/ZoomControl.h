@@ -24,6 +24,7 @@
 #define DEFAULT_ZOOM_MIN 0.3
 #define DEFAULT_ZOOM_STEP 0.1
 #define DEFAULT_ZOOM_STEP_SCROLL 0.01
+#define ZOOM_SCROLL_SEQUENCE_TIMEOUT 250 // ms
 #define ZOOM_IN true
 #define ZOOM_OUT false
 
@@ -147,6 +148,16 @@ public:
 	 */
 	void endZoomSequence();
 
+	/**
+	 * Ends the zoom sequence ZOOM_SCROLL_SEQUENCE_TIMEOUT after the last call, for input without end event
+	 */
+	void endZoomSequenceDelayed();
+
+	/**
+	 * @return true while a zoom sequence (startZoomSequence() / endZoomSequence()) is running
+	 */
+	bool isZoomSequenceActive();
+
 	/**
 	 * Update the scroll position manually
 	 */
@@ -181,13 +192,16 @@ public:
 protected:
 	void fireZoomChanged();
 	void fireZoomRangeValueChanged();
+	void fireZoomSequenceFinished();
 
 	void pageSizeChanged(size_t page);
+	void pageSizesChanged(const std::vector<size_t>& pages);
 // 	void pageChanged(size_t page);
 	void pageSelected(size_t page);
 
 	static bool onScrolledwindowMainScrollEvent(GtkWidget* widget, GdkEventScroll* event, ZoomControl* zoom);
 	static bool onWidgetSizeChangedEvent(GtkWidget* widget, GdkRectangle *allocation, ZoomControl* zoom);
+	static bool zoomScrollTimeout(ZoomControl* zoom);
 
 private:
 	void zoomFit();
@@ -258,6 +272,11 @@ private:
 	 */
 	double scrollCursorPositionY = 0;
 
+	/**
+	 * Timeout which ends the zoom sequence if there are no more Ctrl + Scroll events
+	 */
+	guint zoomScrollTimeoutId = 0;
+
 	/**
 	 * Zoomstep value for Ctrl - and Zoom In and Out Button
 	 * depends dpi (REAL_PERCENTAGE_VALUE * zoom100Value)
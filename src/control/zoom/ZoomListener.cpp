@@ -7,3 +7,7 @@ ZoomListener::~ZoomListener()
 void ZoomListener::zoomRangeValuesChanged()
 {
 }
+
+void ZoomListener::zoomSequenceFinished()
+{
+}
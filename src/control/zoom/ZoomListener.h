@@ -17,5 +17,11 @@ public:
 	virtual void zoomChanged() = 0;
 	virtual void zoomRangeValuesChanged();
 
+	/**
+	 * A zoom sequence (gesture, Ctrl + Scroll, slider...) is finished,
+	 * the zoom value will not change anymore for now
+	 */
+	virtual void zoomSequenceFinished();
+
 	virtual ~ZoomListener();
 };
@@ -5,6 +5,8 @@
 #include "control/Control.h"
 #include "widgets/XournalWidget.h"
 #include "gui/scroll/ScrollHandling.h"
+
+#include <algorithm>
 	
 /**
  * Padding outside the pages, including shadow
@@ -30,7 +32,8 @@ const int XOURNAL_PADDING_BETWEEN = 15;
 
 Layout::Layout(XournalView* view, ScrollHandling* scrollHandling)
  : view(view),
-   scrollHandling(scrollHandling)
+   scrollHandling(scrollHandling),
+   prefetcher(view, this)
 {
 	XOJ_INIT_TYPE(Layout);
 
@@ -79,52 +82,79 @@ void Layout::updateVisibility()
 	XOJ_CHECK_TYPE(Layout);
 
 	Rectangle visRect = getVisibleRect();
-	
-	// step through every possible page position and update using p->setIsVisible()
-	// Using initial grid aprox speeds things up by a factor of 5.  See previous git check-in for specifics.
-	int x1 = 0;
-	int y1 = 0;	
- 	
-	for (int onRow = 0; onRow < this->rows; onRow++)
+
+	// Only the pages visible before and the pages near the visible area are touched,
+	// a page which stays visible is hidden and shown again, which keeps it visible
+	for (XojPageView* pageView : this->visiblePages)
 	{
-		int y2 = this->sizeRow[onRow];
-		for (int onCol = 0; onCol < this->columns; onCol++)
+		pageView->setIsVisible(false);
+	}
+	this->visiblePages.clear();
+	this->visibleIndices.clear();
+
+	getPagesInRect(visRect, this->candidatePages);
+
+	for (int pageIndex : this->candidatePages)
+	{
+		XojPageView* pageView = this->view->viewPages[pageIndex];
+
+		// now use exact check of page itself:
+		Rectangle pageRect = pageView->getRect();
+		if (	!(visRect.x > pageRect.x + pageRect.width || visRect.x + visRect.width < pageRect.x) // visrect not outside current page dimensions
+			&&	!(visRect.y > pageRect.y + pageRect.height || visRect.y + visRect.height < pageRect.y))
 		{
-			int x2 = this->sizeCol[onCol];		
-			int pageIndex = this->mapper.map(onCol, onRow);
-			if (pageIndex >= 0)	// a page exists at this grid location
-			{
+			pageView->setIsVisible(true);
+			this->visiblePages.push_back(pageView);
+			this->visibleIndices.push_back(pageIndex);
+		}
+	}
 
-				XojPageView* pageView = this->view->viewPages[pageIndex];
-				
-				
-				//check if grid location is visible as an aprox for page visiblity:
-				if(		!(visRect.x >x2  || visRect.x+visRect.width < x1) // visrect not outside current row/col 
-					&& 	!(visRect.y >y2  || visRect.y+visRect.height < y1))
-				{
-					// now use exact check of page itself:
-					Rectangle pageRect = pageView->getRect();
-					if(		!(visRect.x >pageRect.x+pageRect.width  || visRect.x+visRect.width < pageRect.x) // visrect not outside current page dimensions 
-						&& 	!(visRect.y >pageRect.y+pageRect.height  || visRect.y+visRect.height < pageRect.y))
-					{
-						pageView->setIsVisible(true);
-					}	
-					else 
-					{
-						pageView->setIsVisible(false);
-					}
-				}
-				else
-				{
-					pageView->setIsVisible(false);
-							
-				}
+	this->prefetcher.update(visRect, this->visibleIndices);
+}
+
+void Layout::pageViewDeleted(XojPageView* pageView)
+{
+	XOJ_CHECK_TYPE(Layout);
+
+	this->visiblePages.erase(std::remove(this->visiblePages.begin(), this->visiblePages.end(), pageView),
+							 this->visiblePages.end());
+	this->prefetcher.pageViewDeleted(pageView);
+}
+
+void Layout::getPagesInRect(const Rectangle& rect, std::vector<int>& pages)
+{
+	XOJ_CHECK_TYPE(Layout);
+
+	pages.clear();
+
+	if (this->rows <= 0 || this->columns <= 0)
+	{
+		return;
+	}
+
+	// sizeRow / sizeCol contain the accumulated end position of each row / column,
+	// a row spans from the end of the previous row to its own end
+	int firstRow = std::lower_bound(this->sizeRow.begin(), this->sizeRow.end(), rect.y) - this->sizeRow.begin();
+	int lastRow = std::upper_bound(this->sizeRow.begin(), this->sizeRow.end(), rect.y + rect.height) - this->sizeRow.begin();
+	lastRow = std::min(lastRow, this->rows - 1);
+
+	int firstCol = std::lower_bound(this->sizeCol.begin(), this->sizeCol.end(), rect.x) - this->sizeCol.begin();
+	int lastCol = std::upper_bound(this->sizeCol.begin(), this->sizeCol.end(), rect.x + rect.width) - this->sizeCol.begin();
+	lastCol = std::min(lastCol, this->columns - 1);
+
+	int len = this->view->viewPagesLen;
+
+	for (int r = firstRow; r <= lastRow; r++)
+	{
+		for (int c = firstCol; c <= lastCol; c++)
+		{
+			int pageIndex = this->mapper.map(c, r);
+			if (pageIndex >= 0 && pageIndex < len)
+			{
+				pages.push_back(pageIndex);
 			}
-			x1 = x2;
 		}
-		y1 = y2;
 	}
-	
 }
 
 Rectangle Layout::getVisibleRect()
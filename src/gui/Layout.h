@@ -16,7 +16,10 @@
 
 #include <gtk/gtk.h>
 
+#include <vector>
+
 #include "gui/LayoutMapper.h"
+#include "gui/RenderPrefetcher.h"
 
 class XojPageView;
 class XournalView;
@@ -87,6 +90,11 @@ public:
 	 */
 	void updateVisibility();
 
+	/**
+	 * The XojPageView is deleted, it must not be hidden by the next updateVisibility()
+	 */
+	void pageViewDeleted(XojPageView* pageView);
+
 	
 	
 	/**
@@ -101,6 +109,13 @@ public:
 	 */	
 	int getIndexAtGridMap(int row, int col);
 
+	/**
+	 * Collects the indices of the pages whose grid cell intersects the rectangle.
+	 * The rows and columns are found by binary search, so only the pages
+	 * near the rectangle are visited.
+	 */
+	void getPagesInRect(const Rectangle& rect, std::vector<int>& pages);
+
 protected:
 	static void horizontalScrollChanged(GtkAdjustment* adjustment, Layout* layout);
 	static void verticalScrollChanged(GtkAdjustment* adjustment, Layout* layout);
@@ -137,11 +152,24 @@ private:
 	 *The following are useful for locating page at a pixel location
 	 */
 	
-	int rows;
-	int columns;
+	int rows = 0;
+	int columns = 0;
 	
 	std::vector<int> sizeCol;
 	std::vector<int> sizeRow;
+
+	/**
+	 * The pages set visible by the last updateVisibility(), only these need to be hidden again.
+	 * Stored as views, the indices change if pages are inserted or deleted.
+	 */
+	std::vector<XojPageView*> visiblePages;
+	std::vector<int> visibleIndices;
+	std::vector<int> candidatePages;
+
+	/**
+	 * Renders the pages ahead while scrolling
+	 */
+	RenderPrefetcher prefetcher;
 	
 	/**
 	 * cache the last GetViewAt() row and column.
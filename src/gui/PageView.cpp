@@ -36,6 +36,8 @@
 
 #include "Range.h"
 #include "Rectangle.h"
+#include "StartupTimeline.h"
+#include "Tracer.h"
 #include "config-debug.h"
 #include "config-features.h"
 #include "config.h"
@@ -67,11 +69,7 @@ XojPageView::XojPageView(XournalView* xournal, PageRef page)
 	// (we need it for undo commands)
 	this->oldtext = nullptr;
 
-	this->eraser = new EraseHandler(xournal->getControl()->getUndoRedoHandler(),
-	                                xournal->getControl()->getDocument(),
-	                                this->page,
-	                                xournal->getControl()->getToolHandler(),
-	                                this);
+	RenderMemoryManager::getInstance().addClient(this);
 }
 
 XojPageView::~XojPageView()
@@ -80,6 +78,7 @@ XojPageView::~XojPageView()
 
 	// Unregister listener before destroying this handler
 	this->unregisterListener();
+	RenderMemoryManager::getInstance().removeClient(this);
 
 	this->xournal->getControl()->getScheduler()->removePage(this);
 	delete this->inputHandler;
@@ -101,6 +100,22 @@ XojPageView::~XojPageView()
 	XOJ_RELEASE_TYPE(XojPageView);
 }
 
+EraseHandler* XojPageView::getEraser()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	if (this->eraser == nullptr)
+	{
+		this->eraser = new EraseHandler(xournal->getControl()->getUndoRedoHandler(),
+		                                xournal->getControl()->getDocument(),
+		                                this->page,
+		                                xournal->getControl()->getToolHandler(),
+		                                this);
+	}
+
+	return this->eraser;
+}
+
 void XojPageView::setIsVisible(bool visible)
 {
 	XOJ_CHECK_TYPE(XojPageView);
@@ -111,9 +126,7 @@ void XojPageView::setIsVisible(bool visible)
 	}
 	else if (this->lastVisibleTime <= 0)
 	{
-		GTimeVal val;
-		g_get_current_time(&val);
-		this->lastVisibleTime = val.tv_sec;
+		this->lastVisibleTime = g_get_monotonic_time() / G_USEC_PER_SEC;
 	}
 }
 
@@ -140,6 +153,8 @@ void XojPageView::deleteViewBuffer()
 		this->crBuffer = nullptr;
 	}
 	g_mutex_unlock(&this->drawingMutex);
+
+	this->layerCache.clear();
 }
 
 bool XojPageView::containsPoint(int x, int y, bool local)
@@ -337,6 +352,8 @@ bool XojPageView::onButtonPressEvent(const PositionInputData& pos)
 {
 	XOJ_CHECK_TYPE(XojPageView);
 
+	TRACE_ZONE_CATEGORY("XojPageView::onButtonPressEvent", "input");
+
 	Control* control = xournal->getControl();
 
 	if (!this->selected)
@@ -396,7 +413,7 @@ bool XojPageView::onButtonPressEvent(const PositionInputData& pos)
 	}
 	else if (h->getToolType() == TOOL_ERASER)
 	{
-		this->eraser->erase(x, y);
+		getEraser()->erase(x, y);
 		this->inEraser = true;
 	}
 	else if (h->getToolType() == TOOL_VERTICAL_SPACE)
@@ -558,6 +575,8 @@ bool XojPageView::onMotionNotifyEvent(const PositionInputData& pos)
 {
 	XOJ_CHECK_TYPE(XojPageView);
 
+	TRACE_ZONE_CATEGORY("XojPageView::onMotionNotifyEvent", "input");
+
 	double zoom = xournal->getZoom();
 	double x = pos.x / zoom;
 	double y = pos.y / zoom;
@@ -586,7 +605,7 @@ bool XojPageView::onMotionNotifyEvent(const PositionInputData& pos)
 	}
 	else if (h->getToolType() == TOOL_ERASER && h->getEraserType() != ERASER_TYPE_WHITEOUT && this->inEraser)
 	{
-		this->eraser->erase(x, y);
+		getEraser()->erase(x, y);
 	}
 
 	return false;
@@ -596,6 +615,8 @@ bool XojPageView::onButtonReleaseEvent(const PositionInputData& pos)
 {
 	XOJ_CHECK_TYPE(XojPageView);
 
+	TRACE_ZONE_CATEGORY("XojPageView::onButtonReleaseEvent", "input");
+
 	Control* control = xournal->getControl();
 
 	if (this->inputHandler)
@@ -635,7 +656,7 @@ bool XojPageView::onButtonReleaseEvent(const PositionInputData& pos)
 		this->inEraser = false;
 		Document* doc = this->xournal->getControl()->getDocument();
 		doc->lock();
-		this->eraser->finalize();
+		getEraser()->finalize();
 		doc->unlock();
 	}
 
@@ -729,10 +750,79 @@ void XojPageView::rerenderPage()
 {
 	XOJ_CHECK_TYPE(XojPageView);
 
+	g_mutex_lock(&this->repaintRectMutex);
+	this->contentsChanged = true;
+	g_mutex_unlock(&this->repaintRectMutex);
+
+	rerenderPageUnchanged();
+}
+
+void XojPageView::rerenderPageUnchanged()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
 	this->rerenderComplete = true;
 	this->xournal->getControl()->getScheduler()->addRerenderPage(this);
 }
 
+void XojPageView::rerenderPageProgressive()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	g_mutex_lock(&this->repaintRectMutex);
+	this->rerenderLowResolution = true;
+	g_mutex_unlock(&this->repaintRectMutex);
+
+	rerenderPageUnchanged();
+}
+
+void XojPageView::prerenderPage()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	// Counts as just used, so the buffer is not the first one freed
+	if (this->lastVisibleTime != 0)
+	{
+		this->lastVisibleTime = g_get_monotonic_time() / G_USEC_PER_SEC;
+	}
+
+	this->rerenderComplete = true;
+	this->xournal->getControl()->getScheduler()->addPrerenderPage(this);
+}
+
+bool XojPageView::hasCurrentBuffer()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	g_mutex_lock(&this->drawingMutex);
+	bool current = bufferMatchesZoom();
+	g_mutex_unlock(&this->drawingMutex);
+
+	return current;
+}
+
+bool XojPageView::bufferMatchesZoom()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	if (this->crBuffer == nullptr)
+	{
+		return false;
+	}
+
+	// The buffer size is rounded up, the display size is rounded down
+	double width = this->page->getWidth() * this->xournal->getZoom() * this->xournal->getDpiScaleFactor();
+	return std::abs(cairo_image_surface_get_width(this->crBuffer) - width) <= 1;
+}
+
+size_t XojPageView::getBufferBytes()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	size_t scale = xournal->getDpiScaleFactor();
+	return (size_t) getDisplayWidth() * getDisplayHeight() * 4 * scale * scale;
+}
+
 void XojPageView::repaintPage()
 {
 	XOJ_CHECK_TYPE(XojPageView);
@@ -764,6 +854,10 @@ void XojPageView::addRerenderRect(double x, double y, double width, double heigh
 {
 	XOJ_CHECK_TYPE(XojPageView);
 
+	g_mutex_lock(&this->repaintRectMutex);
+	this->contentsChanged = true;
+	g_mutex_unlock(&this->repaintRectMutex);
+
 	if (this->rerenderComplete)
 	{
 		return;
@@ -881,7 +975,7 @@ void XojPageView::drawLoadingPage(cairo_t* cr)
 	        cr, (page->getWidth() - ex.width) / 2 - ex.x_bearing, (page->getHeight() - ex.height) / 2 - ex.y_bearing);
 	cairo_show_text(cr, txtLoading.c_str());
 
-	rerenderPage();
+	rerenderPageUnchanged();
 }
 
 /**
@@ -897,6 +991,8 @@ void XojPageView::paintPageSync(cairo_t* cr, GdkRectangle* rect)
 		return;
 	}
 
+	StartupTimeline::mark("document visible");
+
 	double zoom = xournal->getZoom();
 	int dispWidth = getDisplayWidth();
 
@@ -904,8 +1000,10 @@ void XojPageView::paintPageSync(cairo_t* cr, GdkRectangle* rect)
 
 	double width = cairo_image_surface_get_width(this->crBuffer);
 
-	bool rerender = true;
-	if (width / xournal->getDpiScaleFactor() == dispWidth)
+	bool rerender = !bufferMatchesZoom();
+
+	// While zooming only the scaled buffer is painted, the rerendering is done after the zoom sequence
+	if (xournal->getControl()->getZoomControl()->isZoomSequenceActive())
 	{
 		rerender = false;
 	}
@@ -916,13 +1014,12 @@ void XojPageView::paintPageSync(cairo_t* cr, GdkRectangle* rect)
 
 		// Scale current image to fit the zoom level
 		cairo_scale(cr, scale, scale);
-		cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_FAST);
-
 		cairo_set_source_surface(cr, this->crBuffer, 0, 0);
+		cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_FAST);
 
 		if (rerender)
 		{
-			rerenderPage();
+			rerenderPageUnchanged();
 		}
 
 		rect = nullptr;
@@ -976,6 +1073,8 @@ void XojPageView::paintPageSync(cairo_t* cr, GdkRectangle* rect)
 		cairo_restore(cr);
 	}
 
+	paintAudioHighlights(cr, zoom);
+
 	if (this->inputHandler)
 	{
 		int dpiScaleFactor = xournal->getDpiScaleFactor();
@@ -1014,15 +1113,90 @@ bool XojPageView::isSelected()
 	return selected;
 }
 
-int XojPageView::getBufferPixels()
+size_t XojPageView::getRenderMemoryBytes()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	size_t bytes = 0;
+
+	g_mutex_lock(&this->drawingMutex);
+	if (this->crBuffer)
+	{
+		bytes = (size_t) cairo_image_surface_get_stride(this->crBuffer) * cairo_image_surface_get_height(this->crBuffer);
+	}
+	g_mutex_unlock(&this->drawingMutex);
+
+	return bytes + this->layerCache.getBytes();
+}
+
+bool XojPageView::isRenderMemoryInUse()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	return this->lastVisibleTime == 0;
+}
+
+gint64 XojPageView::getRenderMemoryLastUse()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	return this->lastVisibleTime > 0 ? (gint64) this->lastVisibleTime * G_USEC_PER_SEC : 0;
+}
+
+double XojPageView::getRenderMemoryCost()
 {
 	XOJ_CHECK_TYPE(XojPageView);
 
-	if (crBuffer)
+	size_t elements = 0;
+	for (Layer* l : *this->page->getLayers())
 	{
-		return cairo_image_surface_get_width(crBuffer) * cairo_image_surface_get_height(crBuffer);
+		elements += l->getElements()->size();
 	}
-	return 0;
+
+	// A PDF background and many elements take longer to render than a blank page
+	return 1 + (this->page->getBackgroundType().isPdfPage() ? 1 : 0) + elements / 1000.0;
+}
+
+size_t XojPageView::freeRenderMemory()
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	size_t bytes = getRenderMemoryBytes();
+	deleteViewBuffer();
+
+	return bytes;
+}
+
+/**
+ * Marks the elements written just before the current audio playback position
+ */
+void XojPageView::paintAudioHighlights(cairo_t* cr, double zoom)
+{
+	XOJ_CHECK_TYPE(XojPageView);
+
+	vector<AudioHighlight>& highlights = xournal->getControl()->getAudioController()->getHighlights();
+	if (highlights.empty())
+	{
+		return;
+	}
+
+	cairo_save(cr);
+	cairo_scale(cr, zoom, zoom);
+
+	GtkColorWrapper color = getSelectionColor();
+	for (AudioHighlight& h : highlights)
+	{
+		if ((XojPage*) h.page != (XojPage*) this->page)
+		{
+			continue;
+		}
+
+		cairo_rectangle(cr, h.rect.x - 2, h.rect.y - 2, h.rect.width + 4, h.rect.height + 4);
+		color.applyWithAlpha(cr, 0.3);
+		cairo_fill(cr);
+	}
+
+	cairo_restore(cr);
 }
 
 GtkColorWrapper XojPageView::getSelectionColor()
@@ -14,10 +14,15 @@
 #include "Redrawable.h"
 #include "Layout.h"
 
+#include "control/RenderMemoryManager.h"
+
 #include "model/PageListener.h"
 #include "model/PageRef.h"
+#include "model/PageSnapshot.h"
 #include "model/TexImage.h"
 
+#include "view/LayerCache.h"
+
 #include <Range.h>
 
 #include "gui/inputdevices/PositionInputData.h"
@@ -33,7 +38,7 @@ class TextEditor;
 class VerticalToolHandler;
 class XournalView;
 
-class XojPageView : public Redrawable, public PageListener
+class XojPageView : public Redrawable, public PageListener, public RenderMemoryClient
 {
 public:
 	XojPageView(XournalView* xournal, PageRef page);
@@ -43,6 +48,28 @@ public:
 	void updatePageSize(double width, double height);
 
 	virtual void rerenderPage();
+
+	/**
+	 * Rerender the whole page, first with a low resolution, then with the full resolution.
+	 * Used after zooming, so the scaled buffer is replaced fast
+	 */
+	void rerenderPageProgressive();
+
+	/**
+	 * Render the page with a low priority, used for pages which are probably visible soon
+	 */
+	void prerenderPage();
+
+	/**
+	 * @return true if the buffer is rendered with the current zoom
+	 */
+	bool hasCurrentBuffer();
+
+	/**
+	 * @return The bytes of a buffer rendered with the current zoom
+	 */
+	size_t getBufferBytes();
+
 	virtual void rerenderRect(double x, double y, double width, double height);
 
 	virtual void repaintPage();
@@ -90,12 +117,11 @@ public:
 	
 
 	GtkColorWrapper getSelectionColor();
-	int getBufferPixels();
 
 	/**
 	 * 0 if currently visible
 	 * -1 if no image is saved (never visible or cleanup)
-	 * else the time in Seconds
+	 * else the monotonic time in Seconds
 	 */
 	int getLastVisibleTime();
 	TextEditor* getTextEditor();
@@ -170,6 +196,13 @@ public: // listener
 	void pageChanged();
 	void elementChanged(Element* elem);
 
+public: // RenderMemoryClient
+	size_t getRenderMemoryBytes();
+	bool isRenderMemoryInUse();
+	gint64 getRenderMemoryLastUse();
+	double getRenderMemoryCost();
+	size_t freeRenderMemory();
+
 private:
 	void handleScrollEvent(GdkEventButton* event);
 
@@ -178,6 +211,23 @@ private:
 	void addRerenderRect(double x, double y, double width, double height);
 
 	void drawLoadingPage(cairo_t* cr);
+
+	/**
+	 * Rerender the whole page, the contents are not changed, e.g. after zooming
+	 */
+	void rerenderPageUnchanged();
+
+	/**
+	 * @return true if the buffer has the resolution of the current zoom and the device scale.
+	 * The drawing mutex has to be locked.
+	 */
+	bool bufferMatchesZoom();
+	void paintAudioHighlights(cairo_t* cr, double zoom);
+
+	/**
+	 * The eraser is created on first use, most pages of large documents are never erased on
+	 */
+	EraseHandler* getEraser();
 	
 	void setX(int x);
 	void setY(int y);
@@ -193,7 +243,7 @@ private:
 	PageRef page;
 	XournalView* xournal;
 	Settings* settings;
-	EraseHandler* eraser;
+	EraseHandler* eraser = nullptr;
 	InputHandler* inputHandler = nullptr;
 
 	/**
@@ -215,6 +265,16 @@ private:
 
 	cairo_surface_t* crBuffer = nullptr;
 
+	/**
+	 * Copy of the page drawn by RenderJob, only used in the render thread
+	 */
+	PageSnapshot snapshot;
+
+	/**
+	 * The layers below the selected layer, drawn by RenderJob
+	 */
+	LayerCache layerCache;
+
 	bool inEraser = false;
 
 	/**
@@ -228,7 +288,7 @@ private:
 	SearchControl* search = nullptr;
 
 	/**
-	 * Unixtimestam when the page was last time in the visible area
+	 * Monotonic time in seconds when the page was last time in the visible area
 	 */
 	int lastVisibleTime = -1;
 
@@ -236,6 +296,16 @@ private:
 	vector<Rectangle*> rerenderRects;
 	bool rerenderComplete = false;
 
+	/**
+	 * The next complete rerender should first render a low resolution preview
+	 */
+	bool rerenderLowResolution = false;
+
+	/**
+	 * The page may be changed since the last snapshot, else the snapshot is drawn again
+	 */
+	bool contentsChanged = true;
+
 	GMutex drawingMutex;
 	
 	int dispX;	//position on display - set in Layout::layoutPages
@@ -175,13 +175,6 @@ protected:
 
 			if (!fn.empty())
 			{
-				if (fn.rfind(G_DIR_SEPARATOR, 0) != 0)
-				{
-					Path path = Path::fromUri(view->settings->getAudioFolder());
-					path /= fn;
-
-					fn = path.str();
-				}
 				view->getXournal()->getControl()->getAudioController()->startPlayback(fn, (unsigned int) ts);
 				return true;
 			}
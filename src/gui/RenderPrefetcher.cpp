@@ -0,0 +1,232 @@
+#include "RenderPrefetcher.h"
+
+#include "Layout.h"
+#include "PageView.h"
+#include "XournalView.h"
+
+#include "control/Control.h"
+#include "control/RenderMemoryManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+RenderPrefetcher::RenderPrefetcher(XournalView* view, Layout* layout)
+ : view(view),
+   layout(layout)
+{
+	XOJ_INIT_TYPE(RenderPrefetcher);
+}
+
+RenderPrefetcher::~RenderPrefetcher()
+{
+	XOJ_RELEASE_TYPE(RenderPrefetcher);
+}
+
+void RenderPrefetcher::update(const Rectangle& visible, const std::vector<int>& visiblePages)
+{
+	XOJ_CHECK_TYPE(RenderPrefetcher);
+
+	if (updateVelocity(visible.x, visible.y))
+	{
+		// The pages behind are not needed anymore
+		this->view->getControl()->getScheduler()->removePrerenderJobs();
+	}
+
+	if (this->view->getControl()->getSettings()->isPresentationMode())
+	{
+		keepNeighbours(visiblePages);
+		return;
+	}
+
+	if (!this->neighbours.empty())
+	{
+		keepNeighbours(std::vector<int>());
+	}
+
+	prefetchAhead(visible, visiblePages);
+}
+
+bool RenderPrefetcher::updateVelocity(double x, double y)
+{
+	XOJ_CHECK_TYPE(RenderPrefetcher);
+
+	gint64 now = g_get_monotonic_time();
+	double dx = x - this->lastX;
+	double dy = y - this->lastY;
+	double dt = (now - this->lastTime) / (double) G_USEC_PER_SEC;
+
+	this->lastX = x;
+	this->lastY = y;
+
+	// Called for layout changes, too
+	if (dx == 0 && dy == 0)
+	{
+		return false;
+	}
+
+	this->lastTime = now;
+
+	if (dt > PREFETCH_IDLE_SECONDS || dt <= 0)
+	{
+		this->velocityX = 0;
+		this->velocityY = 0;
+	}
+	else
+	{
+		// Scroll events come irregular, the average of the last events is more stable
+		this->velocityX = (this->velocityX + dx / dt) / 2;
+		this->velocityY = (this->velocityY + dy / dt) / 2;
+	}
+
+	bool horizontal = std::abs(dx) > std::abs(dy);
+	double delta = horizontal ? dx : dy;
+	int direction = delta > 0 ? 1 : -1;
+
+	bool reversed = this->direction != 0 && horizontal == this->horizontal && direction != this->direction;
+
+	this->direction = direction;
+	this->horizontal = horizontal;
+
+	return reversed;
+}
+
+void RenderPrefetcher::prefetchAhead(const Rectangle& visible, const std::vector<int>& visiblePages)
+{
+	XOJ_CHECK_TYPE(RenderPrefetcher);
+
+	if (this->direction == 0)
+	{
+		return;
+	}
+
+	// At least the next page, more the faster the movement is
+	double speed = std::abs(this->horizontal ? this->velocityX : this->velocityY);
+	double viewport = this->horizontal ? visible.width : visible.height;
+	double distance = std::max(viewport, speed * PREFETCH_LOOKAHEAD_SECONDS);
+
+	Rectangle ahead = visible;
+	if (this->horizontal)
+	{
+		ahead.x = this->direction > 0 ? visible.x + visible.width : visible.x - distance;
+		ahead.width = distance;
+	}
+	else
+	{
+		ahead.y = this->direction > 0 ? visible.y + visible.height : visible.y - distance;
+		ahead.height = distance;
+	}
+
+	this->layout->getPagesInRect(ahead, this->candidatePages);
+
+	// Nearest pages first
+	if (this->direction < 0)
+	{
+		std::reverse(this->candidatePages.begin(), this->candidatePages.end());
+	}
+
+	RenderMemoryManager& memory = RenderMemoryManager::getInstance();
+	size_t usage = 0;
+	size_t budget = 0;
+	bool budgetKnown = false;
+
+	int count = 0;
+	for (int pageIndex : this->candidatePages)
+	{
+		if (count >= PREFETCH_MAX_PAGES)
+		{
+			break;
+		}
+
+		if (std::find(visiblePages.begin(), visiblePages.end(), pageIndex) != visiblePages.end())
+		{
+			continue;
+		}
+
+		XojPageView* pageView = this->view->getViewFor(pageIndex);
+		if (pageView == NULL)
+		{
+			continue;
+		}
+
+		count++;
+
+		if (pageView->hasCurrentBuffer())
+		{
+			continue;
+		}
+
+		// Only asked if something needs to be rendered, the usage sums up all buffers
+		if (!budgetKnown)
+		{
+			usage = memory.getUsage();
+			budget = memory.getBudget();
+			budget = usage < budget ? (size_t) ((budget - usage) * PREFETCH_BUDGET_FACTOR) : 0;
+			budgetKnown = true;
+		}
+
+		size_t bytes = pageView->getBufferBytes();
+		if (bytes > budget)
+		{
+			break;
+		}
+		budget -= bytes;
+
+		pageView->prerenderPage();
+	}
+}
+
+void RenderPrefetcher::pageViewDeleted(XojPageView* pageView)
+{
+	XOJ_CHECK_TYPE(RenderPrefetcher);
+
+	this->neighbours.erase(std::remove(this->neighbours.begin(), this->neighbours.end(), pageView),
+						   this->neighbours.end());
+}
+
+void RenderPrefetcher::keepNeighbours(const std::vector<int>& visiblePages)
+{
+	XOJ_CHECK_TYPE(RenderPrefetcher);
+
+	std::vector<XojPageView*> visibleViews;
+	for (int pageIndex : visiblePages)
+	{
+		visibleViews.push_back(this->view->getViewFor(pageIndex));
+	}
+
+	std::vector<XojPageView*> neighbours;
+	for (int pageIndex : visiblePages)
+	{
+		for (int neighbour : { pageIndex - 1, pageIndex + 1 })
+		{
+			XojPageView* pageView = this->view->getViewFor(neighbour);
+			if (pageView != NULL &&
+				std::find(visibleViews.begin(), visibleViews.end(), pageView) == visibleViews.end() &&
+				std::find(neighbours.begin(), neighbours.end(), pageView) == neighbours.end())
+			{
+				neighbours.push_back(pageView);
+			}
+		}
+	}
+
+	for (XojPageView* pageView : this->neighbours)
+	{
+		if (std::find(neighbours.begin(), neighbours.end(), pageView) == neighbours.end() &&
+			std::find(visibleViews.begin(), visibleViews.end(), pageView) == visibleViews.end())
+		{
+			pageView->setIsVisible(false);
+		}
+	}
+
+	// Marked as visible, so the buffers are not freed and rendered again after zooming
+	for (XojPageView* pageView : neighbours)
+	{
+		pageView->setIsVisible(true);
+
+		if (!pageView->hasCurrentBuffer())
+		{
+			pageView->prerenderPage();
+		}
+	}
+
+	this->neighbours = neighbours;
+}
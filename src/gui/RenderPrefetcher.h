@@ -0,0 +1,122 @@
+/*
+ * Xournal++
+ *
+ * Renders the pages in the scroll direction before they get visible
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <XournalType.h>
+#include <Rectangle.h>
+
+#include <glib.h>
+
+#include <vector>
+
+class Layout;
+class XojPageView;
+class XournalView;
+
+/**
+ * How far ahead the pages are rendered, in seconds of the current scroll speed
+ */
+#define PREFETCH_LOOKAHEAD_SECONDS 1.0
+
+/**
+ * The maximum number of pages rendered ahead
+ */
+#define PREFETCH_MAX_PAGES 4
+
+/**
+ * The part of the free render memory budget which can be used for the pages ahead
+ */
+#define PREFETCH_BUDGET_FACTOR 0.5
+
+/**
+ * Scrolling after a longer pause starts a new movement
+ */
+#define PREFETCH_IDLE_SECONDS 0.5
+
+/**
+ * Tracks the speed and direction of scrolling and renders the next pages in
+ * this direction with a low priority, so they do not show up as "Loading..."
+ * while scrolling fast. Only the free part of the render memory budget is
+ * used. If the direction reverses, the pages not rendered yet are dropped.
+ *
+ * In presentation mode the previous and the next slide are always rendered
+ * and kept.
+ */
+class RenderPrefetcher
+{
+public:
+	RenderPrefetcher(XournalView* view, Layout* layout);
+	virtual ~RenderPrefetcher();
+
+public:
+	/**
+	 * Called after the visible pages were updated
+	 *
+	 * @param visible The visible area of the layout
+	 * @param visiblePages The indices of the visible pages
+	 */
+	void update(const Rectangle& visible, const std::vector<int>& visiblePages);
+
+	/**
+	 * The XojPageView is deleted, it is not kept as neighbour anymore
+	 */
+	void pageViewDeleted(XojPageView* pageView);
+
+private:
+	/**
+	 * Updates the smoothed scroll velocity
+	 *
+	 * @return true if the direction of the movement was reversed
+	 */
+	bool updateVelocity(double x, double y);
+
+	/**
+	 * Renders the pages in the area ahead of the visible area
+	 */
+	void prefetchAhead(const Rectangle& visible, const std::vector<int>& visiblePages);
+
+	/**
+	 * Keeps the slides before and after the visible slides rendered
+	 */
+	void keepNeighbours(const std::vector<int>& visiblePages);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	XournalView* view = NULL;
+	Layout* layout = NULL;
+
+	double lastX = 0;
+	double lastY = 0;
+	gint64 lastTime = 0;
+
+	/**
+	 * Smoothed scroll velocity in pixels per second
+	 */
+	double velocityX = 0;
+	double velocityY = 0;
+
+	/**
+	 * The direction of the last movement, -1 up / left, 1 down / right, 0 none,
+	 * on the axis which was scrolled the most
+	 */
+	int direction = 0;
+	bool horizontal = false;
+
+	/**
+	 * Slides kept visible in presentation mode, stored as views, the indices
+	 * change if pages are inserted or deleted
+	 */
+	std::vector<XojPageView*> neighbours;
+
+	std::vector<int> candidatePages;
+};
@@ -6,6 +6,8 @@
 #include "gui/scroll/ScrollHandling.h"
 #include "widgets/XournalWidget.h"
 
+#include <Tracer.h>
+
 RepaintHandler::RepaintHandler(XournalView* xournal)
  : xournal(xournal)
 {
@@ -16,6 +18,18 @@ RepaintHandler::~RepaintHandler()
 {
 	XOJ_CHECK_TYPE(RepaintHandler);
 
+	if (this->tickCallbackId)
+	{
+		gtk_widget_remove_tick_callback(this->xournal->getWidget(), this->tickCallbackId);
+		this->tickCallbackId = 0;
+	}
+
+	if (Tracer::isEnabled())
+	{
+		g_message("RepaintHandler: %" G_GUINT64_FORMAT " pixels requested, %" G_GUINT64_FORMAT " painted",
+		          getRequestedPixels(), getPaintedPixels());
+	}
+
 	this->xournal = NULL;
 
 	XOJ_RELEASE_TYPE(RepaintHandler);
@@ -36,7 +50,7 @@ void RepaintHandler::repaintPage(XojPageView* view)
 		int x2 = x1 + view->getDisplayWidth();
 		int y2 = y1 + view->getDisplayHeight();
 
-		gtk_xournal_repaint_area(this->xournal->getWidget(), x1, y1, x2, y2);
+		addDamage(x1, y1, x2, y2);
 	}
 }
 
@@ -44,7 +58,6 @@ void RepaintHandler::repaintPageArea(XojPageView* view, int x1, int y1, int x2,
 {
 	XOJ_CHECK_TYPE(RepaintHandler);
 
-
 	if (xournal->getScrollHandling()->fullRepaint())
 	{
 		gtk_widget_queue_draw(this->xournal->getWidget());
@@ -53,7 +66,7 @@ void RepaintHandler::repaintPageArea(XojPageView* view, int x1, int y1, int x2,
 	{
 		int x = view->getX();
 		int y = view->getY();
-		gtk_xournal_repaint_area(this->xournal->getWidget(), x + x1, y + y1, x + x2, y + y2);
+		addDamage(x + x1, y + y1, x + x2, y + y2);
 	}
 }
 
@@ -63,3 +76,69 @@ void RepaintHandler::repaintPageBorder(XojPageView* view)
 
 	gtk_widget_queue_draw(this->xournal->getWidget());
 }
+
+void RepaintHandler::addDamage(int x1, int y1, int x2, int y2)
+{
+	XOJ_CHECK_TYPE(RepaintHandler);
+
+	this->damage.add(x1, y1, x2, y2);
+
+	GtkWidget* widget = this->xournal->getWidget();
+	if (!gtk_widget_get_mapped(widget))
+	{
+		// No frames are drawn, nothing to collect for
+		flush();
+		return;
+	}
+
+	if (this->tickCallbackId == 0)
+	{
+		this->tickCallbackId = gtk_widget_add_tick_callback(widget, (GtkTickCallback) frameTick, this, NULL);
+	}
+}
+
+gboolean RepaintHandler::frameTick(GtkWidget* widget, GdkFrameClock* clock, RepaintHandler* handler)
+{
+	XOJ_CHECK_TYPE_OBJ(handler, RepaintHandler);
+
+	handler->tickCallbackId = 0;
+	handler->flush();
+
+	return G_SOURCE_REMOVE;
+}
+
+void RepaintHandler::flush()
+{
+	XOJ_CHECK_TYPE(RepaintHandler);
+
+	TRACE_ZONE("RepaintHandler::flush");
+
+	std::vector<DamageRect> rects;
+	this->damage.flush(rects);
+
+	for (DamageRect& r : rects)
+	{
+		gtk_xournal_repaint_area(this->xournal->getWidget(), r.x1, r.y1, r.x2, r.y2);
+	}
+}
+
+guint64 RepaintHandler::getRequestedPixels()
+{
+	XOJ_CHECK_TYPE(RepaintHandler);
+
+	return this->damage.getRequestedPixels();
+}
+
+guint64 RepaintHandler::getPaintedPixels()
+{
+	XOJ_CHECK_TYPE(RepaintHandler);
+
+	return this->damage.getPaintedPixels();
+}
+
+void RepaintHandler::resetStatistics()
+{
+	XOJ_CHECK_TYPE(RepaintHandler);
+
+	this->damage.resetStatistics();
+}
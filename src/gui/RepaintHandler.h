@@ -11,11 +11,19 @@
 
 #pragma once
 
+#include <DamageRegion.h>
 #include <XournalType.h>
 
+#include <gtk/gtk.h>
+
 class XojPageView;
 class XournalView;
 
+/**
+ * Repaint requests are collected and sent to GTK once per frame, in the
+ * update phase of the frame clock. Input handlers request a repaint on
+ * every motion event, often several for the same area within one frame.
+ */
 class RepaintHandler
 {
 public:
@@ -38,8 +46,40 @@ public:
 	 */
 	void repaintPageBorder(XojPageView* view);
 
+	/**
+	 * @return The pixels requested to be repainted since the last reset
+	 */
+	guint64 getRequestedPixels();
+
+	/**
+	 * @return The pixels actually queued for painting since the last reset
+	 */
+	guint64 getPaintedPixels();
+
+	void resetStatistics();
+
+private:
+	/**
+	 * Adds an area in widget coordinates, without the scroll offset
+	 */
+	void addDamage(int x1, int y1, int x2, int y2);
+
+	/**
+	 * Queues the collected areas for painting
+	 */
+	void flush();
+
+	static gboolean frameTick(GtkWidget* widget, GdkFrameClock* clock, RepaintHandler* handler);
+
 private:
 	XOJ_TYPE_ATTRIB;
 
 	XournalView* xournal;
+
+	DamageRegion damage;
+
+	/**
+	 * Tick callback flushing the damage, 0 if none is pending
+	 */
+	guint tickCallbackId = 0;
 };
@@ -21,6 +21,7 @@
 
 #include <gdk/gdk.h>
 
+#include <algorithm>
 #include <cmath>
 #include <tuple>
 
@@ -61,16 +62,12 @@ XournalView::XournalView(GtkWidget* parent, Control* control, ScrollHandling* sc
 	gtk_widget_grab_default(this->widget);
 
 	gtk_widget_grab_focus(this->widget);
-
-	this->cleanupTimeout = g_timeout_add_seconds(5, (GSourceFunc) clearMemoryTimer, this);
 }
 
 XournalView::~XournalView()
 {
 	XOJ_CHECK_TYPE(XournalView);
 
-	g_source_remove(this->cleanupTimeout);
-
 	for (size_t i = 0; i < this->viewPagesLen; i++)
 	{
 		delete this->viewPages[i];
@@ -94,11 +91,6 @@ XournalView::~XournalView()
 	XOJ_RELEASE_TYPE(XournalView);
 }
 
-gint pageViewCmpSize(XojPageView* a, XojPageView* b)
-{
-	return a->getLastVisibleTime() - b->getLastVisibleTime();
-}
-
 void XournalView::staticLayoutPages(GtkWidget* widget, GtkAllocation* allocation, void* data)
 {
 	XournalView* xv = (XournalView*) data;
@@ -106,54 +98,6 @@ void XournalView::staticLayoutPages(GtkWidget* widget, GtkAllocation* allocation
 	xv->layoutPages();
 }
 
-gboolean XournalView::clearMemoryTimer(XournalView* widget)
-{
-	XOJ_CHECK_TYPE_OBJ(widget, XournalView);
-
-	GList* list = nullptr;
-
-	for (size_t i = 0; i < widget->viewPagesLen; i++)
-	{
-		XojPageView* v = widget->viewPages[i];
-		if (v->getLastVisibleTime() > 0)
-		{
-			list = g_list_insert_sorted(list, v, (GCompareFunc) pageViewCmpSize);
-		}
-	}
-
-	int pixel = 2884560;
-	int firstPages = 4;
-
-	int i = 0;
-
-	for (GList* l = list; l != nullptr; l = l->next)
-	{
-		if (firstPages)
-		{
-			firstPages--;
-		}
-		else
-		{
-			XojPageView* v = (XojPageView*) l->data;
-
-			if (pixel <= 0)
-			{
-				v->deleteViewBuffer();
-			}
-			else
-			{
-				pixel -= v->getBufferPixels();
-			}
-		}
-		i++;
-	}
-
-	g_list_free(list);
-
-	// call again
-	return true;
-}
-
 size_t XournalView::getCurrentPage()
 {
 	XOJ_CHECK_TYPE(XournalView);
@@ -723,7 +667,33 @@ void XournalView::zoomChanged()
 	// Updates the Eraser's cursor icon in order to make it as big as the erasing area
 	control->getCursor()->updateCursor();
 
-	this->control->getScheduler()->blockRerenderZoom();
+	if (zoom->isZoomSequenceActive())
+	{
+		// While zooming the existing buffers are scaled, the pages are rendered when the sequence is finished
+		this->control->getScheduler()->blockRerenderZoom();
+	}
+	else
+	{
+		zoomSequenceFinished();
+	}
+}
+
+void XournalView::zoomSequenceFinished()
+{
+	XOJ_CHECK_TYPE(XournalView);
+
+	this->control->getScheduler()->unblockRerenderZoom();
+
+	// Only the visible pages are rendered now, first with a low resolution, then with the full resolution.
+	// The other pages keep their scaled buffer until they get visible again
+	for (size_t i = 0; i < this->viewPagesLen; i++)
+	{
+		XojPageView* v = this->viewPages[i];
+		if (v->getLastVisibleTime() == 0)
+		{
+			v->rerenderPageProgressive();
+		}
+	}
 }
 
 void XournalView::pageSizeChanged(size_t page)
@@ -732,6 +702,12 @@ void XournalView::pageSizeChanged(size_t page)
 	layoutPages();
 }
 
+void XournalView::pageSizesChanged(const std::vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(XournalView);
+	layoutPages();
+}
+
 void XournalView::pageChanged(size_t page)
 {
 	XOJ_CHECK_TYPE(XournalView);
@@ -748,12 +724,10 @@ void XournalView::pageDeleted(size_t page)
 
 	size_t currentPage = control->getCurrentPageNo();
 
+	gtk_xournal_get_layout(this->widget)->pageViewDeleted(this->viewPages[page]);
 	delete this->viewPages[page];
 
-	for (size_t i = page; i < this->viewPagesLen - 1; i++)
-	{
-		this->viewPages[i] = this->viewPages[i + 1];
-	}
+	std::copy(this->viewPages + page + 1, this->viewPages + this->viewPagesLen, this->viewPages + page);
 
 	this->viewPagesLen--;
 	this->viewPages[this->viewPagesLen] = nullptr;
@@ -805,27 +779,19 @@ void XournalView::pageInserted(size_t page)
 {
 	XOJ_CHECK_TYPE(XournalView);
 
-	XojPageView** lastViewPages = this->viewPages;
-
-	this->viewPages = new XojPageView*[this->viewPagesLen + 1];
-
-	for (size_t i = 0; i < page; i++)
+	// unselect to prevent problems...
+	if (this->lastSelectedPage != size_t_npos && this->lastSelectedPage < this->viewPagesLen)
 	{
-		this->viewPages[i] = lastViewPages[i];
-
-		// unselect to prevent problems...
-		this->viewPages[i]->setSelected(false);
+		this->viewPages[this->lastSelectedPage]->setSelected(false);
 	}
+	this->lastSelectedPage = -1;
 
-	for (size_t i = page; i < this->viewPagesLen; i++)
-	{
-		this->viewPages[i + 1] = lastViewPages[i];
+	XojPageView** lastViewPages = this->viewPages;
 
-		// unselect to prevent problems...
-		this->viewPages[i + 1]->setSelected(false);
-	}
+	this->viewPages = new XojPageView*[this->viewPagesLen + 1];
 
-	this->lastSelectedPage = -1;
+	std::copy(lastViewPages, lastViewPages + page, this->viewPages);
+	std::copy(lastViewPages + page, lastViewPages + this->viewPagesLen, this->viewPages + page + 1);
 
 	this->viewPagesLen++;
 
@@ -1018,8 +984,10 @@ void XournalView::documentChanged(DocumentChangeType type)
 
 	clearSelection();
 
+	Layout* layout = gtk_xournal_get_layout(this->widget);
 	for (size_t i = 0; i < this->viewPagesLen; i++)
 	{
+		layout->pageViewDeleted(this->viewPages[i]);
 		delete this->viewPages[i];
 	}
 	delete[] this->viewPages;
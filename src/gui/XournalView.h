@@ -133,11 +133,13 @@ public:
 public:
 	// ZoomListener interface
 	void zoomChanged();
+	void zoomSequenceFinished();
 
 public:
 	// DocumentListener interface
 	void pageSelected(size_t page);
 	void pageSizeChanged(size_t page);
+	void pageSizesChanged(const std::vector<size_t>& pages);
 	void pageChanged(size_t page);
 	void pageInserted(size_t page);
 	void pageDeleted(size_t page);
@@ -156,8 +158,6 @@ private:
 
 	Rectangle* getVisibleRect(size_t page);
 
-	static gboolean clearMemoryTimer(XournalView* widget);
-
 	static void staticLayoutPages(GtkWidget *widget, GtkAllocation* allocation, void* data);
 
 private:
@@ -188,11 +188,6 @@ private:
 	 */
 	RepaintHandler* repaintHandler = NULL;
 
-	/**
-	 * Memory cleanup timeout
-	 */
-	int cleanupTimeout = -1;
-
 	/**
 	 * Helper class for Touch specific fixes
 	 */
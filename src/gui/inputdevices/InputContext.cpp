@@ -5,6 +5,7 @@
 #include "InputContext.h"
 #include "InputEvents.h"
 
+#include <Tracer.h>
 #include <util/DeviceListHelper.h>
 
 InputContext::InputContext(XournalView* view, ScrollHandling* scrollHandling)
@@ -89,6 +90,8 @@ bool InputContext::handle(GdkEvent* sourceEvent)
 {
 	XOJ_CHECK_TYPE(InputContext);
 
+	TRACE_ZONE_CATEGORY("InputContext::handle", "input");
+
 	printDebug(sourceEvent);
 
 	InputEvent* event = InputEvents::translateEvent(sourceEvent, this->getSettings());
@@ -49,6 +49,7 @@ SidebarIndexPage::SidebarIndexPage(Control* control, SidebarToolbar* toolbar)
 	g_object_set(G_OBJECT(renderer), "style", PANGO_STYLE_ITALIC, NULL);
 
 	g_signal_connect(treeViewBookmarks, "cursor-changed", G_CALLBACK(treeBookmarkSelected), this);
+	g_signal_connect(treeViewBookmarks, "map", G_CALLBACK(treeMapped), this);
 
 	gtk_widget_show(this->treeViewBookmarks);
 
@@ -65,6 +66,12 @@ SidebarIndexPage::~SidebarIndexPage()
 		this->searchTimeout = 0;
 	}
 
+	if (this->loadContentsId)
+	{
+		g_source_remove(this->loadContentsId);
+		this->loadContentsId = 0;
+	}
+
 	g_object_unref(this->treeViewBookmarks);
 	g_object_unref(this->scrollBookmarks);
 
@@ -297,6 +304,56 @@ GtkWidget* SidebarIndexPage::getWidget()
 	return this->scrollBookmarks;
 }
 
+void SidebarIndexPage::treeMapped(GtkWidget* treeview, SidebarIndexPage* sidebar)
+{
+	XOJ_CHECK_TYPE_OBJ(sidebar, SidebarIndexPage);
+
+	sidebar->scheduleLoadContents();
+}
+
+void SidebarIndexPage::scheduleLoadContents()
+{
+	XOJ_CHECK_TYPE(SidebarIndexPage);
+
+	if (this->contentsLoaded || this->loadContentsId)
+	{
+		return;
+	}
+
+	// Idle priority, the pages are drawn first
+	this->loadContentsId = g_idle_add((GSourceFunc) loadContentsCallback, this);
+}
+
+bool SidebarIndexPage::loadContentsCallback(SidebarIndexPage* sidebar)
+{
+	XOJ_CHECK_TYPE_OBJ(sidebar, SidebarIndexPage);
+
+	sidebar->loadContentsId = 0;
+	sidebar->loadContents();
+
+	return false;
+}
+
+void SidebarIndexPage::loadContents()
+{
+	XOJ_CHECK_TYPE(SidebarIndexPage);
+
+	if (this->contentsLoaded)
+	{
+		return;
+	}
+
+	Document* doc = this->control->getDocument();
+
+	doc->lock();
+	GtkTreeModel* model = doc->getContentsModel();
+	gtk_tree_view_set_model(GTK_TREE_VIEW(this->treeViewBookmarks), model);
+	expandOpenLinks(model, NULL);
+	doc->unlock();
+
+	this->contentsLoaded = true;
+}
+
 int SidebarIndexPage::expandOpenLinks(GtkTreeModel* model, GtkTreeIter* parent)
 {
 	XOJ_CHECK_TYPE(SidebarIndexPage);
@@ -339,6 +396,11 @@ void SidebarIndexPage::selectPageNr(size_t page, size_t pdfPage)
 {
 	XOJ_CHECK_TYPE(SidebarIndexPage);
 
+	if (!this->contentsLoaded)
+	{
+		return;
+	}
+
 	selectPageNr(page, pdfPage, NULL);
 }
 
@@ -438,15 +500,18 @@ void SidebarIndexPage::documentChanged(DocumentChangeType type)
 	}
 	else if (type == DOCUMENT_CHANGE_PDF_BOOKMARKS || type == DOCUMENT_CHANGE_COMPLETE)
 	{
+		gtk_tree_view_set_model(GTK_TREE_VIEW(this->treeViewBookmarks), NULL);
+		this->contentsLoaded = false;
 
+		// Reading the whole outline is delayed until the index is shown
 		Document* doc = this->control->getDocument();
-
 		doc->lock();
-		GtkTreeModel* model = doc->getContentsModel();
-		gtk_tree_view_set_model(GTK_TREE_VIEW(this->treeViewBookmarks), model);
-		int count = expandOpenLinks(model, NULL);
+		this->hasContents = doc->hasContents();
 		doc->unlock();
 
-		hasContents = (count != 0);
+		if (gtk_widget_get_mapped(this->treeViewBookmarks))
+		{
+			scheduleLoadContents();
+		}
 	}
 }
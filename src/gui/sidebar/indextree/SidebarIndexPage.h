@@ -70,6 +70,12 @@ private:
 	static gboolean treeSearchFunction(GtkTreeModel* model, gint column, const gchar* key,
 									   GtkTreeIter* iter, SidebarIndexPage* sidebar);
 
+	/**
+	 * The tree is shown, the contents are loaded if not done yet
+	 */
+	static void treeMapped(GtkWidget* treeview, SidebarIndexPage* sidebar);
+	static bool loadContentsCallback(SidebarIndexPage* sidebar);
+
 	/**
 	 * A bookmark was selected
 	 */
@@ -91,6 +97,12 @@ private:
 	 */
 	int expandOpenLinks(GtkTreeModel* model, GtkTreeIter* parent);
 
+	/**
+	 * Builds the contents model of the document and shows it in the tree
+	 */
+	void scheduleLoadContents();
+	void loadContents();
+
 private:
 	XOJ_TYPE_ATTRIB;
 
@@ -116,4 +128,14 @@ private:
 	 */
 	bool hasContents = false;
 
+	/**
+	 * If the tree shows the contents of the current document
+	 */
+	bool contentsLoaded = false;
+
+	/**
+	 * The idle callback to load the contents
+	 */
+	int loadContentsId = 0;
+
 };
@@ -32,12 +32,15 @@ SidebarPreviewBaseEntry::SidebarPreviewBaseEntry(SidebarPreviewBase* sidebar, Pa
 			self->mouseButtonPressCallback();
 			return true;
 		}), this);
+
+	RenderMemoryManager::getInstance().addClient(this);
 }
 
 SidebarPreviewBaseEntry::~SidebarPreviewBaseEntry()
 {
 	XOJ_CHECK_TYPE(SidebarPreviewBaseEntry);
 
+	RenderMemoryManager::getInstance().removeClient(this);
 	this->sidebar->getControl()->getScheduler()->removeSidebar(this);
 	this->page = NULL;
 
@@ -122,6 +125,8 @@ void SidebarPreviewBaseEntry::paint(cairo_t* cr)
 
 	g_mutex_lock(&this->drawingMutex);
 
+	this->lastPaintTime = g_get_monotonic_time();
+
 	if (this->crBuffer == NULL)
 	{
 		drawLoadingPage();
@@ -166,6 +171,55 @@ void SidebarPreviewBaseEntry::paint(cairo_t* cr)
 	}
 }
 
+size_t SidebarPreviewBaseEntry::getRenderMemoryBytes()
+{
+	XOJ_CHECK_TYPE(SidebarPreviewBaseEntry);
+
+	size_t bytes = 0;
+
+	g_mutex_lock(&this->drawingMutex);
+	if (this->crBuffer)
+	{
+		bytes = (size_t) cairo_image_surface_get_stride(this->crBuffer) * cairo_image_surface_get_height(this->crBuffer);
+	}
+	g_mutex_unlock(&this->drawingMutex);
+
+	return bytes;
+}
+
+bool SidebarPreviewBaseEntry::isRenderMemoryInUse()
+{
+	XOJ_CHECK_TYPE(SidebarPreviewBaseEntry);
+
+	// Painted again when scrolled into view
+	return false;
+}
+
+gint64 SidebarPreviewBaseEntry::getRenderMemoryLastUse()
+{
+	XOJ_CHECK_TYPE(SidebarPreviewBaseEntry);
+
+	return this->lastPaintTime;
+}
+
+size_t SidebarPreviewBaseEntry::freeRenderMemory()
+{
+	XOJ_CHECK_TYPE(SidebarPreviewBaseEntry);
+
+	size_t bytes = 0;
+
+	g_mutex_lock(&this->drawingMutex);
+	if (this->crBuffer)
+	{
+		bytes = (size_t) cairo_image_surface_get_stride(this->crBuffer) * cairo_image_surface_get_height(this->crBuffer);
+		cairo_surface_destroy(this->crBuffer);
+		this->crBuffer = NULL;
+	}
+	g_mutex_unlock(&this->drawingMutex);
+
+	return bytes;
+}
+
 void SidebarPreviewBaseEntry::updateSize()
 {
 	XOJ_CHECK_TYPE(SidebarPreviewBaseEntry);
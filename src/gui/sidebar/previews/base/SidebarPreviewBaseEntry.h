@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "control/RenderMemoryManager.h"
 #include "model/PageRef.h"
 
 #include <Util.h>
@@ -33,7 +34,7 @@ typedef enum {
 } PreviewRenderType;
 
 
-class SidebarPreviewBaseEntry
+class SidebarPreviewBaseEntry : public RenderMemoryClient
 {
 public:
 	SidebarPreviewBaseEntry(SidebarPreviewBase* sidebar, PageRef page);
@@ -54,6 +55,12 @@ public:
 	 */
 	virtual PreviewRenderType getRenderType() = 0;
 
+public: // RenderMemoryClient
+	size_t getRenderMemoryBytes();
+	bool isRenderMemoryInUse();
+	gint64 getRenderMemoryLastUse();
+	size_t freeRenderMemory();
+
 private:
 	static gboolean drawCallback(GtkWidget* widget, cairo_t* cr, SidebarPreviewBaseEntry* preview);
 
@@ -100,5 +107,10 @@ protected:
 	 */
 	cairo_surface_t* crBuffer = NULL;
 
+	/**
+	 * Monotonic time of the last paint
+	 */
+	gint64 lastPaintTime = 0;
+
 	friend class PreviewJob;
 };
@@ -124,3 +124,14 @@ void SidebarPreviewLayerEntry::setVisibleCheckbox(bool enabled)
 	inUpdate = false;
 }
 
+
+size_t SidebarPreviewLayerEntry::freeRenderMemory()
+{
+	XOJ_CHECK_TYPE(SidebarPreviewLayerEntry);
+
+	g_mutex_lock(&this->drawingMutex);
+	this->revision = -1;
+	g_mutex_unlock(&this->drawingMutex);
+
+	return SidebarPreviewBaseEntry::freeRenderMemory();
+}
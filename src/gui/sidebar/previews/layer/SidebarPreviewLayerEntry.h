@@ -43,6 +43,11 @@ public:
 	 */
 	void setVisibleCheckbox(bool enabled);
 
+	/**
+	 * @override
+	 */
+	virtual size_t freeRenderMemory();
+
 protected:
 	virtual void mouseButtonPressCallback();
 	void checkboxToggled();
@@ -80,5 +85,15 @@ private:
 	 */
 	bool inUpdate = false;
 
+	/**
+	 * The revision of the layer in the buffer, -1 if the buffer does not show the layer
+	 */
+	int revision = -1;
+
+	/**
+	 * The zoom of the buffer
+	 */
+	double revisionZoom = 0;
+
 	friend class PreviewJob;
 };
@@ -13,6 +13,7 @@
 
 #include "control/layer/LayerCtrlListener.h"
 #include "gui/sidebar/previews/base/SidebarPreviewBase.h"
+#include "model/PageSnapshot.h"
 
 #include <XournalType.h>
 
@@ -75,4 +76,12 @@ private:
 	 * Layer Controller
 	 */
 	LayerController* lc;
+
+	/**
+	 * Copy of the current page, shared by the previews of all layers.
+	 * Only used by PreviewJob in the render thread
+	 */
+	PageSnapshot snapshot;
+
+	friend class PreviewJob;
 };
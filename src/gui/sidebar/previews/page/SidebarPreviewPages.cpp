@@ -231,6 +231,24 @@ void SidebarPreviewPages::pageSizeChanged(size_t page)
 	layout();
 }
 
+void SidebarPreviewPages::pageSizesChanged(const std::vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(SidebarPreviewPages);
+
+	for (size_t page : pages)
+	{
+		if (page == size_t_npos || page >= this->previews.size())
+		{
+			continue;
+		}
+		SidebarPreviewBaseEntry* p = this->previews[page];
+		p->updateSize();
+		p->repaint();
+	}
+
+	layout();
+}
+
 void SidebarPreviewPages::pageChanged(size_t page)
 {
 	XOJ_CHECK_TYPE(SidebarPreviewPages);
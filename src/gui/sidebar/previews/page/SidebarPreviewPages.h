@@ -54,6 +54,7 @@ public:
 public:
 	// DocumentListener interface (only the part which is not handled by SidebarPreviewBase)
 	virtual void pageSizeChanged(size_t page);
+	virtual void pageSizesChanged(const std::vector<size_t>& pages);
 	virtual void pageChanged(size_t page);
 	virtual void pageSelected(size_t page);
 	virtual void pageInserted(size_t page);
@@ -61,14 +61,16 @@ bool ToolZoomSlider::sliderHoverScroll(GtkWidget* range,  GdkEventScroll* event,
 {
 	XOJ_CHECK_TYPE_OBJ(self, ToolZoomSlider);
 
-	gint64 now = g_get_monotonic_time();
-	if (now > self->sliderHoverScrollLastTime + 500)
+	if (!self->zoom->isZoomSequenceActive())
 	{
 		self->zoom->setZoomFitMode(false);
 		self->zoom->startZoomSequence(-1, -1);
 	}
+
+	// Scrolling has no end event, the sequence ends if there are no more scroll events
+	self->zoom->endZoomSequenceDelayed();
+
 	self->sliderChangingBySliderHoverScroll = true;
-	self->sliderHoverScrollLastTime = now;
 	return false;
 }
 
@@ -61,7 +61,6 @@ private:
 	bool sliderChangingByZoomControlOrInit = false;
 	bool sliderChangingBySliderDrag = false;
 	bool sliderChangingBySliderHoverScroll = false;
-	gint64 sliderHoverScrollLastTime = 0;
 
 	GtkWidget* slider = NULL;
 	ZoomControl* zoom = NULL;
@@ -298,8 +298,6 @@ static gboolean gtk_xournal_draw(GtkWidget* widget, cairo_t* cr)
 
 	GtkXournal* xournal = GTK_XOURNAL(widget);
 
-	ArrayIterator<XojPageView*> it = xournal->view->pageViewIterator();
-
 	double x1, x2, y1, y2;
 
 	cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
@@ -314,9 +312,13 @@ static gboolean gtk_xournal_draw(GtkWidget* widget, cairo_t* cr)
 
 	Rectangle clippingRect(x1 - 10, y1 - 10, x2 - x1 + 20, y2 - y1 + 20);
 
-	while (it.hasNext())
+	// Only the pages near the clipping area are visited
+	std::vector<int> pages;
+	xournal->layout->getPagesInRect(clippingRect, pages);
+
+	for (int pageIndex : pages)
 	{
-		XojPageView* pv = it.next();
+		XojPageView* pv = xournal->view->getViewFor(pageIndex);
 
 		int px = pv->getX();
 		int py = pv->getY();
@@ -0,0 +1,201 @@
+#include "AudioTimeline.h"
+
+#include "AudioElement.h"
+#include "Layer.h"
+
+#include <algorithm>
+
+static bool compareTimestamp(const AudioTimelineEntry& a, const AudioTimelineEntry& b)
+{
+	return a.timestamp < b.timestamp;
+}
+
+AudioTimeline::AudioTimeline()
+{
+	XOJ_INIT_TYPE(AudioTimeline);
+}
+
+AudioTimeline::~AudioTimeline()
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	XOJ_RELEASE_TYPE(AudioTimeline);
+}
+
+void AudioTimeline::pagesChanged()
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	this->valid = false;
+}
+
+void AudioTimeline::update(vector<PageRef>& pages)
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	guint generation = Layer::getLastElementGeneration();
+	if (this->valid && this->generation == generation)
+	{
+		return;
+	}
+
+	bool changed = !this->valid;
+
+	std::unordered_map<XojPage*, PageEntries> updated;
+	for (PageRef& p : pages)
+	{
+		XojPage* page = p;
+
+		auto it = this->pageEntries.find(page);
+		if (it != this->pageEntries.end() && isUpToDate(it->second, page))
+		{
+			updated[page] = std::move(it->second);
+			this->pageEntries.erase(it);
+			continue;
+		}
+
+		bool hadEntries = it != this->pageEntries.end() && !it->second.entries.empty();
+
+		PageEntries& entries = updated[page];
+		scanPage(page, entries);
+
+		changed = changed || hadEntries || !entries.entries.empty();
+	}
+
+	// Removed pages
+	for (auto& it : this->pageEntries)
+	{
+		changed = changed || !it.second.entries.empty();
+	}
+
+	this->pageEntries.swap(updated);
+	this->generation = generation;
+	this->valid = true;
+
+	if (changed)
+	{
+		rebuild(pages);
+	}
+}
+
+bool AudioTimeline::isUpToDate(PageEntries& cached, XojPage* page)
+{
+	vector<Layer*>* layers = page->getLayers();
+	if (layers->size() != cached.layers.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < layers->size(); i++)
+	{
+		Layer* l = (*layers)[i];
+		if (cached.layers[i].first != l || cached.layers[i].second != l->getElementGeneration())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void AudioTimeline::scanPage(XojPage* page, PageEntries& result)
+{
+	result.layers.clear();
+	result.entries.clear();
+
+	for (Layer* l : *page->getLayers())
+	{
+		result.layers.push_back(std::make_pair(l, l->getElementGeneration()));
+
+		for (Element* e : *l->getElements())
+		{
+			if (e->getType() != ELEMENT_STROKE && e->getType() != ELEMENT_TEXT)
+			{
+				continue;
+			}
+
+			AudioElement* a = (AudioElement*) e;
+			if (a->getAudioFilename().empty())
+			{
+				continue;
+			}
+
+			AudioTimelineEntry entry = { a->getTimestamp(), a, page };
+			result.entries.push_back(entry);
+		}
+	}
+}
+
+void AudioTimeline::rebuild(vector<PageRef>& pages)
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	this->recordings.clear();
+
+	// In page order, so elements with the same timestamp keep the document order
+	for (PageRef& p : pages)
+	{
+		for (AudioTimelineEntry& e : this->pageEntries[p].entries)
+		{
+			this->recordings[e.element->getAudioFilename()].push_back(e);
+		}
+	}
+
+	for (auto& it : this->recordings)
+	{
+		std::stable_sort(it.second.begin(), it.second.end(), compareTimestamp);
+	}
+}
+
+const AudioTimelineEntry* AudioTimeline::findAt(const string& filename, size_t timestamp)
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	auto it = this->recordings.find(filename);
+	if (it == this->recordings.end())
+	{
+		return NULL;
+	}
+
+	vector<AudioTimelineEntry>& entries = it->second;
+	AudioTimelineEntry key = { timestamp, NULL, NULL };
+	auto pos = std::upper_bound(entries.begin(), entries.end(), key, compareTimestamp);
+	if (pos == entries.begin())
+	{
+		return NULL;
+	}
+
+	return &*(pos - 1);
+}
+
+void AudioTimeline::findInRange(const string& filename, size_t from, size_t to, vector<AudioTimelineEntry>& result)
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	auto it = this->recordings.find(filename);
+	if (it == this->recordings.end() || from >= to)
+	{
+		return;
+	}
+
+	vector<AudioTimelineEntry>& entries = it->second;
+	AudioTimelineEntry key = { from, NULL, NULL };
+	for (auto pos = std::lower_bound(entries.begin(), entries.end(), key, compareTimestamp);
+		 pos != entries.end() && pos->timestamp < to; pos++)
+	{
+		result.push_back(*pos);
+	}
+}
+
+size_t AudioTimeline::getEntryCount()
+{
+	XOJ_CHECK_TYPE(AudioTimeline);
+
+	size_t count = 0;
+	for (auto& it : this->recordings)
+	{
+		count += it.second.size();
+	}
+
+	return count;
+}
@@ -0,0 +1,105 @@
+/*
+ * Xournal++
+ *
+ * Index of the audio elements of a document, sorted by recording and timestamp
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "PageRef.h"
+
+#include <XournalType.h>
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using std::vector;
+
+class AudioElement;
+class Layer;
+
+/**
+ * One element which was written while recording
+ */
+struct AudioTimelineEntry
+{
+	size_t timestamp;
+	AudioElement* element;
+	XojPage* page;
+};
+
+/**
+ * Maps a time of a recording to the elements written at this time.
+ *
+ * The index is checked against the layer generations before it is used, only
+ * pages with added or removed elements are scanned again. The timestamp and
+ * the filename of an element are expected to be set before the element is
+ * added to a layer.
+ */
+class AudioTimeline
+{
+public:
+	AudioTimeline();
+	virtual ~AudioTimeline();
+
+public:
+	/**
+	 * Pages were inserted, removed or replaced
+	 */
+	void pagesChanged();
+
+	/**
+	 * Brings the index up to date with the pages of the document
+	 */
+	void update(vector<PageRef>& pages);
+
+	/**
+	 * @return The element written last at or before the timestamp, NULL if there is none.
+	 *         Valid until the next update.
+	 */
+	const AudioTimelineEntry* findAt(const string& filename, size_t timestamp);
+
+	/**
+	 * Appends the elements written from the timestamp from (inclusive) to to (exclusive)
+	 */
+	void findInRange(const string& filename, size_t from, size_t to, vector<AudioTimelineEntry>& result);
+
+	/**
+	 * @return The number of indexed elements of all recordings
+	 */
+	size_t getEntryCount();
+
+private:
+	/**
+	 * The cached entries of one page
+	 */
+	struct PageEntries
+	{
+		vector<std::pair<Layer*, guint>> layers;
+		vector<AudioTimelineEntry> entries;
+	};
+
+	static bool isUpToDate(PageEntries& cached, XojPage* page);
+	static void scanPage(XojPage* page, PageEntries& result);
+
+	void rebuild(vector<PageRef>& pages);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	bool valid = false;
+	guint generation = 0;
+
+	std::unordered_map<XojPage*, PageEntries> pageEntries;
+
+	/**
+	 * The entries of each recording, sorted by timestamp
+	 */
+	std::map<string, vector<AudioTimelineEntry>> recordings;
+};
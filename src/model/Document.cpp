@@ -8,8 +8,11 @@
 #include <config.h>
 #include <i18n.h>
 #include <Stacktrace.h>
+#include <Tracer.h>
 #include <Util.h>
 
+#include <algorithm>
+
 Document::Document(DocumentHandler* handler)
  : handler(handler)
 {
@@ -61,7 +64,18 @@ void Document::lock()
 {
 	XOJ_CHECK_TYPE(Document);
 
+	if (!Tracer::isEnabled())
+	{
+		g_mutex_lock(&this->documentLock);
+		this->lockTime = 0;
+		return;
+	}
+
+	gint64 start = g_get_monotonic_time();
 	g_mutex_lock(&this->documentLock);
+	this->lockTime = g_get_monotonic_time();
+
+	Tracer::addZone("Document::lock wait", "lock", start, this->lockTime - start);
 
 	//	if(tryLock()) {
 	//		fprintf(stderr, "Locked by\n");
@@ -75,8 +89,15 @@ void Document::lock()
 void Document::unlock()
 {
 	XOJ_CHECK_TYPE(Document);
+
+	gint64 lockTime = this->lockTime;
 	g_mutex_unlock(&this->documentLock);
 
+	if (lockTime != 0)
+	{
+		Tracer::addZone("Document::lock held", "lock", lockTime, g_get_monotonic_time() - lockTime);
+	}
+
 	//	fprintf(stderr, "Unlocked by\n");
 	//	Stacktrace::printStracktrace();
 	//	fprintf(stderr, "\n\n\n\n");
@@ -86,7 +107,13 @@ bool Document::tryLock()
 {
 	XOJ_CHECK_TYPE(Document);
 
-	return g_mutex_trylock(&this->documentLock);
+	if (!g_mutex_trylock(&this->documentLock))
+	{
+		return false;
+	}
+
+	this->lockTime = Tracer::isEnabled() ? g_get_monotonic_time() : 0;
+	return true;
 }
 
 void Document::clearDocument(bool destroy)
@@ -111,8 +138,9 @@ void Document::clearDocument(bool destroy)
 		}
 	}
 
-	this->pages.clear();
+	clearPages();
 	freeTreeContentModel();
+	this->contentsModelBuilt = true;
 
 	this->filename = "";
 	this->pdfFilename = "";
@@ -259,18 +287,75 @@ size_t Document::findPdfPage(size_t pdfPage)
 {
 	XOJ_CHECK_TYPE(Document);
 
-	for (size_t i = 0; i < getPageCount(); i++)
+	if (!this->pdfPageIndexValid || this->pdfPageIndexGeneration != this->backgroundGeneration)
+	{
+		buildPdfPageIndex();
+	}
+
+	if (pdfPage >= this->pdfPageIndex.size())
+	{
+		return size_t_npos;
+	}
+	return this->pdfPageIndex[pdfPage];
+}
+
+void Document::buildPdfPageIndex()
+{
+	XOJ_CHECK_TYPE(Document);
+
+	this->pdfPageIndex.assign(this->pdfDocument.getPageCount(), size_t_npos);
+
+	for (size_t i = 0; i < this->pages.size(); i++)
 	{
 		PageRef p = this->pages[i];
-		if (p->getBackgroundType().isPdfPage())
+		if (!p->getBackgroundType().isPdfPage())
 		{
-			if (p->getPdfPageNr() == pdfPage)
-			{
-				return i;
-			}
+			continue;
+		}
+
+		size_t pdfPage = p->getPdfPageNr();
+		if (pdfPage >= this->pdfPageIndex.size())
+		{
+			this->pdfPageIndex.resize(pdfPage + 1, size_t_npos);
+		}
+		if (this->pdfPageIndex[pdfPage] == size_t_npos)
+		{
+			this->pdfPageIndex[pdfPage] = i;
+		}
+	}
+
+	this->pdfPageIndexValid = true;
+	this->pdfPageIndexGeneration = this->backgroundGeneration;
+}
+
+void Document::clearPages()
+{
+	XOJ_CHECK_TYPE(Document);
+
+	for (PageRef p : this->pages)
+	{
+		// A page may already be in another document, e.g. after the assignment of a loaded document
+		if (p->getBackgroundGeneration() == &this->backgroundGeneration)
+		{
+			p->setBackgroundGeneration(NULL);
 		}
 	}
-	return -1;
+
+	this->pages.clear();
+	invalidatePageIndex(0);
+}
+
+void Document::invalidatePageIndex(size_t position)
+{
+	XOJ_CHECK_TYPE(Document);
+
+	if (position == 0)
+	{
+		this->pageIndex.clear();
+	}
+	this->pageIndexValid = std::min(this->pageIndexValid, position);
+	this->pdfPageIndexValid = false;
+	this->audioTimeline.pagesChanged();
 }
 
 void Document::buildTreeContentsModel(GtkTreeIter* parent, XojPdfBookmarkIterator* iter)
@@ -320,6 +405,7 @@ void Document::buildContentsModel()
 	XOJ_CHECK_TYPE(Document);
 
 	freeTreeContentModel();
+	this->contentsModelBuilt = true;
 
 	XojPdfBookmarkIterator* iter = pdfDocument.getContentsIter();
 	if (iter == NULL)
@@ -331,12 +417,46 @@ void Document::buildContentsModel()
 	this->contentsModel = (GtkTreeModel*) gtk_tree_store_new(4, G_TYPE_STRING, G_TYPE_OBJECT, G_TYPE_BOOLEAN, G_TYPE_STRING);
 	buildTreeContentsModel(NULL, iter);
 	delete iter;
+
+	updateIndexPageNumbers();
+}
+
+void Document::invalidateContentsModel()
+{
+	XOJ_CHECK_TYPE(Document);
+
+	freeTreeContentModel();
+	this->contentsModelBuilt = false;
+}
+
+bool Document::hasContents()
+{
+	XOJ_CHECK_TYPE(Document);
+
+	if (this->contentsModelBuilt)
+	{
+		return this->contentsModel != NULL;
+	}
+
+	XojPdfBookmarkIterator* iter = pdfDocument.getContentsIter();
+	if (iter == NULL)
+	{
+		return false;
+	}
+
+	delete iter;
+	return true;
 }
 
 GtkTreeModel* Document::getContentsModel()
 {
 	XOJ_CHECK_TYPE(Document);
 
+	if (!this->contentsModelBuilt)
+	{
+		buildContentsModel();
+	}
+
 	return this->contentsModel;
 }
 
@@ -374,7 +494,7 @@ void Document::updateIndexPageNumbers()
 	}
 }
 
-bool Document::readPdf(Path filename, bool initPages, bool attachToDocument, gpointer data, gsize length)
+bool Document::readPdf(Path filename, bool initPages, bool attachToDocument, Path file)
 {
 	XOJ_CHECK_TYPE(Document);
 
@@ -382,52 +502,55 @@ bool Document::readPdf(Path filename, bool initPages, bool attachToDocument, gpo
 
 	lock();
 
-	if (data != nullptr)
+	if (!pdfDocument.load(file.isEmpty() ? filename : file, password, &popplerError))
 	{
-		if (!pdfDocument.load(data, length, password, &popplerError))
-		{
-			lastError = FS(_F("Document not loaded! ({1}), {2}") % filename.str() % popplerError->message);
-			g_error_free(popplerError);
-			unlock();
-
-			return false;
-		}
-	} else
-	{
-		if (!pdfDocument.load(filename.c_str(), password, &popplerError))
-		{
-			lastError = FS(_F("Document not loaded! ({1}), {2}") % filename.str() % popplerError->message);
-			g_error_free(popplerError);
-			unlock();
+		lastError = FS(_F("Document not loaded! ({1}), {2}") % filename.str() % popplerError->message);
+		g_error_free(popplerError);
+		unlock();
 
-			return false;
-		}
+		return false;
 	}
 
-
 	this->pdfFilename = filename;
 	this->attachPdf = attachToDocument;
 
 	lastError = "";
 
-	if (initPages)
-	{
-		this->pages.clear();
-	}
+	// Existing pages keep their size
+	this->pdfPageSizesRead = pdfDocument.getPageCount();
 
 	if (initPages)
 	{
-		for (size_t i = 0; i < pdfDocument.getPageCount(); i++)
+		clearPages();
+
+		// Reading the size of each page parses the whole page tree, which takes seconds for
+		// large documents. Only the first pages are read now, the others get the size of the
+		// last page read until PdfPageSizeJob reads them in the background.
+		size_t count = pdfDocument.getPageCount();
+		this->pdfPageSizesRead = std::min(count, (size_t) DOCUMENT_PDF_INITIAL_PAGE_SIZES);
+
+		double width = 0;
+		double height = 0;
+		for (size_t i = 0; i < count; i++)
 		{
-			XojPdfPageSPtr page = pdfDocument.getPage(i);
-			PageRef p = new XojPage(page->getWidth(), page->getHeight());
+			if (i < this->pdfPageSizesRead)
+			{
+				XojPdfPageSPtr page = pdfDocument.getPage(i);
+				width = page->getWidth();
+				height = page->getHeight();
+			}
+
+			PageRef p = new XojPage(width, height);
 			p->setBackgroundPdfPageNr(i);
 			addPage(p);
 		}
+
+		this->pdfUnreadPageWidth = width;
+		this->pdfUnreadPageHeight = height;
 	}
 
-	buildContentsModel();
-	updateIndexPageNumbers();
+	// The outline is read when the index is shown
+	invalidateContentsModel();
 
 	unlock();
 
@@ -443,6 +566,68 @@ void Document::setPageSize(PageRef p, double width, double height)
 	p->setSize(width, height);
 }
 
+size_t Document::getPdfPageSizesRead()
+{
+	XOJ_CHECK_TYPE(Document);
+
+	return this->pdfPageSizesRead;
+}
+
+void Document::setPdfPageSizes(size_t firstPage, const std::vector<double>& sizes, std::vector<size_t>& changed)
+{
+	XOJ_CHECK_TYPE(Document);
+
+	size_t count = firstPage + sizes.size() / 2;
+
+	// Skips the pages already read, e.g. synchronously before saving
+	for (size_t pdfPage = std::max(firstPage, this->pdfPageSizesRead); pdfPage < count; pdfPage++)
+	{
+		double width = sizes[2 * (pdfPage - firstPage)];
+		double height = sizes[2 * (pdfPage - firstPage) + 1];
+		if (width == this->pdfUnreadPageWidth && height == this->pdfUnreadPageHeight)
+		{
+			continue;
+		}
+
+		size_t pageNr = findPdfPage(pdfPage);
+		if (pageNr == size_t_npos)
+		{
+			continue;
+		}
+
+		// Not resized by the user in the meantime
+		PageRef p = getPage(pageNr);
+		if (p->getWidth() == this->pdfUnreadPageWidth && p->getHeight() == this->pdfUnreadPageHeight)
+		{
+			setPageSize(p, width, height);
+			changed.push_back(pageNr);
+		}
+	}
+
+	this->pdfPageSizesRead = std::max(this->pdfPageSizesRead, count);
+}
+
+void Document::readPdfPageSizes(std::vector<size_t>& changed)
+{
+	XOJ_CHECK_TYPE(Document);
+
+	size_t count = pdfDocument.getPageCount();
+	if (this->pdfPageSizesRead >= count)
+	{
+		return;
+	}
+
+	std::vector<double> sizes;
+	for (size_t i = this->pdfPageSizesRead; i < count; i++)
+	{
+		XojPdfPageSPtr page = pdfDocument.getPage(i);
+		sizes.push_back(page->getWidth());
+		sizes.push_back(page->getHeight());
+	}
+
+	setPdfPageSizes(this->pdfPageSizesRead, sizes, changed);
+}
+
 double Document::getPageWidth(PageRef p)
 {
 	return p->getWidth();
@@ -468,7 +653,17 @@ void Document::deletePage(size_t pNr)
 	XOJ_CHECK_TYPE(Document);
 
 	vector<PageRef>::iterator it = this->pages.begin() + pNr;
+	auto entry = this->pageIndex.find((XojPage*) *it);
+	if (entry != this->pageIndex.end() && entry->second == pNr)
+	{
+		this->pageIndex.erase(entry);
+	}
+	if ((*it)->getBackgroundGeneration() == &this->backgroundGeneration)
+	{
+		(*it)->setBackgroundGeneration(NULL);
+	}
 	this->pages.erase(it);
+	invalidatePageIndex(pNr);
 
 	updateIndexPageNumbers();
 }
@@ -478,6 +673,8 @@ void Document::insertPage(PageRef p, size_t position)
 	XOJ_CHECK_TYPE(Document);
 
 	this->pages.insert(this->pages.begin() + position, p);
+	p->setBackgroundGeneration(&this->backgroundGeneration);
+	invalidatePageIndex(position);
 
 	updateIndexPageNumbers();
 }
@@ -487,20 +684,63 @@ void Document::addPage(PageRef p)
 	XOJ_CHECK_TYPE(Document);
 
 	this->pages.push_back(p);
+	p->setBackgroundGeneration(&this->backgroundGeneration);
+	this->audioTimeline.pagesChanged();
+
+	// Appending does not move other pages, only the new page may be the first of its PDF page
+	if (this->pdfPageIndexValid && p->getBackgroundType().isPdfPage())
+	{
+		size_t pdfPage = p->getPdfPageNr();
+		if (pdfPage >= this->pdfPageIndex.size())
+		{
+			this->pdfPageIndex.resize(pdfPage + 1, size_t_npos);
+		}
+		if (this->pdfPageIndex[pdfPage] == size_t_npos)
+		{
+			this->pdfPageIndex[pdfPage] = this->pages.size() - 1;
+		}
+	}
 
 	updateIndexPageNumbers();
 }
 
+AudioTimeline* Document::getAudioTimeline()
+{
+	XOJ_CHECK_TYPE(Document);
+
+	this->audioTimeline.update(this->pages);
+	return &this->audioTimeline;
+}
+
 size_t Document::indexOf(PageRef page)
 {
 	XOJ_CHECK_TYPE(Document);
 
-	for (size_t i = 0; i < this->pages.size(); i++)
+	XojPage* p = (XojPage*) page;
+
+	// Entries of moved pages may be outdated, so they are checked against the page list
+	auto it = this->pageIndex.find(p);
+	if (it != this->pageIndex.end() && it->second < this->pageIndexValid && (XojPage*) this->pages[it->second] == p)
+	{
+		return it->second;
+	}
+
+	// Extend the valid part of the index up to the requested page
+	while (this->pageIndexValid < this->pages.size())
 	{
-		PageRef pg = this->pages[i];
-		if (pg == page)
+		size_t i = this->pageIndexValid++;
+		XojPage* pg = (XojPage*) this->pages[i];
+
+		// A page contained twice keeps its first position
+		auto entry = this->pageIndex.find(pg);
+		if (entry == this->pageIndex.end() || entry->second >= i || (XojPage*) this->pages[entry->second] != pg)
 		{
-			return i;
+			this->pageIndex[pg] = i;
+		}
+
+		if (pg == p)
+		{
+			return this->pageIndex[pg];
 		}
 	}
 
@@ -545,6 +785,9 @@ void Document::operator=(Document& doc)
 
 	// Copy PDF Document
 	this->pdfDocument = doc.pdfDocument;
+	this->pdfPageSizesRead = doc.pdfPageSizesRead;
+	this->pdfUnreadPageWidth = doc.pdfUnreadPageWidth;
+	this->pdfUnreadPageHeight = doc.pdfUnreadPageHeight;
 
 	this->password = doc.password;
 	this->createBackupOnSave = doc.createBackupOnSave;
@@ -557,8 +800,7 @@ void Document::operator=(Document& doc)
 		addPage(p);
 	}
 
-	buildContentsModel();
-	updateIndexPageNumbers();
+	invalidateContentsModel();
 
 	bool lastLock = tryLock();
 	unlock();
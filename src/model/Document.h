@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "AudioTimeline.h"
 #include "DocumentHandler.h"
 #include "LinkDestination.h"
 #include "PageRef.h"
@@ -24,6 +25,14 @@
 #include <Path.h>
 #include <XournalType.h>
 
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The number of PDF pages whose size is read while the PDF is opened
+ */
+#define DOCUMENT_PDF_INITIAL_PAGE_SIZES 20
+
 class Document
 {
 public:
@@ -38,13 +47,38 @@ public:
 		PDF
 	};
 
-	bool readPdf(Path filename, bool initPages, bool attachToDocument, gpointer data = nullptr, gsize length = 0);
+	/**
+	 * @param file The file the PDF is read from if it is not filename, e.g. an attachment extracted to a temporary file
+	 */
+	bool readPdf(Path filename, bool initPages, bool attachToDocument, Path file = Path());
 
 	size_t getPageCount();
 	size_t getPdfPageCount();
 	XojPdfPageSPtr getPdfPage(size_t page);
 	XojPdfDocument& getPdfDocument();
 
+	/**
+	 * @return The number of pages created by readPdf with the size of their PDF page,
+	 * the later pages got the size of the last page read
+	 */
+	size_t getPdfPageSizesRead();
+
+	/**
+	 * Sets the sizes of the PDF pages from firstPage on, which were read after readPdf. Only the
+	 * pages which still have the size they got from readPdf are resized.
+	 *
+	 * @param sizes Width and height of each PDF page
+	 * @param changed The numbers of the resized pages are added
+	 */
+	void setPdfPageSizes(size_t firstPage, const std::vector<double>& sizes, std::vector<size_t>& changed);
+
+	/**
+	 * Reads the sizes of all PDF pages which were not read yet, e.g. before the document is saved
+	 *
+	 * @param changed The numbers of the resized pages are added
+	 */
+	void readPdfPageSizes(std::vector<size_t>& changed);
+
 	void insertPage(PageRef p, size_t position);
 	void addPage(PageRef p);
 	PageRef getPage(size_t page);
@@ -64,6 +98,11 @@ public:
 	bool isPdfDocumentLoaded();
 	size_t findPdfPage(size_t pdfPage);
 
+	/**
+	 * @return The index of the elements written while recording, updated before it is returned
+	 */
+	AudioTimeline* getAudioTimeline();
+
 	void operator=(Document& doc);
 
 	void setFilename(Path filename);
@@ -74,8 +113,16 @@ public:
 
 	Path getEvMetadataFilename();
 
+	/**
+	 * The contents model is built on the first call, which reads the whole outline of the PDF
+	 */
 	GtkTreeModel* getContentsModel();
 
+	/**
+	 * @return If the PDF has an outline, without building the contents model
+	 */
+	bool hasContents();
+
 	void setCreateBackupOnSave(bool backup);
 	bool shouldCreateBackupOnSave();
 
@@ -92,11 +139,23 @@ public:
 
 private:
 	void buildContentsModel();
+	void invalidateContentsModel();
 	void freeTreeContentModel();
 	static bool freeTreeContentEntry(GtkTreeModel* treeModel, GtkTreePath* path, GtkTreeIter* iter, Document* doc);
 
 	void buildTreeContentsModel(GtkTreeIter* parent, XojPdfBookmarkIterator* iter);
 	void updateIndexPageNumbers();
+
+	/**
+	 * The pages from position on have been moved or removed
+	 */
+	void invalidatePageIndex(size_t position);
+	void buildPdfPageIndex();
+
+	/**
+	 * Removes all pages, they don't count the background changes of this document anymore
+	 */
+	void clearPages();
 	static bool fillPageLabels(GtkTreeModel* tree_model, GtkTreePath* path, GtkTreeIter* iter, Document* doc);
 
 private:
@@ -106,6 +165,13 @@ private:
 	DocumentHandler* handler = NULL;
 
 	XojPdfDocument pdfDocument;
+	size_t pdfPageSizesRead = 0;
+
+	/**
+	 * The size readPdf gave the pages whose size was not read
+	 */
+	double pdfUnreadPageWidth = 0;
+	double pdfUnreadPageHeight = 0;
 
 	Path filename;
 	Path pdfFilename;
@@ -123,11 +189,38 @@ private:
 	 */
 	vector<PageRef> pages;
 
+	/**
+	 * Position of each page, the positions below pageIndexValid are indexed,
+	 * the index is extended on lookup
+	 */
+	std::unordered_map<XojPage*, size_t> pageIndex;
+	size_t pageIndexValid = 0;
+
+	/**
+	 * The first document page of each PDF page, rebuilt if the pages
+	 * or any page background of this document changed
+	 */
+	vector<size_t> pdfPageIndex;
+	bool pdfPageIndexValid = false;
+	guint pdfPageIndexGeneration = 0;
+
+	/**
+	 * Counts the background changes of the pages of this document
+	 */
+	guint backgroundGeneration = 0;
+
+	AudioTimeline audioTimeline;
+
 	/**
 	 * The bookmark contents model
 	 */
 	GtkTreeModel* contentsModel = NULL;
 
+	/**
+	 * If the contents model is up to date, else it is built on the next access
+	 */
+	bool contentsModelBuilt = false;
+
 	/**
 	 *  create a backup before save, because the original file was an older fileversion
 	 */
@@ -142,4 +235,9 @@ private:
 	 * The lock of the document
 	 */
 	GMutex documentLock;
+
+	/**
+	 * Time the lock was taken, to trace how long it is held. 0 if tracing was disabled.
+	 */
+	gint64 lockTime = 0;
 };
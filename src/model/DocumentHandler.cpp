@@ -50,6 +50,16 @@ void DocumentHandler::firePageSizeChanged(size_t page)
 	}
 }
 
+void DocumentHandler::firePageSizesChanged(const std::vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(DocumentHandler);
+
+	for (DocumentListener* dl : this->listener)
+	{
+		dl->pageSizesChanged(pages);
+	}
+}
+
 void DocumentHandler::firePageChanged(size_t page)
 {
 	XOJ_CHECK_TYPE(DocumentHandler);
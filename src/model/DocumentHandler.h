@@ -17,6 +17,7 @@
 #include <XournalType.h>
 
 #include <list>
+#include <vector>
 
 class DocumentListener;
 
@@ -29,6 +30,7 @@ public:
 public:
 	void fireDocumentChanged(DocumentChangeType type);
 	void firePageSizeChanged(size_t page);
+	void firePageSizesChanged(const std::vector<size_t>& pages);
 	void firePageChanged(size_t page);
 	void firePageInserted(size_t page);
 	void firePageDeleted(size_t page);
@@ -44,6 +44,16 @@ void DocumentListener::pageSizeChanged(size_t page)
 	XOJ_CHECK_TYPE(DocumentListener);
 }
 
+void DocumentListener::pageSizesChanged(const std::vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(DocumentListener);
+
+	for (size_t page : pages)
+	{
+		pageSizeChanged(page);
+	}
+}
+
 void DocumentListener::pageChanged(size_t page)
 {
 	XOJ_CHECK_TYPE(DocumentListener);
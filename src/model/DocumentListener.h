@@ -14,6 +14,8 @@
 #include "DocumentChangeType.h"
 #include <XournalType.h>
 
+#include <vector>
+
 class DocumentHandler;
 
 class DocumentListener
@@ -28,6 +30,12 @@ public:
 
 	virtual void documentChanged(DocumentChangeType type);
 	virtual void pageSizeChanged(size_t page);
+
+	/**
+	 * Several pages were resized at once, calls pageSizeChanged for each page by default
+	 */
+	virtual void pageSizesChanged(const std::vector<size_t>& pages);
+
 	virtual void pageChanged(size_t page);
 	virtual void pageInserted(size_t page);
 	virtual void pageDeleted(size_t page);
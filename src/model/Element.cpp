@@ -170,6 +170,13 @@ bool Element::rescaleOnlyAspectRatio()
 	return false;
 }
 
+bool Element::isUnchangedClone(Element* clone)
+{
+	XOJ_CHECK_TYPE(Element);
+
+	return false;
+}
+
 void Element::serializeElement(ObjectOutputStream& out)
 {
 	XOJ_CHECK_TYPE(Element);
@@ -73,6 +73,12 @@ public:
 	 */
 	virtual Element* clone() = 0;
 
+	/**
+	 * @return true if clone was created by clone() and this element was not
+	 *         changed since, so the clone can be used instead of a new one
+	 */
+	virtual bool isUnchangedClone(Element* clone);
+
 private:
 	XOJ_TYPE_ATTRIB;
 
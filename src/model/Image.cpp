@@ -43,6 +43,23 @@ Element* Image::clone()
 	return img;
 }
 
+bool Image::isUnchangedClone(Element* clone)
+{
+	XOJ_CHECK_TYPE(Image);
+
+	if (clone->getType() != ELEMENT_IMAGE)
+	{
+		return false;
+	}
+
+	Image* img = (Image*) clone;
+
+	// A clone decodes the shared data itself, the surface is only shared if it was set directly
+	return this->data == img->data && (this->image == NULL || this->image == img->image) &&
+		   this->x == img->x && this->y == img->y && this->width == img->width && this->height == img->height &&
+		   getColor() == img->getColor();
+}
+
 void Image::setWidth(double width)
 {
 	XOJ_CHECK_TYPE(Image);
@@ -63,12 +80,12 @@ cairo_status_t Image::cairoReadFunction(Image* image, unsigned char* data, unsig
 
 	for (unsigned int i = 0; i < length; i++, image->read++)
 	{
-		if (image->read >= image->data.length())
+		if (image->read >= image->data->length())
 		{
 			return CAIRO_STATUS_READ_ERROR;
 		}
 
-		data[i] = image->data[image->read];
+		data[i] = (*image->data)[image->read];
 	}
 
 	return CAIRO_STATUS_SUCCESS;
@@ -83,7 +100,7 @@ void Image::setImage(string data)
 		cairo_surface_destroy(this->image);
 		this->image = NULL;
 	}
-	this->data = data;
+	this->data = std::make_shared<const string>(std::move(data));
 }
 
 void Image::setImage(GdkPixbuf* img)
@@ -108,7 +125,7 @@ cairo_surface_t* Image::getImage()
 {
 	XOJ_CHECK_TYPE(Image);
 
-	if (this->image == NULL && this->data.length())
+	if (this->image == NULL && this->data && this->data->length())
 	{
 		this->read = 0;
 		this->image = cairo_image_surface_create_from_png_stream((cairo_read_func_t) &cairoReadFunction, this);
@@ -14,6 +14,8 @@
 #include "Element.h"
 #include <XournalType.h>
 
+#include <memory>
+
 class Image : public Element
 {
 public:
@@ -36,6 +38,7 @@ public:
 	 * @overwrite
 	 */
 	virtual Element* clone();
+	virtual bool isUnchangedClone(Element* clone);
 
 public:
 	// Serialize interface
@@ -52,7 +55,10 @@ private:
 
 	cairo_surface_t* image = NULL;
 
-	string data;
+	/**
+	 * The PNG data, shared with clones
+	 */
+	std::shared_ptr<const string> data;
 
 	string::size_type read = false;
 };
@@ -2,6 +2,8 @@
 
 #include <Stacktrace.h>
 
+std::atomic<guint> Layer::lastElementGeneration(0);
+
 Layer::Layer()
 {
 	XOJ_INIT_TYPE(Layer);
@@ -26,9 +28,16 @@ Layer* Layer::clone()
 
 	Layer* layer = new Layer();
 
+	// The clones are new, so the duplicate check of addElement is not needed
+	layer->elements.reserve(this->elements.size());
 	for (Element* e : this->elements)
 	{
-		layer->addElement(e->clone());
+		layer->elements.push_back(e->clone());
+	}
+
+	if (!layer->elements.empty())
+	{
+		layer->elementsChanged();
 	}
 
 	return layer;
@@ -55,6 +64,7 @@ void Layer::addElement(Element* e)
 	}
 
 	this->elements.push_back(e);
+	elementsChanged();
 }
 
 void Layer::insertElement(Element* e, int pos)
@@ -94,6 +104,7 @@ void Layer::insertElement(Element* e, int pos)
 	{
 		this->elements.insert(this->elements.begin() + pos, e);
 	}
+	elementsChanged();
 }
 
 int Layer::indexOf(Element* e)
@@ -120,7 +131,8 @@ int Layer::removeElement(Element* e, bool free)
 		if (e == this->elements[i])
 		{
 			this->elements.erase(this->elements.begin() + i);
-			
+			elementsChanged();
+
 			if (free)
 			{
 				delete e;
@@ -167,3 +179,22 @@ vector<Element*>* Layer::getElements()
 
 	return &this->elements;
 }
+
+guint Layer::getElementGeneration()
+{
+	XOJ_CHECK_TYPE(Layer);
+
+	return this->elementGeneration;
+}
+
+guint Layer::getLastElementGeneration()
+{
+	return lastElementGeneration.load();
+}
+
+void Layer::elementsChanged()
+{
+	XOJ_CHECK_TYPE(Layer);
+
+	this->elementGeneration = ++lastElementGeneration;
+}
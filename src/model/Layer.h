@@ -14,6 +14,8 @@
 #include "Element.h"
 #include <XournalType.h>
 
+#include <atomic>
+
 class Layer
 {
 public:
@@ -70,10 +72,31 @@ public:
 	 */
 	Layer* clone();
 
+	/**
+	 * Changes whenever an element is added or removed. The value is unique over
+	 * all layers, so a layer can be identified by its pointer and generation.
+	 *
+	 * A new layer has generation 0 until it gets elements, so creating layers,
+	 * e.g. for page snapshots, does not count as a change. All layers with
+	 * generation 0 are empty, so they can not be mistaken for each other.
+	 */
+	guint getElementGeneration();
+
+	/**
+	 * The generation of the last change of any layer
+	 */
+	static guint getLastElementGeneration();
+
+private:
+	void elementsChanged();
+
 private:
 	XOJ_TYPE_ATTRIB;
 
 	vector<Element*> elements;
 
+	guint elementGeneration = 0;
+	static std::atomic<guint> lastElementGeneration;
+
 	bool visible = true;
 };
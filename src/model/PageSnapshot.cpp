@@ -0,0 +1,214 @@
+#include "PageSnapshot.h"
+
+#include "BackgroundImage.h"
+#include "Layer.h"
+#include "Stroke.h"
+#include "Text.h"
+#include "eraser/EraseableStroke.h"
+
+#include <Tracer.h>
+
+PageSnapshot::PageSnapshot()
+{
+	XOJ_INIT_TYPE(PageSnapshot);
+}
+
+PageSnapshot::~PageSnapshot()
+{
+	XOJ_CHECK_TYPE(PageSnapshot);
+
+	this->page = NULL;
+	this->clones.clear();
+
+	XOJ_RELEASE_TYPE(PageSnapshot);
+}
+
+PageRef PageSnapshot::update(PageRef page, bool allLayers, bool changed)
+{
+	XOJ_CHECK_TYPE(PageSnapshot);
+
+	TRACE_ZONE("PageSnapshot::update");
+
+	// Only the layers are compared, so the document lock is held only shortly while zooming or scrolling
+	if (!changed && isCopyReusable(page, allLayers))
+	{
+		this->page->setSelectedLayerId(page->getSelectedLayerId());
+		return this->page;
+	}
+
+	std::unordered_map<Element*, Element*> previous;
+	previous.swap(this->clones);
+
+	std::vector<Element*> previousParts;
+	previousParts.swap(this->erasedParts);
+
+	XojPage* copy = page->cloneWithoutLayers();
+	copy->setLayerVisible(0, page->isLayerVisible(0));
+
+	std::vector<int> previousRevisions;
+	previousRevisions.swap(this->revisions);
+
+	this->revisions.push_back(isBackgroundUnchanged(copy) ? previousRevisions[0] : ++this->revision);
+
+	vector<Layer*>* previousLayers = this->page.isValid() ? this->page->getLayers() : NULL;
+
+	for (Layer* l : *page->getLayers())
+	{
+		Layer* layer = new Layer();
+		layer->setVisible(l->isVisible());
+		copy->addLayer(layer);
+
+		if (allLayers || l->isVisible())
+		{
+			copyElements(l, layer, previous);
+		}
+
+		// Reused clones have the same address, all other clones are new
+		size_t index = copy->getLayerCount() - 1;
+		if (previousLayers != NULL && index < previousLayers->size() &&
+			(*previousLayers)[index]->isVisible() == layer->isVisible() &&
+			*(*previousLayers)[index]->getElements() == *layer->getElements())
+		{
+			this->revisions.push_back(previousRevisions[index + 1]);
+		}
+		else
+		{
+			this->revisions.push_back(++this->revision);
+		}
+	}
+
+	copy->setSelectedLayerId(page->getSelectedLayerId());
+
+	// The clones which were taken over are removed from the old page before it is deleted
+	if (this->page.isValid())
+	{
+		for (Layer* l : *this->page->getLayers())
+		{
+			l->getElements()->clear();
+		}
+	}
+	for (auto& it : previous)
+	{
+		delete it.second;
+	}
+	for (Element* e : previousParts)
+	{
+		delete e;
+	}
+
+	this->page = copy;
+	this->source = page;
+	this->sourceAllLayers = allLayers;
+
+	return this->page;
+}
+
+bool PageSnapshot::isCopyReusable(PageRef page, bool allLayers)
+{
+	XOJ_CHECK_TYPE(PageSnapshot);
+
+	if (!this->page.isValid() || this->source != (XojPage*) page || this->sourceAllLayers != allLayers ||
+		!this->erasedParts.empty())
+	{
+		return false;
+	}
+
+	if (!isBackgroundUnchanged(page))
+	{
+		return false;
+	}
+
+	vector<Layer*>* layers = page->getLayers();
+	vector<Layer*>* copyLayers = this->page->getLayers();
+	if (layers->size() != copyLayers->size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < layers->size(); i++)
+	{
+		if ((*layers)[i]->isVisible() != (*copyLayers)[i]->isVisible())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PageSnapshot::copyElements(Layer* source, Layer* layer, std::unordered_map<Element*, Element*>& previous)
+{
+	XOJ_CHECK_TYPE(PageSnapshot);
+
+	// The clones are new, so the duplicate check of addElement is not needed
+	vector<Element*>* elements = layer->getElements();
+	elements->reserve(source->getElements()->size());
+
+	for (Element* e : *source->getElements())
+	{
+		// The eraseable of a stroke which is erased right now belongs to the page, the
+		// snapshot gets the remaining parts as new strokes instead
+		if (e->getType() == ELEMENT_STROKE && ((Stroke*) e)->getEraseable() != NULL)
+		{
+			GList* parts = ((Stroke*) e)->getEraseable()->getStroke((Stroke*) e);
+			for (GList* l = parts; l != NULL; l = l->next)
+			{
+				elements->push_back((Element*) l->data);
+				this->erasedParts.push_back((Element*) l->data);
+			}
+			g_list_free(parts);
+			continue;
+		}
+
+		Element* clone = NULL;
+
+		auto it = previous.find(e);
+		if (it != previous.end() && e->isUnchangedClone(it->second))
+		{
+			clone = it->second;
+			previous.erase(it);
+		}
+		else
+		{
+			clone = e->clone();
+
+			// Only the snapshot keeps the editing state, a copied text is not edited
+			if (e->getType() == ELEMENT_TEXT)
+			{
+				((Text*) clone)->setInEditing(((Text*) e)->isInEditing());
+			}
+		}
+
+		elements->push_back(clone);
+		this->clones[e] = clone;
+	}
+}
+
+bool PageSnapshot::isBackgroundUnchanged(XojPage* copy)
+{
+	XOJ_CHECK_TYPE(PageSnapshot);
+
+	if (!this->page.isValid())
+	{
+		return false;
+	}
+
+	return this->page->getWidth() == copy->getWidth() && this->page->getHeight() == copy->getHeight() &&
+		   this->page->isLayerVisible(0) == copy->isLayerVisible(0) &&
+		   this->page->getBackgroundType() == copy->getBackgroundType() &&
+		   this->page->getPdfPageNr() == copy->getPdfPageNr() &&
+		   this->page->getBackgroundColor() == copy->getBackgroundColor() &&
+		   this->page->getBackgroundImage() == copy->getBackgroundImage();
+}
+
+int PageSnapshot::getLayerRevision(int layerId)
+{
+	XOJ_CHECK_TYPE(PageSnapshot);
+
+	if (layerId < 0 || layerId >= (int) this->revisions.size())
+	{
+		return -1;
+	}
+
+	return this->revisions[layerId];
+}
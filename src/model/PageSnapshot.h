@@ -0,0 +1,111 @@
+/*
+ * Xournal++
+ *
+ * Copy of a page for drawing without the document lock
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "PageRef.h"
+
+#include <XournalType.h>
+
+#include <unordered_map>
+#include <vector>
+
+class Element;
+class Layer;
+
+/**
+ * Creates copies of a page which are only used by one thread, so they can be
+ * drawn while the document is changed.
+ *
+ * Only the element lists are copied: strokes share their points with the
+ * original until one of them is changed. Clones of elements which were not
+ * changed since the last update are taken over, so their cached
+ * simplifications and text layouts are kept.
+ *
+ * Each layer of the copy has a revision, which is only changed if the layer
+ * is drawn differently than in the previous copy. Buffers of a layer can be
+ * kept as long as its revision is the same.
+ */
+class PageSnapshot
+{
+public:
+	PageSnapshot();
+	virtual ~PageSnapshot();
+
+private:
+	PageSnapshot(const PageSnapshot& snapshot);
+	void operator=(const PageSnapshot& snapshot);
+
+public:
+	/**
+	 * Copies the page, the document has to be locked. The page returned by the
+	 * last call must not be used anymore.
+	 *
+	 * @param allLayers Also copy the elements of hidden layers
+	 * @param changed false if the caller knows that no element of the page was changed since the
+	 * last update, then the last copy is returned without walking the elements, if the layers
+	 * and the background are the same
+	 */
+	PageRef update(PageRef page, bool allLayers = false, bool changed = true);
+
+	/**
+	 * @param layerId Layer ID 0 = Background, Layer ID 1 = Layer 1
+	 * @return The revision of the layer in the last copy, -1 if there is no such layer
+	 */
+	int getLayerRevision(int layerId);
+
+private:
+	/**
+	 * Copies the elements of source into layer, taking over the unchanged clones of the last copy
+	 */
+	void copyElements(Layer* source, Layer* layer, std::unordered_map<Element*, Element*>& previous);
+
+	/**
+	 * @return true if the background of the copy, or of the page itself, is drawn like the background of the last copy
+	 */
+	bool isBackgroundUnchanged(XojPage* copy);
+
+	/**
+	 * @return true if the last copy of page can be returned again, the elements are not compared
+	 */
+	bool isCopyReusable(PageRef page, bool allLayers);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	PageRef page;
+
+	/**
+	 * The page of the last copy, only compared
+	 */
+	XojPage* source = NULL;
+	bool sourceAllLayers = false;
+
+	/**
+	 * The elements of the page and their clones in the snapshot
+	 */
+	std::unordered_map<Element*, Element*> clones;
+
+	/**
+	 * The remaining parts of the strokes which were erased while the snapshot was taken, never taken over
+	 */
+	std::vector<Element*> erasedParts;
+
+	/**
+	 * The revisions of the background and the layers, by layer ID
+	 */
+	std::vector<int> revisions;
+
+	/**
+	 * The last revision given to a layer
+	 */
+	int revision = 0;
+};
@@ -1,4 +1,6 @@
 #include "Stroke.h"
+#include "StrokeLevelOfDetail.h"
+#include "StrokeSegmentIndex.h"
 
 #include <serializing/ObjectInputStream.h>
 #include <serializing/ObjectOutputStream.h>
@@ -7,6 +9,22 @@
 
 #include <cmath>
 
+/**
+ * Frees shared points, unless the last stroke using them took them over
+ */
+struct StrokePointsDeleter
+{
+	bool owned = true;
+
+	void operator()(Point* points)
+	{
+		if (owned)
+		{
+			g_free(points);
+		}
+	}
+};
+
 Stroke::Stroke()
  : AudioElement(ELEMENT_STROKE)
 {
@@ -17,10 +35,13 @@ Stroke::~Stroke()
 {
 	XOJ_CHECK_TYPE(Stroke);
 
-	g_free(this->points);
-	this->points = NULL;
-	this->pointCount = 0;
-	this->pointAllocCount = 0;
+	freePoints();
+
+	delete this->levelOfDetail;
+	this->levelOfDetail = NULL;
+
+	delete this->segmentIndex;
+	this->segmentIndex = NULL;
 
 	XOJ_RELEASE_TYPE(Stroke);
 }
@@ -46,9 +67,13 @@ Stroke* Stroke::cloneStroke() const
 	Stroke* s = new Stroke();
 	s->applyStyleFrom(this);
 
-	s->allocPointSize(this->pointCount);
-	memcpy(s->points, this->points, this->pointCount * sizeof(Point));
+	// The points are shared until one of the strokes is changed
+	sharePoints();
+
+	s->sharedPoints = this->sharedPoints;
+	s->points = this->points;
 	s->pointCount = this->pointCount;
+	s->pointAllocCount = this->pointCount;
 
 	return s;
 }
@@ -60,6 +85,53 @@ Element* Stroke::clone()
 	return this->cloneStroke();
 }
 
+bool Stroke::isUnchangedClone(Element* clone)
+{
+	XOJ_CHECK_TYPE(Stroke);
+
+	if (clone->getType() != ELEMENT_STROKE)
+	{
+		return false;
+	}
+
+	Stroke* s = (Stroke*) clone;
+
+	// Changing the points copies them first, so the geometry is the same as long as they are shared
+	if (this->sharedPoints == NULL || this->sharedPoints != s->sharedPoints || this->pointCount != s->pointCount)
+	{
+		return false;
+	}
+
+	if (getColor() != s->getColor() || this->width != s->width || this->toolType != s->toolType ||
+		this->fill != s->fill || getAudioFilename() != s->getAudioFilename())
+	{
+		return false;
+	}
+
+	const double* dashes = NULL;
+	int dashCount = 0;
+	this->lineStyle.getDashes(dashes, dashCount);
+
+	const double* cloneDashes = NULL;
+	int cloneDashCount = 0;
+	s->lineStyle.getDashes(cloneDashes, cloneDashCount);
+
+	if (dashCount != cloneDashCount)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < dashCount; i++)
+	{
+		if (dashes[i] != cloneDashes[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void Stroke::serialize(ObjectOutputStream& out)
 {
 	XOJ_CHECK_TYPE(Stroke);
@@ -85,6 +157,8 @@ void Stroke::readSerialized(ObjectInputStream& in)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	in.readObject("Stroke");
 
 	readSerializedAudioElement(in);
@@ -95,10 +169,9 @@ void Stroke::readSerialized(ObjectInputStream& in)
 
 	this->fill = in.readInt();
 
-	g_free(this->points);
-	this->points = NULL;
-	this->pointCount = 0;
+	freePoints();
 	in.readData((void**) &this->points, &this->pointCount);
+	this->pointAllocCount = this->pointCount;
 
 	this->lineStyle.readSerialized(in);
 
@@ -169,6 +242,8 @@ void Stroke::setFirstPoint(double x, double y)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (this->pointCount > 0)
 	{
 		Point& p = this->points[0];
@@ -182,6 +257,8 @@ void Stroke::setLastPoint(double x, double y)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (this->pointCount > 0)
 	{
 		Point& p = this->points[this->pointCount - 1];
@@ -200,6 +277,8 @@ void Stroke::addPoint(Point p)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (this->pointCount >= this->pointAllocCount - 1)
 	{
 		this->allocPointSize(this->pointAllocCount + 100);
@@ -234,6 +313,8 @@ void Stroke::deletePointsFrom(int index)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (this->pointCount <= index)
 	{
 		return;
@@ -245,17 +326,16 @@ void Stroke::deletePoint(int index)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (this->pointCount <= index)
 	{
 		return;
 	}
 
-	for (int i = 0; i < this->pointCount; i++)
+	for (int i = index; i < this->pointCount - 1; i++)
 	{
-		if (i >= index)
-		{
-			this->points[i] = this->points[i + 1];
-		}
+		this->points[i] = this->points[i + 1];
 	}
 	this->pointCount--;
 }
@@ -272,6 +352,18 @@ Point Stroke::getPoint(int index) const
 	return points[index];
 }
 
+std::shared_ptr<const Point> Stroke::sharePoints() const
+{
+	XOJ_CHECK_TYPE(Stroke);
+
+	if (this->sharedPoints == NULL && this->points != NULL)
+	{
+		this->sharedPoints = std::shared_ptr<Point>(this->points, StrokePointsDeleter());
+	}
+
+	return this->sharedPoints;
+}
+
 const Point* Stroke::getPoints() const
 {
 	XOJ_CHECK_TYPE(Stroke);
@@ -279,11 +371,79 @@ const Point* Stroke::getPoints() const
 	return this->points;
 }
 
+const Point* Stroke::getDrawPoints(double maxError, int& count)
+{
+	XOJ_CHECK_TYPE(Stroke);
+
+	if (this->pointCount < LOD_MIN_POINTS || maxError < StrokeLevelOfDetail::getTolerance(0))
+	{
+		count = this->pointCount;
+		return this->points;
+	}
+
+	if (this->levelOfDetail == NULL)
+	{
+		this->levelOfDetail = new StrokeLevelOfDetail();
+	}
+
+	return this->levelOfDetail->getPoints(this->points, this->pointCount, maxError, count);
+}
+
+void Stroke::invalidatePointCaches()
+{
+	XOJ_CHECK_TYPE(Stroke);
+
+	if (this->sharedPoints && this->sharedPoints.use_count() == 1)
+	{
+		// No clone uses the points anymore, they are taken over without a copy
+		std::get_deleter<StrokePointsDeleter>(this->sharedPoints)->owned = false;
+		this->sharedPoints.reset();
+	}
+	else if (this->sharedPoints)
+	{
+		Point* copy = (Point*) g_malloc(this->pointCount * sizeof(Point));
+		memcpy(copy, this->points, this->pointCount * sizeof(Point));
+
+		this->sharedPoints.reset();
+		this->points = copy;
+		this->pointAllocCount = this->pointCount;
+	}
+
+	if (this->levelOfDetail)
+	{
+		this->levelOfDetail->invalidate();
+	}
+
+	if (this->segmentIndex)
+	{
+		this->segmentIndex->invalidate();
+	}
+}
+
+void Stroke::freePoints()
+{
+	XOJ_CHECK_TYPE(Stroke);
+
+	if (this->sharedPoints)
+	{
+		this->sharedPoints.reset();
+	}
+	else
+	{
+		g_free(this->points);
+	}
+
+	this->points = NULL;
+	this->pointCount = 0;
+	this->pointAllocCount = 0;
+}
+
 void Stroke::freeUnusedPointItems()
 {
 	XOJ_CHECK_TYPE(Stroke);
 
-	if (this->pointAllocCount == this->pointCount)
+	// Shared points are never larger than needed
+	if (this->sharedPoints || this->pointAllocCount == this->pointCount)
 	{
 		return;
 	}
@@ -323,6 +483,8 @@ void Stroke::move(double dx, double dy)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	for (int i = 0; i < pointCount; i++)
 	{
 		points[i].x += dx;
@@ -335,6 +497,8 @@ void Stroke::move(double dx, double dy)
 void Stroke::rotate(double x0, double y0, double xo, double yo, double th)
 {
 	XOJ_CHECK_TYPE(Stroke);
+
+	invalidatePointCaches();
 	
 	for (int i = 0; i < this->pointCount; i++)
 	{
@@ -365,6 +529,8 @@ void Stroke::scale(double x0, double y0, double fx, double fy)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	double fz = sqrt(fx * fy);
 
 	for (int i = 0; i < this->pointCount; i++)
@@ -415,6 +581,8 @@ void Stroke::scalePressure(double factor)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (!hasPressure())
 	{
 		return;
@@ -429,6 +597,8 @@ void Stroke::clearPressure()
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	for (int i = 0; i < this->pointCount; i++)
 	{
 		this->points[i].z = Point::NO_PRESSURE;
@@ -439,6 +609,8 @@ void Stroke::setLastPressure(double pressure)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	if (this->pointCount > 0)
 	{
 		this->points[this->pointCount - 1].z = pressure;
@@ -449,6 +621,8 @@ void Stroke::setPressure(const vector<double>& pressure)
 {
 	XOJ_CHECK_TYPE(Stroke);
 
+	invalidatePointCaches();
+
 	// The last pressure is not used - as there is no line drawn from this point
 	if (this->pointCount - 1 > (int)pressure.size())
 	{
@@ -484,14 +658,49 @@ bool Stroke::intersects(double x, double y, double halfEraserSize, double* gap)
 		return false;
 	}
 
+	if (this->pointCount < SEGMENT_INDEX_MIN_POINTS)
+	{
+		return intersectsSegments(1, this->pointCount, x, y, halfEraserSize, gap);
+	}
+
+	if (this->segmentIndex == NULL)
+	{
+		this->segmentIndex = new StrokeSegmentIndex();
+	}
+	if (!this->segmentIndex->isBuilt())
+	{
+		this->segmentIndex->build(this->points, this->pointCount);
+	}
+
+	// A segment is hit if its end point is within the eraser square, or if the
+	// eraser is not further from the segment start than the segment length plus
+	// the eraser diagonal (see intersectsSegments)
+	vector<std::pair<int, int>> ranges;
+	this->segmentIndex->findCandidates(x, y, 3 * halfEraserSize + 0.25, true, ranges);
+
+	for (std::pair<int, int>& r : ranges)
+	{
+		if (intersectsSegments(r.first + 1, r.second + 1, x, y, halfEraserSize, gap))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Stroke::intersectsSegments(int first, int last, double x, double y, double halfEraserSize, double* gap)
+{
+	XOJ_CHECK_TYPE(Stroke);
+
 	double x1 = x - halfEraserSize;
 	double x2 = x + halfEraserSize;
 	double y1 = y - halfEraserSize;
 	double y2 = y + halfEraserSize;
 
-	double lastX = points[0].x;
-	double lastY = points[0].y;
-	for (int i = 1; i < pointCount; i++)
+	double lastX = points[first - 1].x;
+	double lastY = points[first - 1].y;
+	for (int i = first; i < last; i++)
 	{
 		double px = points[i].x;
 		double py = points[i].y;
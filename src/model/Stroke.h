@@ -18,12 +18,16 @@
 
 #include <Arrayiterator.h>
 
+#include <memory>
+
 enum StrokeTool
 {
 	STROKE_TOOL_PEN, STROKE_TOOL_ERASER, STROKE_TOOL_HIGHLIGHTER
 };
 
 class EraseableStroke;
+class StrokeLevelOfDetail;
+class StrokeSegmentIndex;
 
 class Stroke : public AudioElement
 {
@@ -34,6 +38,7 @@ public:
 public:
 	Stroke* cloneStroke() const;
 	virtual Element* clone();
+	virtual bool isUnchangedClone(Element* clone);
 
 	/**
 	 * Clone style attributes, but not the data (position, width etc.)
@@ -71,6 +76,20 @@ public:
 	Point getPoint(int index) const;
 	const Point* getPoints() const;
 
+	/**
+	 * The points, kept alive and unchanged even if the stroke is changed or deleted.
+	 * The stroke copies them on its next change.
+	 */
+	std::shared_ptr<const Point> sharePoints() const;
+
+	/**
+	 * Simplified points for drawing at low zoom, the simplification is cached
+	 *
+	 * @param maxError The allowed error in document coordinates, 0 for the exact points
+	 * @param count Returns the point count
+	 */
+	const Point* getDrawPoints(double maxError, int& count);
+
 	void deletePoint(int index);
 	void deletePointsFrom(int index);
 
@@ -111,6 +130,22 @@ protected:
 	virtual void calcSize();
 	void allocPointSize(int size);
 
+	/**
+	 * The points are about to be changed: copy points shared with a clone,
+	 * drop the cached simplifications and the segment index
+	 */
+	void invalidatePointCaches();
+
+	/**
+	 * Frees the points, or releases them if they are shared
+	 */
+	void freePoints();
+
+	/**
+	 * The hit test of intersects() for the segments ending at the points first to last - 1
+	 */
+	bool intersectsSegments(int first, int last, double x, double y, double halfEraserSize, double* gap);
+
 private:
 	XOJ_TYPE_ATTRIB;
 
@@ -124,6 +159,11 @@ private:
 	int pointCount = 0;
 	int pointAllocCount = 0;
 
+	/**
+	 * Owns the points if they are shared with clones, NULL if only this stroke uses them
+	 */
+	mutable std::shared_ptr<Point> sharedPoints;
+
 	/**
 	 * Dashed line
 	 */
@@ -131,6 +171,16 @@ private:
 
 	EraseableStroke* eraseable = NULL;
 
+	/**
+	 * Cached simplifications, created on first use
+	 */
+	StrokeLevelOfDetail* levelOfDetail = NULL;
+
+	/**
+	 * Bounding boxes of the segments for intersects(), created on first use
+	 */
+	StrokeSegmentIndex* segmentIndex = NULL;
+
 	/**
 	 * Option to fill the shape:
 	 *  -1: The shape is not filled
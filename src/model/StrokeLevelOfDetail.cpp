@@ -0,0 +1,169 @@
+#include "StrokeLevelOfDetail.h"
+
+#include <cmath>
+
+/**
+ * Tolerances of the levels, in document coordinates (1/72 inch)
+ */
+static const double LOD_TOLERANCE[LOD_LEVEL_COUNT] = { 0.5, 1.5, 4.0 };
+
+StrokeLevelOfDetail::StrokeLevelOfDetail()
+{
+	XOJ_INIT_TYPE(StrokeLevelOfDetail);
+
+	for (int i = 0; i < LOD_LEVEL_COUNT; i++)
+	{
+		this->built[i] = false;
+	}
+
+	g_mutex_init(&this->levelLock);
+}
+
+StrokeLevelOfDetail::~StrokeLevelOfDetail()
+{
+	XOJ_CHECK_TYPE(StrokeLevelOfDetail);
+
+	g_mutex_clear(&this->levelLock);
+
+	XOJ_RELEASE_TYPE(StrokeLevelOfDetail);
+}
+
+double StrokeLevelOfDetail::getTolerance(int level)
+{
+	return LOD_TOLERANCE[level];
+}
+
+const Point* StrokeLevelOfDetail::getPoints(const Point* points, int count, double maxError, int& resultCount)
+{
+	XOJ_CHECK_TYPE(StrokeLevelOfDetail);
+
+	int level = LOD_LEVEL_COUNT - 1;
+	while (level >= 0 && LOD_TOLERANCE[level] > maxError)
+	{
+		level--;
+	}
+
+	if (level < 0 || count < LOD_MIN_POINTS)
+	{
+		resultCount = count;
+		return points;
+	}
+
+	g_mutex_lock(&this->levelLock);
+	if (!this->built[level])
+	{
+		simplify(points, count, LOD_TOLERANCE[level], this->levels[level]);
+		this->built[level] = true;
+	}
+	g_mutex_unlock(&this->levelLock);
+
+	resultCount = this->levels[level].size();
+	return this->levels[level].data();
+}
+
+void StrokeLevelOfDetail::invalidate()
+{
+	XOJ_CHECK_TYPE(StrokeLevelOfDetail);
+
+	g_mutex_lock(&this->levelLock);
+	for (int i = 0; i < LOD_LEVEL_COUNT; i++)
+	{
+		if (this->built[i])
+		{
+			this->levels[i].clear();
+			this->built[i] = false;
+		}
+	}
+	g_mutex_unlock(&this->levelLock);
+}
+
+/**
+ * Error of p against the segment a - b
+ */
+static inline double simplifyError(const Point& a, const Point& b, const Point& p, double dx, double dy, double len2)
+{
+	double t = 0;
+	if (len2 > 0)
+	{
+		t = ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2;
+		t = std::min(1.0, std::max(0.0, t));
+	}
+
+	double ex = a.x + t * dx - p.x;
+	double ey = a.y + t * dy - p.y;
+	double error = std::sqrt(ex * ex + ey * ey);
+
+	if (p.z != Point::NO_PRESSURE)
+	{
+		// Half of the width change is visible on each side of the line
+		double widthError = std::abs(a.z + t * (b.z - a.z) - p.z) / 2;
+		error = std::max(error, widthError);
+	}
+
+	return error;
+}
+
+void StrokeLevelOfDetail::simplify(const Point* points, int count, double tolerance, vector<Point>& result)
+{
+	result.clear();
+
+	if (count < 3)
+	{
+		result.assign(points, points + count);
+		return;
+	}
+
+	vector<bool> keep(count, false);
+	keep[0] = true;
+	keep[count - 1] = true;
+
+	// Explicit stack, long strokes would recurse too deep
+	vector<std::pair<int, int>> ranges;
+	ranges.push_back(std::make_pair(0, count - 1));
+
+	while (!ranges.empty())
+	{
+		int first = ranges.back().first;
+		int last = ranges.back().second;
+		ranges.pop_back();
+
+		const Point& a = points[first];
+		const Point& b = points[last];
+		double dx = b.x - a.x;
+		double dy = b.y - a.y;
+		double len2 = dx * dx + dy * dy;
+
+		double maxError = tolerance;
+		int index = -1;
+		for (int i = first + 1; i < last; i++)
+		{
+			double error = simplifyError(a, b, points[i], dx, dy, len2);
+			if (error > maxError)
+			{
+				maxError = error;
+				index = i;
+			}
+		}
+
+		if (index != -1)
+		{
+			keep[index] = true;
+			if (index - first > 1)
+			{
+				ranges.push_back(std::make_pair(first, index));
+			}
+			if (last - index > 1)
+			{
+				ranges.push_back(std::make_pair(index, last));
+			}
+		}
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		if (keep[i])
+		{
+			result.push_back(points[i]);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+/*
+ * Xournal++
+ *
+ * Simplified versions of a stroke, used to draw strokes at low zoom
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "Point.h"
+
+#include <XournalType.h>
+
+#include <vector>
+using std::vector;
+
+/**
+ * Number of simplification levels
+ */
+#define LOD_LEVEL_COUNT 3
+
+/**
+ * Strokes with less points are always drawn exact
+ */
+#define LOD_MIN_POINTS 16
+
+/**
+ * Maximum visible error in device pixels for which a simplified level is used
+ */
+#define LOD_PIXEL_ERROR 0.25
+
+class StrokeLevelOfDetail
+{
+public:
+	StrokeLevelOfDetail();
+	virtual ~StrokeLevelOfDetail();
+
+public:
+	/**
+	 * Returns the points of the coarsest level whose error is below maxError,
+	 * the level is built on first use.
+	 *
+	 * @param points The exact points of the stroke
+	 * @param maxError The allowed error in document coordinates
+	 * @param resultCount Returns the point count of the result
+	 * @return The simplified points, or the exact points if no level is coarse enough
+	 */
+	const Point* getPoints(const Point* points, int count, double maxError, int& resultCount);
+
+	/**
+	 * Drops all built levels, needs to be called if the stroke changes
+	 */
+	void invalidate();
+
+	/**
+	 * @return The error of a level in document coordinates
+	 */
+	static double getTolerance(int level);
+
+	/**
+	 * Douglas-Peucker simplification. The error of a point is the distance to the
+	 * simplified line, or half the difference of the width to the interpolated
+	 * width, so pressure changes are kept.
+	 */
+	static void simplify(const Point* points, int count, double tolerance, vector<Point>& result);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	vector<Point> levels[LOD_LEVEL_COUNT];
+	bool built[LOD_LEVEL_COUNT];
+
+	GMutex levelLock;
+};
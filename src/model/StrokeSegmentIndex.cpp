@@ -0,0 +1,137 @@
+#include "StrokeSegmentIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+StrokeSegmentIndex::StrokeSegmentIndex()
+{
+	XOJ_INIT_TYPE(StrokeSegmentIndex);
+}
+
+StrokeSegmentIndex::~StrokeSegmentIndex()
+{
+	XOJ_CHECK_TYPE(StrokeSegmentIndex);
+
+	XOJ_RELEASE_TYPE(StrokeSegmentIndex);
+}
+
+void StrokeSegmentIndex::merge(Box& box, const Box& other)
+{
+	box.minX = std::min(box.minX, other.minX);
+	box.minY = std::min(box.minY, other.minY);
+	box.maxX = std::max(box.maxX, other.maxX);
+	box.maxY = std::max(box.maxY, other.maxY);
+	box.maxLength = std::max(box.maxLength, other.maxLength);
+}
+
+void StrokeSegmentIndex::build(const Point* points, int count)
+{
+	XOJ_CHECK_TYPE(StrokeSegmentIndex);
+
+	this->segmentCount = std::max(count - 1, 0);
+
+	int chunkCount = (this->segmentCount + SEGMENT_INDEX_CHUNK_SIZE - 1) / SEGMENT_INDEX_CHUNK_SIZE;
+	this->chunks.resize(chunkCount);
+
+	for (int c = 0; c < chunkCount; c++)
+	{
+		int first = c * SEGMENT_INDEX_CHUNK_SIZE;
+		int last = std::min(first + SEGMENT_INDEX_CHUNK_SIZE, this->segmentCount);
+
+		Box& box = this->chunks[c];
+		box.minX = box.maxX = points[first].x;
+		box.minY = box.maxY = points[first].y;
+		box.maxLength = 0;
+
+		for (int i = first; i < last; i++)
+		{
+			const Point& b = points[i + 1];
+			box.minX = std::min(box.minX, b.x);
+			box.minY = std::min(box.minY, b.y);
+			box.maxX = std::max(box.maxX, b.x);
+			box.maxY = std::max(box.maxY, b.y);
+			box.maxLength = std::max(box.maxLength, hypot(b.x - points[i].x, b.y - points[i].y));
+		}
+	}
+
+	int groupCount = (chunkCount + SEGMENT_INDEX_CHUNK_SIZE - 1) / SEGMENT_INDEX_CHUNK_SIZE;
+	this->groups.resize(groupCount);
+
+	for (int g = 0; g < groupCount; g++)
+	{
+		int first = g * SEGMENT_INDEX_CHUNK_SIZE;
+		int last = std::min(first + SEGMENT_INDEX_CHUNK_SIZE, chunkCount);
+
+		Box& box = this->groups[g];
+		box = this->chunks[first];
+		for (int c = first + 1; c < last; c++)
+		{
+			merge(box, this->chunks[c]);
+		}
+	}
+
+	this->built = true;
+}
+
+void StrokeSegmentIndex::invalidate()
+{
+	XOJ_CHECK_TYPE(StrokeSegmentIndex);
+
+	this->built = false;
+}
+
+bool StrokeSegmentIndex::isBuilt()
+{
+	XOJ_CHECK_TYPE(StrokeSegmentIndex);
+
+	return this->built;
+}
+
+bool StrokeSegmentIndex::contains(const Box& box, double x, double y, double radius, bool growBySegmentLength)
+{
+	if (growBySegmentLength)
+	{
+		radius += box.maxLength;
+	}
+
+	return x >= box.minX - radius && x <= box.maxX + radius && y >= box.minY - radius && y <= box.maxY + radius;
+}
+
+void StrokeSegmentIndex::findCandidates(double x, double y, double radius, bool growBySegmentLength,
+										vector<std::pair<int, int>>& ranges)
+{
+	XOJ_CHECK_TYPE(StrokeSegmentIndex);
+
+	ranges.clear();
+
+	int chunkCount = this->chunks.size();
+	for (int g = 0; g < (int) this->groups.size(); g++)
+	{
+		if (!contains(this->groups[g], x, y, radius, growBySegmentLength))
+		{
+			continue;
+		}
+
+		int lastChunk = std::min((g + 1) * SEGMENT_INDEX_CHUNK_SIZE, chunkCount);
+		for (int c = g * SEGMENT_INDEX_CHUNK_SIZE; c < lastChunk; c++)
+		{
+			if (!contains(this->chunks[c], x, y, radius, growBySegmentLength))
+			{
+				continue;
+			}
+
+			int first = c * SEGMENT_INDEX_CHUNK_SIZE;
+			int last = std::min(first + SEGMENT_INDEX_CHUNK_SIZE, this->segmentCount);
+
+			// Join neighbouring chunks
+			if (!ranges.empty() && ranges.back().second == first)
+			{
+				ranges.back().second = last;
+			}
+			else
+			{
+				ranges.push_back(std::make_pair(first, last));
+			}
+		}
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * Xournal++
+ *
+ * Bounding boxes over runs of stroke segments, for fast hit tests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "Point.h"
+
+#include <XournalType.h>
+
+#include <utility>
+#include <vector>
+using std::vector;
+
+/**
+ * Segments per chunk, and chunks per group
+ */
+#define SEGMENT_INDEX_CHUNK_SIZE 16
+
+/**
+ * Strokes with less points are tested without index
+ */
+#define SEGMENT_INDEX_MIN_POINTS 64
+
+/**
+ * Two level hierarchy of axis aligned boxes: each chunk covers a run of
+ * segments, each group covers a run of chunks. The runs follow the order
+ * of the points, so the candidates are returned in stroke order.
+ */
+class StrokeSegmentIndex
+{
+public:
+	StrokeSegmentIndex();
+	virtual ~StrokeSegmentIndex();
+
+public:
+	/**
+	 * Segment i is the line from points[i] to points[i + 1]
+	 */
+	void build(const Point* points, int count);
+	void invalidate();
+	bool isBuilt();
+
+	/**
+	 * Collects the segments which may be closer than radius to x / y
+	 * (box distance, per axis), as [first, last) ranges in segment order.
+	 *
+	 * @param growBySegmentLength Also grow each box by its longest segment,
+	 *        for tests measured from the segment start instead of the segment
+	 */
+	void findCandidates(double x, double y, double radius, bool growBySegmentLength,
+						vector<std::pair<int, int>>& ranges);
+
+private:
+	struct Box
+	{
+		double minX;
+		double minY;
+		double maxX;
+		double maxY;
+
+		/**
+		 * The longest segment within the box
+		 */
+		double maxLength;
+	};
+
+	static bool contains(const Box& box, double x, double y, double radius, bool growBySegmentLength);
+	static void merge(Box& box, const Box& other);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	bool built = false;
+	int segmentCount = 0;
+
+	vector<Box> chunks;
+	vector<Box> groups;
+};
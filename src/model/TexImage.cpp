@@ -56,6 +56,7 @@ Element* TexImage::clone()
 	img->height = this->height;
 	img->text = this->text;
 	img->binaryData = this->binaryData;
+	img->parsedBinaryData = this->parsedBinaryData;
 
 	if (this->pdf)
 	{
@@ -71,6 +72,24 @@ Element* TexImage::clone()
 	return img;
 }
 
+bool TexImage::isUnchangedClone(Element* clone)
+{
+	XOJ_CHECK_TYPE(TexImage);
+
+	if (clone->getType() != ELEMENT_TEXIMAGE)
+	{
+		return false;
+	}
+
+	TexImage* img = (TexImage*) clone;
+
+	// A clone parses the shared data itself, the image and PDF are only shared if they were already parsed
+	return this->binaryData == img->binaryData && (this->image == NULL || this->image == img->image) &&
+		   (this->pdf == NULL || this->pdf == img->pdf) && this->text == img->text &&
+		   this->x == img->x && this->y == img->y && this->width == img->width && this->height == img->height &&
+		   getColor() == img->getColor();
+}
+
 void TexImage::setWidth(double width)
 {
 	XOJ_CHECK_TYPE(TexImage);
@@ -91,11 +110,11 @@ cairo_status_t TexImage::cairoReadFunction(TexImage* image, unsigned char* data,
 
 	for (unsigned int i = 0; i < length; i++, image->read++)
 	{
-		if (image->read >= image->binaryData.length())
+		if (image->read >= image->binaryData->length())
 		{
 			return CAIRO_STATUS_READ_ERROR;
 		}
-		data[i] = image->binaryData[image->read];
+		data[i] = (*image->binaryData)[image->read];
 	}
 
 	return CAIRO_STATUS_SUCCESS;
@@ -108,17 +127,18 @@ void TexImage::setBinaryData(string binaryData)
 {
 	XOJ_CHECK_TYPE(TexImage);
 
-	this->binaryData = binaryData;
+	this->binaryData = std::make_shared<const string>(std::move(binaryData));
 }
 
 /**
  * Gets the binary data, a .PNG image or a .PDF
  */
-string& TexImage::getBinaryData()
+const string& TexImage::getBinaryData()
 {
 	XOJ_CHECK_TYPE(TexImage);
 
-	return this->binaryData;
+	static const string empty;
+	return this->binaryData ? *this->binaryData : empty;
 }
 
 void TexImage::setText(string text)
@@ -156,13 +176,15 @@ void TexImage::loadBinaryData()
 
 	freeImageAndPdf();
 
-	if (this->binaryData.length() < 4)
+	const string& binaryData = getBinaryData();
+
+	if (binaryData.length() < 4)
 	{
 		this->parsedBinaryData = true;
 		return;
 	}
 
-	string type = this->binaryData.substr(0, 4);
+	string type = binaryData.substr(0, 4);
 
 	if (type[1] == 'P' && type[2] == 'N' && type[3] == 'G')
 	{
@@ -171,7 +193,7 @@ void TexImage::loadBinaryData()
 	}
 	else if (type[1] == 'P' && type[2] == 'D' && type[3] == 'F')
 	{
-		this->pdf = poppler_document_new_from_data((char*)this->binaryData.c_str(), this->binaryData.length(), NULL, NULL);
+		this->pdf = poppler_document_new_from_data((char*) binaryData.c_str(), binaryData.length(), NULL, NULL);
 	}
 	else
 	{
@@ -255,7 +277,8 @@ void TexImage::serialize(ObjectOutputStream& out)
 	out.writeDouble(this->height);
 	out.writeString(this->text);
 
-	out.writeData(this->binaryData.c_str(), this->binaryData.length(), 1);
+	const string& binaryData = getBinaryData();
+	out.writeData(binaryData.c_str(), binaryData.length(), 1);
 
 	out.endObject();
 }
@@ -278,7 +301,8 @@ void TexImage::readSerialized(ObjectInputStream& in)
 	int len = 0;
 	in.readData((void**)&data, &len);
 
-	this->binaryData = string(data, len);
+	this->binaryData = std::make_shared<const string>(data, len);
+	g_free(data);
 
 	in.endObject();
 }
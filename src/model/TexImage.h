@@ -16,6 +16,8 @@
 
 #include <poppler.h>
 
+#include <memory>
+
 
 class TexImage: public Element
 {
@@ -35,7 +37,7 @@ public:
 	/**
 	 * Gets the binary data, a .PNG image or a .PDF
 	 */
-	string& getBinaryData();
+	const string& getBinaryData();
 
 	/**
 	 * Get the Image, if rendered as image
@@ -64,6 +66,7 @@ public:
 	string getText();
 
 	virtual Element* clone();
+	virtual bool isUnchangedClone(Element* clone);
 
 public:
 	// Serialize interface
@@ -99,9 +102,10 @@ private:
 	cairo_surface_t* image = NULL;
 
 	/**
-	 * PNG Image / PDF Document
+	 * PNG Image / PDF Document, shared with clones. The PDF Document
+	 * does not copy the data, so it has to live as long as the document.
 	 */
-	string binaryData;
+	std::shared_ptr<const string> binaryData;
 
 	/**
 	 * Flag if the binary data is already parsed
@@ -17,6 +17,8 @@ Text::Text()
 
 Text::~Text()
 {
+	TextView::invalidateLayout(this);
+
 	XOJ_RELEASE_TYPE(Text);
 }
 
@@ -35,6 +37,23 @@ Element* Text::clone()
 	return text;
 }
 
+bool Text::isUnchangedClone(Element* clone)
+{
+	XOJ_CHECK_TYPE(Text);
+
+	if (clone->getType() != ELEMENT_TEXT)
+	{
+		return false;
+	}
+
+	Text* t = (Text*) clone;
+
+	return this->text == t->text && this->font.getName() == t->font.getName() &&
+		   this->font.getSize() == t->font.getSize() && getColor() == t->getColor() &&
+		   this->x == t->x && this->y == t->y && this->inEditing == t->inEditing &&
+		   getAudioFilename() == t->getAudioFilename();
+}
+
 XojFont& Text::getFont()
 {
 	XOJ_CHECK_TYPE(Text);
@@ -61,6 +80,7 @@ void Text::setText(string text)
 	XOJ_CHECK_TYPE(Text);
 
 	this->text = text;
+	TextView::invalidateLayout(this);
 
 	calcSize();
 }
@@ -179,6 +199,7 @@ void Text::readSerialized(ObjectInputStream& in)
 	readSerializedAudioElement(in);
 
 	this->text = in.readString();
+	TextView::invalidateLayout(this);
 
 	font.readSerialized(in);
 
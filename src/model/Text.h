@@ -45,6 +45,7 @@ public:
 	 * @overwrite
 	 */
 	virtual Element* clone();
+	virtual bool isUnchangedClone(Element* clone);
 
 	bool intersects(double x, double y, double halfSize) override;
 	bool intersects(double x, double y, double halfSize, double* gap) override;
@@ -65,4 +66,14 @@ private:
 	string text;
 
 	bool inEditing = false;
+
+	/**
+	 * Layout of the text, managed by TextView. Released if the text is changed,
+	 * the font the layout uses is compared on each use.
+	 */
+	PangoLayout* layout = NULL;
+	string layoutFontName;
+	double layoutFontSize = 0;
+
+	friend class TextView;
 };
@@ -46,15 +46,25 @@ void XojPage::unreference()
 
 XojPage* XojPage::clone()
 {
-	XojPage* page = new XojPage(this->width, this->height);
+	XojPage* page = cloneWithoutLayers();
 
-	page->backgroundImage = this->backgroundImage;
 	for (Layer* l : this->layer)
 	{
 		page->addLayer(l->clone());
 	}
 
 	page->currentLayer = this->currentLayer;
+
+	return page;
+}
+
+XojPage* XojPage::cloneWithoutLayers()
+{
+	XOJ_CHECK_TYPE(XojPage);
+
+	XojPage* page = new XojPage(this->width, this->height);
+
+	page->backgroundImage = this->backgroundImage;
 	page->bgType = this->bgType;
 	page->pdfBackgroundPage = this->pdfBackgroundPage;
 	page->backgroundColor = this->backgroundColor;
@@ -194,6 +204,11 @@ void XojPage::setBackgroundPdfPageNr(size_t page)
 	this->pdfBackgroundPage = page;
 	this->bgType.format = PageTypeFormat::Pdf;
 	this->bgType.config = "";
+
+	if (this->backgroundGeneration != NULL)
+	{
+		(*this->backgroundGeneration)++;
+	}
 }
 
 void XojPage::setBackgroundColor(int color)
@@ -267,6 +282,25 @@ void XojPage::setBackgroundType(PageType bgType)
 	{
 		this->backgroundImage.free();
 	}
+
+	if (this->backgroundGeneration != NULL)
+	{
+		(*this->backgroundGeneration)++;
+	}
+}
+
+void XojPage::setBackgroundGeneration(guint* generation)
+{
+	XOJ_CHECK_TYPE(XojPage);
+
+	this->backgroundGeneration = generation;
+}
+
+guint* XojPage::getBackgroundGeneration()
+{
+	XOJ_CHECK_TYPE(XojPage);
+
+	return this->backgroundGeneration;
 }
 
 PageType XojPage::getBackgroundType()
@@ -47,6 +47,14 @@ public:
 	void setBackgroundType(PageType bgType);
 	PageType getBackgroundType();
 
+	/**
+	 * The counter of the document which contains this page, it counts the background
+	 * changes, so the document knows if its index over the PDF backgrounds is still valid.
+	 * NULL if the page is not in a document.
+	 */
+	void setBackgroundGeneration(guint* generation);
+	guint* getBackgroundGeneration();
+
 	/**
 	 * Do not call this, cal doc->setPageSize(Page * p, double width, double height);
 	 */
@@ -79,9 +87,19 @@ public:
 	 */
 	XojPage* clone();
 
+	/**
+	 * Copies the size and the background of this page, without the layers
+	 */
+	XojPage* cloneWithoutLayers();
+
 private:
 	XOJ_TYPE_ATTRIB;
 
+	/**
+	 * The background change counter of the document, not copied by clone()
+	 */
+	guint* backgroundGeneration = NULL;
+
 	/**
 	 * The reference counter
 	 */
@@ -134,4 +152,7 @@ private:
 	// Allow LayerController to modify layers of a page
 	// Notifications were be sent
 	friend class LayerController;
+
+	// Allow PageSnapshot to build the layers of its copies
+	friend class PageSnapshot;
 };
@@ -1,11 +1,10 @@
 #include "EraseableStroke.h"
 
-#include "EraseableStrokePart.h"
-#include "PartList.h"
 #include "model/Stroke.h"
 
 #include <Range.h>
 
+#include <algorithm>
 #include <cmath>
 
 EraseableStroke::EraseableStroke(Stroke* stroke)
@@ -13,12 +12,29 @@ EraseableStroke::EraseableStroke(Stroke* stroke)
 {
 	XOJ_INIT_TYPE(EraseableStroke);
 
-	this->parts = new PartList();
 	g_mutex_init(&this->partLock);
 
-	for (int i = 1; i < stroke->getPointCount(); i++)
+	int count = stroke->getPointCount();
+	const Point* points = stroke->getPoints();
+
+	this->px.reserve(count);
+	this->py.reserve(count);
+	this->pz.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		this->px.push_back(points[i].x);
+		this->py.push_back(points[i].y);
+		this->pz.push_back(points[i].z);
+	}
+
+	this->segmentIndex.build(points, count);
+
+	int segments = std::max(count - 1, 0);
+	this->hit.resize(segments);
+	this->parts.reserve(segments);
+	for (int i = 0; i < segments; i++)
 	{
-		this->parts->add(new EraseableStrokePart(stroke->getPoint(i - 1), stroke->getPoint(i)));
+		this->parts.emplace_back(i, 0.0, 1.0);
 	}
 }
 
@@ -26,12 +42,39 @@ EraseableStroke::~EraseableStroke()
 {
 	XOJ_CHECK_TYPE(EraseableStroke);
 
-	delete this->parts;
-	this->parts = NULL;
+	g_mutex_clear(&this->partLock);
 
 	XOJ_RELEASE_TYPE(EraseableStroke);
 }
 
+Point EraseableStroke::pointAt(int segment, double t)
+{
+	XOJ_CHECK_TYPE(EraseableStroke);
+
+	double x = this->px[segment] + t * (this->px[segment + 1] - this->px[segment]);
+	double y = this->py[segment] + t * (this->py[segment + 1] - this->py[segment]);
+
+	return Point(x, y, this->pz[segment]);
+}
+
+double EraseableStroke::getSegmentLength(int segment)
+{
+	XOJ_CHECK_TYPE(EraseableStroke);
+
+	return hypot(this->px[segment + 1] - this->px[segment], this->py[segment + 1] - this->py[segment]);
+}
+
+int EraseableStroke::getPartCount()
+{
+	XOJ_CHECK_TYPE(EraseableStroke);
+
+	g_mutex_lock(&this->partLock);
+	int count = this->parts.size();
+	g_mutex_unlock(&this->partLock);
+
+	return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // This is done in a Thread, every thing else in the main loop /////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -40,343 +83,239 @@ void EraseableStroke::draw(cairo_t* cr)
 {
 	XOJ_CHECK_TYPE(EraseableStroke);
 
-	Point lastPoint;
-
 	g_mutex_lock(&this->partLock);
-	PartList * tmpCopy = this->parts->clone();
+	vector<EraseableStrokePart> tmpCopy = this->parts;
 	g_mutex_unlock(&this->partLock);
 
 	double w = this->stroke->getWidth();
+	double currentWidth = -1;
 
-	for (GList* l = tmpCopy->data; l != NULL; l = l->next)
+	// Connected parts with the same width are drawn as one path
+	const EraseableStrokePart* last = NULL;
+	for (const EraseableStrokePart& part : tmpCopy)
 	{
-		EraseableStrokePart* part = (EraseableStrokePart*) l->data;
-		if (part->getWidth() == Point::NO_PRESSURE)
+		double width = this->pz[part.segment];
+		if (width == Point::NO_PRESSURE)
 		{
-			cairo_set_line_width(cr, w);
+			width = w;
 		}
-		else
+
+		if (width != currentWidth)
 		{
-			cairo_set_line_width(cr, part->getWidth());
+			if (last)
+			{
+				cairo_stroke(cr);
+			}
+			cairo_set_line_width(cr, width);
+			currentWidth = width;
+			last = NULL;
 		}
 
-		GList* pl = part->getPoints();
-		Point* p = (Point*) pl->data;
-		cairo_move_to(cr, p->x, p->y);
-
-		pl = pl->next;
-		for (; pl != NULL; pl = pl->next)
+		if (last == NULL || !part.continues(*last))
 		{
-			Point* p = (Point*) pl->data;
-			cairo_line_to(cr, p->x, p->y);
+			Point a = pointAt(part.segment, part.t0);
+			cairo_move_to(cr, a.x, a.y);
 		}
-		cairo_stroke(cr);
+
+		Point b = pointAt(part.segment, part.t1);
+		cairo_line_to(cr, b.x, b.y);
+
+		last = &part;
 	}
 
-	delete tmpCopy;
+	if (last)
+	{
+		cairo_stroke(cr);
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-/**
- * The only public method
- */
-Range* EraseableStroke::erase(double x, double y, double halfEraserSize, Range* range)
+bool EraseableStroke::findHitSegments(double x, double y, double radius)
 {
 	XOJ_CHECK_TYPE(EraseableStroke);
 
-	this->repaintRect = range;
+	const double* ax = this->px.data();
+	const double* ay = this->py.data();
+	unsigned char* segmentHit = this->hit.data();
+	const double radiusSq = radius * radius;
 
-	g_mutex_lock(&this->partLock);
-	PartList* tmpCopy = this->parts->clone();
-	g_mutex_unlock(&this->partLock);
+	int hitCount = 0;
 
-	for (GList* l = tmpCopy->data; l != NULL;)
+	// Only the segments tested last time can be marked, the others are still 0
+	for (const std::pair<int, int>& range : this->candidates)
 	{
-		EraseableStrokePart* p = (EraseableStrokePart*) l->data;
-		l = l->next;
-		erase(x, y, halfEraserSize, p, tmpCopy);
+		std::fill(segmentHit + range.first, segmentHit + range.second, 0);
 	}
 
-	g_mutex_lock(&this->partLock);
-	PartList* old = this->parts;
-	this->parts = tmpCopy;
-	g_mutex_unlock(&this->partLock);
+	this->segmentIndex.findCandidates(x, y, radius, false, this->candidates);
 
-	delete old;
+	for (const std::pair<int, int>& range : this->candidates)
+	{
+		// Distance from the eraser center to each segment, branch free so the compiler can vectorize it
+		for (int i = range.first; i < range.second; i++)
+		{
+			double dx = ax[i + 1] - ax[i];
+			double dy = ay[i + 1] - ay[i];
+			double cx = x - ax[i];
+			double cy = y - ay[i];
 
-	return this->repaintRect;
-}
+			double lenSq = dx * dx + dy * dy;
+			double t = (cx * dx + cy * dy) / std::max(lenSq, 1e-12);
+			t = std::min(std::max(t, 0.0), 1.0);
 
-void EraseableStroke::addRepaintRect(double x, double y, double width, double height)
-{
-	XOJ_CHECK_TYPE(EraseableStroke);
+			double ex = cx - t * dx;
+			double ey = cy - t * dy;
 
-	if (this->repaintRect)
-	{
-		this->repaintRect->addPoint(x, y);
-	}
-	else
-	{
-		this->repaintRect = new Range(x, y);
+			segmentHit[i] = (ex * ex + ey * ey) <= radiusSq;
+			hitCount += segmentHit[i];
+		}
 	}
 
-	this->repaintRect->addPoint(x + width, y + height);
+	return hitCount > 0;
 }
 
-void EraseableStroke::erase(double x, double y, double halfEraserSize, EraseableStrokePart* part, PartList* list)
+void EraseableStroke::eraseInterval(int segment, double x, double y, double radius, double& t0, double& t1)
 {
 	XOJ_CHECK_TYPE(EraseableStroke);
 
-	if (part->points->next == NULL)
+	double dx = this->px[segment + 1] - this->px[segment];
+	double dy = this->py[segment + 1] - this->py[segment];
+	double cx = x - this->px[segment];
+	double cy = y - this->py[segment];
+
+	double lenSq = dx * dx + dy * dy;
+	if (lenSq < 1e-12)
 	{
+		// A segment without length is completely within the eraser, if it is hit
+		t0 = 0;
+		t1 = 1;
 		return;
 	}
 
-	Point eraser(x, y);
+	// Solve |a + t * d - c|² = r² for t
+	double b = (cx * dx + cy * dy) / lenSq;
+	double c = (cx * cx + cy * cy - radius * radius) / lenSq;
+	double discriminant = std::max(b * b - c, 0.0);
+	double root = sqrt(discriminant);
 
-	Point* a = (Point*) g_list_first(part->points)->data;
-	Point* b = (Point*) g_list_last(part->points)->data;
+	t0 = b - root;
+	t1 = b + root;
+}
 
-	if (eraser.lineLengthTo(*a) < halfEraserSize * 1.2 && eraser.lineLengthTo(*b) < halfEraserSize * 1.2)
-	{
-		list->data = g_list_remove(list->data, part);
-		addRepaintRect(part->getX(), part->getY(), part->getElementWidth(), part->getElementHeight());
+/**
+ * The only public method
+ */
+Range* EraseableStroke::erase(double x, double y, double halfEraserSize, Range* range)
+{
+	XOJ_CHECK_TYPE(EraseableStroke);
 
-		delete part;
-		return;
-	}
+	this->repaintRect = range;
 
-	double x1 = x - halfEraserSize;
-	double x2 = x + halfEraserSize;
-	double y1 = y - halfEraserSize;
-	double y2 = y + halfEraserSize;
+	if (!findHitSegments(x, y, halfEraserSize))
+	{
+		return this->repaintRect;
+	}
 
-	double aX = a->x;
-	double aY = a->y;
-	double bX = b->x;
-	double bY = b->y;
+	// Only the main thread changes the parts, so reading them here needs no lock
+	vector<EraseableStrokePart> newParts;
+	newParts.reserve(this->parts.size() + 1);
 
-	// check first point
-	if (aX >= x1 && aY >= y1 && aX <= x2 && aY <= y2)
+	for (const EraseableStrokePart& part : this->parts)
 	{
-		bool deleteAfter = false;
-
-		if (erasePart(x, y, halfEraserSize, part, list, &deleteAfter))
+		if (!this->hit[part.segment])
 		{
-			addRepaintRect(part->getX(), part->getY(), part->getElementWidth(), part->getElementHeight());
-			part->calcSize();
+			newParts.push_back(part);
+			continue;
 		}
 
-		if (deleteAfter)
+		double e0 = 0;
+		double e1 = 0;
+		eraseInterval(part.segment, x, y, halfEraserSize, e0, e1);
+
+		if (e1 <= part.t0 || e0 >= part.t1)
 		{
-			delete part;
+			// The eraser touches another part of this segment
+			newParts.push_back(part);
+			continue;
 		}
 
-		return;
-	}
-
-	// check last point
-	if (bX >= x1 && bY >= y1 && bX <= x2 && bY <= y2)
-	{
-		bool deleteAfter = false;
+		double minT = ERASER_MIN_PART_LENGTH / std::max(getSegmentLength(part.segment), ERASER_MIN_PART_LENGTH);
 
-		if (erasePart(x, y, halfEraserSize, part, list, &deleteAfter))
+		if (e0 - part.t0 > minT)
 		{
-			addRepaintRect(part->getX(), part->getY(), part->getElementWidth(), part->getElementHeight());
-			part->calcSize();
+			newParts.emplace_back(part.segment, part.t0, e0);
 		}
-
-		if (deleteAfter)
+		if (part.t1 - e1 > minT)
 		{
-			delete part;
+			newParts.emplace_back(part.segment, e1, part.t1);
 		}
 
-		return;
+		addRepaintPart(part.segment, std::max(part.t0, e0), std::min(part.t1, e1));
 	}
 
-	double len = hypot(bX - aX, bY - aY);
-	/**
-	 * The normale to a vector, the padding to a point
-	 */
-	double p = ABS((x - aX) * (aY - bY) + (y - aY) * (bX - aX)) / hypot(aX - x, aY - y);
-
-	// The space to the line is in the range, but it can also be parallel
-	// and not enough close, so calculate a "circle" with the center on the
-	// center of the line
-
-	if (p <= halfEraserSize)
-	{
-		double centerX = (aX + x) / 2;
-		double centerY = (aY + y) / 2;
-		double distance = hypot(x - centerX, y - centerY);
-
-		// we should calculate the length of the line within the rectangle, to find out
-		// the distance from the border to the point, but the stroke are not rectangular
-		// so we can do it simpler
-		distance -= hypot((x2 - x1) / 2, (y2 - y1) / 2);
-
-		if (distance <= (len / 2) + 0.1)
-		{
-			bool deleteAfter = false;
-
-			if (erasePart(x, y, halfEraserSize, part, list, &deleteAfter))
-			{
-				addRepaintRect(part->getX(), part->getY(), part->getElementWidth(), part->getElementHeight());
-				part->calcSize();
-			}
-
-			if (deleteAfter)
-			{
-				delete part;
-			}
+	g_mutex_lock(&this->partLock);
+	this->parts.swap(newParts);
+	g_mutex_unlock(&this->partLock);
 
-			return;
-		}
-	}
+	return this->repaintRect;
 }
 
-bool EraseableStroke::erasePart(double x, double y, double halfEraserSize, EraseableStrokePart* part,
-								PartList* list, bool* deleteStrokeAfter)
+void EraseableStroke::addRepaintPart(int segment, double t0, double t1)
 {
 	XOJ_CHECK_TYPE(EraseableStroke);
 
-	bool changed = false;
-
-	part->splitFor(halfEraserSize);
+	Point a = pointAt(segment, t0);
+	Point b = pointAt(segment, t1);
 
-	double x1 = x - halfEraserSize;
-	double x2 = x + halfEraserSize;
-	double y1 = y - halfEraserSize;
-	double y2 = y + halfEraserSize;
-
-	/**
-	 * erase the beginning
-	 */
-	for (GList* l = part->getPoints(); l != NULL;)
+	double width = this->pz[segment];
+	if (width == Point::NO_PRESSURE)
 	{
-		Point* p = (Point*) l->data;
-		l = l->next;
-		if (p->x >= x1 && p->y >= y1 && p->x <= x2 && p->y <= y2)
-		{
-			part->points = g_list_remove(part->points, p);
-			delete p;
-			changed = true;
-		}
-		else
-		{
-			// only the beginning is handled here
-			break;
-		}
+		width = this->stroke->getWidth();
 	}
+	double padding = width / 2;
 
-	/**
-	 * erase the end
-	 */
-	for (GList* l = g_list_last(part->getPoints()); l != NULL;)
-	{
-		Point* p = (Point*) l->data;
-		l = l->prev;
-		if (p->x >= x1 && p->y >= y1 && p->x <= x2 && p->y <= y2)
-		{
-			part->points = g_list_remove(part->points, p);
-			delete p;
-			changed = true;
-		}
-		else
-		{
-			// only the end is handled here
-			break;
-		}
-	}
+	double x = std::min(a.x, b.x) - padding;
+	double y = std::min(a.y, b.y) - padding;
 
-	/**
-	 * handle the rest
-	 */
-
-	GList* lists = NULL;
-	GList* current = NULL;
-
-	for (GList* l = part->points; l != NULL;)
-	{
-		Point* p = (Point*) l->data;
-		l = l->next;
-		if (p->x >= x1 && p->y >= y1 && p->x <= x2 && p->y <= y2)
-		{
-			part->points = g_list_remove(part->points, p);
-			delete p;
-			if (current)
-			{
-				lists = g_list_append(lists, current);
-				current = NULL;
-			}
-			changed = true;
-		}
-		else
-		{
-			current = g_list_append(current, p);
-		}
-	}
+	addRepaintRect(x, y, fabs(a.x - b.x) + width, fabs(a.y - b.y) + width);
+}
 
-	if (current)
-	{
-		lists = g_list_append(lists, current);
-		current = NULL;
-	}
+void EraseableStroke::addRepaintRect(double x, double y, double width, double height)
+{
+	XOJ_CHECK_TYPE(EraseableStroke);
 
-	g_list_free(part->points);
-	part->points = NULL;
-	if (lists)
+	if (this->repaintRect)
 	{
-		part->points = (GList*) lists->data;
-		lists = g_list_delete_link(lists, lists);
-
-		int pos = g_list_index(list->data, part) + 1;
-		
-		// create data structure for all new (splitted) parts
-		for (GList* l = lists; l != NULL; l = l->next)
-		{
-			EraseableStrokePart* newPart = new EraseableStrokePart(part->width);
-			newPart->points = (GList*) l->data;
-			list->data = g_list_insert(list->data, newPart, pos++);
-		}
-
-		g_list_free(lists);
+		this->repaintRect->addPoint(x, y);
 	}
 	else
 	{
-		// no parts, all deleted
-		list->data = g_list_remove(list->data, part);
-		*deleteStrokeAfter = true;
+		this->repaintRect = new Range(x, y);
 	}
 
-	return changed;
+	this->repaintRect->addPoint(x + width, y + height);
 }
 
 GList* EraseableStroke::getStroke(Stroke* original)
 {
 	XOJ_CHECK_TYPE(EraseableStroke);
 
+	// Also called by the render thread while the main thread erases
+	g_mutex_lock(&this->partLock);
+	vector<EraseableStrokePart> tmpCopy = this->parts;
+	g_mutex_unlock(&this->partLock);
+
 	GList* list = NULL;
 
 	Stroke* s = NULL;
-	Point lastPoint(NAN, NAN);
-	for (GList* l = this->parts->data; l != NULL; l = l->next)
+	Point lastPoint;
+	const EraseableStrokePart* last = NULL;
+	for (const EraseableStrokePart& part : tmpCopy)
 	{
-		EraseableStrokePart* p = (EraseableStrokePart*) l->data;
-		GList* points = p->getPoints();
-		if (g_list_length(points) < 2)
-		{
-			continue;
-		}
-
-		Point a = *((Point*) g_list_first(points)->data);
-		Point b = *((Point*) g_list_last(points)->data);
-		a.z = p->width;
-
-		if (!lastPoint.equalsPos(a) || s == NULL)
+		if (last == NULL || !part.continues(*last))
 		{
 			if (s)
 			{
@@ -389,8 +328,15 @@ GList* EraseableStroke::getStroke(Stroke* original)
 			s->setWidth(original->getWidth());
 			list = g_list_append(list, s);
 		}
-		s->addPoint(a);
-		lastPoint = b;
+
+		s->addPoint(pointAt(part.segment, part.t0));
+
+		lastPoint = pointAt(part.segment, part.t1);
+		if (part.t1 == 1.0)
+		{
+			lastPoint.z = this->pz[part.segment + 1];
+		}
+		last = &part;
 	}
 	if (s)
 	{
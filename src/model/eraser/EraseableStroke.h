@@ -11,16 +11,21 @@
 
 #pragma once
 
+#include "EraseableStrokePart.h"
 #include "model/Point.h"
+#include "model/StrokeSegmentIndex.h"
 #include <XournalType.h>
 
 #include <gtk/gtk.h>
 
-class EraseableStrokePart;
-class PartList;
 class Range;
 class Stroke;
 
+/**
+ * Parts shorter than this (in document coordinates) are dropped while erasing
+ */
+#define ERASER_MIN_PART_LENGTH 0.01
+
 class EraseableStroke
 {
 public:
@@ -33,23 +38,69 @@ public:
 	 */
 	Range* erase(double x, double y, double halfEraserSize, Range* range = NULL);
 
+	/**
+	 * Creates the strokes which remain after erasing, in one pass over the parts
+	 */
 	GList* getStroke(Stroke* original);
 
 	void draw(cairo_t* cr);
 
+	/**
+	 * @return The number of remaining parts
+	 */
+	int getPartCount();
+
 private:
-	void erase(double x, double y, double halfEraserSize, EraseableStrokePart* part, PartList* list);
-	bool erasePart(double x, double y, double halfEraserSize, EraseableStrokePart* part,
-				   PartList* list, bool* deleteStrokeAfter);
+	/**
+	 * Marks all segments which are touched by the eraser circle
+	 *
+	 * @return true if any segment was hit
+	 */
+	bool findHitSegments(double x, double y, double radius);
+
+	/**
+	 * Calculates the interval of the segment within the eraser circle
+	 */
+	void eraseInterval(int segment, double x, double y, double radius, double& t0, double& t1);
+
+	Point pointAt(int segment, double t);
+	double getSegmentLength(int segment);
 
 	void addRepaintRect(double x, double y, double width, double height);
+	void addRepaintPart(int segment, double t0, double t1);
 
 private:
 	XOJ_TYPE_ATTRIB;
 
-
 	GMutex partLock;
-	PartList * parts = NULL;
+
+	/**
+	 * The remaining parts, sorted by segment and position
+	 */
+	vector<EraseableStrokePart> parts;
+
+	/**
+	 * The original points, stored as separate arrays, so the
+	 * distance test runs over contiguous memory
+	 */
+	vector<double> px;
+	vector<double> py;
+	vector<double> pz;
+
+	/**
+	 * Result of the last distance test, one entry per segment
+	 */
+	vector<unsigned char> hit;
+
+	/**
+	 * Bounding boxes of the original segments, only segments near the eraser are tested
+	 */
+	StrokeSegmentIndex segmentIndex;
+
+	/**
+	 * The segment ranges tested last, only their hit entries have to be reset
+	 */
+	vector<std::pair<int, int>> candidates;
 
 	Range* repaintRect = NULL;
 
@@ -1,7 +1,7 @@
 /*
  * Xournal++
  *
- * A stroke which is temporary used if you erase a part
+ * A part of a stroke which is not yet erased
  *
  * @author Xournal++ Team
  * https://github.com/xournalpp/xournalpp
@@ -11,52 +11,40 @@
 
 #pragma once
 
-#include "model/Point.h"
-#include <XournalType.h>
-
+/**
+ * The remaining interval [t0, t1] of one segment of the original stroke.
+ *
+ * This is a plain value, the parts are stored contiguously in the
+ * EraseableStroke, the geometry is taken from the original points.
+ */
 class EraseableStrokePart
 {
 public:
-	EraseableStrokePart(Point a, Point b);
-	EraseableStrokePart(double width);
-	virtual ~EraseableStrokePart();
-
-private:
-	EraseableStrokePart(const EraseableStrokePart& part);
+	EraseableStrokePart(int segment, double t0, double t1)
+	 : segment(segment),
+	   t0(t0),
+	   t1(t1)
+	{
+	}
 
 public:
-	void addPoint(Point p);
-	double getWidth();
-
-	GList* getPoints();
-
-	void clearSplitData();
-	void splitFor(double halfEraserSize);
-
-	EraseableStrokePart* clone();
-
-	void calcSize();
+	/**
+	 * @return true if this part continues the part before without a gap
+	 */
+	bool continues(const EraseableStrokePart& before) const
+	{
+		return before.segment + 1 == this->segment && before.t1 == 1.0 && this->t0 == 0.0;
+	}
 
 public:
-	double getX();
-	double getY();
-	double getElementWidth();
-	double getElementHeight();
-
-	static void printDebugStrokeParts();
-
-private:
-	XOJ_TYPE_ATTRIB;
-
-	double width = 0;
-	double splitSize = 0;
-
-	GList* points = NULL;
-
-	double x = 0;
-	double y = 0;
-	double elementWidth = 0;
-	double elementHeight = 0;
-
-	friend class EraseableStroke;
+	/**
+	 * Index of the segment, the segment goes from point[segment] to point[segment + 1]
+	 */
+	int segment;
+
+	/**
+	 * Start and end of the remaining part, as parameter on the segment
+	 */
+	double t0;
+	double t1;
 };
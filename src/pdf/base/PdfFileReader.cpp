@@ -0,0 +1,1121 @@
+#include "PdfFileReader.h"
+
+#include <i18n.h>
+
+#include <glib.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Maximum nesting of arrays and dictionaries, deeper objects are treated as broken
+ */
+#define PDF_MAX_OBJECT_DEPTH 100
+
+/**
+ * Maximum depth of the page tree and of the parents of a page
+ */
+#define PDF_MAX_TREE_DEPTH 64
+
+static bool isPdfWhitespace(char c)
+{
+	return c == '\0' || c == '\t' || c == '\n' || c == '\f' || c == '\r' || c == ' ';
+}
+
+static bool isPdfDelimiter(char c)
+{
+	return c != '\0' && strchr("()<>[]{}/%", c) != NULL;
+}
+
+/**
+ * Tokenizer and object parser working on a buffer
+ */
+class PdfParser
+{
+public:
+	PdfParser(const string& data, size_t pos)
+	 : data(data),
+	   pos(std::min(pos, data.size()))
+	{
+	}
+
+public:
+	void skipWhitespace()
+	{
+		while (this->pos < this->data.size())
+		{
+			char c = this->data[this->pos];
+			if (c == '%')
+			{
+				while (this->pos < this->data.size() && this->data[this->pos] != '\n' && this->data[this->pos] != '\r')
+				{
+					this->pos++;
+				}
+			}
+			else if (isPdfWhitespace(c))
+			{
+				this->pos++;
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	/**
+	 * Reads characters up to the next whitespace or delimiter
+	 */
+	string readRegular()
+	{
+		size_t start = this->pos;
+		while (this->pos < this->data.size() && !isPdfWhitespace(this->data[this->pos]) &&
+			   !isPdfDelimiter(this->data[this->pos]))
+		{
+			this->pos++;
+		}
+
+		return this->data.substr(start, this->pos - start);
+	}
+
+	/**
+	 * Reads the keyword if it is the next token, else nothing is read
+	 */
+	bool readKeyword(const char* keyword)
+	{
+		skipWhitespace();
+
+		size_t start = this->pos;
+		if (readRegular() == keyword)
+		{
+			return true;
+		}
+
+		this->pos = start;
+		return false;
+	}
+
+	/**
+	 * Reads an integer if it is the next token, else nothing is read
+	 */
+	bool readInteger(long& value)
+	{
+		skipWhitespace();
+
+		size_t start = this->pos;
+		string token = readRegular();
+		if (!isNumber(token) || token.find('.') != string::npos)
+		{
+			this->pos = start;
+			return false;
+		}
+
+		value = strtol(token.c_str(), NULL, 10);
+		return true;
+	}
+
+	PdfObject parseObject(int depth = 0)
+	{
+		skipWhitespace();
+
+		if (depth > PDF_MAX_OBJECT_DEPTH || this->pos >= this->data.size())
+		{
+			return fail();
+		}
+
+		char c = this->data[this->pos];
+		if (c == '/')
+		{
+			this->pos++;
+			return PdfObject::createName(readRegular());
+		}
+
+		if (c == '(')
+		{
+			return parseLiteralString();
+		}
+
+		if (c == '<' && this->pos + 1 < this->data.size() && this->data[this->pos + 1] == '<')
+		{
+			return parseDict(depth);
+		}
+
+		if (c == '<')
+		{
+			size_t end = this->data.find('>', this->pos);
+			if (end == string::npos)
+			{
+				return fail();
+			}
+
+			PdfObject o = PdfObject::createToken(PDF_OBJECT_STRING, this->data.substr(this->pos, end + 1 - this->pos));
+			this->pos = end + 1;
+			return o;
+		}
+
+		if (c == '[')
+		{
+			return parseArray(depth);
+		}
+
+		string token = readRegular();
+		if (isNumber(token))
+		{
+			return parseNumberOrRef(token);
+		}
+
+		if (token == "true" || token == "false")
+		{
+			return PdfObject::createToken(PDF_OBJECT_BOOL, token);
+		}
+
+		if (token == "null")
+		{
+			return PdfObject();
+		}
+
+		return fail();
+	}
+
+	bool hasFailed()
+	{
+		return this->failed;
+	}
+
+	size_t getPosition()
+	{
+		return this->pos;
+	}
+
+private:
+	static bool isNumber(const string& token)
+	{
+		if (token.empty())
+		{
+			return false;
+		}
+
+		bool digit = false;
+		for (char c : token)
+		{
+			if (c >= '0' && c <= '9')
+			{
+				digit = true;
+			}
+			else if (c != '+' && c != '-' && c != '.')
+			{
+				return false;
+			}
+		}
+
+		return digit;
+	}
+
+	PdfObject fail()
+	{
+		this->failed = true;
+		return PdfObject();
+	}
+
+	PdfObject parseLiteralString()
+	{
+		size_t start = this->pos;
+		int level = 0;
+
+		while (this->pos < this->data.size())
+		{
+			char c = this->data[this->pos++];
+			if (c == '\\')
+			{
+				this->pos++;
+			}
+			else if (c == '(')
+			{
+				level++;
+			}
+			else if (c == ')' && --level == 0)
+			{
+				return PdfObject::createToken(PDF_OBJECT_STRING, this->data.substr(start, this->pos - start));
+			}
+		}
+
+		return fail();
+	}
+
+	PdfObject parseDict(int depth)
+	{
+		this->pos += 2;
+
+		PdfObject dict = PdfObject::createDict();
+		while (true)
+		{
+			skipWhitespace();
+			if (this->pos + 1 >= this->data.size())
+			{
+				return fail();
+			}
+
+			if (this->data[this->pos] == '>' && this->data[this->pos + 1] == '>')
+			{
+				this->pos += 2;
+				return dict;
+			}
+
+			if (this->data[this->pos] != '/')
+			{
+				return fail();
+			}
+
+			this->pos++;
+			string key = readRegular();
+
+			PdfObject value = parseObject(depth + 1);
+			if (this->failed)
+			{
+				return PdfObject();
+			}
+
+			dict.set(key, value);
+		}
+	}
+
+	PdfObject parseArray(int depth)
+	{
+		this->pos++;
+
+		PdfObject array = PdfObject::createArray();
+		while (true)
+		{
+			skipWhitespace();
+			if (this->pos >= this->data.size())
+			{
+				return fail();
+			}
+
+			if (this->data[this->pos] == ']')
+			{
+				this->pos++;
+				return array;
+			}
+
+			PdfObject item = parseObject(depth + 1);
+			if (this->failed)
+			{
+				return PdfObject();
+			}
+
+			array.getArray().push_back(item);
+		}
+	}
+
+	PdfObject parseNumberOrRef(const string& token)
+	{
+		if (token.find('.') == string::npos)
+		{
+			size_t afterNumber = this->pos;
+
+			long gen = 0;
+			if (readInteger(gen) && readKeyword("R"))
+			{
+				return PdfObject::createRef(strtol(token.c_str(), NULL, 10), gen);
+			}
+
+			this->pos = afterNumber;
+		}
+
+		return PdfObject::createToken(PDF_OBJECT_NUMBER, token);
+	}
+
+private:
+	const string& data;
+	size_t pos;
+	bool failed = false;
+};
+
+static bool inflateData(const string& input, string& output)
+{
+	z_stream zs;
+	memset(&zs, 0, sizeof(zs));
+	if (inflateInit(&zs) != Z_OK)
+	{
+		return false;
+	}
+
+	zs.next_in = (Bytef*) input.data();
+	zs.avail_in = input.size();
+
+	output.clear();
+	char buffer[65536];
+	int ret = Z_OK;
+	while (ret == Z_OK)
+	{
+		zs.next_out = (Bytef*) buffer;
+		zs.avail_out = sizeof(buffer);
+		ret = inflate(&zs, Z_NO_FLUSH);
+		output.append(buffer, sizeof(buffer) - zs.avail_out);
+	}
+
+	inflateEnd(&zs);
+
+	// Some writers cut off the end of the stream, the data up to there is still used
+	return ret == Z_STREAM_END || (ret == Z_BUF_ERROR && zs.avail_in == 0);
+}
+
+/**
+ * Reverts the PNG predictors, each row starts with the predictor type
+ */
+static bool removePngPredictor(string& data, int colors, int bitsPerComponent, int columns)
+{
+	size_t bpp = std::max(1, colors * bitsPerComponent / 8);
+	size_t rowLength = ((size_t) colors * bitsPerComponent * columns + 7) / 8;
+	if (rowLength == 0)
+	{
+		return false;
+	}
+
+	string result;
+	result.reserve(data.size() / (rowLength + 1) * rowLength);
+
+	vector<unsigned char> previous(rowLength, 0);
+	vector<unsigned char> row(rowLength);
+	for (size_t start = 0; start + 1 + rowLength <= data.size(); start += rowLength + 1)
+	{
+		int predictor = (unsigned char) data[start];
+		const unsigned char* in = (const unsigned char*) data.data() + start + 1;
+
+		for (size_t i = 0; i < rowLength; i++)
+		{
+			int left = i >= bpp ? row[i - bpp] : 0;
+			int up = previous[i];
+			int upLeft = i >= bpp ? previous[i - bpp] : 0;
+
+			switch (predictor)
+			{
+			case 0:
+				row[i] = in[i];
+				break;
+			case 1:
+				row[i] = in[i] + left;
+				break;
+			case 2:
+				row[i] = in[i] + up;
+				break;
+			case 3:
+				row[i] = in[i] + (left + up) / 2;
+				break;
+			case 4:
+			{
+				int p = left + up - upLeft;
+				int pa = std::abs(p - left);
+				int pb = std::abs(p - up);
+				int pc = std::abs(p - upLeft);
+				row[i] = in[i] + ((pa <= pb && pa <= pc) ? left : (pb <= pc ? up : upLeft));
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+
+		result.append((const char*) row.data(), rowLength);
+		previous.swap(row);
+	}
+
+	data.swap(result);
+	return true;
+}
+
+PdfFileReader::PdfFileReader()
+{
+	XOJ_INIT_TYPE(PdfFileReader);
+}
+
+PdfFileReader::~PdfFileReader()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	XOJ_RELEASE_TYPE(PdfFileReader);
+}
+
+bool PdfFileReader::load(Path file)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	gchar* contents = NULL;
+	gsize length = 0;
+	GError* error = NULL;
+	if (!g_file_get_contents(file.c_str(), &contents, &length, &error))
+	{
+		string message = error->message;
+		g_error_free(error);
+		return setError(message);
+	}
+
+	string data(contents, length);
+	g_free(contents);
+
+	return loadData(data);
+}
+
+bool PdfFileReader::loadData(string data)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	this->data.swap(data);
+	this->trailer = PdfObject();
+	this->xrefStream = false;
+	this->xref.clear();
+	this->objects.clear();
+	this->objectStreams.clear();
+	this->loading.clear();
+
+	size_t pos = this->data.rfind("startxref");
+	if (pos == string::npos)
+	{
+		return setError("startxref not found");
+	}
+
+	PdfParser parser(this->data, pos + strlen("startxref"));
+	long offset = 0;
+	if (!parser.readInteger(offset) || offset < 0)
+	{
+		return setError("Invalid startxref");
+	}
+	this->startXref = offset;
+
+	std::set<size_t> visited;
+	if (!readXrefSection(this->startXref, visited))
+	{
+		return false;
+	}
+
+	if (!this->trailer.isDict())
+	{
+		return setError("No trailer found");
+	}
+
+	return true;
+}
+
+bool PdfFileReader::readXrefSection(size_t offset, std::set<size_t>& visited)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	if (visited.count(offset))
+	{
+		return true;
+	}
+	visited.insert(offset);
+
+	if (offset >= this->data.size())
+	{
+		return setError("Cross reference offset out of range");
+	}
+
+	PdfObject sectionTrailer;
+	PdfParser parser(this->data, offset);
+	bool stream = !parser.readKeyword("xref");
+	if (!(stream ? readXrefStream(offset, sectionTrailer) : readXrefTable(offset, sectionTrailer)))
+	{
+		return false;
+	}
+
+	if (this->trailer.isNull())
+	{
+		this->trailer = sectionTrailer;
+		this->xrefStream = stream;
+	}
+
+	// Hybrid files, the entries of the stream come after the table of the same section
+	const PdfObject* xrefStm = sectionTrailer.get("XRefStm");
+	if (xrefStm && xrefStm->isNumber() && !visited.count(xrefStm->getInteger()))
+	{
+		visited.insert(xrefStm->getInteger());
+		PdfObject ignored;
+		if (!readXrefStream(xrefStm->getInteger(), ignored))
+		{
+			return false;
+		}
+	}
+
+	const PdfObject* prev = sectionTrailer.get("Prev");
+	if (prev && prev->isNumber() && prev->getInteger() >= 0)
+	{
+		return readXrefSection(prev->getInteger(), visited);
+	}
+
+	return true;
+}
+
+bool PdfFileReader::readXrefTable(size_t offset, PdfObject& trailer)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	PdfParser parser(this->data, offset);
+	parser.readKeyword("xref");
+
+	long start = 0;
+	while (parser.readInteger(start))
+	{
+		long count = 0;
+		if (!parser.readInteger(count) || start < 0 || count < 0)
+		{
+			return setError("Invalid cross reference table");
+		}
+
+		for (long i = 0; i < count; i++)
+		{
+			long entryOffset = 0;
+			long gen = 0;
+			if (!parser.readInteger(entryOffset) || !parser.readInteger(gen))
+			{
+				return setError("Invalid cross reference table");
+			}
+
+			parser.skipWhitespace();
+			string kind = parser.readRegular();
+			if (kind != "n" && kind != "f")
+			{
+				return setError("Invalid cross reference table");
+			}
+
+			// Newer sections are read first and win, free entries hide older versions
+			int num = start + i;
+			if (!this->xref.count(num))
+			{
+				XrefEntry entry = { kind == "n" ? 1 : 0, (size_t) entryOffset, (int) gen };
+				this->xref[num] = entry;
+			}
+		}
+	}
+
+	if (!parser.readKeyword("trailer"))
+	{
+		return setError("trailer not found");
+	}
+
+	trailer = parser.parseObject();
+	if (parser.hasFailed() || !trailer.isDict())
+	{
+		return setError("Invalid trailer");
+	}
+
+	return true;
+}
+
+bool PdfFileReader::readXrefStream(size_t offset, PdfObject& trailer)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	PdfObject stream;
+	if (!parseIndirectObject(offset, -1, stream))
+	{
+		return false;
+	}
+
+	const PdfObject* type = stream.get("Type");
+	if (!stream.isStream() || !type || !type->isName("XRef"))
+	{
+		return setError("Invalid cross reference stream");
+	}
+
+	string decoded;
+	if (!decodeStream(stream, decoded))
+	{
+		return false;
+	}
+
+	const PdfObject* w = stream.get("W");
+	if (!w || !w->isArray() || w->getArray().size() != 3)
+	{
+		return setError("Invalid cross reference stream");
+	}
+
+	size_t widths[3];
+	size_t entryWidth = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		long width = w->getArray()[i].getInteger();
+		if (width < 0 || width > 8)
+		{
+			return setError("Invalid cross reference stream");
+		}
+		widths[i] = width;
+		entryWidth += width;
+	}
+
+	vector<long> index;
+	const PdfObject* indexObject = stream.get("Index");
+	if (indexObject && indexObject->isArray())
+	{
+		for (const PdfObject& o : indexObject->getArray())
+		{
+			index.push_back(o.getInteger());
+		}
+	}
+	else
+	{
+		const PdfObject* size = stream.get("Size");
+		index.push_back(0);
+		index.push_back(size ? size->getInteger() : 0);
+	}
+
+	size_t pos = 0;
+	for (size_t i = 0; i + 1 < index.size(); i += 2)
+	{
+		for (long num = index[i]; num < index[i] + index[i + 1]; num++)
+		{
+			if (pos + entryWidth > decoded.size())
+			{
+				return setError("Cross reference stream too short");
+			}
+
+			size_t fields[3];
+			for (int f = 0; f < 3; f++)
+			{
+				fields[f] = 0;
+				for (size_t b = 0; b < widths[f]; b++)
+				{
+					fields[f] = (fields[f] << 8) | (unsigned char) decoded[pos++];
+				}
+			}
+
+			// Without a type field, all entries are objects in the file
+			if (widths[0] == 0)
+			{
+				fields[0] = 1;
+			}
+
+			if (!this->xref.count(num))
+			{
+				XrefEntry entry = { (int) fields[0], fields[1], fields[0] == 1 ? (int) fields[2] : 0 };
+				this->xref[num] = entry;
+			}
+		}
+	}
+
+	trailer = PdfObject::createDict();
+	trailer.getEntries() = stream.getEntries();
+
+	return true;
+}
+
+bool PdfFileReader::parseIndirectObject(size_t offset, int num, PdfObject& result)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	PdfParser parser(this->data, offset);
+	long objNum = 0;
+	long objGen = 0;
+	if (!parser.readInteger(objNum) || !parser.readInteger(objGen) || !parser.readKeyword("obj") ||
+		(num >= 0 && objNum != num))
+	{
+		return setError(FS(FORMAT_STR("Object {1} not found at offset {2}") % num % offset));
+	}
+
+	result = parser.parseObject();
+	if (parser.hasFailed())
+	{
+		return setError(FS(FORMAT_STR("Object {1} could not be parsed") % objNum));
+	}
+
+	if (!result.isDict() || !parser.readKeyword("stream"))
+	{
+		return true;
+	}
+
+	size_t start = parser.getPosition();
+	if (start < this->data.size() && this->data[start] == '\r')
+	{
+		start++;
+	}
+	if (start < this->data.size() && this->data[start] == '\n')
+	{
+		start++;
+	}
+
+	long length = -1;
+	const PdfObject* lengthObject = result.get("Length");
+	if (lengthObject)
+	{
+		PdfObject l = resolve(*lengthObject);
+		if (l.isNumber())
+		{
+			length = l.getInteger();
+		}
+	}
+
+	// Check the length, if it is wrong the data ends before the next endstream
+	if (length >= 0 && start + length <= this->data.size())
+	{
+		PdfParser end(this->data, start + length);
+		if (!end.readKeyword("endstream"))
+		{
+			length = -1;
+		}
+	}
+	else
+	{
+		length = -1;
+	}
+
+	if (length < 0)
+	{
+		size_t end = this->data.find("endstream", start);
+		if (end == string::npos)
+		{
+			return setError(FS(FORMAT_STR("Stream of object {1} not terminated") % objNum));
+		}
+
+		if (end > start && this->data[end - 1] == '\n')
+		{
+			end--;
+		}
+		if (end > start && this->data[end - 1] == '\r')
+		{
+			end--;
+		}
+
+		length = end - start;
+	}
+
+	result.remove("Length");
+	result.setStreamData(this->data.substr(start, length));
+
+	return true;
+}
+
+bool PdfFileReader::loadObjectStream(int num)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	if (this->objectStreams.count(num))
+	{
+		return true;
+	}
+
+	PdfObject stream = getObject(num);
+	if (!stream.isStream())
+	{
+		return setError(FS(FORMAT_STR("Object stream {1} not found") % num));
+	}
+
+	ObjectStream objects;
+	if (!decodeStream(stream, objects.data))
+	{
+		return false;
+	}
+
+	const PdfObject* n = stream.get("N");
+	const PdfObject* first = stream.get("First");
+	if (!n || !first)
+	{
+		return setError(FS(FORMAT_STR("Invalid object stream {1}") % num));
+	}
+
+	PdfParser parser(objects.data, 0);
+	for (long i = 0; i < n->getInteger(); i++)
+	{
+		long objNum = 0;
+		long offset = 0;
+		if (!parser.readInteger(objNum) || !parser.readInteger(offset))
+		{
+			return setError(FS(FORMAT_STR("Invalid object stream {1}") % num));
+		}
+
+		objects.offsets[objNum] = first->getInteger() + offset;
+	}
+
+	this->objectStreams[num] = objects;
+	return true;
+}
+
+PdfObject PdfFileReader::getObject(int num)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	auto cached = this->objects.find(num);
+	if (cached != this->objects.end())
+	{
+		return cached->second;
+	}
+
+	auto it = this->xref.find(num);
+	if (it == this->xref.end() || this->loading.count(num))
+	{
+		return PdfObject();
+	}
+
+	XrefEntry entry = it->second;
+	PdfObject result;
+
+	// A stream length may reference the stream itself in a broken file
+	this->loading.insert(num);
+
+	if (entry.type == 1)
+	{
+		parseIndirectObject(entry.offset, num, result);
+	}
+	else if (entry.type == 2 && loadObjectStream(entry.offset))
+	{
+		ObjectStream& stream = this->objectStreams[entry.offset];
+		auto offset = stream.offsets.find(num);
+		if (offset != stream.offsets.end())
+		{
+			PdfParser parser(stream.data, offset->second);
+			result = parser.parseObject();
+			if (parser.hasFailed())
+			{
+				result = PdfObject();
+			}
+		}
+	}
+
+	this->loading.erase(num);
+
+	this->objects[num] = result;
+	return result;
+}
+
+PdfObject PdfFileReader::resolve(const PdfObject& o)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	if (o.isRef())
+	{
+		return getObject(o.getRefNum());
+	}
+
+	return o;
+}
+
+bool PdfFileReader::decodeStream(const PdfObject& stream, string& result)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	vector<PdfObject> filters;
+	vector<PdfObject> params;
+
+	const PdfObject* filter = stream.get("Filter");
+	PdfObject f = filter ? resolve(*filter) : PdfObject();
+	if (f.isArray())
+	{
+		for (const PdfObject& o : f.getArray())
+		{
+			filters.push_back(resolve(o));
+		}
+	}
+	else if (!f.isNull())
+	{
+		filters.push_back(f);
+	}
+
+	const PdfObject* param = stream.get("DecodeParms");
+	PdfObject p = param ? resolve(*param) : PdfObject();
+	if (p.isArray())
+	{
+		for (const PdfObject& o : p.getArray())
+		{
+			params.push_back(resolve(o));
+		}
+	}
+	else
+	{
+		params.push_back(p);
+	}
+
+	result = stream.getStreamData();
+
+	for (size_t i = 0; i < filters.size(); i++)
+	{
+		if (!filters[i].isName("FlateDecode") && !filters[i].isName("Fl"))
+		{
+			return setError("Unsupported stream filter " + filters[i].getName());
+		}
+
+		string decoded;
+		if (!inflateData(result, decoded))
+		{
+			return setError("Stream could not be inflated");
+		}
+		result.swap(decoded);
+
+		PdfObject parms = i < params.size() ? params[i] : PdfObject();
+		const PdfObject* predictor = parms.get("Predictor");
+		if (!predictor || predictor->getInteger() <= 1)
+		{
+			continue;
+		}
+
+		if (predictor->getInteger() < 10)
+		{
+			return setError("Unsupported TIFF predictor");
+		}
+
+		const PdfObject* colors = parms.get("Colors");
+		const PdfObject* bits = parms.get("BitsPerComponent");
+		const PdfObject* columns = parms.get("Columns");
+		if (!removePngPredictor(result, colors ? colors->getInteger() : 1, bits ? bits->getInteger() : 8,
+								columns ? columns->getInteger() : 1))
+		{
+			return setError("Invalid PNG predictor");
+		}
+	}
+
+	return true;
+}
+
+vector<int> PdfFileReader::getPages()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	vector<int> pages;
+	std::set<int> visited;
+
+	PdfObject root = resolve(this->trailer.get("Root") ? *this->trailer.get("Root") : PdfObject());
+	const PdfObject* tree = root.get("Pages");
+	if (tree)
+	{
+		collectPages(*tree, pages, visited);
+	}
+
+	return pages;
+}
+
+void PdfFileReader::collectPages(const PdfObject& node, vector<int>& pages, std::set<int>& visited)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	// Pages are always indirect objects, a loop in the tree is broken here
+	if (!node.isRef() || visited.count(node.getRefNum()))
+	{
+		return;
+	}
+	visited.insert(node.getRefNum());
+
+	PdfObject o = getObject(node.getRefNum());
+	if (!o.isDict())
+	{
+		return;
+	}
+
+	const PdfObject* type = o.get("Type");
+	const PdfObject* kids = o.get("Kids");
+	if ((type && type->isName("Pages")) || (!type && kids))
+	{
+		PdfObject k = kids ? resolve(*kids) : PdfObject();
+		for (const PdfObject& kid : k.getArray())
+		{
+			collectPages(kid, pages, visited);
+		}
+	}
+	else
+	{
+		pages.push_back(node.getRefNum());
+	}
+}
+
+PdfObject PdfFileReader::getInheritedAttribute(const PdfObject& page, const string& key)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	PdfObject node = page;
+	for (int depth = 0; depth < PDF_MAX_TREE_DEPTH && node.isDict(); depth++)
+	{
+		const PdfObject* value = node.get(key);
+		if (value)
+		{
+			return *value;
+		}
+
+		const PdfObject* parent = node.get("Parent");
+		if (!parent)
+		{
+			break;
+		}
+		node = resolve(*parent);
+	}
+
+	return PdfObject();
+}
+
+string PdfFileReader::getLastError()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	return this->lastError;
+}
+
+const string& PdfFileReader::getData()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	return this->data;
+}
+
+const PdfObject& PdfFileReader::getTrailer()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	return this->trailer;
+}
+
+bool PdfFileReader::isEncrypted()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	return this->trailer.get("Encrypt") != NULL;
+}
+
+bool PdfFileReader::hasXrefStream()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	return this->xrefStream;
+}
+
+size_t PdfFileReader::getStartXref()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	return this->startXref;
+}
+
+int PdfFileReader::getObjectCount()
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	const PdfObject* size = this->trailer.get("Size");
+	int count = size ? size->getInteger() : 0;
+
+	// Broken files may contain objects above Size
+	for (auto& it : this->xref)
+	{
+		count = std::max(count, it.first + 1);
+	}
+
+	return count;
+}
+
+int PdfFileReader::getGeneration(int num)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	auto it = this->xref.find(num);
+	if (it == this->xref.end() || it->second.type != 1)
+	{
+		return 0;
+	}
+
+	return it->second.gen;
+}
+
+bool PdfFileReader::setError(string error)
+{
+	XOJ_CHECK_TYPE(PdfFileReader);
+
+	this->lastError = error;
+	return false;
+}
@@ -0,0 +1,167 @@
+/*
+ * Xournal++
+ *
+ * Reads the object structure of a PDF file
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "PdfObject.h"
+
+#include <Path.h>
+#include <XournalType.h>
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+/**
+ * Gives access to the objects of a PDF file without interpreting the pages,
+ * for tools which copy objects into another file.
+ *
+ * Cross reference tables, cross reference streams and object streams are
+ * supported, including incremental updates. Encrypted files can be opened,
+ * but the strings and streams are not decrypted.
+ *
+ * All errors are reported by the return values, the reason is available with
+ * getLastError.
+ */
+class PdfFileReader
+{
+public:
+	PdfFileReader();
+	virtual ~PdfFileReader();
+
+private:
+	PdfFileReader(const PdfFileReader& reader);
+	void operator=(const PdfFileReader& reader);
+
+public:
+	/**
+	 * Reads the file into memory and parses the cross reference sections
+	 */
+	bool load(Path file);
+
+	/**
+	 * Parses a PDF file which is already in memory
+	 */
+	bool loadData(string data);
+
+	string getLastError();
+
+	/**
+	 * @return The complete file
+	 */
+	const string& getData();
+
+	/**
+	 * @return The trailer dictionary of the newest cross reference section
+	 */
+	const PdfObject& getTrailer();
+
+	bool isEncrypted();
+
+	/**
+	 * @return true if the newest cross reference section is a stream
+	 */
+	bool hasXrefStream();
+
+	/**
+	 * @return The offset of the newest cross reference section
+	 */
+	size_t getStartXref();
+
+	/**
+	 * @return The Size entry of the trailer, all object numbers are lower
+	 */
+	int getObjectCount();
+
+	/**
+	 * @return The generation of the current version of the object
+	 */
+	int getGeneration(int num);
+
+	/**
+	 * @return The object, null if it is not in the file or cannot be parsed
+	 */
+	PdfObject getObject(int num);
+
+	/**
+	 * @return The referenced object if o is a reference, else o
+	 */
+	PdfObject resolve(const PdfObject& o);
+
+	/**
+	 * Removes the filters of a stream, only FlateDecode is supported
+	 */
+	bool decodeStream(const PdfObject& stream, string& result);
+
+	/**
+	 * @return The object numbers of all pages, in document order
+	 */
+	vector<int> getPages();
+
+	/**
+	 * @return The entry of a page, or of the nearest node of the page tree which
+	 *         has it. Null if there is none. References are not resolved.
+	 */
+	PdfObject getInheritedAttribute(const PdfObject& page, const string& key);
+
+private:
+	bool readXrefSection(size_t offset, std::set<size_t>& visited);
+	bool readXrefTable(size_t offset, PdfObject& trailer);
+	bool readXrefStream(size_t offset, PdfObject& trailer);
+
+	bool parseIndirectObject(size_t offset, int num, PdfObject& result);
+	bool loadObjectStream(int num);
+
+	void collectPages(const PdfObject& node, vector<int>& pages, std::set<int>& visited);
+
+	bool setError(string error);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	/**
+	 * Position of an object in the file
+	 */
+	struct XrefEntry
+	{
+		/**
+		 * 1: at offset, 2: in the object stream offset
+		 */
+		int type;
+		size_t offset;
+		int gen;
+	};
+
+	/**
+	 * Decoded object stream
+	 */
+	struct ObjectStream
+	{
+		string data;
+		std::map<int, size_t> offsets;
+	};
+
+	string data;
+	string lastError;
+
+	PdfObject trailer;
+	bool xrefStream = false;
+	size_t startXref = 0;
+
+	std::unordered_map<int, XrefEntry> xref;
+	std::unordered_map<int, PdfObject> objects;
+	std::unordered_map<int, ObjectStream> objectStreams;
+
+	/**
+	 * Objects which are currently parsed
+	 */
+	std::set<int> loading;
+};
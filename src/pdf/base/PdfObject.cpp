@@ -0,0 +1,324 @@
+#include "PdfObject.h"
+
+#include <glib.h>
+
+#include <cstdlib>
+
+PdfObject::PdfObject()
+{
+}
+
+PdfObject PdfObject::createBool(bool value)
+{
+	return createToken(PDF_OBJECT_BOOL, value ? "true" : "false");
+}
+
+PdfObject PdfObject::createInteger(long value)
+{
+	char buffer[32];
+	g_snprintf(buffer, sizeof(buffer), "%ld", value);
+	return createToken(PDF_OBJECT_NUMBER, buffer);
+}
+
+PdfObject PdfObject::createReal(double value)
+{
+	char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+	g_ascii_formatd(buffer, sizeof(buffer), "%.6f", value);
+
+	// PDF does not allow exponents, so a fixed format is used and the zeros are cut off
+	string text = buffer;
+	text.erase(text.find_last_not_of('0') + 1);
+	if (text.back() == '.')
+	{
+		text.pop_back();
+	}
+	if (text == "-0")
+	{
+		text = "0";
+	}
+
+	return createToken(PDF_OBJECT_NUMBER, text);
+}
+
+PdfObject PdfObject::createName(string name)
+{
+	return createToken(PDF_OBJECT_NAME, name);
+}
+
+PdfObject PdfObject::createRef(int num, int gen)
+{
+	PdfObject o;
+	o.type = PDF_OBJECT_REF;
+	o.num = num;
+	o.gen = gen;
+	return o;
+}
+
+PdfObject PdfObject::createArray()
+{
+	PdfObject o;
+	o.type = PDF_OBJECT_ARRAY;
+	return o;
+}
+
+PdfObject PdfObject::createDict()
+{
+	PdfObject o;
+	o.type = PDF_OBJECT_DICT;
+	return o;
+}
+
+PdfObject PdfObject::createStream(string data)
+{
+	PdfObject o;
+	o.type = PDF_OBJECT_STREAM;
+	o.data = data;
+	return o;
+}
+
+PdfObject PdfObject::createToken(PdfObjectType type, string text)
+{
+	PdfObject o;
+	o.type = type;
+	o.text = text;
+	return o;
+}
+
+PdfObjectType PdfObject::getType() const
+{
+	return this->type;
+}
+
+bool PdfObject::isNull() const
+{
+	return this->type == PDF_OBJECT_NULL;
+}
+
+bool PdfObject::isNumber() const
+{
+	return this->type == PDF_OBJECT_NUMBER;
+}
+
+bool PdfObject::isName(const char* name) const
+{
+	return this->type == PDF_OBJECT_NAME && (name == NULL || this->text == name);
+}
+
+bool PdfObject::isArray() const
+{
+	return this->type == PDF_OBJECT_ARRAY;
+}
+
+bool PdfObject::isRef() const
+{
+	return this->type == PDF_OBJECT_REF;
+}
+
+bool PdfObject::isStream() const
+{
+	return this->type == PDF_OBJECT_STREAM;
+}
+
+bool PdfObject::isDict() const
+{
+	return this->type == PDF_OBJECT_DICT || this->type == PDF_OBJECT_STREAM;
+}
+
+bool PdfObject::getBool() const
+{
+	return this->type == PDF_OBJECT_BOOL && this->text == "true";
+}
+
+long PdfObject::getInteger() const
+{
+	if (this->type != PDF_OBJECT_NUMBER)
+	{
+		return 0;
+	}
+
+	return strtol(this->text.c_str(), NULL, 10);
+}
+
+double PdfObject::getReal() const
+{
+	if (this->type != PDF_OBJECT_NUMBER)
+	{
+		return 0;
+	}
+
+	return g_ascii_strtod(this->text.c_str(), NULL);
+}
+
+const string& PdfObject::getName() const
+{
+	return this->text;
+}
+
+const string& PdfObject::getText() const
+{
+	return this->text;
+}
+
+int PdfObject::getRefNum() const
+{
+	return this->num;
+}
+
+int PdfObject::getRefGen() const
+{
+	return this->gen;
+}
+
+vector<PdfObject>& PdfObject::getArray()
+{
+	return this->items;
+}
+
+const vector<PdfObject>& PdfObject::getArray() const
+{
+	return this->items;
+}
+
+const PdfObject* PdfObject::get(const string& key) const
+{
+	for (const std::pair<string, PdfObject>& e : this->entries)
+	{
+		if (e.first == key)
+		{
+			return &e.second;
+		}
+	}
+
+	return NULL;
+}
+
+PdfObject* PdfObject::get(const string& key)
+{
+	for (std::pair<string, PdfObject>& e : this->entries)
+	{
+		if (e.first == key)
+		{
+			return &e.second;
+		}
+	}
+
+	return NULL;
+}
+
+void PdfObject::set(const string& key, PdfObject value)
+{
+	PdfObject* entry = get(key);
+	if (entry)
+	{
+		*entry = value;
+	}
+	else
+	{
+		this->entries.push_back(std::make_pair(key, value));
+	}
+}
+
+void PdfObject::remove(const string& key)
+{
+	for (auto it = this->entries.begin(); it != this->entries.end(); it++)
+	{
+		if (it->first == key)
+		{
+			this->entries.erase(it);
+			return;
+		}
+	}
+}
+
+vector<std::pair<string, PdfObject>>& PdfObject::getEntries()
+{
+	return this->entries;
+}
+
+const vector<std::pair<string, PdfObject>>& PdfObject::getEntries() const
+{
+	return this->entries;
+}
+
+string& PdfObject::getStreamData()
+{
+	return this->data;
+}
+
+const string& PdfObject::getStreamData() const
+{
+	return this->data;
+}
+
+void PdfObject::setStreamData(string data)
+{
+	this->type = PDF_OBJECT_STREAM;
+	this->data = data;
+}
+
+void PdfObject::write(string& out) const
+{
+	char buffer[32];
+
+	switch (this->type)
+	{
+	case PDF_OBJECT_NULL:
+		out += "null";
+		break;
+	case PDF_OBJECT_BOOL:
+	case PDF_OBJECT_NUMBER:
+	case PDF_OBJECT_STRING:
+		out += this->text;
+		break;
+	case PDF_OBJECT_NAME:
+		out += '/';
+		out += this->text;
+		break;
+	case PDF_OBJECT_REF:
+		g_snprintf(buffer, sizeof(buffer), "%d %d R", this->num, this->gen);
+		out += buffer;
+		break;
+	case PDF_OBJECT_ARRAY:
+		out += '[';
+		for (size_t i = 0; i < this->items.size(); i++)
+		{
+			if (i > 0)
+			{
+				out += ' ';
+			}
+			this->items[i].write(out);
+		}
+		out += ']';
+		break;
+	case PDF_OBJECT_DICT:
+	case PDF_OBJECT_STREAM:
+		out += "<<";
+		for (const std::pair<string, PdfObject>& e : this->entries)
+		{
+			if (this->type == PDF_OBJECT_STREAM && e.first == "Length")
+			{
+				continue;
+			}
+
+			out += '/';
+			out += e.first;
+			out += ' ';
+			e.second.write(out);
+			out += '\n';
+		}
+
+		if (this->type == PDF_OBJECT_STREAM)
+		{
+			g_snprintf(buffer, sizeof(buffer), "/Length %lu", (unsigned long) this->data.size());
+			out += buffer;
+			out += ">>\nstream\n";
+			out += this->data;
+			out += "\nendstream";
+		}
+		else
+		{
+			out += ">>";
+		}
+		break;
+	}
+}
@@ -0,0 +1,134 @@
+/*
+ * Xournal++
+ *
+ * A PDF object, as read from a file or written to it
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+using std::string;
+using std::vector;
+
+enum PdfObjectType
+{
+	PDF_OBJECT_NULL,
+	PDF_OBJECT_BOOL,
+	PDF_OBJECT_NUMBER,
+	PDF_OBJECT_STRING,
+	PDF_OBJECT_NAME,
+	PDF_OBJECT_ARRAY,
+	PDF_OBJECT_DICT,
+	PDF_OBJECT_REF,
+	PDF_OBJECT_STREAM
+};
+
+/**
+ * Value type for all PDF objects.
+ *
+ * Numbers, strings and names keep the text they were read from, so an object
+ * is written exactly as it was read. Names are stored without the leading
+ * slash and without resolving # escapes. Dictionaries keep the order of their
+ * entries. The data of a stream is kept encoded, as it is stored in the file.
+ */
+class PdfObject
+{
+public:
+	PdfObject();
+
+public:
+	static PdfObject createBool(bool value);
+	static PdfObject createInteger(long value);
+	static PdfObject createReal(double value);
+	static PdfObject createName(string name);
+	static PdfObject createRef(int num, int gen);
+	static PdfObject createArray();
+	static PdfObject createDict();
+	static PdfObject createStream(string data);
+
+	/**
+	 * Creates a number, string or keyword from the text of a token, without checking it
+	 */
+	static PdfObject createToken(PdfObjectType type, string text);
+
+public:
+	PdfObjectType getType() const;
+	bool isNull() const;
+	bool isNumber() const;
+	bool isName(const char* name = NULL) const;
+	bool isArray() const;
+	bool isRef() const;
+	bool isStream() const;
+
+	/**
+	 * @return true for dictionaries and streams
+	 */
+	bool isDict() const;
+
+	bool getBool() const;
+	long getInteger() const;
+	double getReal() const;
+	const string& getName() const;
+
+	/**
+	 * @return The text of a number, string, name or keyword as it is written
+	 */
+	const string& getText() const;
+
+	int getRefNum() const;
+	int getRefGen() const;
+
+	vector<PdfObject>& getArray();
+	const vector<PdfObject>& getArray() const;
+
+	/**
+	 * @return The entry of a dictionary or stream, NULL if there is none
+	 */
+	const PdfObject* get(const string& key) const;
+	PdfObject* get(const string& key);
+
+	/**
+	 * Adds or replaces an entry of a dictionary or stream
+	 */
+	void set(const string& key, PdfObject value);
+	void remove(const string& key);
+
+	vector<std::pair<string, PdfObject>>& getEntries();
+	const vector<std::pair<string, PdfObject>>& getEntries() const;
+
+	/**
+	 * @return The encoded data of a stream
+	 */
+	string& getStreamData();
+	const string& getStreamData() const;
+
+	/**
+	 * Turns a dictionary into a stream with this data, the Length entry is
+	 * written with the object
+	 */
+	void setStreamData(string data);
+
+	/**
+	 * Appends the object in PDF syntax. Streams are written with their Length.
+	 */
+	void write(string& out) const;
+
+private:
+	PdfObjectType type = PDF_OBJECT_NULL;
+
+	string text;
+	int num = 0;
+	int gen = 0;
+
+	vector<PdfObject> items;
+	vector<std::pair<string, PdfObject>> entries;
+
+	string data;
+};
@@ -69,6 +69,8 @@ void XojCairoPdfExport::exportPage(size_t page)
 	cairo_pdf_surface_set_size(this->surface, p->getWidth(), p->getHeight());
 
 	DocumentView view;
+	// The export keeps the exact strokes
+	view.setLevelOfDetail(false);
 
 	if (p->getBackgroundType().isPdfPage() && !noBackgroundExport)
 	{
@@ -0,0 +1,699 @@
+#include "XojPdfOverlayExport.h"
+
+#include "XojCairoPdfExport.h"
+
+#include "model/Layer.h"
+#include "view/DocumentView.h"
+
+#include <i18n.h>
+
+#include <cairo/cairo-pdf.h>
+#include <glib/gstdio.h>
+
+#include <algorithm>
+#include <initializer_list>
+
+static cairo_status_t appendToString(void* closure, const unsigned char* data, unsigned int length)
+{
+	((string*) closure)->append((const char*) data, length);
+	return CAIRO_STATUS_SUCCESS;
+}
+
+static bool hasVisibleElements(PageRef page)
+{
+	for (Layer* l : *page->getLayers())
+	{
+		if (page->isLayerVisible(l) && !l->getElements()->empty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static PdfObject createRealArray(std::initializer_list<double> values)
+{
+	PdfObject array = PdfObject::createArray();
+	for (double v : values)
+	{
+		array.getArray().push_back(PdfObject::createReal(v));
+	}
+
+	return array;
+}
+
+XojPdfOverlayExport::XojPdfOverlayExport(Document* doc, ProgressListener* progressListener)
+ : doc(doc),
+   progressListener(progressListener)
+{
+	XOJ_INIT_TYPE(XojPdfOverlayExport);
+}
+
+XojPdfOverlayExport::~XojPdfOverlayExport()
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	XOJ_RELEASE_TYPE(XojPdfOverlayExport);
+}
+
+/**
+ * Export without background
+ */
+void XojPdfOverlayExport::setNoBackgroundExport(bool noBackgroundExport)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	this->noBackgroundExport = noBackgroundExport;
+}
+
+bool XojPdfOverlayExport::createPdf(Path file, PageRangeVector& range)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	vector<size_t> pages;
+	for (PageRangeEntry* e : range)
+	{
+		for (int i = e->getFirst(); i <= e->getLast(); i++)
+		{
+			if (i >= 0 && i < (int) doc->getPageCount())
+			{
+				pages.push_back(i);
+			}
+		}
+	}
+
+	if (pages.empty())
+	{
+		this->lastError = _("No pages to export!");
+		return false;
+	}
+
+	return exportPages(file, pages);
+}
+
+bool XojPdfOverlayExport::createPdf(Path file)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	vector<size_t> pages;
+	for (size_t i = 0; i < doc->getPageCount(); i++)
+	{
+		pages.push_back(i);
+	}
+
+	if (pages.empty())
+	{
+		this->lastError = _("No pages to export!");
+		return false;
+	}
+
+	return exportPages(file, pages);
+}
+
+bool XojPdfOverlayExport::exportPages(Path file, vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	if (!canKeepBackground(pages))
+	{
+		return exportWithCairo(file, pages);
+	}
+
+	vector<int> overlayPages;
+	string overlayData;
+	if (!renderOverlays(pages, overlayPages, overlayData))
+	{
+		return false;
+	}
+
+	this->overlayPageObjects.clear();
+	if (std::any_of(overlayPages.begin(), overlayPages.end(), [](int i) { return i >= 0; }))
+	{
+		if (!this->overlay.loadData(overlayData))
+		{
+			g_warning("PDF export: the layers could not be read back: %s", this->overlay.getLastError().c_str());
+			return exportWithCairo(file, pages);
+		}
+		this->overlayPageObjects = this->overlay.getPages();
+	}
+
+	if (!writeUpdate(pages, overlayPages))
+	{
+		g_warning("PDF export: the background PDF could not be reused: %s", this->lastError.c_str());
+		return exportWithCairo(file, pages);
+	}
+
+	return saveFile(file);
+}
+
+bool XojPdfOverlayExport::exportWithCairo(Path file, vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	XojCairoPdfExport cairoExport(doc, progressListener);
+	cairoExport.setNoBackgroundExport(this->noBackgroundExport);
+
+	PageRangeVector range;
+	for (size_t page : pages)
+	{
+		range.push_back(new PageRangeEntry(page, page));
+	}
+
+	bool result = cairoExport.createPdf(file, range);
+	this->lastError = cairoExport.getLastError();
+
+	for (PageRangeEntry* e : range)
+	{
+		delete e;
+	}
+
+	return result;
+}
+
+bool XojPdfOverlayExport::canKeepBackground(vector<size_t>& pages)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	if (this->noBackgroundExport)
+	{
+		return false;
+	}
+
+	// The output contains the whole source file, so the export has to show all of its pages in
+	// their order, else the pages which were not selected would remain in the file
+	for (size_t i = 0; i < pages.size(); i++)
+	{
+		PageRef p = doc->getPage(pages[i]);
+		if (!p->getBackgroundType().isPdfPage() || p->getPdfPageNr() != i)
+		{
+			return false;
+		}
+
+		// A hidden background is drawn as pattern above the PDF page, as in the cairo export
+		if (!p->isLayerVisible(0))
+		{
+			return false;
+		}
+	}
+
+	Path pdfFile = doc->getPdfFilename();
+	if (pdfFile.isEmpty() || !pdfFile.exists())
+	{
+		return false;
+	}
+
+	if (!this->source.load(pdfFile))
+	{
+		g_warning("PDF export: \"%s\" could not be parsed: %s", pdfFile.c_str(), this->source.getLastError().c_str());
+		return false;
+	}
+
+	if (this->source.isEncrypted())
+	{
+		return false;
+	}
+
+	this->sourcePages = this->source.getPages();
+	return this->sourcePages.size() == pages.size();
+}
+
+bool XojPdfOverlayExport::renderOverlays(vector<size_t>& pages, vector<int>& overlayPages, string& result)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	if (this->progressListener)
+	{
+		this->progressListener->setMaximumState(pages.size());
+	}
+
+	cairo_surface_t* surface = cairo_pdf_surface_create_for_stream(appendToString, &result, 0, 0);
+	cairo_t* cr = cairo_create(surface);
+
+	int count = 0;
+	for (size_t i = 0; i < pages.size(); i++)
+	{
+		PageRef p = doc->getPage(pages[i]);
+
+		if (!hasVisibleElements(p))
+		{
+			overlayPages.push_back(-1);
+		}
+		else
+		{
+			cairo_pdf_surface_set_size(surface, p->getWidth(), p->getHeight());
+
+			DocumentView view;
+			// The export keeps the exact strokes
+			view.setLevelOfDetail(false);
+			view.drawPage(p, cr, true /* dont render eraseable */, true /* hide background */);
+
+			cairo_show_page(cr);
+			overlayPages.push_back(count++);
+		}
+
+		if (this->progressListener)
+		{
+			this->progressListener->setCurrentState(i);
+		}
+	}
+
+	cairo_destroy(cr);
+	cairo_surface_finish(surface);
+	cairo_status_t status = cairo_surface_status(surface);
+	cairo_surface_destroy(surface);
+
+	if (status != CAIRO_STATUS_SUCCESS)
+	{
+		this->lastError = cairo_status_to_string(status);
+		return false;
+	}
+
+	return true;
+}
+
+bool XojPdfOverlayExport::writeUpdate(vector<size_t>& pages, vector<int>& overlayPages)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	// The update starts after a newline behind the original file
+	this->updateOffset = this->source.getData().size() + 1;
+	this->update.clear();
+	this->writtenObjects.clear();
+	this->copiedObjects.clear();
+	this->drawFormStreams.clear();
+	this->saveStateStream = 0;
+	this->nextObject = this->source.getObjectCount();
+
+	for (int overlayPage : overlayPages)
+	{
+		if (overlayPage >= (int) this->overlayPageObjects.size())
+		{
+			this->lastError = "Missing page in the rendered layers";
+			return false;
+		}
+	}
+
+	// The pages are the same as in the source, only the annotated pages are replaced
+	for (size_t i = 0; i < pages.size(); i++)
+	{
+		if (overlayPages[i] >= 0 && !writePdfPage(this->sourcePages[i], overlayPages[i]))
+		{
+			return false;
+		}
+	}
+
+	writeXref();
+	return true;
+}
+
+bool XojPdfOverlayExport::writePdfPage(int num, int overlayPage)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	PdfObject page = this->source.getObject(num);
+	if (!page.isDict())
+	{
+		this->lastError = FS(FORMAT_STR("Page object {1} not found") % num);
+		return false;
+	}
+
+	PdfObject box = this->source.resolve(this->source.getInheritedAttribute(page, "CropBox"));
+	if (!box.isArray() || box.getArray().size() != 4)
+	{
+		box = this->source.resolve(this->source.getInheritedAttribute(page, "MediaBox"));
+	}
+
+	int rotate = this->source.resolve(this->source.getInheritedAttribute(page, "Rotate")).getInteger();
+	rotate = ((rotate % 360) + 360) % 360;
+
+	int form = writeForm(overlayPage, box, rotate);
+	if (form == 0)
+	{
+		return false;
+	}
+
+	PdfObject resources = this->source.resolve(this->source.getInheritedAttribute(page, "Resources"));
+	if (!resources.isDict())
+	{
+		resources = PdfObject::createDict();
+	}
+
+	const PdfObject* xobjectsRef = resources.get("XObject");
+	PdfObject xobjects = xobjectsRef ? this->source.resolve(*xobjectsRef) : PdfObject();
+	if (!xobjects.isDict())
+	{
+		xobjects = PdfObject::createDict();
+	}
+
+	string name = "XojOverlay";
+	for (int i = 1; xobjects.get(name); i++)
+	{
+		name = "XojOverlay" + std::to_string(i);
+	}
+
+	xobjects.set(name, PdfObject::createRef(form, 0));
+	resources.set("XObject", xobjects);
+	page.set("Resources", resources);
+
+	// The original content is enclosed in q / Q, so the overlay starts with the initial graphics state
+	if (this->saveStateStream == 0)
+	{
+		this->saveStateStream = writeObject(0, PdfObject::createStream("q\n"));
+	}
+
+	PdfObject contents = PdfObject::createArray();
+	contents.getArray().push_back(PdfObject::createRef(this->saveStateStream, 0));
+
+	const PdfObject* original = page.get("Contents");
+	PdfObject resolved = original ? this->source.resolve(*original) : PdfObject();
+	if (resolved.isArray())
+	{
+		for (const PdfObject& o : resolved.getArray())
+		{
+			contents.getArray().push_back(o);
+		}
+	}
+	else if (original)
+	{
+		contents.getArray().push_back(*original);
+	}
+
+	int& drawForm = this->drawFormStreams[name];
+	if (drawForm == 0)
+	{
+		drawForm = writeObject(0, PdfObject::createStream("Q\n/" + name + " Do\n"));
+	}
+	contents.getArray().push_back(PdfObject::createRef(drawForm, 0));
+
+	page.set("Contents", contents);
+
+	writeObject(num, this->source.getGeneration(num), page);
+	return true;
+}
+
+int XojPdfOverlayExport::writeForm(int overlayPage, const PdfObject& box, int rotate)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	PdfObject page = this->overlay.getObject(this->overlayPageObjects[overlayPage]);
+	PdfObject mediaBox = this->overlay.resolve(this->overlay.getInheritedAttribute(page, "MediaBox"));
+	if (!box.isArray() || box.getArray().size() != 4 || !mediaBox.isArray() || mediaBox.getArray().size() != 4)
+	{
+		this->lastError = "Page size not found";
+		return 0;
+	}
+
+	const PdfObject* contentsRef = page.get("Contents");
+	PdfObject contents = contentsRef ? this->overlay.resolve(*contentsRef) : PdfObject();
+
+	PdfObject form;
+	if (contents.isStream())
+	{
+		form = contents;
+	}
+	else
+	{
+		// Several streams are joined, a form has only one
+		string data;
+		for (const PdfObject& o : contents.getArray())
+		{
+			string decoded;
+			if (!this->overlay.decodeStream(this->overlay.resolve(o), decoded))
+			{
+				this->lastError = this->overlay.getLastError();
+				return 0;
+			}
+			data += decoded;
+			data += '\n';
+		}
+		form = PdfObject::createStream(data);
+	}
+
+	double width = mediaBox.getArray()[2].getReal() - mediaBox.getArray()[0].getReal();
+	double height = mediaBox.getArray()[3].getReal() - mediaBox.getArray()[1].getReal();
+
+	const vector<PdfObject>& b = box.getArray();
+	double x0 = std::min(b[0].getReal(), b[2].getReal());
+	double x1 = std::max(b[0].getReal(), b[2].getReal());
+	double y0 = std::min(b[1].getReal(), b[3].getReal());
+	double y1 = std::max(b[1].getReal(), b[3].getReal());
+
+	// Size of the page as it is shown, usually the same as the size of the layers
+	bool sideways = rotate == 90 || rotate == 270;
+	double sx = ((sideways ? y1 - y0 : x1 - x0)) / std::max(width, 1.0);
+	double sy = ((sideways ? x1 - x0 : y1 - y0)) / std::max(height, 1.0);
+
+	// Maps the upright overlay onto the unrotated page
+	PdfObject matrix;
+	switch (rotate)
+	{
+	case 90:
+		matrix = createRealArray({ 0, sx, -sy, 0, x1, y0 });
+		break;
+	case 180:
+		matrix = createRealArray({ -sx, 0, 0, -sy, x1, y1 });
+		break;
+	case 270:
+		matrix = createRealArray({ 0, -sx, sy, 0, x0, y1 });
+		break;
+	default:
+		matrix = createRealArray({ sx, 0, 0, sy, x0, y0 });
+		break;
+	}
+
+	form.set("Type", PdfObject::createName("XObject"));
+	form.set("Subtype", PdfObject::createName("Form"));
+	form.set("BBox", mediaBox);
+	form.set("Matrix", matrix);
+
+	PdfObject resources = this->overlay.getInheritedAttribute(page, "Resources");
+	if (!resources.isNull())
+	{
+		form.set("Resources", resources);
+	}
+
+	const PdfObject* group = page.get("Group");
+	if (group)
+	{
+		form.set("Group", *group);
+	}
+
+	return writeObject(0, copyFromOverlay(form));
+}
+
+PdfObject XojPdfOverlayExport::copyFromOverlay(const PdfObject& o)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	vector<int> pending;
+	PdfObject result = renumber(o, pending);
+
+	// The referenced objects are copied once, even if several pages use them
+	while (!pending.empty())
+	{
+		int num = pending.back();
+		pending.pop_back();
+
+		PdfObject copy = renumber(this->overlay.getObject(num), pending);
+		writeObject(this->copiedObjects[num], 0, copy);
+	}
+
+	return result;
+}
+
+PdfObject XojPdfOverlayExport::renumber(const PdfObject& o, vector<int>& pending)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	if (o.isRef())
+	{
+		auto it = this->copiedObjects.find(o.getRefNum());
+		if (it != this->copiedObjects.end())
+		{
+			return PdfObject::createRef(it->second, 0);
+		}
+
+		int num = this->nextObject++;
+		this->copiedObjects[o.getRefNum()] = num;
+		pending.push_back(o.getRefNum());
+		return PdfObject::createRef(num, 0);
+	}
+
+	PdfObject result = o;
+	if (o.isArray())
+	{
+		for (PdfObject& item : result.getArray())
+		{
+			item = renumber(item, pending);
+		}
+	}
+	else if (o.isDict())
+	{
+		for (std::pair<string, PdfObject>& e : result.getEntries())
+		{
+			e.second = renumber(e.second, pending);
+		}
+	}
+
+	return result;
+}
+
+int XojPdfOverlayExport::writeObject(int gen, const PdfObject& o)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	int num = this->nextObject++;
+	writeObject(num, gen, o);
+	return num;
+}
+
+void XojPdfOverlayExport::writeObject(int num, int gen, const PdfObject& o)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	this->writtenObjects[num] = std::make_pair(this->updateOffset + this->update.size(), gen);
+
+	this->update += std::to_string(num) + " " + std::to_string(gen) + " obj\n";
+	o.write(this->update);
+	this->update += "\nendobj\n";
+}
+
+void XojPdfOverlayExport::writeXref()
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	const PdfObject& sourceTrailer = this->source.getTrailer();
+	size_t xrefOffset = this->updateOffset + this->update.size();
+
+	PdfObject trailer = PdfObject::createDict();
+	for (const char* key : { "Root", "Info", "ID" })
+	{
+		const PdfObject* value = sourceTrailer.get(key);
+		if (value)
+		{
+			trailer.set(key, *value);
+		}
+	}
+	trailer.set("Prev", PdfObject::createInteger(this->source.getStartXref()));
+
+	if (this->source.hasXrefStream())
+	{
+		// A file with a cross reference stream may only be updated with a stream
+		int num = this->nextObject++;
+		this->writtenObjects[num] = std::make_pair(xrefOffset, 0);
+
+		int offsetBytes = 1;
+		while (offsetBytes < 8 && (xrefOffset >> (8 * offsetBytes)) != 0)
+		{
+			offsetBytes++;
+		}
+
+		string data;
+		PdfObject index = PdfObject::createArray();
+		int runStart = -1;
+		int last = -2;
+		for (auto& it : this->writtenObjects)
+		{
+			if (it.first != last + 1)
+			{
+				if (runStart >= 0)
+				{
+					index.getArray().push_back(PdfObject::createInteger(runStart));
+					index.getArray().push_back(PdfObject::createInteger(last + 1 - runStart));
+				}
+				runStart = it.first;
+			}
+			last = it.first;
+
+			data += (char) 1;
+			for (int b = offsetBytes - 1; b >= 0; b--)
+			{
+				data += (char) ((it.second.first >> (8 * b)) & 0xFF);
+			}
+			data += (char) ((it.second.second >> 8) & 0xFF);
+			data += (char) (it.second.second & 0xFF);
+		}
+		index.getArray().push_back(PdfObject::createInteger(runStart));
+		index.getArray().push_back(PdfObject::createInteger(last + 1 - runStart));
+
+		PdfObject w = PdfObject::createArray();
+		w.getArray().push_back(PdfObject::createInteger(1));
+		w.getArray().push_back(PdfObject::createInteger(offsetBytes));
+		w.getArray().push_back(PdfObject::createInteger(2));
+
+		trailer.set("Type", PdfObject::createName("XRef"));
+		trailer.set("Size", PdfObject::createInteger(this->nextObject));
+		trailer.set("Index", index);
+		trailer.set("W", w);
+		trailer.setStreamData(data);
+
+		writeObject(num, 0, trailer);
+	}
+	else
+	{
+		this->update += "xref\n";
+
+		char buffer[64];
+		for (auto it = this->writtenObjects.begin(); it != this->writtenObjects.end();)
+		{
+			auto end = it;
+			int count = 0;
+			while (end != this->writtenObjects.end() && end->first == it->first + count)
+			{
+				end++;
+				count++;
+			}
+
+			g_snprintf(buffer, sizeof(buffer), "%d %d\n", it->first, count);
+			this->update += buffer;
+
+			for (; it != end; it++)
+			{
+				// Each entry has exactly 20 bytes
+				g_snprintf(buffer, sizeof(buffer), "%010lu %05d n\r\n", (unsigned long) it->second.first, it->second.second);
+				this->update += buffer;
+			}
+		}
+
+		trailer.set("Size", PdfObject::createInteger(this->nextObject));
+
+		this->update += "trailer\n";
+		trailer.write(this->update);
+		this->update += "\n";
+	}
+
+	this->update += "startxref\n" + std::to_string(xrefOffset) + "\n%%EOF\n";
+}
+
+bool XojPdfOverlayExport::saveFile(Path file)
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	FILE* fp = g_fopen(file.c_str(), "wb");
+	if (!fp)
+	{
+		this->lastError = FS(_F("Could not write file \"{1}\"") % file.str());
+		return false;
+	}
+
+	const string& data = this->source.getData();
+	bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+	ok = ok && fwrite("\n", 1, 1, fp) == 1;
+	ok = ok && fwrite(this->update.data(), 1, this->update.size(), fp) == this->update.size();
+	ok = fclose(fp) == 0 && ok;
+
+	if (!ok)
+	{
+		this->lastError = FS(_F("Could not write file \"{1}\"") % file.str());
+	}
+
+	return ok;
+}
+
+string XojPdfOverlayExport::getLastError()
+{
+	XOJ_CHECK_TYPE(XojPdfOverlayExport);
+
+	return this->lastError;
+}
@@ -0,0 +1,101 @@
+/*
+ * Xournal++
+ *
+ * PDF export which keeps the pages of the background PDF
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "PdfFileReader.h"
+#include "XojPdfExport.h"
+
+#include "control/jobs/ProgressListener.h"
+#include "model/Document.h"
+
+/**
+ * Exports by appending an incremental update to a copy of the background PDF.
+ *
+ * The objects and content streams of the background pages are not touched.
+ * Only the layers are drawn with cairo, each page of the cairo output becomes a
+ * Form XObject which is drawn after the original content of its page.
+ *
+ * This is only done if the exported pages are exactly the pages of the background
+ * PDF in their original order. All other exports, e.g. of a page range, of moved or
+ * inserted pages, or if the PDF is encrypted or cannot be parsed, are done with
+ * XojCairoPdfExport.
+ */
+class XojPdfOverlayExport : public XojPdfExport
+{
+public:
+	XojPdfOverlayExport(Document* doc, ProgressListener* progressListener);
+	virtual ~XojPdfOverlayExport();
+
+public:
+	virtual bool createPdf(Path file);
+	virtual bool createPdf(Path file, PageRangeVector& range);
+	virtual string getLastError();
+
+	/**
+	 * Export without background
+	 */
+	virtual void setNoBackgroundExport(bool noBackgroundExport);
+
+private:
+	bool exportPages(Path file, vector<size_t>& pages);
+	bool exportWithCairo(Path file, vector<size_t>& pages);
+
+	bool canKeepBackground(vector<size_t>& pages);
+	bool renderOverlays(vector<size_t>& pages, vector<int>& overlayPages, string& result);
+	bool writeUpdate(vector<size_t>& pages, vector<int>& overlayPages);
+
+	bool writePdfPage(int num, int overlayPage);
+	int writeForm(int overlayPage, const PdfObject& box, int rotate);
+
+	PdfObject copyFromOverlay(const PdfObject& o);
+	PdfObject renumber(const PdfObject& o, vector<int>& pending);
+	int writeObject(int gen, const PdfObject& o);
+	void writeObject(int num, int gen, const PdfObject& o);
+	void writeXref();
+
+	bool saveFile(Path file);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	Document* doc = NULL;
+	ProgressListener* progressListener = NULL;
+
+	bool noBackgroundExport = false;
+
+	string lastError;
+
+	PdfFileReader source;
+	vector<int> sourcePages;
+
+	PdfFileReader overlay;
+	vector<int> overlayPageObjects;
+
+	/**
+	 * Object numbers of the overlay PDF and their numbers in the output
+	 */
+	std::unordered_map<int, int> copiedObjects;
+
+	/**
+	 * The content streams added around the original content, shared by all pages
+	 */
+	int saveStateStream = 0;
+	std::map<string, int> drawFormStreams;
+
+	/**
+	 * The appended update and the position of its objects in the output
+	 */
+	string update;
+	size_t updateOffset = 0;
+	std::map<int, std::pair<size_t, int>> writtenObjects;
+	int nextObject = 0;
+};
@@ -13,6 +13,7 @@ extern "C" {
 }
 
 #include "luapi_application.h"
+#include "luapi_document.h"
 
 #define LOAD_FROM_INI(target, group, key) \
 	{ \
@@ -30,6 +31,7 @@ extern "C" {
  */
 static const luaL_Reg loadedlibs[] = {
 	{ "app", luaopen_app },
+	{ "doc", luaopen_doc },
 	{ NULL, NULL }
 };
 
@@ -410,7 +412,7 @@ void Plugin::loadScript()
 	addPluginToLuaPath();
 
 	// Run the loaded Lua script
-	if (lua_pcall(lua, 0, 0, 0) != LUA_OK)
+	if (!callWithTimeBudget())
 	{
 		const char* errMsg = lua_tostring(lua, -1);
 		map<int, string> button;
@@ -431,7 +433,7 @@ bool Plugin::callFunction(string fnc)
 	lua_getglobal(lua, fnc.c_str());
 
 	// Run the function
-	if (lua_pcall(lua, 0, 0, 0))
+	if (!callWithTimeBudget())
 	{
 		const char* errMsg = lua_tostring(lua, -1);
 		map<int, string> button;
@@ -445,6 +447,45 @@ bool Plugin::callFunction(string fnc)
 	return true;
 }
 
+/**
+ * Runs the function on the top of the stack, stopped if it exceeds the time budget
+ */
+bool Plugin::callWithTimeBudget()
+{
+	XOJ_CHECK_TYPE(Plugin);
+
+	this->callStart = g_get_monotonic_time();
+	lua_sethook(lua, timeBudgetHook, LUA_MASKCOUNT, PLUGIN_BUDGET_CHECK_INSTRUCTIONS);
+
+	int result = lua_pcall(lua, 0, 0, 0);
+
+	lua_sethook(lua, NULL, 0, 0);
+
+	return result == LUA_OK;
+}
+
+/**
+ * Lua count hook, raises an error if the time budget is exceeded
+ */
+void Plugin::timeBudgetHook(lua_State* lua, lua_Debug* ar)
+{
+	Plugin* plugin = getPluginFromLua(lua);
+	if (plugin && g_get_monotonic_time() - plugin->callStart > PLUGIN_TIME_BUDGET_MS * 1000)
+	{
+		luaL_error(lua, "Plugin stopped, it was running for more than %d ms", PLUGIN_TIME_BUDGET_MS);
+	}
+}
+
+/**
+ * Restarts the time budget of the running call, e.g. after a dialog was shown
+ */
+void Plugin::restartTimeBudget()
+{
+	XOJ_CHECK_TYPE(Plugin);
+
+	this->callStart = g_get_monotonic_time();
+}
+
 /**
  * Check if this plugin is valid
  */
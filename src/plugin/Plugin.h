@@ -22,6 +22,16 @@ extern "C" {
 #include <lua.h>
 }
 
+/**
+ * Maximum time a call into a plugin may run, the plugin is stopped with an error afterwards
+ */
+#define PLUGIN_TIME_BUDGET_MS 5000
+
+/**
+ * The time budget is checked after this number of Lua instructions
+ */
+#define PLUGIN_BUDGET_CHECK_INSTRUCTIONS 10000
+
 class Plugin;
 class Control;
 
@@ -154,6 +164,11 @@ public:
 	 */
 	Control* getControl();
 
+	/**
+	 * Restarts the time budget of the running call, e.g. after a dialog was shown
+	 */
+	void restartTimeBudget();
+
 private:
 	/**
 	 * Load ini file
@@ -165,6 +180,18 @@ private:
 	 */
 	bool callFunction(string fnc);
 
+	/**
+	 * Runs the function on the top of the stack, stopped if it exceeds the time budget
+	 *
+	 * @return true on success, the error message is on the stack otherwise
+	 */
+	bool callWithTimeBudget();
+
+	/**
+	 * Lua count hook, raises an error if the time budget is exceeded
+	 */
+	static void timeBudgetHook(lua_State* lua, lua_Debug* ar);
+
 	/**
 	 * Load custom Lua Libraries
 	 */
@@ -248,6 +275,11 @@ private:
 	 * Flag if the plugin is valid / correct loaded
 	 */
 	bool valid = false;
+
+	/**
+	 * Start of the running call, monotonic time in microseconds
+	 */
+	gint64 callStart = 0;
 };
 
 #endif
@@ -16,18 +16,6 @@ PluginController::PluginController(Control* control)
  : control(control)
 {
 	XOJ_INIT_TYPE(PluginController);
-#ifdef ENABLE_PLUGINS
-	string path = control->getGladeSearchPath()->getFirstSearchPath();
-	if (StringUtils::endsWith(path, "ui"))
-	{
-		path = path.substr(0, path.length() - 2) + "plugins";
-	}
-	else
-	{
-		path += "/../plugins";
-	}
-	loadPluginsFrom(path);
-#endif
 }
 
 PluginController::~PluginController()
@@ -46,6 +34,30 @@ PluginController::~PluginController()
 	XOJ_RELEASE_TYPE(PluginController);
 }
 
+/**
+ * Load the installed plugins and register their UI, called after the main window is shown
+ */
+void PluginController::loadPlugins()
+{
+	XOJ_CHECK_TYPE(PluginController);
+
+#ifdef ENABLE_PLUGINS
+	string path = control->getGladeSearchPath()->getFirstSearchPath();
+	if (StringUtils::endsWith(path, "ui"))
+	{
+		path = path.substr(0, path.length() - 2) + "plugins";
+	}
+	else
+	{
+		path += "/../plugins";
+	}
+	loadPluginsFrom(path);
+#endif
+
+	registerToolbar();
+	registerMenu();
+}
+
 /**
  * Load all plugins within this folder
  *
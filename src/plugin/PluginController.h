@@ -23,6 +23,11 @@ public:
 	virtual ~PluginController();
 
 public:
+	/**
+	 * Load the installed plugins and register their UI, called after the main window is shown
+	 */
+	void loadPlugins();
+
 	/**
 	 * Load all plugins within this folder
 	 *
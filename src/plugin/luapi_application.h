@@ -48,6 +48,9 @@ static int applib_msgbox(lua_State* L)
 	Plugin* plugin = Plugin::getPluginFromLua(L);
 
 	int result = XojMsgBox::showPluginMessage(plugin->getName(), msg, button);
+
+	// The time waiting for the user is not counted
+	plugin->restartTimeBudget();
 	lua_pushinteger(L, result);
 	return 1;
 }
@@ -170,6 +173,9 @@ static int applib_uiAction(lua_State* L)
 	Control* ctrl = plugin->getControl();
 	ctrl->actionPerformed(action, group, event, menuitem, toolbutton, enabled);
 
+	// The action may have shown a dialog
+	plugin->restartTimeBudget();
+
 	// Make sure to remove all vars which are put to the stack before!
 	lua_pop(L, 3);
 
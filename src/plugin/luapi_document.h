@@ -0,0 +1,772 @@
+/*
+ * Xournal++
+ *
+ * Lua API, document library
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "control/Control.h"
+#include "control/ToolHandler.h"
+#include "model/Document.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "undo/ColorUndoAction.h"
+#include "undo/DeleteUndoAction.h"
+#include "undo/GroupUndoAction.h"
+#include "undo/InsertUndoAction.h"
+#include "undo/SizeUndoAction.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+
+/*
+ * Pages, layers and element indices start with 1, as usual in Lua.
+ *
+ * The functions which change the document check all arguments before anything
+ * is allocated: lua_error does not unwind the C++ stack. The tables are only read
+ * with raw accesses, so no metamethod of the plugin runs in between and the
+ * checked values are still the same when they are copied into C++ structures.
+ */
+
+#define LUA_POINT_ARRAY "Xournalpp.PointArray"
+
+/**
+ * Read only view of the points of a stroke, the points are not copied
+ */
+struct LuaPointArray
+{
+	std::shared_ptr<const Point> points;
+	int count;
+};
+
+static LuaPointArray* doclib_checkPointArray(lua_State* L, int arg)
+{
+	return (LuaPointArray*) luaL_checkudata(L, arg, LUA_POINT_ARRAY);
+}
+
+static int pointarray_gc(lua_State* L)
+{
+	LuaPointArray* array = doclib_checkPointArray(L, 1);
+	array->~LuaPointArray();
+	return 0;
+}
+
+static int pointarray_len(lua_State* L)
+{
+	LuaPointArray* array = doclib_checkPointArray(L, 1);
+	lua_pushinteger(L, array->count);
+	return 1;
+}
+
+/**
+ * Example:
+ * local x, y, pressure = stroke.points:get(1)
+ * The pressure is -1 if the stroke has no pressure
+ */
+static int pointarray_get(lua_State* L)
+{
+	LuaPointArray* array = doclib_checkPointArray(L, 1);
+	lua_Integer index = luaL_checkinteger(L, 2);
+	luaL_argcheck(L, index >= 1 && index <= array->count, 2, "index out of range");
+
+	const Point& p = array->points.get()[index - 1];
+	lua_pushnumber(L, p.x);
+	lua_pushnumber(L, p.y);
+	lua_pushnumber(L, p.z);
+	return 3;
+}
+
+/**
+ * Example:
+ * local x, y, pressure = stroke.points:unpack()
+ * Returns three arrays with all points
+ */
+static int pointarray_unpack(lua_State* L)
+{
+	LuaPointArray* array = doclib_checkPointArray(L, 1);
+	const Point* points = array->points.get();
+
+	lua_createtable(L, array->count, 0);
+	lua_createtable(L, array->count, 0);
+	lua_createtable(L, array->count, 0);
+	for (int i = 0; i < array->count; i++)
+	{
+		lua_pushnumber(L, points[i].x);
+		lua_rawseti(L, -4, i + 1);
+		lua_pushnumber(L, points[i].y);
+		lua_rawseti(L, -3, i + 1);
+		lua_pushnumber(L, points[i].z);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 3;
+}
+
+static const luaL_Reg pointarraylib[] = {
+	{ "get", pointarray_get },
+	{ "unpack", pointarray_unpack },
+	{ NULL, NULL }
+};
+
+static void doclib_pushPointArray(lua_State* L, std::shared_ptr<const Point> points, int count)
+{
+	void* data = lua_newuserdata(L, sizeof(LuaPointArray));
+	new (data) LuaPointArray { points, count };
+	luaL_setmetatable(L, LUA_POINT_ARRAY);
+}
+
+/**
+ * Pushes the field key of the table at index, without metamethods
+ *
+ * @return The type of the value
+ */
+static int doclib_rawgetfield(lua_State* L, int index, const char* key)
+{
+	index = lua_absindex(L, index);
+	lua_pushstring(L, key);
+	return lua_rawget(L, index);
+}
+
+/**
+ * @return The page of the argument pageArg, the layer is the argument after it
+ */
+static XojPage* doclib_checkPage(lua_State* L, int pageArg)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	Document* doc = plugin->getControl()->getDocument();
+
+	lua_Integer pageNr = luaL_checkinteger(L, pageArg);
+
+	doc->lock();
+	bool valid = pageNr >= 1 && (size_t) pageNr <= doc->getPageCount();
+	XojPage* page = valid ? (XojPage*) doc->getPage(pageNr - 1) : NULL;
+	doc->unlock();
+
+	luaL_argcheck(L, valid, pageArg, "page does not exist");
+	return page;
+}
+
+static Layer* doclib_checkLayer(lua_State* L, XojPage* page, int layerArg)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	Document* doc = plugin->getControl()->getDocument();
+
+	lua_Integer layerNr = luaL_checkinteger(L, layerArg);
+
+	doc->lock();
+	vector<Layer*>* layers = page->getLayers();
+	bool valid = layerNr >= 1 && (size_t) layerNr <= layers->size();
+	Layer* layer = valid ? (*layers)[layerNr - 1] : NULL;
+	doc->unlock();
+
+	luaL_argcheck(L, valid, layerArg, "layer does not exist");
+	return layer;
+}
+
+/**
+ * @return The stroke at the 1 based index of the table at the top of the stack
+ */
+static Stroke* doclib_checkStrokeIndex(lua_State* L, Layer* layer, int arg)
+{
+	if (!lua_isinteger(L, -1))
+	{
+		luaL_argerror(L, arg, "stroke index expected");
+	}
+
+	lua_Integer index = lua_tointeger(L, -1);
+	vector<Element*>* elements = layer->getElements();
+	if (index < 1 || (size_t) index > elements->size() || (*elements)[index - 1]->getType() != ELEMENT_STROKE)
+	{
+		luaL_argerror(L, arg, "no stroke at this index");
+	}
+
+	return (Stroke*) (*elements)[index - 1];
+}
+
+static StrokeTool doclib_toolFromString(const char* tool)
+{
+	if (strcmp(tool, "highlighter") == 0)
+	{
+		return STROKE_TOOL_HIGHLIGHTER;
+	}
+	if (strcmp(tool, "eraser") == 0)
+	{
+		return STROKE_TOOL_ERASER;
+	}
+	return STROKE_TOOL_PEN;
+}
+
+static const char* doclib_toolToString(StrokeTool tool)
+{
+	switch (tool)
+	{
+	case STROKE_TOOL_HIGHLIGHTER:
+		return "highlighter";
+	case STROKE_TOOL_ERASER:
+		return "eraser";
+	default:
+		return "pen";
+	}
+}
+
+static int doclib_getPageCount(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	Document* doc = plugin->getControl()->getDocument();
+
+	doc->lock();
+	size_t count = doc->getPageCount();
+	doc->unlock();
+
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+static int doclib_getCurrentPage(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+
+	lua_pushinteger(L, plugin->getControl()->getCurrentPageNo() + 1);
+	return 1;
+}
+
+static int doclib_getLayerCount(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	Document* doc = plugin->getControl()->getDocument();
+	XojPage* page = doclib_checkPage(L, 1);
+
+	doc->lock();
+	size_t count = page->getLayers()->size();
+	doc->unlock();
+
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+/**
+ * A stroke of getStrokes, copied while the document is locked
+ */
+struct LuaStrokeInfo
+{
+	size_t index;
+	StrokeTool tool;
+	int color;
+	double width;
+	int fill;
+	std::shared_ptr<const Point> points;
+	int pointCount;
+};
+
+/**
+ * Copies the strokes of the layer with their 1 based index, the document has to be locked
+ */
+static void doclib_readStrokes(Layer* layer, vector<LuaStrokeInfo>& result)
+{
+	vector<Element*>* elements = layer->getElements();
+	for (size_t i = 0; i < elements->size(); i++)
+	{
+		if ((*elements)[i]->getType() != ELEMENT_STROKE)
+		{
+			continue;
+		}
+
+		Stroke* s = (Stroke*) (*elements)[i];
+		result.push_back({ i + 1, s->getToolType(), s->getColor(), s->getWidth(), s->getFill(), s->sharePoints(),
+						   s->getPointCount() });
+	}
+}
+
+/**
+ * Example:
+ * local strokes = doc.getStrokes(1, 1)
+ * for _, s in ipairs(strokes) do print(s.index, s.tool, s.color, s.width, #s.points) end
+ *
+ * The points are no copy, they can be read with points:get(i) or points:unpack()
+ */
+static int doclib_getStrokes(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	Document* doc = plugin->getControl()->getDocument();
+	XojPage* page = doclib_checkPage(L, 1);
+	Layer* layer = doclib_checkLayer(L, page, 2);
+
+	// The tables are created after the document is unlocked, only a memory error could raise an error there
+	vector<LuaStrokeInfo> strokes;
+	doc->lock();
+	doclib_readStrokes(layer, strokes);
+	doc->unlock();
+
+	lua_createtable(L, strokes.size(), 0);
+
+	int n = 0;
+	for (LuaStrokeInfo& s : strokes)
+	{
+		lua_createtable(L, 0, 6);
+
+		lua_pushinteger(L, s.index);
+		lua_setfield(L, -2, "index");
+		lua_pushstring(L, doclib_toolToString(s.tool));
+		lua_setfield(L, -2, "tool");
+		lua_pushinteger(L, s.color);
+		lua_setfield(L, -2, "color");
+		lua_pushnumber(L, s.width);
+		lua_setfield(L, -2, "width");
+		lua_pushinteger(L, s.fill);
+		lua_setfield(L, -2, "fill");
+		doclib_pushPointArray(L, s.points, s.pointCount);
+		lua_setfield(L, -2, "points");
+
+		lua_rawseti(L, -2, ++n);
+	}
+
+	return 1;
+}
+
+/**
+ * A stroke of addStrokes, copied from its table before any element is created
+ */
+struct LuaNewStroke
+{
+	StrokeTool tool = STROKE_TOOL_PEN;
+	bool hasColor = false;
+	int color = 0;
+	bool hasWidth = false;
+	double width = 0;
+	vector<Point> points;
+};
+
+/**
+ * Checks one stroke of addStrokes, the table is at the top of the stack
+ *
+ * @return The point count
+ */
+static lua_Integer doclib_checkNewStroke(lua_State* L, int arg)
+{
+	if (!lua_istable(L, -1))
+	{
+		luaL_argerror(L, arg, "stroke table expected");
+	}
+
+	lua_Integer count = 0;
+	if (doclib_rawgetfield(L, -1, "points") != LUA_TNIL)
+	{
+		LuaPointArray* array = (LuaPointArray*) luaL_testudata(L, -1, LUA_POINT_ARRAY);
+		if (array == NULL)
+		{
+			luaL_argerror(L, arg, "points need to be the points of getStrokes");
+		}
+		count = array->count;
+	}
+	else
+	{
+		bool valid = doclib_rawgetfield(L, -2, "x") == LUA_TTABLE;
+		valid = doclib_rawgetfield(L, -3, "y") == LUA_TTABLE && valid;
+		if (!valid)
+		{
+			luaL_argerror(L, arg, "a stroke needs points or x and y");
+		}
+
+		count = lua_rawlen(L, -2);
+		if ((lua_Integer) lua_rawlen(L, -1) != count)
+		{
+			luaL_argerror(L, arg, "x and y need the same length");
+		}
+
+		int type = doclib_rawgetfield(L, -4, "pressure");
+		if (type != LUA_TNIL && (type != LUA_TTABLE || (lua_Integer) lua_rawlen(L, -1) != count))
+		{
+			luaL_argerror(L, arg, "pressure needs the length of x");
+		}
+
+		for (lua_Integer i = 1; i <= count; i++)
+		{
+			for (int t = -3; t < (type == LUA_TNIL ? -1 : 0); t++)
+			{
+				lua_rawgeti(L, t, i);
+				if (!lua_isnumber(L, -1))
+				{
+					luaL_argerror(L, arg, "coordinates need to be numbers");
+				}
+				lua_pop(L, 1);
+			}
+		}
+		lua_pop(L, 3);
+	}
+	lua_pop(L, 1);
+
+	if (count < 2)
+	{
+		luaL_argerror(L, arg, "a stroke needs at least two points");
+	}
+
+	return count;
+}
+
+/**
+ * Copies one stroke of addStrokes, the table is at the top of the stack and was checked before.
+ * Only raw accesses are used, so no metamethod runs and no error is raised.
+ */
+static void doclib_readNewStroke(lua_State* L, LuaNewStroke& stroke)
+{
+	if (doclib_rawgetfield(L, -1, "tool") == LUA_TSTRING)
+	{
+		stroke.tool = doclib_toolFromString(lua_tostring(L, -1));
+	}
+	doclib_rawgetfield(L, -2, "color");
+	if (lua_isinteger(L, -1))
+	{
+		stroke.hasColor = true;
+		stroke.color = lua_tointeger(L, -1);
+	}
+	doclib_rawgetfield(L, -3, "width");
+	if (lua_isnumber(L, -1))
+	{
+		stroke.hasWidth = true;
+		stroke.width = lua_tonumber(L, -1);
+	}
+	lua_pop(L, 3);
+
+	if (doclib_rawgetfield(L, -1, "points") != LUA_TNIL)
+	{
+		LuaPointArray* array = (LuaPointArray*) lua_touserdata(L, -1);
+		stroke.points.assign(array->points.get(), array->points.get() + array->count);
+		lua_pop(L, 1);
+	}
+	else
+	{
+		doclib_rawgetfield(L, -2, "x");
+		doclib_rawgetfield(L, -3, "y");
+		bool hasPressure = doclib_rawgetfield(L, -4, "pressure") != LUA_TNIL;
+
+		lua_Integer count = lua_rawlen(L, -3);
+		stroke.points.reserve(count);
+		for (lua_Integer i = 1; i <= count; i++)
+		{
+			lua_rawgeti(L, -3, i);
+			lua_rawgeti(L, -3, i);
+			double z = Point::NO_PRESSURE;
+			if (hasPressure)
+			{
+				lua_rawgeti(L, -3, i);
+				z = lua_tonumber(L, -1);
+				lua_pop(L, 1);
+			}
+
+			stroke.points.push_back(Point(lua_tonumber(L, -2), lua_tonumber(L, -1), z));
+			lua_pop(L, 2);
+		}
+		lua_pop(L, 4);
+	}
+}
+
+/**
+ * Creates a stroke of addStrokes, the color and the width default to the current tool
+ */
+static Stroke* doclib_createStroke(const LuaNewStroke& stroke, int defaultColor, double defaultWidth)
+{
+	Stroke* s = new Stroke();
+	s->setToolType(stroke.tool);
+	s->setColor(stroke.hasColor ? stroke.color : defaultColor);
+	s->setWidth(stroke.hasWidth ? stroke.width : defaultWidth);
+
+	for (const Point& p : stroke.points)
+	{
+		s->addPoint(p);
+	}
+
+	s->freeUnusedPointItems();
+	return s;
+}
+
+/**
+ * Example:
+ * doc.addStrokes(1, 1, {
+ *   {x = {10, 100}, y = {10, 100}, color = 0xff0000, width = 2},
+ *   {points = otherStroke.points, tool = "highlighter"}
+ * })
+ *
+ * color and width default to the current tool, tool defaults to "pen".
+ * All strokes are added with one undo action.
+ */
+static int doclib_addStrokes(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	XojPage* page = doclib_checkPage(L, 1);
+	Layer* layer = doclib_checkLayer(L, page, 2);
+	luaL_checktype(L, 3, LUA_TTABLE);
+
+	lua_Integer count = lua_rawlen(L, 3);
+	for (lua_Integer i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		doclib_checkNewStroke(L, 3);
+		lua_pop(L, 1);
+	}
+
+	if (count == 0)
+	{
+		lua_pushinteger(L, 0);
+		return 1;
+	}
+
+	// No Lua error is raised from here on
+	vector<LuaNewStroke> newStrokes(count);
+	for (lua_Integer i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		doclib_readNewStroke(L, newStrokes[i - 1]);
+		lua_pop(L, 1);
+	}
+
+	Control* ctrl = plugin->getControl();
+	Document* doc = ctrl->getDocument();
+	ToolHandler* toolHandler = ctrl->getToolHandler();
+
+	vector<Element*> strokes;
+	strokes.reserve(count);
+	for (LuaNewStroke& s : newStrokes)
+	{
+		strokes.push_back(doclib_createStroke(s, toolHandler->getColor(), toolHandler->getThickness()));
+	}
+
+	doc->lock();
+	for (Element* e : strokes)
+	{
+		layer->addElement(e);
+	}
+	doc->unlock();
+
+	page->firePageChanged();
+
+	ctrl->getUndoRedoHandler()->addUndoAction(UndoActionPtr(new InsertsUndoAction(page, layer, strokes)));
+
+	lua_pushinteger(L, count);
+	return 1;
+}
+
+/**
+ * A change of setStrokeStyles, copied from its table before anything is changed
+ */
+struct LuaStyleChange
+{
+	Stroke* stroke;
+	bool hasColor;
+	int color;
+	bool hasWidth;
+	double width;
+};
+
+/**
+ * Example:
+ * doc.setStrokeStyles(1, 1, {{index = 3, color = 0x00ff00}, {index = 5, width = 4}})
+ *
+ * The index is the index returned by getStrokes. All changes are one undo action.
+ */
+static int doclib_setStrokeStyles(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	XojPage* page = doclib_checkPage(L, 1);
+	Layer* layer = doclib_checkLayer(L, page, 2);
+	luaL_checktype(L, 3, LUA_TTABLE);
+
+	lua_Integer count = lua_rawlen(L, 3);
+	for (lua_Integer i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		luaL_argcheck(L, lua_istable(L, -1), 3, "change table expected");
+
+		doclib_rawgetfield(L, -1, "index");
+		doclib_checkStrokeIndex(L, layer, 3);
+		doclib_rawgetfield(L, -2, "color");
+		luaL_argcheck(L, lua_isnil(L, -1) || lua_isinteger(L, -1), 3, "color needs to be an integer");
+		doclib_rawgetfield(L, -3, "width");
+		luaL_argcheck(L, lua_isnil(L, -1) || (lua_isnumber(L, -1) && lua_tonumber(L, -1) > 0), 3,
+					  "width needs to be a positive number");
+		lua_pop(L, 4);
+	}
+
+	// No Lua error is raised from here on
+	vector<LuaStyleChange> changes;
+	for (lua_Integer i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		doclib_rawgetfield(L, -1, "index");
+		doclib_rawgetfield(L, -2, "color");
+		doclib_rawgetfield(L, -3, "width");
+
+		LuaStyleChange change = { (Stroke*) (*layer->getElements())[lua_tointeger(L, -3) - 1],
+								  !lua_isnil(L, -2), (int) lua_tointeger(L, -2),
+								  !lua_isnil(L, -1), lua_tonumber(L, -1) };
+		changes.push_back(change);
+
+		lua_pop(L, 4);
+	}
+
+	Control* ctrl = plugin->getControl();
+	Document* doc = ctrl->getDocument();
+	ColorUndoAction* colorUndo = new ColorUndoAction(page, layer);
+	SizeUndoAction* sizeUndo = new SizeUndoAction(page, layer);
+	bool colorChanged = false;
+	bool sizeChanged = false;
+
+	Range range(0, 0);
+	bool rangeEmpty = true;
+
+	doc->lock();
+	for (LuaStyleChange& c : changes)
+	{
+		Stroke* s = c.stroke;
+
+		if (rangeEmpty)
+		{
+			range = Range(s->getX(), s->getY());
+			rangeEmpty = false;
+		}
+		range.addPoint(s->getX(), s->getY());
+		range.addPoint(s->getX() + s->getElementWidth(), s->getY() + s->getElementHeight());
+
+		if (c.hasColor)
+		{
+			colorUndo->addStroke(s, s->getColor(), c.color);
+			s->setColor(c.color);
+			colorChanged = true;
+		}
+
+		if (c.hasWidth)
+		{
+			vector<double> pressure = SizeUndoAction::getPressure(s);
+			sizeUndo->addStroke(s, s->getWidth(), c.width, pressure, pressure, pressure.size());
+			s->setWidth(c.width);
+			sizeChanged = true;
+
+			range.addPoint(s->getX(), s->getY());
+			range.addPoint(s->getX() + s->getElementWidth(), s->getY() + s->getElementHeight());
+		}
+	}
+	doc->unlock();
+
+	if (colorChanged || sizeChanged)
+	{
+		page->fireRangeChanged(range);
+	}
+
+	if (!colorChanged)
+	{
+		delete colorUndo;
+		colorUndo = NULL;
+	}
+	if (!sizeChanged)
+	{
+		delete sizeUndo;
+		sizeUndo = NULL;
+	}
+
+	if (colorUndo && sizeUndo)
+	{
+		GroupUndoAction* undo = new GroupUndoAction();
+		undo->addAction(colorUndo);
+		undo->addAction(sizeUndo);
+		ctrl->getUndoRedoHandler()->addUndoAction(UndoActionPtr(undo));
+	}
+	else if (colorUndo || sizeUndo)
+	{
+		ctrl->getUndoRedoHandler()->addUndoAction(UndoActionPtr(colorUndo ? (UndoAction*) colorUndo : sizeUndo));
+	}
+
+	return 0;
+}
+
+/**
+ * Example:
+ * doc.removeStrokes(1, 1, {3, 5, 8})
+ *
+ * The indices are the indices returned by getStrokes. All strokes are removed with one undo action.
+ */
+static int doclib_removeStrokes(lua_State* L)
+{
+	Plugin* plugin = Plugin::getPluginFromLua(L);
+	XojPage* page = doclib_checkPage(L, 1);
+	Layer* layer = doclib_checkLayer(L, page, 2);
+	luaL_checktype(L, 3, LUA_TTABLE);
+
+	lua_Integer count = lua_rawlen(L, 3);
+	for (lua_Integer i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		doclib_checkStrokeIndex(L, layer, 3);
+		lua_pop(L, 1);
+	}
+
+	// No Lua error is raised from here on
+	vector<int> indices;
+	for (lua_Integer i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 3, i);
+		indices.push_back(lua_tointeger(L, -1) - 1);
+		lua_pop(L, 1);
+	}
+
+	std::sort(indices.begin(), indices.end());
+	indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+	if (indices.empty())
+	{
+		return 0;
+	}
+
+	Control* ctrl = plugin->getControl();
+	Document* doc = ctrl->getDocument();
+	DeleteUndoAction* undo = new DeleteUndoAction(page, false);
+
+	// From the end, so the indices of the remaining strokes stay valid
+	doc->lock();
+	for (auto it = indices.rbegin(); it != indices.rend(); it++)
+	{
+		Element* e = (*layer->getElements())[*it];
+		undo->addElement(layer, e, *it);
+		layer->removeElement(e, false);
+	}
+	doc->unlock();
+
+	page->firePageChanged();
+
+	ctrl->getUndoRedoHandler()->addUndoAction(UndoActionPtr(undo));
+
+	return 0;
+}
+
+static const luaL_Reg doclib[] = {
+	{ "getPageCount", doclib_getPageCount },
+	{ "getCurrentPage", doclib_getCurrentPage },
+	{ "getLayerCount", doclib_getLayerCount },
+	{ "getStrokes", doclib_getStrokes },
+	{ "addStrokes", doclib_addStrokes },
+	{ "setStrokeStyles", doclib_setStrokeStyles },
+	{ "removeStrokes", doclib_removeStrokes },
+	{ NULL, NULL }
+};
+
+/**
+ * Open document Library
+ */
+LUAMOD_API int luaopen_doc(lua_State* L)
+{
+	luaL_newmetatable(L, LUA_POINT_ARRAY);
+	luaL_newlib(L, pointarraylib);
+	lua_setfield(L, -2, "__index");
+	lua_pushcfunction(L, pointarray_len);
+	lua_setfield(L, -2, "__len");
+	lua_pushcfunction(L, pointarray_gc);
+	lua_setfield(L, -2, "__gc");
+	lua_pop(L, 1);
+
+	luaL_newlib(L, doclib);
+	return 1;
+}
@@ -0,0 +1,110 @@
+#include "DamageRegion.h"
+
+#include <algorithm>
+
+DamageRegion::DamageRegion()
+{
+	XOJ_INIT_TYPE(DamageRegion);
+}
+
+DamageRegion::~DamageRegion()
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	XOJ_RELEASE_TYPE(DamageRegion);
+}
+
+guint64 DamageRegion::area(const DamageRect& r)
+{
+	return (guint64) (r.x2 - r.x1) * (guint64) (r.y2 - r.y1);
+}
+
+void DamageRegion::add(int x1, int y1, int x2, int y2)
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	if (x2 <= x1 || y2 <= y1)
+	{
+		return;
+	}
+
+	DamageRect rect = { x1, y1, x2, y2 };
+	this->requestedPixels += area(rect);
+
+	// A merged rectangle may now be mergeable with one already checked, so start again
+	for (size_t i = 0; i < this->rects.size();)
+	{
+		DamageRect& r = this->rects[i];
+		DamageRect merged = { std::min(r.x1, rect.x1), std::min(r.y1, rect.y1), std::max(r.x2, rect.x2), std::max(r.y2, rect.y2) };
+
+		if (area(merged) <= area(r) + area(rect))
+		{
+			rect = merged;
+			this->rects.erase(this->rects.begin() + i);
+			i = 0;
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	this->rects.push_back(rect);
+
+	if (this->rects.size() > DAMAGE_REGION_MAX_RECTS)
+	{
+		DamageRect bounds = this->rects[0];
+		for (DamageRect& r : this->rects)
+		{
+			bounds.x1 = std::min(bounds.x1, r.x1);
+			bounds.y1 = std::min(bounds.y1, r.y1);
+			bounds.x2 = std::max(bounds.x2, r.x2);
+			bounds.y2 = std::max(bounds.y2, r.y2);
+		}
+
+		this->rects.clear();
+		this->rects.push_back(bounds);
+	}
+}
+
+bool DamageRegion::isEmpty()
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	return this->rects.empty();
+}
+
+void DamageRegion::flush(std::vector<DamageRect>& result)
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	for (DamageRect& r : this->rects)
+	{
+		this->paintedPixels += area(r);
+		result.push_back(r);
+	}
+
+	this->rects.clear();
+}
+
+guint64 DamageRegion::getRequestedPixels()
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	return this->requestedPixels;
+}
+
+guint64 DamageRegion::getPaintedPixels()
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	return this->paintedPixels;
+}
+
+void DamageRegion::resetStatistics()
+{
+	XOJ_CHECK_TYPE(DamageRegion);
+
+	this->requestedPixels = 0;
+	this->paintedPixels = 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Xournal++
+ *
+ * Collects the areas which need to be repainted until the next frame
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include "XournalType.h"
+
+#include <vector>
+
+/**
+ * Maximum number of separate rectangles, if there are more all
+ * are replaced by their bounding box
+ */
+#define DAMAGE_REGION_MAX_RECTS 16
+
+/**
+ * A damaged area, x2 and y2 are exclusive
+ */
+struct DamageRect
+{
+	int x1;
+	int y1;
+	int x2;
+	int y2;
+};
+
+/**
+ * Unions overlapping rectangles, so an area requested several times
+ * within one frame is only painted once.
+ *
+ * Two rectangles are merged if their bounding box is not larger than
+ * both of them together, so merging never paints more pixels.
+ */
+class DamageRegion
+{
+public:
+	DamageRegion();
+	virtual ~DamageRegion();
+
+public:
+	void add(int x1, int y1, int x2, int y2);
+
+	bool isEmpty();
+
+	/**
+	 * Moves the collected rectangles into result and clears the region
+	 */
+	void flush(std::vector<DamageRect>& result);
+
+	/**
+	 * @return The sum of the areas of all added rectangles
+	 */
+	guint64 getRequestedPixels();
+
+	/**
+	 * @return The sum of the areas of all flushed rectangles
+	 */
+	guint64 getPaintedPixels();
+
+	void resetStatistics();
+
+private:
+	static guint64 area(const DamageRect& r);
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	std::vector<DamageRect> rects;
+
+	guint64 requestedPixels = 0;
+	guint64 paintedPixels = 0;
+};
@@ -1,9 +1,12 @@
 #include "OutputStream.h"
 
-#include "GzUtil.h"
 #include <i18n.h>
 
+#include <glib/gstdio.h>
+
+#include <algorithm>
 #include <stdlib.h>
+#include <string.h>
 
 OutputStream::OutputStream() { }
 
@@ -23,17 +26,38 @@ void OutputStream::write(const char* str)
 /// GzOutputStream /////////////////////////////////////
 ////////////////////////////////////////////////////////
 
-GzOutputStream::GzOutputStream(Path filename)
+GzOutputStream::GzOutputStream(Path filename, int level, int threads)
+ : level(level),
+   threadCount(threads)
 {
 	XOJ_INIT_TYPE(GzOutputStream);
 
 	this->filename = filename;
 
-	this->fp = GzUtil::openPath(filename, "w");
+	if (this->level < Z_DEFAULT_COMPRESSION || this->level > Z_BEST_COMPRESSION)
+	{
+		this->level = Z_DEFAULT_COMPRESSION;
+	}
+
+	if (this->threadCount <= 0)
+	{
+		this->threadCount = std::thread::hardware_concurrency();
+	}
+	this->threadCount = std::min(this->threadCount, GZ_OUTPUT_MAX_THREADS);
+
+	this->fp = g_fopen(filename.c_str(), "wb");
 	if (this->fp == NULL)
 	{
 		this->error = FS(_F("Error opening file: \"{1}\"") % filename.str());
+		return;
 	}
+
+	// gzip header: deflate, no flags, no time, Unix
+	static const char header[] = { 0x1f, (char) 0x8b, 8, 0, 0, 0, 0, 0, 0, 3 };
+	writeRaw(header, sizeof(header));
+
+	this->current.reserve(GZ_OUTPUT_BLOCK_SIZE);
+	this->crc = crc32(0, NULL, 0);
 }
 
 GzOutputStream::~GzOutputStream()
@@ -60,16 +84,231 @@ void GzOutputStream::write(const char* data, int len)
 {
 	XOJ_CHECK_TYPE(GzOutputStream);
 
-	gzwrite(this->fp, data, len);
+	if (this->fp == NULL)
+	{
+		return;
+	}
+
+	while (len > 0)
+	{
+		int count = std::min(len, (int) (GZ_OUTPUT_BLOCK_SIZE - this->current.size()));
+		this->current.append(data, count);
+		data += count;
+		len -= count;
+
+		if (this->current.size() == GZ_OUTPUT_BLOCK_SIZE)
+		{
+			submitBlock(false);
+		}
+	}
+}
+
+void GzOutputStream::submitBlock(bool last)
+{
+	XOJ_CHECK_TYPE(GzOutputStream);
+
+	Block* block = new Block();
+	block->input.swap(this->current);
+	block->dictionary = this->history;
+	block->last = last;
+
+	this->current.reserve(GZ_OUTPUT_BLOCK_SIZE);
+
+	// The dictionary of the next block is the end of all input so far
+	this->history += block->input.substr(block->input.size() - std::min(block->input.size(), (size_t) GZ_OUTPUT_DICTIONARY_SIZE));
+	if (this->history.size() > GZ_OUTPUT_DICTIONARY_SIZE)
+	{
+		this->history.erase(0, this->history.size() - GZ_OUTPUT_DICTIONARY_SIZE);
+	}
+
+	this->pending.push_back(block);
+
+	// A single block is not worth a thread
+	if (this->threads.empty() && (last || this->threadCount <= 1))
+	{
+		compressBlock(block, this->level);
+		block->done = true;
+		writeFinishedBlocks(0);
+		return;
+	}
+
+	startThreads();
+
+	{
+		std::lock_guard<std::mutex> lock(this->queueMutex);
+		this->queue.push_back(block);
+	}
+	this->blockQueued.notify_one();
+
+	// Limits the memory used for blocks which are waiting to be written
+	writeFinishedBlocks(2 * this->threads.size());
+}
+
+void GzOutputStream::writeFinishedBlocks(size_t maxPending)
+{
+	XOJ_CHECK_TYPE(GzOutputStream);
+
+	while (!this->pending.empty())
+	{
+		Block* block = this->pending.front();
+
+		{
+			std::unique_lock<std::mutex> lock(this->queueMutex);
+			if (!block->done && this->pending.size() <= maxPending)
+			{
+				break;
+			}
+			this->blockDone.wait(lock, [block] { return block->done; });
+		}
+
+		writeRaw(block->output.data(), block->output.size());
+		this->crc = crc32_combine(this->crc, block->crc, block->input.size());
+		this->inputSize += block->input.size();
+
+		this->pending.pop_front();
+		delete block;
+	}
+}
+
+void GzOutputStream::writeRaw(const char* data, size_t len)
+{
+	XOJ_CHECK_TYPE(GzOutputStream);
+
+	if (fwrite(data, 1, len, this->fp) != len && this->error.empty())
+	{
+		this->error = FS(_F("Error writing file: \"{1}\"") % this->filename.str());
+	}
+}
+
+void GzOutputStream::startThreads()
+{
+	XOJ_CHECK_TYPE(GzOutputStream);
+
+	while ((int) this->threads.size() < this->threadCount)
+	{
+		this->threads.push_back(std::thread(&GzOutputStream::compressThread, this));
+	}
+}
+
+void GzOutputStream::stopThreads()
+{
+	XOJ_CHECK_TYPE(GzOutputStream);
+
+	{
+		std::lock_guard<std::mutex> lock(this->queueMutex);
+		this->stopping = true;
+	}
+	this->blockQueued.notify_all();
+
+	for (std::thread& t : this->threads)
+	{
+		t.join();
+	}
+	this->threads.clear();
+}
+
+void GzOutputStream::compressThread()
+{
+	XOJ_CHECK_TYPE(GzOutputStream);
+
+	while (true)
+	{
+		Block* block = NULL;
+		{
+			std::unique_lock<std::mutex> lock(this->queueMutex);
+			this->blockQueued.wait(lock, [this] { return this->stopping || !this->queue.empty(); });
+			if (this->queue.empty())
+			{
+				return;
+			}
+
+			block = this->queue.front();
+			this->queue.pop_front();
+		}
+
+		compressBlock(block, this->level);
+
+		{
+			std::lock_guard<std::mutex> lock(this->queueMutex);
+			block->done = true;
+		}
+		this->blockDone.notify_all();
+	}
+}
+
+void GzOutputStream::compressBlock(Block* block, int level)
+{
+	z_stream zs;
+	memset(&zs, 0, sizeof(zs));
+
+	// Raw deflate data, the gzip header and trailer are written for the whole file
+	if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		g_error("GzOutputStream: deflateInit2 failed");
+	}
+
+	if (!block->dictionary.empty())
+	{
+		deflateSetDictionary(&zs, (const Bytef*) block->dictionary.data(), block->dictionary.size());
+	}
+
+	// Not final blocks end with a sync flush, which aligns them to a byte boundary
+	int flush = block->last ? Z_FINISH : Z_SYNC_FLUSH;
+
+	block->output.resize(deflateBound(&zs, block->input.size()) + 16);
+	zs.next_in = (Bytef*) block->input.data();
+	zs.avail_in = block->input.size();
+	zs.next_out = (Bytef*) &block->output[0];
+	zs.avail_out = block->output.size();
+
+	while (true)
+	{
+		int ret = deflate(&zs, flush);
+		if (ret == Z_STREAM_END || ret == Z_STREAM_ERROR || (!block->last && zs.avail_out > 0))
+		{
+			break;
+		}
+
+		if (zs.avail_out == 0)
+		{
+			size_t used = block->output.size();
+			block->output.resize(used * 2);
+			zs.next_out = (Bytef*) &block->output[used];
+			zs.avail_out = used;
+		}
+	}
+
+	block->output.resize(zs.total_out);
+	deflateEnd(&zs);
+
+	block->crc = crc32(crc32(0, NULL, 0), (const Bytef*) block->input.data(), block->input.size());
 }
 
 void GzOutputStream::close()
 {
 	XOJ_CHECK_TYPE(GzOutputStream);
 
-	if (this->fp)
+	if (this->fp == NULL)
 	{
-		gzclose(this->fp);
-		this->fp = NULL;
+		return;
 	}
+
+	submitBlock(true);
+	writeFinishedBlocks(0);
+	stopThreads();
+
+	// gzip trailer, little endian
+	unsigned char trailer[8];
+	for (int i = 0; i < 4; i++)
+	{
+		trailer[i] = (this->crc >> (8 * i)) & 0xFF;
+		trailer[4 + i] = (this->inputSize >> (8 * i)) & 0xFF;
+	}
+	writeRaw((const char*) trailer, sizeof(trailer));
+
+	if (fclose(this->fp) != 0 && this->error.empty())
+	{
+		this->error = FS(_F("Error writing file: \"{1}\"") % this->filename.str());
+	}
+	this->fp = NULL;
 }
@@ -16,6 +16,27 @@
 #include <Path.h>
 #include <zlib.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Uncompressed size of the blocks which are compressed in parallel
+ */
+#define GZ_OUTPUT_BLOCK_SIZE (128 * 1024)
+
+/**
+ * Each block is compressed with the end of the previous block as dictionary, this is the deflate window size
+ */
+#define GZ_OUTPUT_DICTIONARY_SIZE (32 * 1024)
+
+/**
+ * Upper limit for the number of compression threads
+ */
+#define GZ_OUTPUT_MAX_THREADS 8
+
 class OutputStream
 {
 public:
@@ -30,10 +51,22 @@ public:
 	virtual void close() = 0;
 };
 
+/**
+ * Writes a gzip file, compressed on several threads.
+ *
+ * The data is split into blocks which are deflated independently, each ending
+ * with a sync flush, so they can be concatenated into a single deflate stream
+ * (the same approach as pigz). The result is a normal gzip file with one member.
+ * Files smaller than one block are compressed without starting any thread.
+ */
 class GzOutputStream : public OutputStream
 {
 public:
-	GzOutputStream(Path filename);
+	/**
+	 * @param level zlib compression level, 0 (fastest) to 9 (smallest), or Z_DEFAULT_COMPRESSION
+	 * @param threads The number of compression threads, 0 for one per CPU core
+	 */
+	GzOutputStream(Path filename, int level = Z_DEFAULT_COMPRESSION, int threads = 0);
 	virtual ~GzOutputStream();
 
 public:
@@ -43,10 +76,61 @@ public:
 
 	string& getLastError();
 
+private:
+	/**
+	 * A part of the data, compressed as raw deflate data
+	 */
+	struct Block
+	{
+		string input;
+		string dictionary;
+		string output;
+		uLong crc = 0;
+		bool last = false;
+		bool done = false;
+	};
+
+	void submitBlock(bool last);
+	void writeFinishedBlocks(size_t maxPending);
+	void writeRaw(const char* data, size_t len);
+	void startThreads();
+	void stopThreads();
+	void compressThread();
+
+	static void compressBlock(Block* block, int level);
+
 private:
 	XOJ_TYPE_ATTRIB;
 
-	gzFile fp = NULL;
+	FILE* fp = NULL;
+
+	int level;
+	int threadCount;
+
+	/**
+	 * The block which is currently filled, and the last input for the dictionary of the next block
+	 */
+	string current;
+	string history;
+
+	/**
+	 * Blocks which are not yet written, in file order
+	 */
+	std::deque<Block*> pending;
+
+	/**
+	 * Blocks waiting for a compression thread
+	 */
+	std::deque<Block*> queue;
+
+	std::vector<std::thread> threads;
+	std::mutex queueMutex;
+	std::condition_variable blockQueued;
+	std::condition_variable blockDone;
+	bool stopping = false;
+
+	uLong crc = 0;
+	size_t inputSize = 0;
 
 	string error;
 
@@ -0,0 +1,58 @@
+#include "StartupTimeline.h"
+
+#include "Tracer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+using std::vector;
+
+static gint64 startTime = 0;
+static bool printMarks = false;
+static vector<std::pair<const char*, gint64>> marks;
+
+void StartupTimeline::start()
+{
+	startTime = g_get_monotonic_time();
+	marks.clear();
+}
+
+void StartupTimeline::enable()
+{
+	printMarks = true;
+}
+
+void StartupTimeline::mark(const char* name)
+{
+	if (startTime == 0 || getElapsed(name) >= 0)
+	{
+		return;
+	}
+
+	gint64 elapsed = g_get_monotonic_time() - startTime;
+	marks.push_back(std::make_pair(name, elapsed));
+
+	if (printMarks)
+	{
+		fprintf(stderr, "Startup: %-24s %8.1f ms\n", name, elapsed / 1000.0);
+	}
+
+	if (Tracer::isEnabled())
+	{
+		Tracer::addZone(name, "startup", startTime, elapsed);
+	}
+}
+
+gint64 StartupTimeline::getElapsed(const char* name)
+{
+	for (std::pair<const char*, gint64>& m : marks)
+	{
+		if (strcmp(m.first, name) == 0)
+		{
+			return m.second;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,52 @@
+/*
+ * Xournal++
+ *
+ * Timestamps of the startup phases, printed with --startup-timeline
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+/**
+ * Records when the startup reached a phase, relative to start().
+ *
+ * Only the first mark of a name is kept, so marks may be placed in code which
+ * runs repeatedly, e.g. the first painted page. Only called from the main thread,
+ * names are not copied, only string literals may be used.
+ */
+class StartupTimeline
+{
+private:
+	StartupTimeline();
+	virtual ~StartupTimeline();
+	StartupTimeline(const StartupTimeline&);
+	StartupTimeline& operator=(const StartupTimeline&);
+
+public:
+	/**
+	 * The time all marks are relative to, the phases recorded before are cleared
+	 */
+	static void start();
+
+	/**
+	 * Print each phase to stderr when it is reached
+	 */
+	static void enable();
+
+	/**
+	 * Records the phase, if it was not reached before. If tracing is enabled the
+	 * time since start() is also added as zone of the category "startup".
+	 */
+	static void mark(const char* name);
+
+	/**
+	 * @return The microseconds from start() to the phase, -1 if it was not reached
+	 */
+	static gint64 getElapsed(const char* name);
+};
@@ -0,0 +1,219 @@
+#include "Tracer.h"
+
+#include <fstream>
+#include <vector>
+using std::vector;
+
+/**
+ * One recorded zone
+ */
+struct TraceEvent
+{
+	const char* name;
+	const char* category;
+	gint64 start;
+	gint64 duration;
+};
+
+/**
+ * The events of one thread. Only the owning thread adds events, without a
+ * lock: the flag is only taken by another thread while the buffer is cleared
+ * or written, an event added in this moment is dropped.
+ *
+ * The events are only allocated while tracing is enabled.
+ */
+class TraceBuffer
+{
+public:
+	TraceBuffer(int threadId, size_t size)
+	 : threadId(threadId)
+	{
+		this->events.resize(size);
+	}
+
+public:
+	void add(const TraceEvent& event)
+	{
+		if (this->busy.exchange(true, std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if (!this->events.empty())
+		{
+			this->events[this->next] = event;
+			this->next = (this->next + 1) % this->events.size();
+			if (this->count < this->events.size())
+			{
+				this->count++;
+			}
+		}
+
+		this->busy.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * Waits until the owning thread has finished adding an event
+	 */
+	void lock()
+	{
+		while (this->busy.exchange(true, std::memory_order_acquire))
+		{
+			g_thread_yield();
+		}
+	}
+
+	void unlock()
+	{
+		this->busy.store(false, std::memory_order_release);
+	}
+
+	void clear(size_t size)
+	{
+		lock();
+		this->events.resize(size);
+		this->events.shrink_to_fit();
+		this->next = 0;
+		this->count = 0;
+		unlock();
+	}
+
+public:
+	int threadId;
+	string threadName;
+
+	std::atomic<bool> busy { false };
+	vector<TraceEvent> events;
+
+	/**
+	 * Position of the next event, the oldest event if the buffer is full
+	 */
+	size_t next = 0;
+	size_t count = 0;
+};
+
+std::atomic<bool> Tracer::enabled(false);
+
+/**
+ * All buffers, the buffers of finished threads are kept, so their events are not lost
+ */
+static GMutex buffersMutex;
+static vector<TraceBuffer*> buffers;
+static size_t bufferSize = TRACE_DEFAULT_BUFFER_SIZE;
+
+static thread_local TraceBuffer* threadBuffer = NULL;
+
+static TraceBuffer* getThreadBuffer()
+{
+	if (threadBuffer == NULL)
+	{
+		g_mutex_lock(&buffersMutex);
+		threadBuffer = new TraceBuffer(buffers.size() + 1, Tracer::isEnabled() ? bufferSize : 0);
+		buffers.push_back(threadBuffer);
+		g_mutex_unlock(&buffersMutex);
+	}
+
+	return threadBuffer;
+}
+
+Tracer::Tracer() { }
+
+Tracer::~Tracer() { }
+
+void Tracer::enable(size_t eventsPerThread)
+{
+	g_mutex_lock(&buffersMutex);
+	bufferSize = MAX(eventsPerThread, 1);
+	for (TraceBuffer* b : buffers)
+	{
+		b->clear(bufferSize);
+	}
+
+	// Set with the lock, so a buffer created right now gets its events
+	enabled.store(true);
+	g_mutex_unlock(&buffersMutex);
+}
+
+void Tracer::disable()
+{
+	enabled.store(false);
+}
+
+void Tracer::setThreadName(const char* name)
+{
+	TraceBuffer* b = getThreadBuffer();
+
+	b->lock();
+	b->threadName = name;
+	b->unlock();
+}
+
+void Tracer::addZone(const char* name, const char* category, gint64 start, gint64 duration)
+{
+	TraceEvent event = { name, category, start, duration };
+	getThreadBuffer()->add(event);
+}
+
+static void writeJsonString(std::ofstream& out, const char* str)
+{
+	out << '"';
+	for (const char* c = str; *c; c++)
+	{
+		if (*c == '"' || *c == '\\')
+		{
+			out << '\\';
+		}
+		out << *c;
+	}
+	out << '"';
+}
+
+bool Tracer::writeChromeTrace(string filename)
+{
+	std::ofstream out(filename.c_str());
+	if (!out.is_open())
+	{
+		return false;
+	}
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool first = true;
+
+	g_mutex_lock(&buffersMutex);
+	for (TraceBuffer* b : buffers)
+	{
+		b->lock();
+
+		if (!b->threadName.empty())
+		{
+			out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->threadId
+				<< ",\"args\":{\"name\":";
+			writeJsonString(out, b->threadName.c_str());
+			out << "}}";
+			first = false;
+		}
+
+		size_t size = b->events.size();
+		size_t oldest = size > 0 ? (b->next + size - b->count) % size : 0;
+		for (size_t i = 0; i < b->count; i++)
+		{
+			const TraceEvent& e = b->events[(oldest + i) % size];
+
+			out << (first ? "" : ",\n") << "{\"name\":";
+			writeJsonString(out, e.name);
+			out << ",\"cat\":";
+			writeJsonString(out, e.category);
+			out << ",\"ph\":\"X\",\"ts\":" << e.start << ",\"dur\":" << e.duration << ",\"pid\":1,\"tid\":" << b->threadId << "}";
+			first = false;
+		}
+
+		b->unlock();
+	}
+	g_mutex_unlock(&buffersMutex);
+
+	out << "\n]}\n";
+	out.close();
+
+	return !out.fail();
+}
@@ -0,0 +1,117 @@
+/*
+ * Xournal++
+ *
+ * Low overhead performance tracing, exported as Chrome trace events
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+#include <atomic>
+#include <string>
+using std::string;
+
+/**
+ * Default number of events kept per thread, older events are overwritten
+ */
+#define TRACE_DEFAULT_BUFFER_SIZE 65536
+
+/**
+ * Collects timed zones into one ring buffer per thread.
+ *
+ * If tracing is disabled a zone costs one atomic load. Names and
+ * categories are not copied, only string literals may be used.
+ */
+class Tracer
+{
+private:
+	Tracer();
+	virtual ~Tracer();
+	Tracer(const Tracer&);
+	Tracer& operator=(const Tracer&);
+
+public:
+	/**
+	 * Start recording, the buffers of all threads are cleared
+	 */
+	static void enable(size_t eventsPerThread = TRACE_DEFAULT_BUFFER_SIZE);
+
+	/**
+	 * Stop recording, the recorded events are kept until the next enable
+	 */
+	static void disable();
+
+	static inline bool isEnabled()
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Name of the current thread in the trace
+	 */
+	static void setThreadName(const char* name);
+
+	/**
+	 * Records a finished zone of the current thread, times in microseconds
+	 */
+	static void addZone(const char* name, const char* category, gint64 start, gint64 duration);
+
+	/**
+	 * Writes all recorded events as Chrome trace event JSON (chrome://tracing, Perfetto)
+	 *
+	 * @return true on success
+	 */
+	static bool writeChromeTrace(string filename);
+
+private:
+	static std::atomic<bool> enabled;
+};
+
+/**
+ * Records the time from construction to destruction
+ */
+class TraceZone
+{
+public:
+	TraceZone(const char* name, const char* category = "xournalpp")
+	{
+		if (Tracer::isEnabled())
+		{
+			this->name = name;
+			this->category = category;
+			this->start = g_get_monotonic_time();
+		}
+	}
+
+	~TraceZone()
+	{
+		if (this->name)
+		{
+			Tracer::addZone(this->name, this->category, this->start, g_get_monotonic_time() - this->start);
+		}
+	}
+
+private:
+	TraceZone(const TraceZone&);
+	TraceZone& operator=(const TraceZone&);
+
+private:
+	const char* name = NULL;
+	const char* category = NULL;
+	gint64 start = 0;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * Traces the rest of the current scope
+ */
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_ZONE_CATEGORY(name, category) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name, category)
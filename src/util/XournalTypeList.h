@@ -40,7 +40,6 @@ XOJ_DECLARE_TYPE(XournalppCursor, 28);
 XOJ_DECLARE_TYPE(GladeGui, 29);
 XOJ_DECLARE_TYPE(GladeSearchpath, 30);
 XOJ_DECLARE_TYPE(EraseableStroke, 31);
-XOJ_DECLARE_TYPE(EraseableStrokePart, 32);
 XOJ_DECLARE_TYPE(Document, 33);
 XOJ_DECLARE_TYPE(DocumentHandler, 34);
 XOJ_DECLARE_TYPE(DocumentListener, 35);
@@ -153,7 +152,6 @@ XOJ_DECLARE_TYPE(GzOutputStream, 142);
 XOJ_DECLARE_TYPE(PageBackgroundChangedUndoAction, 143);
 XOJ_DECLARE_TYPE(PdfExportJob, 144);
 XOJ_DECLARE_TYPE(BackgroundImage, 145);
-XOJ_DECLARE_TYPE(PartList, 146);
 XOJ_DECLARE_TYPE(PageRangeEntry, 147);
 XOJ_DECLARE_TYPE(ImageExport, 148);
 XOJ_DECLARE_TYPE(ColorSelectImage, 149);
@@ -297,3 +295,15 @@ XOJ_DECLARE_TYPE(TouchDisableGdk, 287);
 XOJ_DECLARE_TYPE(DeviceClassConfigGui, 288);
 XOJ_DECLARE_TYPE(FloatingToolbox, 289);
 XOJ_DECLARE_TYPE(StavesBackgroundPainter, 290);
+XOJ_DECLARE_TYPE(IncrementalShapeRecognizer, 291);
+XOJ_DECLARE_TYPE(StrokeLevelOfDetail, 292);
+XOJ_DECLARE_TYPE(StrokeSegmentIndex, 293);
+XOJ_DECLARE_TYPE(AudioTimeline, 294);
+XOJ_DECLARE_TYPE(DamageRegion, 296);
+XOJ_DECLARE_TYPE(RenderMemoryManager, 297);
+XOJ_DECLARE_TYPE(PdfFileReader, 298);
+XOJ_DECLARE_TYPE(XojPdfOverlayExport, 299);
+XOJ_DECLARE_TYPE(PageSnapshot, 300);
+XOJ_DECLARE_TYPE(LayerCache, 301);
+XOJ_DECLARE_TYPE(RenderPrefetcher, 302);
+XOJ_DECLARE_TYPE(PdfPageSizeJob, 303);
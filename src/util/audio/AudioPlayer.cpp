@@ -5,7 +5,8 @@ AudioPlayer::AudioPlayer(Control* control, Settings* settings) : control(control
 {
 	XOJ_INIT_TYPE(AudioPlayer);
 
-	this->audioQueue = new AudioQueue<float>();
+	// Only read a short time ahead, the file reader waits for free space
+	this->audioQueue = new AudioQueue<float>(16384);
 	this->portAudioConsumer = new PortAudioConsumer(this, this->audioQueue);
 	this->vorbisProducer = new VorbisProducer(this->audioQueue);
 }
@@ -32,6 +33,8 @@ bool AudioPlayer::start(string filename, unsigned int timestamp)
 {
 	XOJ_CHECK_TYPE(AudioPlayer);
 
+	this->startTimestamp = timestamp;
+
 	// Start the producer for reading the data
 	bool status = this->vorbisProducer->start(std::move(filename), timestamp);
 
@@ -76,6 +79,22 @@ bool AudioPlayer::play()
 	return this->portAudioConsumer->startPlaying();
 }
 
+size_t AudioPlayer::getPlaybackTime()
+{
+	XOJ_CHECK_TYPE(AudioPlayer);
+
+	double sampleRate;
+	unsigned int channels;
+	this->audioQueue->getAudioAttributes(sampleRate, channels);
+
+	if (sampleRate <= 0)
+	{
+		return this->startTimestamp;
+	}
+
+	return this->startTimestamp + static_cast<size_t>(this->audioQueue->getConsumedFrames() * 1000 / sampleRate);
+}
+
 void AudioPlayer::disableAudioPlaybackButtons()
 {
 	XOJ_CHECK_TYPE(AudioPlayer);
@@ -31,6 +31,11 @@ public:
 	bool play();
 	void pause();
 
+	/**
+	 * @return The position of the playback in the recording in milliseconds
+	 */
+	size_t getPlaybackTime();
+
 	vector<DeviceInfo> getOutputDevices();
 
 	Settings* getSettings();
@@ -46,4 +51,6 @@ protected:
 	PortAudioConsumer* portAudioConsumer = nullptr;
 	VorbisProducer* vorbisProducer = nullptr;
 	std::thread stopThread;
+
+	size_t startTimestamp = 0;
 };
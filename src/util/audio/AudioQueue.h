@@ -13,18 +13,51 @@
 
 #include <XournalType.h>
 
-#include <vector>
-#include <deque>
-#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+/**
+ * Default capacity in samples, about ten seconds of 48 kHz stereo
+ */
+#define AUDIO_QUEUE_DEFAULT_CAPACITY (1 << 20)
+
+/**
+ * Maximum time a waiting thread sleeps without being notified.
+ * Notifications are sent without a lock, so a wakeup may be missed.
+ */
+#define AUDIO_QUEUE_WAIT_TIMEOUT std::chrono::milliseconds(5)
 
+/**
+ * Lock-free ring buffer with a single producer and a single consumer.
+ *
+ * push and pop never lock and never allocate, so they can be called from the
+ * PortAudio callbacks. The wait methods are only for the file reader / writer
+ * threads, they sleep until the other side made progress.
+ *
+ * reset may only be called while neither side is running.
+ */
 template <typename T>
-class AudioQueue : protected std::deque<T>
+class AudioQueue
 {
 public:
-	AudioQueue()
+	explicit AudioQueue(unsigned long capacity = AUDIO_QUEUE_DEFAULT_CAPACITY)
 	{
 		XOJ_INIT_TYPE(AudioQueue);
+
+		// Power of two, so the position can be wrapped with a mask
+		unsigned long size = 1;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		this->buffer.resize(size);
+		this->mask = size - 1;
 	}
 
 	~AudioQueue()
@@ -34,15 +67,21 @@ public:
 		XOJ_RELEASE_TYPE(AudioQueue);
 	}
 
+private:
+	AudioQueue(const AudioQueue& queue);
+	void operator=(const AudioQueue& queue);
+
 public:
 	void reset()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		this->popNotified = false;
-		this->pushNotified = false;
 		this->streamEnd = false;
-		this->clear();
+		this->writePosition = 0;
+		this->readPosition = 0;
+
+		this->underruns = 0;
+		this->overruns = 0;
 
 		this->sampleRate = -1;
 		this->channels = 0;
@@ -52,31 +91,74 @@ public:
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		return std::deque<T>::empty();
+		return size() == 0;
 	}
 
 	unsigned long size()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		return std::deque<T>::size();
+		return this->writePosition.load(std::memory_order_acquire) - this->readPosition.load(std::memory_order_acquire);
+	}
+
+	unsigned long capacity()
+	{
+		XOJ_CHECK_TYPE(AudioQueue);
+
+		return this->buffer.size();
 	}
 
-	void push(T* samples, unsigned long nSamples)
+	/**
+	 * @return The number of frames removed by the consumer since the last reset
+	 */
+	unsigned long getConsumedFrames()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		for (unsigned long i = 0; i < nSamples; i++)
+		return this->channels == 0 ? 0 : this->readPosition.load(std::memory_order_acquire) / this->channels;
+	}
+
+	/**
+	 * @return The number of samples which can be pushed without dropping any
+	 */
+	unsigned long freeSpace()
+	{
+		XOJ_CHECK_TYPE(AudioQueue);
+
+		return capacity() - size();
+	}
+
+	/**
+	 * Appends the samples. Only called by the producer.
+	 *
+	 * Samples which do not fit are dropped and counted as overrun.
+	 *
+	 * @return The number of samples stored
+	 */
+	unsigned long push(const T* samples, unsigned long nSamples)
+	{
+		XOJ_CHECK_TYPE(AudioQueue);
+
+		unsigned long write = this->writePosition.load(std::memory_order_relaxed);
+		unsigned long read = this->readPosition.load(std::memory_order_acquire);
+
+		unsigned long length = std::min(nSamples, this->buffer.size() - (write - read));
+		copyIn(write, samples, length);
+		this->writePosition.store(write + length, std::memory_order_release);
+
+		if (length < nSamples)
 		{
-			this->push_front(samples[i]);
+			this->overruns.fetch_add(1, std::memory_order_relaxed);
 		}
 
-		this->popNotified = false;
+		this->pushCondition.notify_one();
 
-		this->pushNotified = true;
-		this->pushLockCondition.notify_one();
+		return length;
 	}
 
+	/**
+	 * Removes up to nSamples samples, always whole frames. Only called by the consumer.
+	 */
 	void pop(T* returnBuffer, unsigned long& returnBufferLength, unsigned long nSamples)
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
@@ -84,69 +166,94 @@ public:
 		if (this->channels == 0)
 		{
 			returnBufferLength = 0;
-
-			this->popNotified = true;
-			this->popLockCondition.notify_one();
-
+			this->popCondition.notify_one();
 			return;
 		}
 
-		returnBufferLength = std::min(nSamples, this->size() - this->size() % this->channels);
-		for (long i = 0; i < returnBufferLength; i++)
-		{
-			returnBuffer[i] = this->back();
-			this->pop_back();
-		}
+		unsigned long read = this->readPosition.load(std::memory_order_relaxed);
+		unsigned long available = this->writePosition.load(std::memory_order_acquire) - read;
 
-		this->pushNotified = false;
+		returnBufferLength = std::min(nSamples, available);
+		returnBufferLength -= returnBufferLength % this->channels;
 
-		this->popNotified = true;
-		this->popLockCondition.notify_one();
+		copyOut(read, returnBuffer, returnBufferLength);
+		this->readPosition.store(read + returnBufferLength, std::memory_order_release);
+
+		this->popCondition.notify_one();
 	}
 
 	void signalEndOfStream()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		this->streamEnd = true;
-		this->pushNotified = true;
-		this->pushLockCondition.notify_one();
-		this->popNotified = true;
-		this->popLockCondition.notify_one();
+		this->streamEnd.store(true, std::memory_order_release);
+		this->pushCondition.notify_all();
+		this->popCondition.notify_all();
 	}
 
-	void waitForProducer(std::unique_lock<std::mutex>& lock)
+	/**
+	 * Waits until at least one frame is available or the stream has ended
+	 */
+	void waitForProducer()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		while (!this->pushNotified)
+		std::unique_lock<std::mutex> lock(this->waitMutex);
+		this->pushCondition.wait_for(lock, AUDIO_QUEUE_WAIT_TIMEOUT, [this]
 		{
-			this->pushLockCondition.wait(lock);
-		}
+			return size() >= std::max(this->channels, 1u) || hasStreamEnded();
+		});
 	}
 
-	void waitForConsumer(std::unique_lock<std::mutex>& lock)
+	/**
+	 * Waits until nSamples samples can be pushed or the stream has ended
+	 */
+	void waitForConsumer(unsigned long nSamples)
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		while (!this->popNotified)
+		std::unique_lock<std::mutex> lock(this->waitMutex);
+		this->popCondition.wait_for(lock, AUDIO_QUEUE_WAIT_TIMEOUT, [this, nSamples]
 		{
-			this->popLockCondition.wait(lock);
-		}
+			return freeSpace() >= nSamples || hasStreamEnded();
+		});
 	}
 
 	bool hasStreamEnded()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		return this->streamEnd;
+		return this->streamEnd.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Called by the consumer if it needed more samples than were available
+	 */
+	void reportUnderrun()
+	{
+		XOJ_CHECK_TYPE(AudioQueue);
+
+		this->underruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return How often the consumer ran out of samples since the last reset
+	 */
+	unsigned long getUnderrunCount()
+	{
+		XOJ_CHECK_TYPE(AudioQueue);
+
+		return this->underruns.load(std::memory_order_relaxed);
 	}
 
-	std::mutex& syncMutex()
+	/**
+	 * @return How often samples were dropped because the queue was full since the last reset
+	 */
+	unsigned long getOverrunCount()
 	{
 		XOJ_CHECK_TYPE(AudioQueue);
 
-		return this->queueLock;
+		return this->overruns.load(std::memory_order_relaxed);
 	}
 
 	void setAudioAttributes(double sampleRate, unsigned int channels)
@@ -161,16 +268,49 @@ public:
 		channels = this->channels;
 	}
 
+private:
+	void copyIn(unsigned long position, const T* samples, unsigned long length)
+	{
+		unsigned long start = position & this->mask;
+		unsigned long first = std::min(length, this->buffer.size() - start);
+
+		std::memcpy(&this->buffer[start], samples, first * sizeof(T));
+		std::memcpy(&this->buffer[0], samples + first, (length - first) * sizeof(T));
+	}
+
+	void copyOut(unsigned long position, T* samples, unsigned long length)
+	{
+		unsigned long start = position & this->mask;
+		unsigned long first = std::min(length, this->buffer.size() - start);
+
+		std::memcpy(samples, &this->buffer[start], first * sizeof(T));
+		std::memcpy(samples + first, &this->buffer[0], (length - first) * sizeof(T));
+	}
+
 private:
 	XOJ_TYPE_ATTRIB;
 
 protected:
-	std::mutex queueLock;
-	bool streamEnd = false;
-	std::condition_variable pushLockCondition;
-	bool pushNotified = false;
-	std::condition_variable popLockCondition;
-	bool popNotified = false;
+	std::vector<T> buffer;
+	unsigned long mask = 0;
+
+	/**
+	 * Positions only grow, the index into the buffer is position & mask.
+	 * The padding keeps them on different cache lines.
+	 */
+	std::atomic<unsigned long> writePosition{0};
+	char writePadding[64];
+	std::atomic<unsigned long> readPosition{0};
+	char readPadding[64];
+
+	std::atomic<bool> streamEnd{false};
+
+	std::atomic<unsigned long> underruns{0};
+	std::atomic<unsigned long> overruns{0};
+
+	std::mutex waitMutex;
+	std::condition_variable pushCondition;
+	std::condition_variable popCondition;
 
 	double sampleRate = -1;
 	unsigned int channels = 0;
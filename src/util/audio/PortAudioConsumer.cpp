@@ -143,10 +143,11 @@ int PortAudioConsumer::playCallback(const void* inputBuffer, void* outputBuffer,
 
 		if (outputBufferLength < framesPerBuffer * this->outputChannels)
 		{
-			// Show frame underflow warning if there are not enough samples and the stream is not yet finished
+			// Count the underflow if there are not enough samples and the stream is not yet finished,
+			// it is reported when the playback stops, the callback should not log
 			if (!this->audioQueue->hasStreamEnded())
 			{
-				g_warning("PortAudioConsumer: Not enough audio samples available to fill requested frame");
+				this->audioQueue->reportUnderrun();
 			}
 
 			auto outputBufferImpl = (float*) outputBuffer;
@@ -209,4 +210,10 @@ void PortAudioConsumer::stopPlaying()
 			 */
 		}
 	}
+
+	if (this->audioQueue->getUnderrunCount() > 0)
+	{
+		g_message("PortAudioConsumer: %lu times not enough audio samples were available to fill the requested frame",
+				  this->audioQueue->getUnderrunCount());
+	}
 }
@@ -119,7 +119,6 @@ int PortAudioProducer::recordCallback(const void* inputBuffer, void* outputBuffe
 									  const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags)
 {
 	XOJ_CHECK_TYPE(PortAudioProducer);
-	std::unique_lock<std::mutex> lock(this->audioQueue->syncMutex());
 
 	if (statusFlags)
 	{
@@ -130,7 +129,8 @@ int PortAudioProducer::recordCallback(const void* inputBuffer, void* outputBuffe
 	{
 		unsigned long providedFrames = framesPerBuffer * this->inputChannels;
 
-		this->audioQueue->push((float*) inputBuffer, providedFrames);
+		// Does not block, if the writer thread is too slow the samples are dropped and counted
+		this->audioQueue->push((const float*) inputBuffer, providedFrames);
 	}
 	return paContinue;
 }
@@ -162,6 +162,12 @@ void PortAudioProducer::stopRecording()
 	// Notify the consumer at the other side that ther will be no more data
 	this->audioQueue->signalEndOfStream();
 
+	if (this->audioQueue->getOverrunCount() > 0)
+	{
+		g_message("PortAudioProducer: %lu times audio samples were dropped, because they could not be written fast enough",
+				  this->audioQueue->getOverrunCount());
+	}
+
 	// Allow new recording by removing the old one
 	delete this->inputStream;
 	this->inputStream = nullptr;
@@ -44,31 +44,38 @@ bool VorbisConsumer::start(string filename)
 	this->consumerThread = new std::thread(
 			[&, sfFile, channels]
 			{
-				std::unique_lock<std::mutex> lock(audioQueue->syncMutex());
-
-				float buffer[64 * channels];
+				std::vector<float> buffer(1024 * channels);
 				unsigned long bufferLength;
 				double audioGain = this->settings->getAudioGain();
 
-				while (!(this->stopConsumer || (audioQueue->hasStreamEnded() && audioQueue->empty())))
+				while (true)
 				{
-					audioQueue->waitForProducer(lock);
+					// Read before pop, so all samples pushed before the end are seen
+					bool streamEnded = audioQueue->hasStreamEnded();
 
-					while (!audioQueue->empty())
-					{
-						this->audioQueue->pop(buffer, bufferLength, 64 * channels);
+					this->audioQueue->pop(buffer.data(), bufferLength, buffer.size());
 
-						// apply gain
-						if (audioGain != 1.0)
+					if (bufferLength == 0)
+					{
+						if (this->stopConsumer || streamEnded)
 						{
-							for (unsigned int i = 0; i < 64 * channels; ++i)
-							{
-								buffer[i] = buffer[i] * audioGain;
-							}
+							break;
 						}
 
-						sf_writef_float(sfFile, buffer, 64);
+						audioQueue->waitForProducer();
+						continue;
 					}
+
+					// apply gain
+					if (audioGain != 1.0)
+					{
+						for (unsigned long i = 0; i < bufferLength; ++i)
+						{
+							buffer[i] = buffer[i] * audioGain;
+						}
+					}
+
+					sf_writef_float(sfFile, buffer.data(), bufferLength / channels);
 				}
 
 				sf_close(sfFile);
@@ -25,7 +25,7 @@ bool VorbisProducer::start(std::string filename, unsigned int timestamp)
 		return false;
 	}
 
-	sf_count_t seekPosition = this->sfInfo.samplerate / 1000 * timestamp;
+	sf_count_t seekPosition = static_cast<sf_count_t>(this->sfInfo.samplerate) * timestamp / 1000;
 	if (seekPosition < this->sfInfo.frames)
 	{
 		sf_seek(this->sfFile, seekPosition, SEEK_SET);
@@ -46,13 +46,19 @@ bool VorbisProducer::start(std::string filename, unsigned int timestamp)
 				while (!this->stopProducer && numSamples > 0 && !this->audioQueue->hasStreamEnded())
 				{
 					numSamples = sf_readf_float(this->sfFile, sampleBuffer, 1024);
+					auto length = static_cast<unsigned long>(numSamples * this->sfInfo.channels);
 
-					while (this->audioQueue->size() >= this->sample_buffer_size && !this->audioQueue->hasStreamEnded() && !this->stopProducer)
+					while (this->audioQueue->freeSpace() < length && !this->audioQueue->hasStreamEnded() && !this->stopProducer)
 					{
-						std::this_thread::sleep_for(std::chrono::microseconds(100));
+						this->audioQueue->waitForConsumer(length);
 					}
 
-					this->audioQueue->push(sampleBuffer, static_cast<unsigned long>(numSamples * this->sfInfo.channels));
+					if (this->stopProducer || this->audioQueue->hasStreamEnded())
+					{
+						break;
+					}
+
+					this->audioQueue->push(sampleBuffer, length);
 				}
 				this->audioQueue->signalEndOfStream();
 
@@ -9,9 +9,13 @@
 #include "model/BackgroundImage.h"
 #include "model/eraser/EraseableStroke.h"
 #include "model/Layer.h"
+#include "model/StrokeLevelOfDetail.h"
 
 #include <config.h>
 #include <config-debug.h>
+#include <Tracer.h>
+
+#include <cmath>
 
 
 DocumentView::DocumentView()
@@ -41,6 +45,13 @@ void DocumentView::setMarkAudioStroke(bool markAudioStroke)
 	this->markAudioStroke = markAudioStroke;
 }
 
+void DocumentView::setLevelOfDetail(bool levelOfDetail)
+{
+	XOJ_CHECK_TYPE(DocumentView);
+
+	this->levelOfDetail = levelOfDetail;
+}
+
 void DocumentView::applyColor(cairo_t* cr, Stroke* s)
 {
 	if (s->getToolType() == STROKE_TOOL_HIGHLIGHTER)
@@ -87,6 +98,16 @@ void DocumentView::drawStroke(cairo_t* cr, Stroke* s, int startPoint, double sca
 
 	StrokeView sv(cr, s, startPoint, scaleFactor, noAlpha);
 
+	if (this->lodMaxError > 0)
+	{
+		sv.useLevelOfDetail(this->lodMaxError);
+	}
+
+	if (this->highlighterGroup)
+	{
+		sv.useSharedGroup();
+	}
+
 	if (changeSource)
 	{
 		sv.changeCairoSource(this->markAudioStroke);
@@ -204,6 +225,85 @@ void DocumentView::drawElement(cairo_t* cr, Element* e)
 	}
 }
 
+void DocumentView::drawLayerElement(cairo_t* cr, Element* e)
+{
+	XOJ_CHECK_TYPE(DocumentView);
+
+	if (e->getType() == ELEMENT_STROKE)
+	{
+		Stroke* s = (Stroke*) e;
+
+		// Strokes which are erased right now are drawn without group
+		if (StrokeView::needsGroup(s) && !(s->getEraseable() && !this->dontRenderEditingStroke))
+		{
+			drawHighlighterStroke(cr, s);
+			return;
+		}
+	}
+
+	finishHighlighterGroup(cr);
+	drawElement(cr, e);
+}
+
+void DocumentView::drawHighlighterStroke(cairo_t* cr, Stroke* s)
+{
+	XOJ_CHECK_TYPE(DocumentView);
+
+	// The bounding box starts at the points, the round caps and the antialiasing are outside
+	double aaX = 2;
+	double aaY = 2;
+	cairo_device_to_user_distance(cr, &aaX, &aaY);
+	double margin = s->getWidth() / 2 + std::abs(aaX) + std::abs(aaY);
+	Rectangle area(s->getX() - margin, s->getY() - margin,
+				   s->getElementWidth() + 2 * margin, s->getElementHeight() + 2 * margin);
+
+	if (this->highlighterGroup &&
+		(s->getColor() != this->highlighterColor || s->getFill() != this->highlighterFill))
+	{
+		finishHighlighterGroup(cr);
+	}
+
+	// Overlapping strokes in one group would be painted darker than with a group each
+	for (Rectangle& r : this->highlighterAreas)
+	{
+		if (r.intersects(area))
+		{
+			finishHighlighterGroup(cr);
+			break;
+		}
+	}
+
+	if (!this->highlighterGroup)
+	{
+		// The operator of the highlighter, the group is painted with it
+		cairo_set_operator(cr, CAIRO_OPERATOR_MULTIPLY);
+		cairo_push_group(cr);
+
+		this->highlighterGroup = true;
+		this->highlighterColor = s->getColor();
+		this->highlighterFill = s->getFill();
+	}
+
+	this->highlighterAreas.push_back(area);
+
+	drawStroke(cr, s);
+}
+
+void DocumentView::finishHighlighterGroup(cairo_t* cr)
+{
+	XOJ_CHECK_TYPE(DocumentView);
+
+	if (!this->highlighterGroup)
+	{
+		return;
+	}
+
+	StrokeView::paintGroup(cr, this->highlighterFill, false);
+
+	this->highlighterGroup = false;
+	this->highlighterAreas.clear();
+}
+
 /**
  * Draw a single layer
  * @param cr Draw to thgis context
@@ -233,7 +333,7 @@ void DocumentView::drawLayer(cairo_t* cr, Layer* l)
 		{
 			if (e->intersectsArea(this->lX, this->lY, this->width, this->height))
 			{
-				drawElement(cr, e);
+				drawLayerElement(cr, e);
 #ifdef DEBUG_SHOW_REPAINT_BOUNDS
 				drawn++;
 #endif // DEBUG_SHOW_REPAINT_BOUNDS
@@ -251,10 +351,12 @@ void DocumentView::drawLayer(cairo_t* cr, Layer* l)
 #ifdef DEBUG_SHOW_REPAINT_BOUNDS
 			drawn++;
 #endif // DEBUG_SHOW_REPAINT_BOUNDS
-			drawElement(cr, e);
+			drawLayerElement(cr, e);
 		}
 	}
 
+	finishHighlighterGroup(cr);
+
 #ifdef DEBUG_SHOW_REPAINT_BOUNDS
 	g_message("DBG:DocumentView: draw %i / not draw %i", drawn, notDrawn);
 #endif // DEBUG_SHOW_REPAINT_BOUNDS
@@ -320,6 +422,39 @@ void DocumentView::initDrawing(PageRef page, cairo_t* cr, bool dontRenderEditing
 	this->width = page->getWidth();
 	this->height = page->getHeight();
 	this->dontRenderEditingStroke = dontRenderEditingStroke;
+
+	initLevelOfDetail();
+}
+
+void DocumentView::initLevelOfDetail()
+{
+	XOJ_CHECK_TYPE(DocumentView);
+
+	this->lodMaxError = 0;
+
+	if (!this->levelOfDetail)
+	{
+		return;
+	}
+
+	cairo_surface_type_t type = cairo_surface_get_type(cairo_get_target(cr));
+	if (type == CAIRO_SURFACE_TYPE_PDF || type == CAIRO_SURFACE_TYPE_PS ||
+		type == CAIRO_SURFACE_TYPE_SVG || type == CAIRO_SURFACE_TYPE_RECORDING)
+	{
+		return;
+	}
+
+	// Smallest scale of the current transformation, one document unit in device pixels
+	double xx = 1, xy = 0;
+	double yx = 0, yy = 1;
+	cairo_user_to_device_distance(cr, &xx, &xy);
+	cairo_user_to_device_distance(cr, &yx, &yy);
+	double scale = std::min(std::hypot(xx, xy), std::hypot(yx, yy));
+
+	if (scale > 0)
+	{
+		this->lodMaxError = LOD_PIXEL_ERROR / scale;
+	}
 }
 
 /**
@@ -349,6 +484,8 @@ void DocumentView::finializeDrawing()
 	this->lWidth = -1;
 	this->lHeight = -1;
 
+	this->lodMaxError = 0;
+
 	this->page = NULL;
 	this->cr = NULL;
 }
@@ -407,16 +544,35 @@ void DocumentView::drawPage(PageRef page, cairo_t* cr, bool dontRenderEditingStr
 {
 	XOJ_CHECK_TYPE(DocumentView);
 
+	drawLayers(page, cr, 0, page->getLayerCount(), dontRenderEditingStroke, hideBackground);
+}
+
+/**
+ * Draw a part of the page, e.g. on top of a buffer which contains the layers below
+ * @param page The page to draw
+ * @param cr Draw to this context
+ * @param firstLayer The first layer ID to draw, 0 to draw the background, too
+ * @param lastLayer The last layer ID to draw
+ * @param dontRenderEditingStroke false to draw currently drawing stroke
+ * @param hideBackground true to hide the background
+ */
+void DocumentView::drawLayers(PageRef page, cairo_t* cr, int firstLayer, int lastLayer,
+							  bool dontRenderEditingStroke, bool hideBackground)
+{
+	XOJ_CHECK_TYPE(DocumentView);
+
+	TRACE_ZONE("DocumentView::drawPage");
+
 	initDrawing(page, cr, dontRenderEditingStroke);
 
 	bool backgroundVisible = page->isLayerVisible(0);
 
-	if (!hideBackground && backgroundVisible)
+	if (firstLayer == 0 && !hideBackground && backgroundVisible)
 	{
 		drawBackground();
 	}
 
-	if (!backgroundVisible)
+	if (firstLayer == 0 && !backgroundVisible)
 	{
 		drawTransparentBackgroundPattern();
 	}
@@ -424,13 +580,13 @@ void DocumentView::drawPage(PageRef page, cairo_t* cr, bool dontRenderEditingStr
 	int layer = 0;
 	for (Layer* l : *page->getLayers())
 	{
-		if (!page->isLayerVisible(l))
+		layer++;
+		if (layer < firstLayer || layer > lastLayer || !page->isLayerVisible(l))
 		{
 			continue;
 		}
 
 		drawLayer(cr, l);
-		layer++;
 	}
 
 	finializeDrawing();
@@ -20,10 +20,13 @@
 #include "model/TexImage.h"
 #include "model/Text.h"
 
+#include <Rectangle.h>
 #include <XournalType.h>
 
 #include <gtk/gtk.h>
 
+#include <vector>
+
 class EditSelection;
 class MainBackgroundPainter;
 
@@ -44,6 +47,18 @@ public:
 	 */
 	void drawPage(PageRef page, cairo_t* cr, bool dontRenderEditingStroke, bool hideBackground = false);
 
+	/**
+	 * Draw a part of the page, e.g. on top of a buffer which contains the layers below
+	 * @param page The page to draw
+	 * @param cr Draw to this context
+	 * @param firstLayer The first layer ID to draw, 0 to draw the background, too
+	 * @param lastLayer The last layer ID to draw
+	 * @param dontRenderEditingStroke false to draw currently drawing stroke
+	 * @param hideBackground true to hide the background
+	 */
+	void drawLayers(PageRef page, cairo_t* cr, int firstLayer, int lastLayer, bool dontRenderEditingStroke,
+					bool hideBackground = false);
+
 
 
 	void drawStroke(cairo_t* cr, Stroke* s, int startPoint = 0, double scaleFactor = 1, bool changeSource = true, bool noAlpha = false);
@@ -61,6 +76,12 @@ public:
 	 */
 	void setMarkAudioStroke(bool markAudioStroke);
 
+	/**
+	 * Draw simplified strokes if the page is drawn at a small scale, enabled by default.
+	 * Strokes are always drawn exact to vector surfaces (PDF, SVG, PS).
+	 */
+	void setLevelOfDetail(bool levelOfDetail);
+
 	// API for special drawing, usually you won't call this methods
 public:
 	/**
@@ -100,8 +121,30 @@ private:
 
 	void drawElement(cairo_t* cr, Element* e);
 
+	/**
+	 * Draws an element of a layer, filled highlighter strokes are collected in a shared group
+	 */
+	void drawLayerElement(cairo_t* cr, Element* e);
+
+	/**
+	 * Draws a filled highlighter stroke into the group of the previous strokes,
+	 * if it has the same color and fill and does not overlap them. The result
+	 * is the same as with one group for each stroke.
+	 */
+	void drawHighlighterStroke(cairo_t* cr, Stroke* s);
+
+	/**
+	 * Paints the group of highlighter strokes, if there is one
+	 */
+	void finishHighlighterGroup(cairo_t* cr);
+
 	void paintBackgroundImage();
 
+	/**
+	 * Calculates the allowed stroke error from the scale of the context
+	 */
+	void initLevelOfDetail();
+
 private:
 	XOJ_TYPE_ATTRIB;
 
@@ -112,6 +155,25 @@ private:
 	bool dontRenderEditingStroke = false;
 	bool markAudioStroke = false;
 
+	bool levelOfDetail = true;
+
+	/**
+	 * The allowed stroke error in document coordinates for the current page, 0 to draw exact
+	 */
+	double lodMaxError = 0;
+
+	/**
+	 * Consecutive filled highlighter strokes share one group, which is painted once
+	 */
+	bool highlighterGroup = false;
+	int highlighterColor = 0;
+	int highlighterFill = -1;
+
+	/**
+	 * The areas of the strokes in the group, including the antialiasing
+	 */
+	std::vector<Rectangle> highlighterAreas;
+
 	double lX = -1;
 	double lY = -1;
 	double lWidth = -1;
@@ -0,0 +1,105 @@
+#include "LayerCache.h"
+
+#include "model/PageSnapshot.h"
+
+LayerCache::LayerCache()
+{
+	XOJ_INIT_TYPE(LayerCache);
+
+	g_mutex_init(&this->mutex);
+}
+
+LayerCache::~LayerCache()
+{
+	XOJ_CHECK_TYPE(LayerCache);
+
+	clear();
+	g_mutex_clear(&this->mutex);
+
+	XOJ_RELEASE_TYPE(LayerCache);
+}
+
+cairo_surface_t* LayerCache::get(PageSnapshot& snapshot, int layerId, double zoom)
+{
+	XOJ_CHECK_TYPE(LayerCache);
+
+	g_mutex_lock(&this->mutex);
+
+	cairo_surface_t* result = NULL;
+	if (this->buffer != NULL && this->layerId == layerId && this->zoom == zoom)
+	{
+		result = this->buffer;
+		for (int i = 0; i < layerId; i++)
+		{
+			if (snapshot.getLayerRevision(i) != this->revisions[i])
+			{
+				result = NULL;
+				break;
+			}
+		}
+	}
+
+	if (result != NULL)
+	{
+		cairo_surface_reference(result);
+	}
+
+	g_mutex_unlock(&this->mutex);
+
+	return result;
+}
+
+void LayerCache::set(cairo_surface_t* buffer, PageSnapshot& snapshot, int layerId, double zoom)
+{
+	XOJ_CHECK_TYPE(LayerCache);
+
+	g_mutex_lock(&this->mutex);
+
+	if (this->buffer != NULL)
+	{
+		cairo_surface_destroy(this->buffer);
+	}
+	this->buffer = cairo_surface_reference(buffer);
+	this->layerId = layerId;
+	this->zoom = zoom;
+
+	this->revisions.clear();
+	for (int i = 0; i < layerId; i++)
+	{
+		this->revisions.push_back(snapshot.getLayerRevision(i));
+	}
+
+	g_mutex_unlock(&this->mutex);
+}
+
+void LayerCache::clear()
+{
+	XOJ_CHECK_TYPE(LayerCache);
+
+	g_mutex_lock(&this->mutex);
+
+	if (this->buffer != NULL)
+	{
+		cairo_surface_destroy(this->buffer);
+		this->buffer = NULL;
+	}
+	this->revisions.clear();
+
+	g_mutex_unlock(&this->mutex);
+}
+
+size_t LayerCache::getBytes()
+{
+	XOJ_CHECK_TYPE(LayerCache);
+
+	size_t bytes = 0;
+
+	g_mutex_lock(&this->mutex);
+	if (this->buffer != NULL)
+	{
+		bytes = (size_t) cairo_image_surface_get_stride(this->buffer) * cairo_image_surface_get_height(this->buffer);
+	}
+	g_mutex_unlock(&this->mutex);
+
+	return bytes;
+}
@@ -0,0 +1,83 @@
+/*
+ * Xournal++
+ *
+ * Buffer with the lower layers of a page
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#pragma once
+
+#include <XournalType.h>
+
+#include <cairo.h>
+#include <glib.h>
+
+#include <vector>
+
+class PageSnapshot;
+
+/**
+ * The background and the layers below the selected layer, drawn once at the
+ * current zoom. While writing on the selected layer, only the selected layer
+ * and the layers above are drawn on top of this buffer.
+ *
+ * The buffer is valid as long as the revisions of the cached layers in the
+ * PageSnapshot are the same.
+ */
+class LayerCache
+{
+public:
+	LayerCache();
+	virtual ~LayerCache();
+
+private:
+	LayerCache(const LayerCache& cache);
+	void operator=(const LayerCache& cache);
+
+public:
+	/**
+	 * @param layerId The layers below this layer ID are needed
+	 * @param zoom The zoom of the buffer
+	 * @return A new reference of the buffer, NULL if there is none matching the snapshot
+	 */
+	cairo_surface_t* get(PageSnapshot& snapshot, int layerId, double zoom);
+
+	/**
+	 * Replaces the buffer, a reference is taken
+	 *
+	 * @param buffer The background and the layers below layerId of the snapshot
+	 */
+	void set(cairo_surface_t* buffer, PageSnapshot& snapshot, int layerId, double zoom);
+
+	/**
+	 * Frees the buffer
+	 */
+	void clear();
+
+	/**
+	 * @return The bytes held by the buffer
+	 */
+	size_t getBytes();
+
+private:
+	XOJ_TYPE_ATTRIB;
+
+	/**
+	 * The buffer can be freed by the UI thread while it is used by the render thread
+	 */
+	GMutex mutex;
+
+	cairo_surface_t* buffer = NULL;
+
+	int layerId = 0;
+	double zoom = 0;
+
+	/**
+	 * The revisions of the background and the layers in the buffer
+	 */
+	std::vector<int> revisions;
+};
@@ -7,6 +7,8 @@
 StrokeView::StrokeView(cairo_t* cr, Stroke* s, int startPoint, double scaleFactor, bool noAlpha)
  : cr(cr),
    s(s),
+   drawPoints(s->getPoints()),
+   drawPointCount(s->getPointCount()),
    startPoint(startPoint),
    scaleFactor(scaleFactor),
    noAlpha(noAlpha)
@@ -17,9 +19,45 @@ StrokeView::~StrokeView()
 {
 }
 
+void StrokeView::useLevelOfDetail(double maxError)
+{
+	// Partially drawn strokes count the points of the stroke
+	if (this->startPoint != 0)
+	{
+		return;
+	}
+
+	this->drawPoints = s->getDrawPoints(maxError, this->drawPointCount);
+}
+
+void StrokeView::useSharedGroup()
+{
+	this->sharedGroup = true;
+}
+
+bool StrokeView::needsGroup(Stroke* s)
+{
+	return s->getFill() != -1 && s->getToolType() == STROKE_TOOL_HIGHLIGHTER;
+}
+
+void StrokeView::paintGroup(cairo_t* cr, int fill, bool noAlpha)
+{
+	cairo_pop_group_to_source(cr);
+
+	if (noAlpha)
+	{
+		// Currently drawing -> transparent applied on blitting
+		cairo_paint(cr);
+	}
+	else
+	{
+		cairo_paint_with_alpha(cr, fill / 255.0);
+	}
+}
+
 void StrokeView::drawFillStroke()
 {
-	ArrayIterator<Point> points = s->pointIterator();
+	ArrayIterator<Point> points(this->drawPoints, this->drawPointCount);
 
 	if (points.hasNext())
 	{
@@ -109,17 +147,19 @@ void StrokeView::drawNoPressure()
 {
 	int count = 1;
 	double width = s->getWidth();
-	ArrayIterator<Point> points = s->pointIterator();
+	ArrayIterator<Point> points(this->drawPoints, this->drawPointCount);
 
-	bool group = false;
-	if (s->getFill() != -1 && s->getToolType() == STROKE_TOOL_HIGHLIGHTER)
+	bool group = needsGroup(s);
+	if (group)
 	{
-		cairo_push_group(cr);
+		if (!this->sharedGroup)
+		{
+			cairo_push_group(cr);
+		}
 		// Do not apply the alpha here, else the border and the fill
 		// are visible instead of one homogeneous area
 		DocumentView::applyColor(cr, s, 255);
 		drawFillStroke();
-		group = true;
 	}
 
 	// Set width
@@ -147,19 +187,9 @@ void StrokeView::drawNoPressure()
 
 	cairo_stroke(cr);
 
-	if (group)
+	if (group && !this->sharedGroup)
 	{
-		cairo_pop_group_to_source(cr);
-
-		if (noAlpha)
-		{
-			// Currently drawing -> transparent applied on blitting
-			cairo_paint(cr);
-		}
-		else
-		{
-			cairo_paint_with_alpha(cr, s->getFill() / 255.0);
-		}
+		paintGroup(cr, s->getFill(), noAlpha);
 	}
 }
 
@@ -171,7 +201,7 @@ void StrokeView::drawWithPressuire()
 {
 	int count = 1;
 	double width = s->getWidth();
-	ArrayIterator<Point> points = s->pointIterator();
+	ArrayIterator<Point> points(this->drawPoints, this->drawPointCount);
 
 	Point lastPoint1 = points.next();
 	double dashOffset = 0;
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "model/Point.h"
+
 #include <gtk/gtk.h>
 
 class Stroke;
@@ -24,12 +26,35 @@ public:
 public:
 	void paint(bool dontRenderEditingStroke);
 
+	/**
+	 * Draw a simplified version of the stroke, if the allowed error is large enough
+	 *
+	 * @param maxError The allowed error in document coordinates
+	 */
+	void useLevelOfDetail(double maxError);
+
 	/**
 	 * Change cairo source, used to draw hilighter transparent,
 	 * but only if not currently drawing and so on (yes, complicated)
 	 */
 	void changeCairoSource(bool markAudioStroke);
 
+	/**
+	 * The group of a filled highlighter stroke is opened and painted by the
+	 * caller, so several strokes can share one group
+	 */
+	void useSharedGroup();
+
+	/**
+	 * @return true if the stroke is drawn into a group, which is painted with the transparency of the fill
+	 */
+	static bool needsGroup(Stroke* s);
+
+	/**
+	 * Paints the group of filled highlighter strokes with the transparency of the fill
+	 */
+	static void paintGroup(cairo_t* cr, int fill, bool noAlpha);
+
 private:
 	void drawFillStroke();
 	void applyDashed(double offset);
@@ -51,7 +76,15 @@ private:
 	cairo_t* cr;
 	Stroke* s;
 
+	/**
+	 * The points to draw, the points of the stroke or a simplified version
+	 */
+	const Point* drawPoints;
+	int drawPointCount;
+
 	int startPoint;
 	double scaleFactor;
 	bool noAlpha;
+
+	bool sharedGroup = false;
 };
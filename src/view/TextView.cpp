@@ -7,15 +7,119 @@
 #include <Util.h>
 #include <StringUtils.h>
 
+#include <unordered_map>
+
 TextView::TextView() { }
 
 TextView::~TextView() { }
 
 static int textDpi = 72;
 
+/**
+ * Protects the measurement context, the font descriptions and the layouts of all Text elements
+ */
+static GMutex layoutMutex;
+
+static PangoContext* measureContext = NULL;
+
+/**
+ * Font descriptions by font name, the size is set before a description is used
+ */
+static std::unordered_map<string, PangoFontDescription*> fontDescriptions;
+
 void TextView::setDpi(int dpi)
 {
+	g_mutex_lock(&layoutMutex);
+
 	textDpi = dpi;
+
+	// The layouts may be drawn right now, so the context is not changed. The
+	// layouts still use the old context and are created again on next use.
+	if (measureContext)
+	{
+		g_object_unref(measureContext);
+		measureContext = NULL;
+	}
+
+	g_mutex_unlock(&layoutMutex);
+}
+
+/**
+ * The glyph positions do not depend on the target. The cached layouts are not
+ * updated for each cairo context they are drawn on, and the text editor has to
+ * place its cursor on the same positions.
+ */
+static void setTargetIndependent(PangoContext* context)
+{
+	cairo_font_options_t* options = cairo_font_options_create();
+	cairo_font_options_set_hint_metrics(options, CAIRO_HINT_METRICS_OFF);
+	pango_cairo_context_set_font_options(context, options);
+	cairo_font_options_destroy(options);
+}
+
+/**
+ * The mutex has to be locked
+ */
+PangoContext* TextView::getMeasureContext()
+{
+	if (measureContext == NULL)
+	{
+		measureContext = pango_font_map_create_context(pango_cairo_font_map_get_default());
+		pango_cairo_context_set_resolution(measureContext, textDpi);
+		pango_context_set_matrix(measureContext, NULL);
+		setTargetIndependent(measureContext);
+	}
+
+	return measureContext;
+}
+
+/**
+ * The mutex has to be locked
+ */
+PangoFontDescription* TextView::getFontDescription(XojFont& font)
+{
+	string name = font.getName();
+
+	PangoFontDescription*& desc = fontDescriptions[name];
+	if (desc == NULL)
+	{
+		desc = pango_font_description_from_string(name.c_str());
+	}
+
+	pango_font_description_set_size(desc, font.getSize() * PANGO_SCALE);
+	return desc;
+}
+
+/**
+ * The layout of the Text, created on first use. The mutex has to be locked.
+ *
+ * A layout is never changed once it is created, so it can be drawn without the mutex.
+ */
+PangoLayout* TextView::getLayout(Text* t)
+{
+	XojFont& font = t->getFont();
+
+	// The font may be changed directly, e.g. by scaling the Text
+	if (t->layout && pango_layout_get_context(t->layout) == getMeasureContext() &&
+		t->layoutFontName == font.getName() && t->layoutFontSize == font.getSize())
+	{
+		return t->layout;
+	}
+
+	if (t->layout)
+	{
+		g_object_unref(t->layout);
+	}
+
+	t->layout = pango_layout_new(getMeasureContext());
+	pango_layout_set_font_description(t->layout, getFontDescription(font));
+	t->layoutFontName = font.getName();
+	t->layoutFontSize = font.getSize();
+
+	string str = t->getText();
+	pango_layout_set_text(t->layout, str.c_str(), str.length());
+
+	return t->layout;
 }
 
 PangoLayout* TextView::initPango(cairo_t* cr, Text* t)
@@ -27,21 +131,51 @@ PangoLayout* TextView::initPango(cairo_t* cr, Text* t)
 	// pango_layout_set_wrap
 
 	pango_cairo_context_set_resolution(pango_layout_get_context(layout), textDpi);
+	setTargetIndependent(pango_layout_get_context(layout));
 	pango_cairo_update_layout(cr, layout);
 
-	pango_context_set_matrix(pango_layout_get_context(layout), NULL);
 	updatePangoFont(layout, t);
+
 	return layout;
 }
 
 void TextView::updatePangoFont(PangoLayout* layout, Text* t)
 {
-	PangoFontDescription* desc = pango_font_description_from_string(t->getFont().getName().c_str());
-	//pango_font_description_set_absolute_size(desc, t->getFont().getSize() * PANGO_SCALE);
-	pango_font_description_set_size(desc, t->getFont().getSize() * PANGO_SCALE);
+	g_mutex_lock(&layoutMutex);
+	pango_layout_set_font_description(layout, getFontDescription(t->getFont()));
+	g_mutex_unlock(&layoutMutex);
+}
+
+void TextView::invalidateLayout(Text* t)
+{
+	g_mutex_lock(&layoutMutex);
+
+	if (t->layout)
+	{
+		g_object_unref(t->layout);
+		t->layout = NULL;
+	}
+
+	g_mutex_unlock(&layoutMutex);
+}
+
+void TextView::freeCache()
+{
+	g_mutex_lock(&layoutMutex);
+
+	for (auto& it : fontDescriptions)
+	{
+		pango_font_description_free(it.second);
+	}
+	fontDescriptions.clear();
 
-	pango_layout_set_font_description(layout, desc);
-	pango_font_description_free(desc);
+	if (measureContext)
+	{
+		g_object_unref(measureContext);
+		measureContext = NULL;
+	}
+
+	g_mutex_unlock(&layoutMutex);
 }
 
 void TextView::drawText(cairo_t* cr, Text* t)
@@ -50,12 +184,15 @@ void TextView::drawText(cairo_t* cr, Text* t)
 
 	cairo_translate(cr, t->getX(), t->getY());
 
-	PangoLayout* layout = initPango(cr, t);
-	string str = t->getText();
-	pango_layout_set_text(layout, str.c_str(), str.length());
+	// The layout is not updated for cr, it is shared by all targets and laid out
+	// without hinted metrics. Only laid out with the mutex, drawing the lines
+	// does not change the layout.
+	g_mutex_lock(&layoutMutex);
+	PangoLayout* layout = (PangoLayout*) g_object_ref(getLayout(t));
+	pango_layout_get_size(layout, NULL, NULL);
+	g_mutex_unlock(&layoutMutex);
 
 	pango_cairo_show_layout(cr, layout);
-
 	g_object_unref(layout);
 
 	cairo_restore(cr);
@@ -63,24 +200,19 @@ void TextView::drawText(cairo_t* cr, Text* t)
 
 vector<XojPdfRectangle> TextView::findText(Text* t, string& search)
 {
-	cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-	cairo_t* cr = cairo_create(surface);
-
-	PangoLayout* layout = initPango(cr, t);
-	string str = t->getText();
-	pango_layout_set_text(layout, str.c_str(), str.length());
-
-
-	string text = t->getText();
+	string text = StringUtils::toLowerCase(t->getText());
 
 	string srch = StringUtils::toLowerCase(search);
 
 	vector<XojPdfRectangle> list;
 
+	g_mutex_lock(&layoutMutex);
+	PangoLayout* layout = getLayout(t);
+
 	int pos = -1;
 	do
 	{
-		pos = StringUtils::toLowerCase(text).find(srch, pos + 1);
+		pos = text.find(srch, pos + 1);
 		if (pos != -1)
 		{
 			XojPdfRectangle mark;
@@ -98,28 +230,20 @@ vector<XojPdfRectangle> TextView::findText(Text* t, string& search)
 	}
 	while (pos != -1);
 
-	g_object_unref(layout);
-	cairo_surface_destroy(surface);
-	cairo_destroy(cr);
+	g_mutex_unlock(&layoutMutex);
 
 	return list;
 }
 
 void TextView::calcSize(Text* t, double& width, double& height)
 {
-	cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
-	cairo_t* cr = cairo_create(surface);
-
-	PangoLayout* layout = initPango(cr, t);
-	string str = t->getText();
-	pango_layout_set_text(layout, str.c_str(), str.length());
 	int w = 0;
 	int h = 0;
-	pango_layout_get_size(layout, &w, &h);
+
+	g_mutex_lock(&layoutMutex);
+	pango_layout_get_size(getLayout(t), &w, &h);
+	g_mutex_unlock(&layoutMutex);
+
 	width = ((double) w) / PANGO_SCALE;
 	height = ((double) h) / PANGO_SCALE;
-	g_object_unref(layout);
-
-	cairo_surface_destroy(surface);
-	cairo_destroy(cr);
 }
@@ -16,7 +16,18 @@
 #include <gtk/gtk.h>
 
 class Text;
+class XojFont;
 
+/**
+ * Each Text keeps its Pango layout until the text is changed, the layouts are
+ * created on one shared measurement context and share the font descriptions.
+ * The layouts are used by the render threads, they are created and laid out
+ * with a mutex and drawn without it.
+ *
+ * The layouts are not updated for the cairo context they are drawn on, so the
+ * measurement context uses no hinted metrics. The text editor does not use the
+ * cached layout, it changes the text and attributes on each key press.
+ */
 class TextView
 {
 private:
@@ -42,7 +53,9 @@ public:
 	static vector<XojPdfRectangle> findText(Text* t, string& text);
 
 	/**
-	 * Initialize a Pango layout
+	 * Creates a new Pango layout for cr with the font of the Text, without text. The layout has
+	 * its own context, it is not shared with the cached layouts, but is laid out the same way.
+	 * The caller owns the layout.
 	 */
 	static PangoLayout* initPango(cairo_t* cr, Text* t);
 
@@ -50,4 +63,19 @@ public:
 	 * Sets the font name from Text model
 	 */
 	static void updatePangoFont(PangoLayout* layout, Text* t);
+
+	/**
+	 * The text was changed or is deleted, the cached layout is released
+	 */
+	static void invalidateLayout(Text* t);
+
+	/**
+	 * Frees the measurement context and the font descriptions, called on exit
+	 */
+	static void freeCache();
+
+private:
+	static PangoContext* getMeasureContext();
+	static PangoFontDescription* getFontDescription(XojFont& font);
+	static PangoLayout* getLayout(Text* t);
 };
@@ -0,0 +1,182 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "control/xojfile/BinaryStrokeFormat.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <glib.h>
+#include <zlib.h>
+
+#include <cmath>
+#include <random>
+
+class BinaryStrokeFormatTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(BinaryStrokeFormatTest);
+
+	CPPUNIT_TEST(testRoundtrip);
+	CPPUNIT_TEST(testPressure);
+	CPPUNIT_TEST(testInvalid);
+	CPPUNIT_TEST(testSize);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	/**
+	 * A stroke like handwriting, with the precision of the input devices
+	 */
+	vector<Point> createStroke(int count, double offset)
+	{
+		vector<Point> points;
+		std::minstd_rand random(count + (int) (offset * 100));
+		std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+		for (int i = 0; i < count; i++)
+		{
+			double t = i * 0.05;
+			points.push_back(Point(offset + t * 12.3 + 3.1 * std::sin(t * 7.7) + jitter(random),
+								   offset * 0.5 + 17.9 * std::cos(t * 3.1) / 3.0 + jitter(random),
+								   1.41 * (0.4 + 0.5 * std::fabs(std::sin(t + jitter(random))))));
+		}
+		return points;
+	}
+
+	/**
+	 * The points as written by XmlPointNode without binary encoding
+	 */
+	string toText(const vector<Point>& points)
+	{
+		string text;
+		for (const Point& p : points)
+		{
+			char tmp[G_ASCII_DTOSTR_BUF_SIZE];
+			g_ascii_dtostr(tmp, G_ASCII_DTOSTR_BUF_SIZE, p.x);
+			text += tmp;
+			text += " ";
+			g_ascii_dtostr(tmp, G_ASCII_DTOSTR_BUF_SIZE, p.y);
+			text += tmp;
+			text += " ";
+		}
+		return text;
+	}
+
+	string toBase64(const string& data)
+	{
+		gchar* base64 = g_base64_encode((const guchar*) data.c_str(), data.length());
+		string result = base64;
+		g_free(base64);
+		return result;
+	}
+
+	size_t compressedSize(const string& data)
+	{
+		uLongf length = compressBound(data.length());
+		string buffer(length, '\0');
+		compress2((Bytef*) &buffer[0], &length, (const Bytef*) data.c_str(), data.length(), 6);
+		return length;
+	}
+
+	void testRoundtrip()
+	{
+		vector<Point> points = createStroke(500, 100);
+		points.push_back(Point(-12.25, 0.0005));
+		points.push_back(Point(841.889, 1190.551));
+
+		string data = BinaryStrokeFormat::encode(points, false);
+
+		vector<Point> decoded;
+		vector<double> pressure;
+		CPPUNIT_ASSERT(BinaryStrokeFormat::decode(data, decoded, pressure));
+		CPPUNIT_ASSERT(pressure.empty());
+		CPPUNIT_ASSERT_EQUAL(points.size(), decoded.size());
+
+		double maxError = 0.5 / BinaryStrokeFormat::BINARY_STROKE_UNITS + 1e-9;
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(points[i].x, decoded[i].x, maxError);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(points[i].y, decoded[i].y, maxError);
+		}
+
+		// A second save does not change the values any more
+		CPPUNIT_ASSERT(data == BinaryStrokeFormat::encode(decoded, false));
+
+		CPPUNIT_ASSERT(BinaryStrokeFormat::decode(BinaryStrokeFormat::encode(vector<Point>(), false), decoded, pressure));
+		CPPUNIT_ASSERT(decoded.empty());
+	}
+
+	void testPressure()
+	{
+		vector<Point> points = createStroke(100, 20);
+
+		vector<Point> decoded;
+		vector<double> pressure;
+		CPPUNIT_ASSERT(BinaryStrokeFormat::decode(BinaryStrokeFormat::encode(points, true), decoded, pressure));
+
+		// The last point has no segment
+		CPPUNIT_ASSERT_EQUAL(points.size() - 1, pressure.size());
+		for (size_t i = 0; i < pressure.size(); i++)
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(points[i].z, pressure[i], 0.5 / BinaryStrokeFormat::BINARY_STROKE_UNITS + 1e-9);
+		}
+	}
+
+	void testInvalid()
+	{
+		vector<Point> points;
+		vector<double> pressure;
+
+		string data = BinaryStrokeFormat::encode(createStroke(50, 0), true);
+
+		CPPUNIT_ASSERT(!BinaryStrokeFormat::decode("", points, pressure));
+
+		// Truncated
+		for (size_t length = 0; length < data.length(); length++)
+		{
+			CPPUNIT_ASSERT(!BinaryStrokeFormat::decode(data.substr(0, length), points, pressure));
+			CPPUNIT_ASSERT(points.empty());
+		}
+
+		// Trailing data
+		CPPUNIT_ASSERT(!BinaryStrokeFormat::decode(data + '\0', points, pressure));
+
+		// Unknown version
+		string other = data;
+		other[0] = BinaryStrokeFormat::BINARY_STROKE_VERSION + 1;
+		CPPUNIT_ASSERT(!BinaryStrokeFormat::decode(other, points, pressure));
+
+		// A point count which does not fit into the data
+		string count("\x01\x00\xff\xff\xff\xff\x0f", 7);
+		CPPUNIT_ASSERT(!BinaryStrokeFormat::decode(count, points, pressure));
+	}
+
+	void testSize()
+	{
+		vector<Point> points = createStroke(1000, 300);
+
+		string text = toText(points);
+		string binary = toBase64(BinaryStrokeFormat::encode(points, false));
+
+		CPPUNIT_ASSERT(binary.length() * 3 < text.length());
+		CPPUNIT_ASSERT(compressedSize(binary) < compressedSize(text));
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(BinaryStrokeFormatTest);
@@ -41,6 +41,7 @@ class LoadHandlerTest : public CppUnit::TestFixture
 	CPPUNIT_TEST(testText);
 	CPPUNIT_TEST(testTextZipped);
 	CPPUNIT_TEST(testStroke);
+	CPPUNIT_TEST(testBinaryStroke);
 	CPPUNIT_TEST(loadImage);
 
 	CPPUNIT_TEST_SUITE_END();
@@ -298,6 +299,45 @@ public:
 
 	}
 
+	/**
+	 * The second layer contains the strokes of the first one with binary encoding
+	 */
+	void testBinaryStroke()
+	{
+		LoadHandler handler;
+		Document* doc = handler.loadDocument(GET_TESTFILE("load/binaryStroke.xml"));
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, doc->getPageCount());
+		PageRef page = doc->getPage(0);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, (*page).getLayerCount());
+		Layer* text = (*(*page).getLayers())[0];
+		Layer* binary = (*(*page).getLayers())[1];
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, binary->getElements()->size());
+
+		for (int i = 0; i < 2; i++)
+		{
+			Stroke* expected = (Stroke*) (*text->getElements())[i];
+			Stroke* s = (Stroke*) (*binary->getElements())[i];
+			CPPUNIT_ASSERT_EQUAL(ELEMENT_STROKE, s->getType());
+
+			CPPUNIT_ASSERT_EQUAL(expected->getColor(), s->getColor());
+			CPPUNIT_ASSERT_EQUAL(expected->getWidth(), s->getWidth());
+			CPPUNIT_ASSERT_EQUAL(expected->hasPressure(), s->hasPressure());
+			CPPUNIT_ASSERT_EQUAL(expected->getPointCount(), s->getPointCount());
+
+			for (int p = 0; p < s->getPointCount(); p++)
+			{
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getPoint(p).x, s->getPoint(p).x, 0.001);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getPoint(p).y, s->getPoint(p).y, 0.001);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getPoint(p).z, s->getPoint(p).z, 0.001);
+			}
+		}
+
+		CPPUNIT_ASSERT(((Stroke*) (*binary->getElements())[1])->hasPressure());
+	}
+
 	void loadImage()
 	{
 
@@ -0,0 +1,125 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "control/RenderMemoryManager.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * A buffer of a fixed size
+ */
+class FakeRenderMemoryClient : public RenderMemoryClient
+{
+public:
+	FakeRenderMemoryClient(size_t bytes, bool inUse, gint64 lastUse, double cost = 1)
+	 : bytes(bytes),
+	   inUse(inUse),
+	   lastUse(lastUse),
+	   cost(cost)
+	{
+		RenderMemoryManager::getInstance().addClient(this);
+	}
+
+	virtual ~FakeRenderMemoryClient()
+	{
+		RenderMemoryManager::getInstance().removeClient(this);
+	}
+
+	size_t getRenderMemoryBytes()
+	{
+		return this->bytes;
+	}
+
+	bool isRenderMemoryInUse()
+	{
+		return this->inUse;
+	}
+
+	gint64 getRenderMemoryLastUse()
+	{
+		return this->lastUse;
+	}
+
+	double getRenderMemoryCost()
+	{
+		return this->cost;
+	}
+
+	size_t freeRenderMemory()
+	{
+		size_t freed = this->bytes;
+		this->bytes = 0;
+		return freed;
+	}
+
+	size_t bytes;
+	bool inUse;
+	gint64 lastUse;
+	double cost;
+};
+
+class RenderMemoryManagerTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(RenderMemoryManagerTest);
+
+	CPPUNIT_TEST(testEvictionOrder);
+	CPPUNIT_TEST(testInUse);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+		RenderMemoryManager::freeInstance();
+	}
+
+	void testEvictionOrder()
+	{
+		gint64 now = g_get_monotonic_time();
+		gint64 old = now - 10 * G_USEC_PER_SEC;
+
+		FakeRenderMemoryClient recent(1000, false, now);
+		FakeRenderMemoryClient oldPage(1000, false, old);
+		FakeRenderMemoryClient oldExpensive(1000, false, old, 100);
+
+		RenderMemoryManager& manager = RenderMemoryManager::getInstance();
+		CPPUNIT_ASSERT_EQUAL((size_t) 3000, manager.getUsage());
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 1000, manager.freeUntil(2500));
+		CPPUNIT_ASSERT_EQUAL((size_t) 0, oldPage.bytes);
+		CPPUNIT_ASSERT_EQUAL((size_t) 1000, recent.bytes);
+		CPPUNIT_ASSERT_EQUAL((size_t) 1000, oldExpensive.bytes);
+
+		// Nothing to do within the budget
+		CPPUNIT_ASSERT_EQUAL((size_t) 0, manager.freeUntil(2000));
+	}
+
+	void testInUse()
+	{
+		FakeRenderMemoryClient visible(5000, true, 0);
+		FakeRenderMemoryClient hidden(1000, false, 0);
+
+		RenderMemoryManager& manager = RenderMemoryManager::getInstance();
+		manager.freeUntil(0);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 5000, visible.bytes);
+		CPPUNIT_ASSERT_EQUAL((size_t) 0, hidden.bytes);
+		CPPUNIT_ASSERT_EQUAL((size_t) 5000, manager.getUsage());
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(RenderMemoryManagerTest);
@@ -0,0 +1,191 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "control/shaperecognizer/IncrementalShapeRecognizer.h"
+#include "control/shaperecognizer/ShapeRecognizer.h"
+#include "control/shaperecognizer/ShapeRecognizerResult.h"
+#include "model/Stroke.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * Runs the shape recognizers over the labelled corpus in test/files/shaperecognizer
+ */
+class ShapeRecognizerTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(ShapeRecognizerTest);
+
+	CPPUNIT_TEST(testCorpus);
+	CPPUNIT_TEST(testFullRecognizer);
+	CPPUNIT_TEST(testIncrementalRecognizer);
+
+	CPPUNIT_TEST_SUITE_END();
+
+private:
+	struct LabelledStroke
+	{
+		string label;
+		Stroke* stroke;
+	};
+
+	vector<LabelledStroke> corpus;
+
+public:
+	void setUp()
+	{
+		std::ifstream in(GET_TESTFILE("shaperecognizer/strokes.txt"));
+		string line;
+		while (std::getline(in, line))
+		{
+			if (line.empty() || line[0] == '#')
+			{
+				continue;
+			}
+
+			std::istringstream ss(line);
+			LabelledStroke ls;
+			ss >> ls.label;
+			ls.stroke = new Stroke();
+			ls.stroke->setWidth(1);
+
+			string point;
+			while (ss >> point)
+			{
+				double x = 0;
+				double y = 0;
+				if (sscanf(point.c_str(), "%lf,%lf", &x, &y) == 2)
+				{
+					ls.stroke->addPoint(Point(x, y));
+				}
+			}
+
+			corpus.push_back(ls);
+		}
+	}
+
+	void tearDown()
+	{
+		for (LabelledStroke& ls : corpus)
+		{
+			delete ls.stroke;
+		}
+		corpus.clear();
+	}
+
+	/**
+	 * The recognized shapes are identified by their number of points
+	 */
+	static string classify(Stroke* s)
+	{
+		if (s == NULL)
+		{
+			return "none";
+		}
+
+		switch (s->getPointCount())
+		{
+		case 2:
+			return "line";
+		case 5:
+			return "rectangle";
+		default:
+			return "circle";
+		}
+	}
+
+	void printResult(string name, int correct, gint64 time, int points)
+	{
+#ifdef TEST_CHECK_SPEED
+		std::cout << std::endl << "== " << name << " ==" << std::endl;
+		std::cout << "Accuracy: " << correct << " / " << corpus.size() << std::endl;
+		std::cout << "Time per stroke: " << (double) time / corpus.size() << " us" << std::endl;
+		std::cout << "Time per point: " << (double) time / points << " us" << std::endl;
+#endif
+	}
+
+	void testCorpus()
+	{
+		CPPUNIT_ASSERT_EQUAL((size_t) 60, corpus.size());
+	}
+
+	void testFullRecognizer()
+	{
+		int correct = 0;
+		int points = 0;
+		gint64 time = 0;
+
+		for (LabelledStroke& ls : corpus)
+		{
+			ShapeRecognizer reco;
+
+			gint64 start = g_get_monotonic_time();
+			ShapeRecognizerResult* result = reco.recognizePatterns(ls.stroke);
+			time += g_get_monotonic_time() - start;
+			points += ls.stroke->getPointCount();
+
+			Stroke* recognized = result ? result->getRecognized() : NULL;
+			if (classify(recognized) == ls.label)
+			{
+				correct++;
+			}
+
+			delete recognized;
+			delete result;
+		}
+
+		printResult("ShapeRecognizer (on pen up)", correct, time, points);
+		CPPUNIT_ASSERT(correct >= 54);
+	}
+
+	void testIncrementalRecognizer()
+	{
+		int correct = 0;
+		int points = 0;
+		gint64 time = 0;
+
+		IncrementalShapeRecognizer reco;
+
+		for (LabelledStroke& ls : corpus)
+		{
+			Stroke* recognized = NULL;
+			reco.reset();
+
+			// Like while drawing: the preview is updated for each point
+			gint64 start = g_get_monotonic_time();
+			for (int i = 0; i < ls.stroke->getPointCount(); i++)
+			{
+				reco.addPoint(ls.stroke->getPoint(i));
+				delete recognized;
+				recognized = reco.recognize(ls.stroke);
+			}
+			time += g_get_monotonic_time() - start;
+			points += ls.stroke->getPointCount();
+
+			if (classify(recognized) == ls.label)
+			{
+				correct++;
+			}
+
+			delete recognized;
+		}
+
+		printResult("IncrementalShapeRecognizer (live preview)", correct, time, points);
+		CPPUNIT_ASSERT(correct >= 54);
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(ShapeRecognizerTest);
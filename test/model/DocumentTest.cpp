@@ -0,0 +1,242 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/Document.h"
+#include "model/DocumentHandler.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <iostream>
+
+/**
+ * Checks the page lookups of the document against a scan over all pages
+ */
+class DocumentTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(DocumentTest);
+
+	CPPUNIT_TEST(testIndexOf);
+	CPPUNIT_TEST(testFindPdfPage);
+	CPPUNIT_TEST(testBackgroundGeneration);
+	CPPUNIT_TEST(testManyPages);
+	CPPUNIT_TEST(testAudioTimeline);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	static void checkIndex(Document& doc)
+	{
+		for (size_t i = 0; i < doc.getPageCount(); i++)
+		{
+			CPPUNIT_ASSERT_EQUAL(i, doc.indexOf(doc.getPage(i)));
+		}
+	}
+
+	static PageRef createPdfPage(size_t pdfPage)
+	{
+		PageRef p = new XojPage(100, 100);
+		p->setBackgroundPdfPageNr(pdfPage);
+		return p;
+	}
+
+	void testIndexOf()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+
+		for (int i = 0; i < 20; i++)
+		{
+			doc.addPage(new XojPage(100, 100));
+		}
+		checkIndex(doc);
+
+		PageRef inserted = new XojPage(100, 100);
+		doc.insertPage(inserted, 5);
+		CPPUNIT_ASSERT_EQUAL((size_t) 5, doc.indexOf(inserted));
+		checkIndex(doc);
+
+		PageRef deleted = doc.getPage(3);
+		doc.deletePage(3);
+		CPPUNIT_ASSERT_EQUAL(size_t_npos, doc.indexOf(deleted));
+		CPPUNIT_ASSERT_EQUAL((size_t) 4, doc.indexOf(inserted));
+		checkIndex(doc);
+
+		PageRef unknown = new XojPage(100, 100);
+		CPPUNIT_ASSERT_EQUAL(size_t_npos, doc.indexOf(unknown));
+	}
+
+	void testFindPdfPage()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+
+		doc.addPage(new XojPage(100, 100));
+		for (size_t i = 0; i < 10; i++)
+		{
+			doc.addPage(createPdfPage(i));
+		}
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, doc.findPdfPage(0));
+		CPPUNIT_ASSERT_EQUAL((size_t) 10, doc.findPdfPage(9));
+		CPPUNIT_ASSERT_EQUAL(size_t_npos, doc.findPdfPage(10));
+
+		// The first page with a PDF page is returned
+		doc.insertPage(createPdfPage(5), 0);
+		CPPUNIT_ASSERT_EQUAL((size_t) 0, doc.findPdfPage(5));
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, doc.findPdfPage(0));
+
+		// Background changes are seen without a document change
+		doc.getPage(0)->setBackgroundType(PageType(PageTypeFormat::Plain));
+		CPPUNIT_ASSERT_EQUAL((size_t) 7, doc.findPdfPage(5));
+
+		doc.deletePage(1);
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, doc.findPdfPage(0));
+		CPPUNIT_ASSERT_EQUAL((size_t) 6, doc.findPdfPage(5));
+	}
+
+	void testBackgroundGeneration()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+		PageRef removed = createPdfPage(0);
+
+		{
+			Document other(&handler);
+			other.addPage(createPdfPage(3));
+			other.addPage(removed);
+			CPPUNIT_ASSERT_EQUAL((size_t) 1, other.findPdfPage(0));
+
+			// Each document only sees the changes of its own pages
+			doc.addPage(createPdfPage(0));
+			doc.getPage(0)->setBackgroundPdfPageNr(2);
+			CPPUNIT_ASSERT_EQUAL((size_t) 0, other.findPdfPage(3));
+			CPPUNIT_ASSERT_EQUAL((size_t) 0, doc.findPdfPage(2));
+
+			other.getPage(0)->setBackgroundPdfPageNr(0);
+			CPPUNIT_ASSERT_EQUAL((size_t) 0, other.findPdfPage(0));
+			CPPUNIT_ASSERT_EQUAL(size_t_npos, other.findPdfPage(3));
+
+			other.deletePage(1);
+			CPPUNIT_ASSERT(removed->getBackgroundGeneration() == NULL);
+			other.addPage(removed);
+		}
+
+		// The page outlives its document
+		CPPUNIT_ASSERT(removed->getBackgroundGeneration() == NULL);
+		removed->setBackgroundType(PageType(PageTypeFormat::Plain));
+
+		doc.insertPage(removed, 0);
+		removed->setBackgroundPdfPageNr(2);
+		CPPUNIT_ASSERT_EQUAL((size_t) 0, doc.findPdfPage(2));
+	}
+
+	static Stroke* createAudioStroke(string recording, size_t timestamp)
+	{
+		Stroke* s = new Stroke();
+		s->addPoint(Point(10, 10));
+		s->addPoint(Point(20, 20));
+		s->setAudioFilename(recording);
+		s->setTimestamp(timestamp);
+		return s;
+	}
+
+	void testAudioTimeline()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+
+		Layer* layers[3];
+		for (int i = 0; i < 3; i++)
+		{
+			PageRef p = new XojPage(100, 100);
+			layers[i] = new Layer();
+			p->addLayer(layers[i]);
+			doc.addPage(p);
+		}
+
+		// Written on the pages in a different order than recorded
+		Stroke* a = createAudioStroke("a.ogg", 3000);
+		Stroke* b = createAudioStroke("a.ogg", 1000);
+		Stroke* c = createAudioStroke("a.ogg", 2000);
+		layers[2]->addElement(a);
+		layers[0]->addElement(b);
+		layers[1]->addElement(c);
+		layers[1]->addElement(createAudioStroke("b.ogg", 1500));
+		layers[1]->addElement(new Stroke());
+
+		AudioTimeline* timeline = doc.getAudioTimeline();
+		CPPUNIT_ASSERT_EQUAL((size_t) 4, timeline->getEntryCount());
+
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 999) == NULL);
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 1000)->element == b);
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 2500)->element == c);
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 10000)->element == a);
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 2500)->page == (XojPage*) doc.getPage(1));
+		CPPUNIT_ASSERT(timeline->findAt("c.ogg", 2500) == NULL);
+
+		vector<AudioTimelineEntry> range;
+		timeline->findInRange("a.ogg", 1000, 3000, range);
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, range.size());
+		CPPUNIT_ASSERT(range[0].element == b);
+		CPPUNIT_ASSERT(range[1].element == c);
+
+		// Edits are seen on the next access
+		layers[1]->removeElement(c, true);
+		Stroke* d = createAudioStroke("a.ogg", 2500);
+		layers[0]->addElement(d);
+
+		timeline = doc.getAudioTimeline();
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 2600)->element == d);
+
+		doc.deletePage(2);
+		timeline = doc.getAudioTimeline();
+		CPPUNIT_ASSERT_EQUAL((size_t) 3, timeline->getEntryCount());
+		CPPUNIT_ASSERT(timeline->findAt("a.ogg", 10000)->element == d);
+	}
+
+	void testManyPages()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+
+		const int count = 10000;
+		for (int i = 0; i < count; i++)
+		{
+			doc.addPage(createPdfPage(i));
+		}
+
+		gint64 start = g_get_monotonic_time();
+		for (int i = 0; i < count; i++)
+		{
+			CPPUNIT_ASSERT_EQUAL((size_t) i, doc.indexOf(doc.getPage(i)));
+			CPPUNIT_ASSERT_EQUAL((size_t) i, doc.findPdfPage(i));
+		}
+		gint64 time = g_get_monotonic_time() - start;
+
+#ifdef TEST_CHECK_SPEED
+		std::cout << std::endl << "Lookup of " << count << " pages: " << time << " us" << std::endl;
+#endif
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(DocumentTest);
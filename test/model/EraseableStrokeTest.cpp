@@ -0,0 +1,256 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/eraser/EraseableStroke.h"
+#include "model/Stroke.h"
+#include <config-test.h>
+#include <Range.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+#include <iostream>
+
+/**
+ * Erases parts of strokes, and measures the eraser on dense handwriting
+ */
+class EraseableStrokeTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(EraseableStrokeTest);
+
+	CPPUNIT_TEST(testEraseMiss);
+	CPPUNIT_TEST(testEraseMiddle);
+	CPPUNIT_TEST(testEraseEnd);
+	CPPUNIT_TEST(testEraseAll);
+	CPPUNIT_TEST(testPressure);
+	CPPUNIT_TEST(testDenseHandwriting);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	/**
+	 * A horizontal line from 0 to length, with a point every 1.0
+	 */
+	static Stroke* createLine(int length, double pressure = Point::NO_PRESSURE)
+	{
+		Stroke* s = new Stroke();
+		s->setWidth(1);
+		for (int i = 0; i <= length; i++)
+		{
+			s->addPoint(Point(i, 0, pressure));
+		}
+		return s;
+	}
+
+	static void freeStrokes(GList* strokes)
+	{
+		for (GList* l = strokes; l != NULL; l = l->next)
+		{
+			delete (Stroke*) l->data;
+		}
+		g_list_free(strokes);
+	}
+
+	void testEraseMiss()
+	{
+		Stroke* s = createLine(100);
+		EraseableStroke e(s);
+
+		Range* range = e.erase(50, 10, 5);
+		CPPUNIT_ASSERT(range == NULL);
+		CPPUNIT_ASSERT_EQUAL(100, e.getPartCount());
+
+		GList* strokes = e.getStroke(s);
+		CPPUNIT_ASSERT_EQUAL(1u, g_list_length(strokes));
+		CPPUNIT_ASSERT_EQUAL(101, ((Stroke*) strokes->data)->getPointCount());
+
+		freeStrokes(strokes);
+		delete s;
+	}
+
+	void testEraseMiddle()
+	{
+		Stroke* s = createLine(100);
+		EraseableStroke e(s);
+
+		// 3 along the line, 4 across, so the split is at 50 -+ 5
+		Range* range = e.erase(50.5, 3, 5);
+		CPPUNIT_ASSERT(range != NULL);
+		CPPUNIT_ASSERT(range->getX() <= 46.5 && range->getX2() >= 54.5);
+		delete range;
+
+		GList* strokes = e.getStroke(s);
+		CPPUNIT_ASSERT_EQUAL(2u, g_list_length(strokes));
+
+		Stroke* first = (Stroke*) g_list_nth_data(strokes, 0);
+		Stroke* second = (Stroke*) g_list_nth_data(strokes, 1);
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0, first->getPoint(0).x, 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(46.5, first->getPoint(first->getPointCount() - 1).x, 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(54.5, second->getPoint(0).x, 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(100, second->getPoint(second->getPointCount() - 1).x, 1e-9);
+
+		// 0 .. 46 and 46.5, 54.5 and 55 .. 100
+		CPPUNIT_ASSERT_EQUAL(48, first->getPointCount());
+		CPPUNIT_ASSERT_EQUAL(47, second->getPointCount());
+
+		freeStrokes(strokes);
+		delete s;
+	}
+
+	void testEraseEnd()
+	{
+		Stroke* s = createLine(100);
+		EraseableStroke e(s);
+
+		delete e.erase(100, 0, 10);
+
+		GList* strokes = e.getStroke(s);
+		CPPUNIT_ASSERT_EQUAL(1u, g_list_length(strokes));
+
+		Stroke* first = (Stroke*) strokes->data;
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(90, first->getPoint(first->getPointCount() - 1).x, 1e-9);
+
+		freeStrokes(strokes);
+		delete s;
+	}
+
+	void testEraseAll()
+	{
+		Stroke* s = createLine(20);
+		EraseableStroke e(s);
+
+		Range* range = NULL;
+		for (int x = 0; x <= 20; x += 2)
+		{
+			range = e.erase(x, 0, 2, range);
+		}
+		delete range;
+
+		CPPUNIT_ASSERT_EQUAL(0, e.getPartCount());
+		CPPUNIT_ASSERT(e.getStroke(s) == NULL);
+
+		delete s;
+	}
+
+	void testPressure()
+	{
+		Stroke* s = createLine(10, 2.5);
+		EraseableStroke e(s);
+
+		delete e.erase(5, 0, 1);
+
+		GList* strokes = e.getStroke(s);
+		CPPUNIT_ASSERT_EQUAL(2u, g_list_length(strokes));
+
+		for (GList* l = strokes; l != NULL; l = l->next)
+		{
+			Stroke* part = (Stroke*) l->data;
+			CPPUNIT_ASSERT(part->hasPressure());
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, part->getPoint(0).z, 1e-9);
+		}
+
+		freeStrokes(strokes);
+		delete s;
+	}
+
+	/**
+	 * A page of dense handwriting: lines of long pressure strokes with small loops,
+	 * the eraser is moved across all of them in a zig zag
+	 */
+	void testDenseHandwriting()
+	{
+		vector<Stroke*> strokes;
+		for (int line = 0; line < 30; line++)
+		{
+			for (int word = 0; word < 6; word++)
+			{
+				Stroke* s = new Stroke();
+				s->setWidth(1.4);
+				double x0 = 40 + word * 90;
+				double y0 = 60 + line * 24;
+				for (int i = 0; i < 800; i++)
+				{
+					double t = i * 0.1;
+					double x = x0 + t + 4 * cos(t * 2.1);
+					double y = y0 + 6 * sin(t * 2.1) + sin(t * 0.37);
+					s->addPoint(Point(x, y, 1.0 + 0.4 * sin(t)));
+				}
+				strokes.push_back(s);
+			}
+		}
+
+		vector<EraseableStroke*> eraseable;
+		for (Stroke* s : strokes)
+		{
+			eraseable.push_back(new EraseableStroke(s));
+		}
+
+		int eraseCalls = 0;
+		gint64 start = g_get_monotonic_time();
+
+		for (double y = 50; y < 800; y += 48)
+		{
+			for (double x = 30; x < 600; x += 1.5)
+			{
+				Range* range = NULL;
+				for (EraseableStroke* e : eraseable)
+				{
+					range = e->erase(x, y + 20 * sin(x * 0.05), 3, range);
+					eraseCalls++;
+				}
+				delete range;
+			}
+		}
+
+		gint64 eraseTime = g_get_monotonic_time() - start;
+
+		start = g_get_monotonic_time();
+		int resultStrokes = 0;
+		for (size_t i = 0; i < strokes.size(); i++)
+		{
+			GList* result = eraseable[i]->getStroke(strokes[i]);
+			resultStrokes += g_list_length(result);
+			freeStrokes(result);
+		}
+		gint64 resultTime = g_get_monotonic_time() - start;
+
+		// The eraser cut through the strokes
+		CPPUNIT_ASSERT(resultStrokes > (int) strokes.size());
+
+#ifdef TEST_CHECK_SPEED
+		std::cout << std::endl << "== Eraser on dense handwriting ==" << std::endl;
+		std::cout << "Strokes: " << strokes.size() << ", result strokes: " << resultStrokes << std::endl;
+		std::cout << "Time per erase call: " << (double) eraseTime / eraseCalls << " us" << std::endl;
+		std::cout << "Time to create strokes: " << resultTime << " us" << std::endl;
+#endif
+
+		for (EraseableStroke* e : eraseable)
+		{
+			delete e;
+		}
+		for (Stroke* s : strokes)
+		{
+			delete s;
+		}
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(EraseableStrokeTest);
@@ -0,0 +1,257 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "control/xojfile/LoadHandler.h"
+#include "model/PageSnapshot.h"
+#include "model/eraser/EraseableStroke.h"
+#include <Range.h>
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Checks that snapshots are independent of later changes of the page
+ */
+class PageSnapshotTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(PageSnapshotTest);
+
+	CPPUNIT_TEST(testCopy);
+	CPPUNIT_TEST(testHiddenLayer);
+	CPPUNIT_TEST(testChanges);
+	CPPUNIT_TEST(testReuse);
+	CPPUNIT_TEST(testRevisions);
+	CPPUNIT_TEST(testErasing);
+	CPPUNIT_TEST(testUnchanged);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	static Stroke* createStroke(double offset)
+	{
+		Stroke* s = new Stroke();
+		s->setWidth(1.41);
+		for (int i = 0; i < 20; i++)
+		{
+			s->addPoint(Point(offset + i, i * 2));
+		}
+		return s;
+	}
+
+	/**
+	 * A page with two strokes on the first layer and one on the second
+	 */
+	static PageRef createPage()
+	{
+		LoadHandler handler;
+		Document* doc = handler.loadDocument(GET_TESTFILE("load/strokes.xml"));
+
+		CPPUNIT_ASSERT(doc != NULL);
+		return doc->getPage(0);
+	}
+
+	static Stroke* getStroke(PageRef page, int layer, int index)
+	{
+		return (Stroke*) (*(*page->getLayers())[layer]->getElements())[index];
+	}
+
+	void testCopy()
+	{
+		PageRef page = createPage();
+
+		PageSnapshot snapshot;
+		PageRef copy = snapshot.update(page);
+
+		CPPUNIT_ASSERT(!(copy == page));
+		CPPUNIT_ASSERT_EQUAL(595.0, copy->getWidth());
+		CPPUNIT_ASSERT_EQUAL(842.0, copy->getHeight());
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, copy->getLayerCount());
+
+		Stroke* original = getStroke(page, 0, 1);
+		Stroke* clone = getStroke(copy, 0, 1);
+		CPPUNIT_ASSERT(original != clone);
+		CPPUNIT_ASSERT_EQUAL(original->getPointCount(), clone->getPointCount());
+
+		// Only the element list is copied
+		CPPUNIT_ASSERT(original->getPoints() == clone->getPoints());
+	}
+
+	void testHiddenLayer()
+	{
+		PageRef page = createPage();
+		(*page->getLayers())[1]->setVisible(false);
+
+		PageSnapshot snapshot;
+		PageRef copy = snapshot.update(page);
+
+		CPPUNIT_ASSERT(!copy->isLayerVisible(2));
+		CPPUNIT_ASSERT((*copy->getLayers())[1]->getElements()->empty());
+
+		copy = snapshot.update(page, true);
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, (*copy->getLayers())[1]->getElements()->size());
+	}
+
+	void testChanges()
+	{
+		PageRef page = createPage();
+
+		PageSnapshot snapshot;
+		PageRef copy = snapshot.update(page);
+
+		Stroke* original = getStroke(page, 0, 0);
+		Stroke* clone = getStroke(copy, 0, 0);
+
+		original->move(100, 0);
+		original->setColor(0xff0000);
+		(*page->getLayers())[1]->removeElement(getStroke(page, 1, 0), true);
+		(*page->getLayers())[0]->addElement(createStroke(30));
+
+		CPPUNIT_ASSERT_EQUAL(0.0, clone->getPoint(0).x);
+		CPPUNIT_ASSERT(clone->getColor() != 0xff0000);
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, (*copy->getLayers())[0]->getElements()->size());
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, (*copy->getLayers())[1]->getElements()->size());
+
+		copy = snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL(100.0, getStroke(copy, 0, 0)->getPoint(0).x);
+		CPPUNIT_ASSERT_EQUAL(0xff0000, getStroke(copy, 0, 0)->getColor());
+		CPPUNIT_ASSERT_EQUAL((size_t) 3, (*copy->getLayers())[0]->getElements()->size());
+		CPPUNIT_ASSERT((*copy->getLayers())[1]->getElements()->empty());
+	}
+
+	void testReuse()
+	{
+		PageRef page = createPage();
+
+		PageSnapshot snapshot;
+		PageRef copy = snapshot.update(page);
+		Stroke* unchanged = getStroke(copy, 0, 0);
+		copy = NULL;
+
+		getStroke(page, 0, 1)->setWidth(3);
+
+		copy = snapshot.update(page);
+		CPPUNIT_ASSERT(unchanged == getStroke(copy, 0, 0));
+		CPPUNIT_ASSERT_EQUAL(3.0, getStroke(copy, 0, 1)->getWidth());
+	}
+
+	void testRevisions()
+	{
+		PageRef page = createPage();
+
+		PageSnapshot snapshot;
+		snapshot.update(page);
+
+		int background = snapshot.getLayerRevision(0);
+		int layer1 = snapshot.getLayerRevision(1);
+		int layer2 = snapshot.getLayerRevision(2);
+		CPPUNIT_ASSERT(background != layer1 && layer1 != layer2 && background != layer2);
+		CPPUNIT_ASSERT_EQUAL(-1, snapshot.getLayerRevision(3));
+
+		// Nothing changed
+		snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL(background, snapshot.getLayerRevision(0));
+		CPPUNIT_ASSERT_EQUAL(layer1, snapshot.getLayerRevision(1));
+		CPPUNIT_ASSERT_EQUAL(layer2, snapshot.getLayerRevision(2));
+
+		// Only the changed layer gets a new revision
+		getStroke(page, 1, 0)->move(5, 5);
+		snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL(background, snapshot.getLayerRevision(0));
+		CPPUNIT_ASSERT_EQUAL(layer1, snapshot.getLayerRevision(1));
+		CPPUNIT_ASSERT(layer2 != snapshot.getLayerRevision(2));
+		layer2 = snapshot.getLayerRevision(2);
+
+		(*page->getLayers())[0]->addElement(createStroke(30));
+		snapshot.update(page);
+		CPPUNIT_ASSERT(layer1 != snapshot.getLayerRevision(1));
+		CPPUNIT_ASSERT_EQUAL(layer2, snapshot.getLayerRevision(2));
+		layer1 = snapshot.getLayerRevision(1);
+
+		(*page->getLayers())[1]->setVisible(false);
+		snapshot.update(page);
+		CPPUNIT_ASSERT(layer2 != snapshot.getLayerRevision(2));
+
+		page->setBackgroundColor(0xff0000);
+		snapshot.update(page);
+		CPPUNIT_ASSERT(background != snapshot.getLayerRevision(0));
+		CPPUNIT_ASSERT_EQUAL(layer1, snapshot.getLayerRevision(1));
+	}
+
+	void testErasing()
+	{
+		PageRef page = createPage();
+		Stroke* s = createStroke(0);
+		(*page->getLayers())[1]->addElement(s);
+
+		PageSnapshot snapshot;
+		PageRef copy = snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, (*copy->getLayers())[1]->getElements()->size());
+
+		EraseableStroke* eraseable = new EraseableStroke(s);
+		s->setEraseable(eraseable);
+		delete eraseable->erase(10, 20, 1.5);
+
+		// The stroke is drawn as its remaining parts
+		copy = snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL((size_t) 3, (*copy->getLayers())[1]->getElements()->size());
+		CPPUNIT_ASSERT(getStroke(copy, 1, 1)->getEraseable() == NULL);
+		CPPUNIT_ASSERT(getStroke(copy, 1, 1)->getPoint(0).x < 10);
+		CPPUNIT_ASSERT(getStroke(copy, 1, 2)->getPoint(0).x > 10);
+
+		int revision = snapshot.getLayerRevision(2);
+		delete eraseable->erase(5, 10, 1.5);
+		copy = snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL((size_t) 4, (*copy->getLayers())[1]->getElements()->size());
+		CPPUNIT_ASSERT(revision != snapshot.getLayerRevision(2));
+
+		s->setEraseable(NULL);
+		delete eraseable;
+
+		copy = snapshot.update(page);
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, (*copy->getLayers())[1]->getElements()->size());
+	}
+
+	void testUnchanged()
+	{
+		PageRef page = createPage();
+
+		PageSnapshot snapshot;
+		PageRef copy = snapshot.update(page);
+		XojPage* first = copy;
+		int layer1 = snapshot.getLayerRevision(1);
+		copy = NULL;
+
+		// The caller knows that no element was changed, the copy is returned again
+		page->setSelectedLayerId(2);
+		copy = snapshot.update(page, false, false);
+		CPPUNIT_ASSERT(first == (XojPage*) copy);
+		CPPUNIT_ASSERT_EQUAL(2, copy->getSelectedLayerId());
+		CPPUNIT_ASSERT_EQUAL(layer1, snapshot.getLayerRevision(1));
+		copy = NULL;
+
+		// Changed layers are still noticed
+		(*page->getLayers())[1]->setVisible(false);
+		copy = snapshot.update(page, false, false);
+		CPPUNIT_ASSERT(first != (XojPage*) copy);
+		CPPUNIT_ASSERT((*copy->getLayers())[1]->getElements()->empty());
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(PageSnapshotTest);
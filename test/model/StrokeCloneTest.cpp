@@ -0,0 +1,165 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Checks that clones share the points until one of them is edited
+ */
+class StrokeCloneTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(StrokeCloneTest);
+
+	CPPUNIT_TEST(testShared);
+	CPPUNIT_TEST(testEditClone);
+	CPPUNIT_TEST(testEditOriginal);
+	CPPUNIT_TEST(testLayerClone);
+	CPPUNIT_TEST(testTakeOver);
+	CPPUNIT_TEST(testDeletePoint);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	static Stroke* createStroke()
+	{
+		Stroke* s = new Stroke();
+		s->setWidth(1.41);
+		for (int i = 0; i < 100; i++)
+		{
+			s->addPoint(Point(i, i * 2));
+		}
+		return s;
+	}
+
+	void testShared()
+	{
+		Stroke* s = createStroke();
+		Stroke* c = s->cloneStroke();
+
+		CPPUNIT_ASSERT(s->getPoints() == c->getPoints());
+		CPPUNIT_ASSERT_EQUAL(100, c->getPointCount());
+
+		// The points have to survive the stroke which allocated them
+		delete s;
+		CPPUNIT_ASSERT_EQUAL(99.0, c->getPoint(99).x);
+		delete c;
+	}
+
+	void testEditClone()
+	{
+		Stroke* s = createStroke();
+		Stroke* c = s->cloneStroke();
+
+		c->move(10, 0);
+		c->addPoint(Point(200, 200));
+
+		CPPUNIT_ASSERT(s->getPoints() != c->getPoints());
+		CPPUNIT_ASSERT_EQUAL(100, s->getPointCount());
+		CPPUNIT_ASSERT_EQUAL(0.0, s->getPoint(0).x);
+		CPPUNIT_ASSERT_EQUAL(101, c->getPointCount());
+		CPPUNIT_ASSERT_EQUAL(10.0, c->getPoint(0).x);
+
+		delete s;
+		delete c;
+	}
+
+	void testEditOriginal()
+	{
+		Stroke* s = createStroke();
+		Stroke* c1 = s->cloneStroke();
+		Stroke* c2 = s->cloneStroke();
+
+		s->setLastPoint(-1, -1);
+
+		CPPUNIT_ASSERT(c1->getPoints() == c2->getPoints());
+		CPPUNIT_ASSERT_EQUAL(99.0, c1->getPoint(99).x);
+		CPPUNIT_ASSERT_EQUAL(-1.0, s->getPoint(99).x);
+
+		delete c1;
+		delete s;
+		CPPUNIT_ASSERT_EQUAL(198.0, c2->getPoint(99).y);
+		delete c2;
+	}
+
+	void testLayerClone()
+	{
+		Layer* layer = new Layer();
+		layer->addElement(createStroke());
+		layer->addElement(createStroke());
+
+		Layer* clone = layer->clone();
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, clone->getElements()->size());
+
+		Stroke* s = (Stroke*) (*layer->getElements())[1];
+		Stroke* c = (Stroke*) (*clone->getElements())[1];
+		CPPUNIT_ASSERT(s != c);
+		CPPUNIT_ASSERT(s->getPoints() == c->getPoints());
+
+		delete layer;
+		delete clone;
+	}
+
+	void testTakeOver()
+	{
+		Stroke* s = createStroke();
+		Stroke* c = s->cloneStroke();
+		const Point* points = s->getPoints();
+		delete c;
+
+		// The clone is gone, so the points are not copied
+		s->move(10, 0);
+		CPPUNIT_ASSERT(s->getPoints() == points);
+		CPPUNIT_ASSERT_EQUAL(10.0, s->getPoint(0).x);
+
+		// Not shared anymore, a new clone shares them again
+		c = s->cloneStroke();
+		CPPUNIT_ASSERT(c->getPoints() == points);
+		delete s;
+		CPPUNIT_ASSERT_EQUAL(109.0, c->getPoint(99).x);
+		delete c;
+	}
+
+	void testDeletePoint()
+	{
+		Stroke* s = createStroke();
+		Stroke* c = s->cloneStroke();
+
+		// The points of the clone are copied with their exact size
+		c->deletePoint(99);
+		CPPUNIT_ASSERT_EQUAL(99, c->getPointCount());
+		CPPUNIT_ASSERT_EQUAL(98.0, c->getPoint(98).x);
+
+		c->deletePoint(0);
+		CPPUNIT_ASSERT_EQUAL(98, c->getPointCount());
+		CPPUNIT_ASSERT_EQUAL(1.0, c->getPoint(0).x);
+		CPPUNIT_ASSERT_EQUAL(98.0, c->getPoint(97).x);
+
+		CPPUNIT_ASSERT_EQUAL(100, s->getPointCount());
+
+		delete s;
+		delete c;
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(StrokeCloneTest);
@@ -0,0 +1,192 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/Stroke.h"
+#include "model/StrokeLevelOfDetail.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+#include <iostream>
+
+/**
+ * Checks the error bound of the simplified strokes
+ */
+class StrokeLevelOfDetailTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(StrokeLevelOfDetailTest);
+
+	CPPUNIT_TEST(testStraightLine);
+	CPPUNIT_TEST(testErrorBound);
+	CPPUNIT_TEST(testPressure);
+	CPPUNIT_TEST(testExact);
+	CPPUNIT_TEST(testInvalidate);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	/**
+	 * A handwriting like curve
+	 */
+	static Stroke* createCurve(int count, bool pressure)
+	{
+		Stroke* s = new Stroke();
+		s->setWidth(1.41);
+		for (int i = 0; i < count; i++)
+		{
+			double t = i * 0.1;
+			s->addPoint(Point(t * 0.8 + 3 * cos(t * 2), 5 * sin(t * 2), pressure ? 1 + 0.5 * sin(t * 0.5) : Point::NO_PRESSURE));
+		}
+		return s;
+	}
+
+	/**
+	 * Distance of p to the polyline
+	 */
+	static double distanceTo(const Point* points, int count, const Point& p)
+	{
+		double min = INFINITY;
+		for (int i = 0; i + 1 < count; i++)
+		{
+			const Point& a = points[i];
+			const Point& b = points[i + 1];
+			double dx = b.x - a.x;
+			double dy = b.y - a.y;
+			double len2 = dx * dx + dy * dy;
+			double t = len2 > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2 : 0;
+			t = std::min(1.0, std::max(0.0, t));
+			min = std::min(min, std::hypot(a.x + t * dx - p.x, a.y + t * dy - p.y));
+		}
+		return min;
+	}
+
+	void testStraightLine()
+	{
+		Stroke* s = new Stroke();
+		for (int i = 0; i < 100; i++)
+		{
+			s->addPoint(Point(i, 2 * i));
+		}
+
+		int count = 0;
+		const Point* points = s->getDrawPoints(100, count);
+		CPPUNIT_ASSERT_EQUAL(2, count);
+		CPPUNIT_ASSERT_EQUAL(0.0, points[0].x);
+		CPPUNIT_ASSERT_EQUAL(99.0, points[1].x);
+
+		delete s;
+	}
+
+	void testErrorBound()
+	{
+		Stroke* s = createCurve(1000, false);
+
+		for (int level = 0; level < LOD_LEVEL_COUNT; level++)
+		{
+			double tolerance = StrokeLevelOfDetail::getTolerance(level);
+
+			int count = 0;
+			const Point* points = s->getDrawPoints(tolerance, count);
+			CPPUNIT_ASSERT(count < s->getPointCount());
+			CPPUNIT_ASSERT(count >= 2);
+
+			for (int i = 0; i < s->getPointCount(); i++)
+			{
+				CPPUNIT_ASSERT(distanceTo(points, count, s->getPoint(i)) <= tolerance + 1e-9);
+			}
+
+#ifdef TEST_CHECK_SPEED
+			std::cout << std::endl << "Level " << level << ": " << count << " of " << s->getPointCount() << " points";
+#endif
+		}
+
+		delete s;
+	}
+
+	void testPressure()
+	{
+		// A straight line, only the pressure changes
+		Stroke* s = new Stroke();
+		for (int i = 0; i < 100; i++)
+		{
+			s->addPoint(Point(i, 0, i < 50 ? 1 : 5));
+		}
+
+		int count = 0;
+		const Point* points = s->getDrawPoints(StrokeLevelOfDetail::getTolerance(0), count);
+		CPPUNIT_ASSERT(count > 2);
+
+		// The width step is kept
+		bool found = false;
+		for (int i = 0; i + 1 < count; i++)
+		{
+			if (points[i].x == 49 && points[i + 1].x == 50)
+			{
+				found = true;
+			}
+		}
+		CPPUNIT_ASSERT(found);
+
+		delete s;
+	}
+
+	void testExact()
+	{
+		Stroke* s = createCurve(1000, true);
+
+		int count = 0;
+		const Point* points = s->getDrawPoints(0, count);
+		CPPUNIT_ASSERT(points == s->getPoints());
+		CPPUNIT_ASSERT_EQUAL(s->getPointCount(), count);
+
+		delete s;
+
+		// Short strokes are not simplified
+		s = createCurve(LOD_MIN_POINTS - 1, true);
+		points = s->getDrawPoints(100, count);
+		CPPUNIT_ASSERT(points == s->getPoints());
+
+		delete s;
+	}
+
+	void testInvalidate()
+	{
+		Stroke* s = createCurve(200, false);
+
+		int count = 0;
+		const Point* points = s->getDrawPoints(100, count);
+		Point last = points[count - 1];
+
+		s->move(10, 20);
+
+		points = s->getDrawPoints(100, count);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(last.x + 10, points[count - 1].x, 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(last.y + 20, points[count - 1].y, 1e-9);
+
+		s->addPoint(Point(500, 500));
+		points = s->getDrawPoints(100, count);
+		CPPUNIT_ASSERT_EQUAL(500.0, points[count - 1].x);
+
+		delete s;
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(StrokeLevelOfDetailTest);
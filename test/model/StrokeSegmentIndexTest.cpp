@@ -0,0 +1,111 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/StrokeSegmentIndex.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+#include <iostream>
+
+/**
+ * Compares the candidates of the segment index with a test of all segments
+ */
+class StrokeSegmentIndexTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(StrokeSegmentIndexTest);
+
+	CPPUNIT_TEST(testEmpty);
+	CPPUNIT_TEST(testCandidates);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	static double segmentDistance(const Point& a, const Point& b, double x, double y)
+	{
+		double dx = b.x - a.x;
+		double dy = b.y - a.y;
+		double lenSq = dx * dx + dy * dy;
+		double t = lenSq > 0 ? ((x - a.x) * dx + (y - a.y) * dy) / lenSq : 0;
+		t = std::min(1.0, std::max(0.0, t));
+		return hypot(a.x + t * dx - x, a.y + t * dy - y);
+	}
+
+	void testEmpty()
+	{
+		StrokeSegmentIndex index;
+		index.build(NULL, 0);
+
+		vector<std::pair<int, int>> ranges;
+		index.findCandidates(0, 0, 100, true, ranges);
+		CPPUNIT_ASSERT(ranges.empty());
+	}
+
+	void testCandidates()
+	{
+		// A long scribble
+		vector<Point> points;
+		for (int i = 0; i < 5000; i++)
+		{
+			double t = i * 0.05;
+			points.push_back(Point(t * 2 + 20 * cos(t * 0.7), 200 + 50 * sin(t * 1.3)));
+		}
+
+		StrokeSegmentIndex index;
+		index.build(points.data(), points.size());
+
+		vector<std::pair<int, int>> ranges;
+		int candidates = 0;
+		for (int q = 0; q < 200; q++)
+		{
+			double x = (q * 37) % 600;
+			double y = 120 + (q * 13) % 160;
+			double radius = 1 + q % 10;
+
+			index.findCandidates(x, y, radius, false, ranges);
+
+			vector<bool> candidate(points.size() - 1, false);
+			for (std::pair<int, int>& r : ranges)
+			{
+				CPPUNIT_ASSERT(r.first < r.second);
+				for (int i = r.first; i < r.second; i++)
+				{
+					candidate[i] = true;
+					candidates++;
+				}
+			}
+
+			for (int i = 0; i + 1 < (int) points.size(); i++)
+			{
+				if (segmentDistance(points[i], points[i + 1], x, y) <= radius)
+				{
+					CPPUNIT_ASSERT(candidate[i]);
+				}
+			}
+		}
+
+#ifdef TEST_CHECK_SPEED
+		std::cout << std::endl << "Average candidates: " << candidates / 200 << " of " << points.size() - 1 << " segments";
+#endif
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(StrokeSegmentIndexTest);
@@ -0,0 +1,109 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "pdf/base/PdfFileReader.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Both test files contain the same two pages, one with a cross reference
+ * table, one with a cross reference stream and an object stream.
+ */
+class PdfFileReaderTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(PdfFileReaderTest);
+
+	CPPUNIT_TEST(testXrefTable);
+	CPPUNIT_TEST(testXrefStream);
+	CPPUNIT_TEST(testWriteNumbers);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	void checkPages(PdfFileReader& reader)
+	{
+		vector<int> pages = reader.getPages();
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, pages.size());
+		CPPUNIT_ASSERT_EQUAL(3, pages[0]);
+		CPPUNIT_ASSERT_EQUAL(4, pages[1]);
+
+		// Inherited from the page tree, or overwritten by the page
+		PdfObject page = reader.getObject(3);
+		CPPUNIT_ASSERT_EQUAL(90L, reader.getInheritedAttribute(page, "Rotate").getInteger());
+		CPPUNIT_ASSERT_EQUAL((size_t) 4, reader.getInheritedAttribute(page, "MediaBox").getArray().size());
+		CPPUNIT_ASSERT(reader.getInheritedAttribute(page, "CropBox").isNull());
+		CPPUNIT_ASSERT_EQUAL(0L, reader.getInheritedAttribute(reader.getObject(4), "Rotate").getInteger());
+
+		PdfObject content = reader.resolve(*page.get("Contents"));
+		CPPUNIT_ASSERT(content.isStream());
+
+		string decoded;
+		CPPUNIT_ASSERT(reader.decodeStream(content, decoded));
+		CPPUNIT_ASSERT_EQUAL(string("BT /F1 12 Tf 72 720 Td (Hello \\) world) Tj ET"), decoded);
+
+		// Strings and names are kept as they are written
+		PdfObject info = reader.getObject(8);
+		CPPUNIT_ASSERT_EQUAL(string("(Test % not a comment)"), info.get("Title")->getText());
+		CPPUNIT_ASSERT_EQUAL(string("<48656c6c6f>"), info.get("Producer")->getText());
+		CPPUNIT_ASSERT_EQUAL(string("F#31"), reader.getObject(7).get("Name")->getName());
+
+		string written;
+		reader.getObject(4).get("Contents")->write(written);
+		CPPUNIT_ASSERT_EQUAL(string("[5 0 R 6 0 R]"), written);
+	}
+
+	void testXrefTable()
+	{
+		PdfFileReader reader;
+		CPPUNIT_ASSERT(reader.load(GET_TESTFILE("pdf/classic.pdf")));
+		CPPUNIT_ASSERT(!reader.hasXrefStream());
+		CPPUNIT_ASSERT(!reader.isEncrypted());
+		CPPUNIT_ASSERT_EQUAL(9, reader.getObjectCount());
+
+		checkPages(reader);
+	}
+
+	void testXrefStream()
+	{
+		PdfFileReader reader;
+		CPPUNIT_ASSERT(reader.load(GET_TESTFILE("pdf/xrefstream.pdf")));
+		CPPUNIT_ASSERT(reader.hasXrefStream());
+		CPPUNIT_ASSERT_EQUAL(11, reader.getObjectCount());
+
+		checkPages(reader);
+	}
+
+	void testWriteNumbers()
+	{
+		string written;
+		PdfObject::createReal(0.5).write(written);
+		written += ' ';
+		PdfObject::createReal(612).write(written);
+		written += ' ';
+		PdfObject::createReal(-0.0000001).write(written);
+		written += ' ';
+		PdfObject::createInteger(-42).write(written);
+
+		CPPUNIT_ASSERT_EQUAL(string("0.5 612 0 -42"), written);
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(PdfFileReaderTest);
@@ -0,0 +1,164 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/Document.h"
+#include "model/DocumentHandler.h"
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "pdf/base/XojPdfExportFactory.h"
+#include <config-test.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <glib/gstdio.h>
+
+/**
+ * Exports a document with the two pages of classic.pdf as background and reads the result with poppler.
+ * The first page is 612 x 792 and rotated by 90 degrees, the second page has a CropBox of 300 x 400.
+ */
+class XojPdfExportTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(XojPdfExportTest);
+
+	CPPUNIT_TEST(testAllPages);
+	CPPUNIT_TEST(testPageRange);
+	CPPUNIT_TEST(testMovedPages);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+		gchar* name = g_build_filename(g_get_tmp_dir(), "xournalpp-pdfexport-test.pdf", NULL);
+		this->filename = name;
+		g_free(name);
+	}
+
+	void tearDown()
+	{
+		g_unlink(this->filename.c_str());
+	}
+
+	static void loadDocument(Document& doc)
+	{
+		CPPUNIT_ASSERT(doc.readPdf(Path(GET_TESTFILE("pdf/classic.pdf")), true, false));
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, doc.getPageCount());
+
+		Stroke* s = new Stroke();
+		s->setWidth(1.41);
+		s->addPoint(Point(10, 10));
+		s->addPoint(Point(100, 50));
+
+		Layer* layer = new Layer();
+		layer->addElement(s);
+		doc.getPage(1)->addLayer(layer);
+	}
+
+	/**
+	 * Exports the pages and returns the file contents, the exported pages are loaded into result
+	 */
+	string exportPdf(Document& doc, PageRangeVector* range, XojPdfDocument& result)
+	{
+		XojPdfExport* pdf = XojPdfExportFactory::createExport(&doc, NULL);
+		bool ok = range ? pdf->createPdf(Path(this->filename), *range) : pdf->createPdf(Path(this->filename));
+		CPPUNIT_ASSERT_MESSAGE(pdf->getLastError(), ok);
+		delete pdf;
+
+		gchar* data = NULL;
+		gsize length = 0;
+		CPPUNIT_ASSERT(g_file_get_contents(this->filename.c_str(), &data, &length, NULL));
+		string contents(data, length);
+		g_free(data);
+
+		GError* error = NULL;
+		CPPUNIT_ASSERT(result.load(Path(this->filename), "", &error));
+		CPPUNIT_ASSERT(error == NULL);
+
+		return contents;
+	}
+
+	static void checkSize(XojPdfDocument& pdf, size_t page, double width, double height)
+	{
+		XojPdfPageSPtr p = pdf.getPage(page);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(width, p->getWidth(), 0.5);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(height, p->getHeight(), 0.5);
+	}
+
+	void testAllPages()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+		loadDocument(doc);
+
+		XojPdfDocument result;
+		string contents = exportPdf(doc, NULL, result);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, result.getPageCount());
+		checkSize(result, 0, 792, 612);
+		checkSize(result, 1, 300, 400);
+
+		// The background PDF is kept, the layers are appended
+		gchar* source = NULL;
+		gsize length = 0;
+		CPPUNIT_ASSERT(g_file_get_contents(GET_TESTFILE("pdf/classic.pdf"), &source, &length, NULL));
+		CPPUNIT_ASSERT(contents.size() > length);
+		CPPUNIT_ASSERT(contents.compare(0, length, source, length) == 0);
+		g_free(source);
+	}
+
+	void testPageRange()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+		loadDocument(doc);
+
+		PageRangeVector range;
+		range.push_back(new PageRangeEntry(1, 1));
+
+		XojPdfDocument result;
+		string contents = exportPdf(doc, &range, result);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, result.getPageCount());
+		checkSize(result, 0, 300, 400);
+
+		// The page which was not selected must not remain in the file
+		CPPUNIT_ASSERT(contents.find("Test % not a comment") == string::npos);
+
+		for (PageRangeEntry* e : range)
+		{
+			delete e;
+		}
+	}
+
+	void testMovedPages()
+	{
+		DocumentHandler handler;
+		Document doc(&handler);
+		loadDocument(doc);
+
+		PageRef page = doc.getPage(1);
+		doc.deletePage(1);
+		doc.insertPage(page, 0);
+
+		XojPdfDocument result;
+		exportPdf(doc, NULL, result);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, result.getPageCount());
+		checkSize(result, 0, 300, 400);
+		checkSize(result, 1, 792, 612);
+	}
+
+private:
+	string filename;
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(XojPdfExportTest);
@@ -0,0 +1,188 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "plugin/Plugin.h"
+#include <config-test.h>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+}
+
+#include "plugin/luapi_document.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Checks how the document library reads the strokes of a plugin, without a running application
+ */
+class LuaDocumentTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(LuaDocumentTest);
+
+	CPPUNIT_TEST(testNewStroke);
+	CPPUNIT_TEST(testMetamethods);
+	CPPUNIT_TEST(testInvalidStrokes);
+	CPPUNIT_TEST(testPointArray);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+		this->L = luaL_newstate();
+		luaL_openlibs(this->L);
+		luaL_requiref(this->L, "doc", luaopen_doc, 0);
+		lua_pop(this->L, 1);
+	}
+
+	void tearDown()
+	{
+		lua_close(this->L);
+		this->L = NULL;
+	}
+
+	static int checkNewStroke(lua_State* L)
+	{
+		lua_pushinteger(L, doclib_checkNewStroke(L, 1));
+		return 1;
+	}
+
+	/**
+	 * Evaluates the expression and leaves the result at the top of the stack
+	 */
+	void eval(const char* expression)
+	{
+		string code = string("return ") + expression;
+		CPPUNIT_ASSERT_EQUAL(LUA_OK, luaL_dostring(this->L, code.c_str()));
+	}
+
+	/**
+	 * @return The point count, or -1 if the stroke at the top of the stack is rejected with an error
+	 */
+	lua_Integer check()
+	{
+		lua_pushcfunction(this->L, checkNewStroke);
+		lua_pushvalue(this->L, -2);
+		if (lua_pcall(this->L, 1, 1, 0) != LUA_OK)
+		{
+			lua_pop(this->L, 1);
+			return -1;
+		}
+
+		lua_Integer count = lua_tointeger(this->L, -1);
+		lua_pop(this->L, 1);
+		return count;
+	}
+
+	void testNewStroke()
+	{
+		eval("{x = {1, 2, 3}, y = {4, 5, 6}, pressure = {0.5, 0.6, 0.7}, color = 255, tool = 'highlighter'}");
+		CPPUNIT_ASSERT_EQUAL((lua_Integer) 3, check());
+
+		LuaNewStroke stroke;
+		doclib_readNewStroke(this->L, stroke);
+		CPPUNIT_ASSERT_EQUAL(1, lua_gettop(this->L));
+
+		CPPUNIT_ASSERT_EQUAL(STROKE_TOOL_HIGHLIGHTER, stroke.tool);
+		CPPUNIT_ASSERT(stroke.hasColor);
+		CPPUNIT_ASSERT_EQUAL(255, stroke.color);
+		CPPUNIT_ASSERT(!stroke.hasWidth);
+		CPPUNIT_ASSERT_EQUAL((size_t) 3, stroke.points.size());
+		CPPUNIT_ASSERT_EQUAL(3.0, stroke.points[2].x);
+		CPPUNIT_ASSERT_EQUAL(6.0, stroke.points[2].y);
+		CPPUNIT_ASSERT_EQUAL(0.7, stroke.points[2].z);
+
+		Stroke* s = doclib_createStroke(stroke, 0, 1.5);
+		CPPUNIT_ASSERT_EQUAL(255, s->getColor());
+		CPPUNIT_ASSERT_EQUAL(1.5, s->getWidth());
+		CPPUNIT_ASSERT_EQUAL(3, s->getPointCount());
+		CPPUNIT_ASSERT_EQUAL(0.5, s->getPoint(0).z);
+		delete s;
+	}
+
+	void testMetamethods()
+	{
+		// The metamethods of the plugin are not called, an error in them does not matter
+		eval("setmetatable({x = {1, 2}, y = {3, 4}}, {__index = function() error('no access') end})");
+		CPPUNIT_ASSERT_EQUAL((lua_Integer) 2, check());
+
+		LuaNewStroke stroke;
+		doclib_readNewStroke(this->L, stroke);
+		CPPUNIT_ASSERT_EQUAL(STROKE_TOOL_PEN, stroke.tool);
+		CPPUNIT_ASSERT(!stroke.hasColor);
+		CPPUNIT_ASSERT_EQUAL(Point::NO_PRESSURE, stroke.points[1].z);
+		lua_pop(this->L, 1);
+
+		// Values which only exist through __index are not seen
+		eval("setmetatable({}, {__index = function() return {1, 2} end})");
+		CPPUNIT_ASSERT_EQUAL((lua_Integer) -1, check());
+		lua_pop(this->L, 1);
+	}
+
+	void testInvalidStrokes()
+	{
+		const char* strokes[] = {
+			"5",
+			"{}",
+			"{x = {1, 2}, y = {1}}",
+			"{x = {1}, y = {1}}",
+			"{x = {1, 'a'}, y = {1, 2}}",
+			"{x = {1, 2}, y = {1, 2}, pressure = {1}}",
+			"{points = {}}",
+		};
+
+		for (const char* s : strokes)
+		{
+			eval(s);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE(s, (lua_Integer) -1, check());
+			lua_pop(this->L, 1);
+		}
+	}
+
+	void testPointArray()
+	{
+		Layer layer;
+		Stroke* s = new Stroke();
+		s->setWidth(2);
+		for (int i = 0; i < 10; i++)
+		{
+			s->addPoint(Point(i, i * 2, 0.5));
+		}
+		layer.addElement(s);
+
+		vector<LuaStrokeInfo> strokes;
+		doclib_readStrokes(&layer, strokes);
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, strokes.size());
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, strokes[0].index);
+		CPPUNIT_ASSERT_EQUAL(10, strokes[0].pointCount);
+		CPPUNIT_ASSERT(strokes[0].points.get() == s->getPoints());
+
+		// The points of getStrokes can be passed to addStrokes
+		lua_createtable(this->L, 0, 1);
+		doclib_pushPointArray(this->L, strokes[0].points, strokes[0].pointCount);
+		lua_setfield(this->L, -2, "points");
+		CPPUNIT_ASSERT_EQUAL((lua_Integer) 10, check());
+
+		LuaNewStroke stroke;
+		doclib_readNewStroke(this->L, stroke);
+		CPPUNIT_ASSERT_EQUAL((size_t) 10, stroke.points.size());
+		CPPUNIT_ASSERT_EQUAL(18.0, stroke.points[9].y);
+		lua_pop(this->L, 1);
+	}
+
+private:
+	lua_State* L = NULL;
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(LuaDocumentTest);
@@ -0,0 +1,257 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <config-test.h>
+#include <audio/AudioQueue.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <functional>
+#include <thread>
+
+#define CHANNELS 2
+#define FRAMES_PER_BUFFER 64
+
+/**
+ * Calls a callback with a fixed number of frames in a fixed interval,
+ * like the PortAudio callbacks of a real audio device
+ */
+class FakeAudioDevice
+{
+public:
+	FakeAudioDevice(std::function<bool(float*, unsigned long)> callback, std::chrono::microseconds period)
+	 : callback(callback),
+	   period(period)
+	{
+	}
+
+	void run()
+	{
+		float buffer[FRAMES_PER_BUFFER * CHANNELS];
+		auto next = std::chrono::steady_clock::now();
+
+		while (this->callback(buffer, FRAMES_PER_BUFFER))
+		{
+			next += this->period;
+			std::this_thread::sleep_until(next);
+		}
+	}
+
+private:
+	std::function<bool(float*, unsigned long)> callback;
+	std::chrono::microseconds period;
+};
+
+/**
+ * Stress test of the ring buffer between the device callbacks and the file reader / writer
+ */
+class AudioQueueTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(AudioQueueTest);
+
+	CPPUNIT_TEST(testWrapAround);
+	CPPUNIT_TEST(testOverrun);
+	CPPUNIT_TEST(testRecording);
+	CPPUNIT_TEST(testPlayback);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	void testWrapAround()
+	{
+		AudioQueue<float> queue(100);
+		queue.setAudioAttributes(44100, CHANNELS);
+		CPPUNIT_ASSERT_EQUAL(128ul, queue.capacity());
+
+		float in[90];
+		float out[90];
+		float next = 0;
+		float expected = 0;
+
+		for (int round = 0; round < 20; round++)
+		{
+			for (float& f : in)
+			{
+				f = next++;
+			}
+			CPPUNIT_ASSERT_EQUAL(90ul, queue.push(in, 90));
+
+			// Odd request, only whole frames are returned
+			unsigned long length;
+			queue.pop(out, length, 89);
+			CPPUNIT_ASSERT_EQUAL(88ul, length);
+			queue.pop(out + 88, length, 2);
+			CPPUNIT_ASSERT_EQUAL(2ul, length);
+
+			for (float f : out)
+			{
+				CPPUNIT_ASSERT_EQUAL(expected++, f);
+			}
+		}
+
+		CPPUNIT_ASSERT(queue.empty());
+		CPPUNIT_ASSERT_EQUAL(0ul, queue.getOverrunCount());
+	}
+
+	void testOverrun()
+	{
+		AudioQueue<float> queue(64);
+		queue.setAudioAttributes(44100, CHANNELS);
+
+		float in[48] = { 0 };
+		CPPUNIT_ASSERT_EQUAL(48ul, queue.push(in, 48));
+		CPPUNIT_ASSERT_EQUAL(16ul, queue.push(in, 48));
+		CPPUNIT_ASSERT_EQUAL(0ul, queue.push(in, 48));
+		CPPUNIT_ASSERT_EQUAL(2ul, queue.getOverrunCount());
+		CPPUNIT_ASSERT_EQUAL(0ul, queue.freeSpace());
+
+		queue.reset();
+		CPPUNIT_ASSERT(queue.empty());
+		CPPUNIT_ASSERT_EQUAL(0ul, queue.getOverrunCount());
+	}
+
+	/**
+	 * A fake input device pushes from its callback, a writer thread pops like VorbisConsumer
+	 */
+	void testRecording()
+	{
+		AudioQueue<float> queue;
+		queue.setAudioAttributes(44100, CHANNELS);
+
+		const int buffers = 4000;
+		int pushed = 0;
+		float next = 0;
+
+		FakeAudioDevice device([&](float* buffer, unsigned long frames)
+		{
+			for (unsigned long i = 0; i < frames * CHANNELS; i++)
+			{
+				buffer[i] = next++;
+			}
+			queue.push(buffer, frames * CHANNELS);
+			return ++pushed < buffers;
+		}, std::chrono::microseconds(20));
+
+		unsigned long received = 0;
+		bool ordered = true;
+
+		std::thread writer([&]
+		{
+			float buffer[1024 * CHANNELS];
+			unsigned long length;
+
+			while (true)
+			{
+				bool streamEnded = queue.hasStreamEnded();
+				queue.pop(buffer, length, 1024 * CHANNELS);
+
+				if (length == 0)
+				{
+					if (streamEnded)
+					{
+						break;
+					}
+					queue.waitForProducer();
+					continue;
+				}
+
+				for (unsigned long i = 0; i < length; i++)
+				{
+					ordered = ordered && buffer[i] == received++;
+				}
+			}
+		});
+
+		device.run();
+		queue.signalEndOfStream();
+		writer.join();
+
+		CPPUNIT_ASSERT(ordered);
+		CPPUNIT_ASSERT_EQUAL((unsigned long) buffers * FRAMES_PER_BUFFER * CHANNELS, received);
+		CPPUNIT_ASSERT_EQUAL(0ul, queue.getOverrunCount());
+	}
+
+	/**
+	 * A reader thread pushes like VorbisProducer, a fake output device pops from its callback
+	 */
+	void testPlayback()
+	{
+		AudioQueue<float> queue(16384);
+		queue.setAudioAttributes(44100, CHANNELS);
+
+		const unsigned long total = 200 * 1024 * CHANNELS;
+
+		std::thread reader([&]
+		{
+			float buffer[1024 * CHANNELS];
+			float next = 0;
+
+			for (unsigned long sent = 0; sent < total; sent += 1024 * CHANNELS)
+			{
+				for (float& f : buffer)
+				{
+					f = next++;
+				}
+
+				while (queue.freeSpace() < 1024 * CHANNELS)
+				{
+					queue.waitForConsumer(1024 * CHANNELS);
+				}
+				queue.push(buffer, 1024 * CHANNELS);
+			}
+
+			queue.signalEndOfStream();
+		});
+
+		unsigned long received = 0;
+		bool ordered = true;
+
+		FakeAudioDevice device([&](float* buffer, unsigned long frames)
+		{
+			unsigned long length;
+			queue.pop(buffer, length, frames * CHANNELS);
+			if (length < frames * CHANNELS && !queue.hasStreamEnded())
+			{
+				queue.reportUnderrun();
+			}
+
+			for (unsigned long i = 0; i < length; i++)
+			{
+				ordered = ordered && buffer[i] == received++;
+			}
+
+			return !(queue.hasStreamEnded() && queue.empty());
+		}, std::chrono::microseconds(20));
+
+		device.run();
+		reader.join();
+
+		CPPUNIT_ASSERT(ordered);
+		CPPUNIT_ASSERT_EQUAL(total, received);
+
+		// Only a hint, an overloaded machine may not keep up with the fake device
+		if (queue.getUnderrunCount() > 0)
+		{
+			printf("AudioQueueTest: %lu underruns\n", queue.getUnderrunCount());
+		}
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(AudioQueueTest);
@@ -0,0 +1,92 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <config-test.h>
+#include <DamageRegion.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+class DamageRegionTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(DamageRegionTest);
+
+	CPPUNIT_TEST(testSeparate);
+	CPPUNIT_TEST(testStrokeMotion);
+	CPPUNIT_TEST(testMaxRects);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	void testSeparate()
+	{
+		DamageRegion region;
+		region.add(0, 0, 10, 10);
+		region.add(100, 100, 110, 110);
+		region.add(5, 5, 5, 20); // empty
+
+		std::vector<DamageRect> rects;
+		region.flush(rects);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 2, rects.size());
+		CPPUNIT_ASSERT(region.isEmpty());
+		CPPUNIT_ASSERT_EQUAL((guint64) 200, region.getRequestedPixels());
+		CPPUNIT_ASSERT_EQUAL((guint64) 200, region.getPaintedPixels());
+	}
+
+	/**
+	 * A stroke repaints an area around each new segment, the areas overlap
+	 */
+	void testStrokeMotion()
+	{
+		DamageRegion region;
+		for (int i = 0; i < 20; i++)
+		{
+			region.add(i * 2 - 10, 50 - 10, i * 2 + 12, 50 + 10);
+		}
+
+		std::vector<DamageRect> rects;
+		region.flush(rects);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, rects.size());
+		CPPUNIT_ASSERT_EQUAL(-10, rects[0].x1);
+		CPPUNIT_ASSERT_EQUAL(50, rects[0].x2);
+		CPPUNIT_ASSERT_EQUAL((guint64) 20 * 22 * 20, region.getRequestedPixels());
+		CPPUNIT_ASSERT_EQUAL((guint64) 60 * 20, region.getPaintedPixels());
+	}
+
+	void testMaxRects()
+	{
+		DamageRegion region;
+		for (int i = 0; i <= DAMAGE_REGION_MAX_RECTS; i++)
+		{
+			region.add(i * 100, 0, i * 100 + 10, 10);
+		}
+
+		std::vector<DamageRect> rects;
+		region.flush(rects);
+
+		CPPUNIT_ASSERT_EQUAL((size_t) 1, rects.size());
+		CPPUNIT_ASSERT_EQUAL(DAMAGE_REGION_MAX_RECTS * 100 + 10, rects[0].x2);
+	}
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(DamageRegionTest);
@@ -0,0 +1,114 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include <config-test.h>
+#include <OutputStream.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <glib/gstdio.h>
+
+#include <string>
+
+using namespace std;
+
+class GzOutputStreamTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(GzOutputStreamTest);
+
+	CPPUNIT_TEST(testEmpty);
+	CPPUNIT_TEST(testSingleBlock);
+	CPPUNIT_TEST(testParallelBlocks);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+		gchar* name = g_build_filename(g_get_tmp_dir(), "xournalpp-gzoutputstream-test.gz", NULL);
+		this->filename = name;
+		g_free(name);
+	}
+
+	void tearDown()
+	{
+		g_unlink(this->filename.c_str());
+	}
+
+	/**
+	 * Writes the data in small pieces, as the XML writer does, and reads it back with zlib
+	 */
+	string writeAndRead(const string& data, int level, int threads)
+	{
+		GzOutputStream out(Path(this->filename), level, threads);
+		CPPUNIT_ASSERT(out.getLastError().empty());
+
+		for (size_t pos = 0; pos < data.size(); pos += 1000)
+		{
+			out.write(data.c_str() + pos, std::min((size_t) 1000, data.size() - pos));
+		}
+		out.close();
+		CPPUNIT_ASSERT(out.getLastError().empty());
+
+		string result;
+		gzFile fp = gzopen(this->filename.c_str(), "r");
+		CPPUNIT_ASSERT(fp != NULL);
+
+		char buffer[4096];
+		int len;
+		while ((len = gzread(fp, buffer, sizeof(buffer))) > 0)
+		{
+			result.append(buffer, len);
+		}
+		CPPUNIT_ASSERT_EQUAL(0, len);
+		gzclose(fp);
+
+		return result;
+	}
+
+	static string createXml(size_t size)
+	{
+		string xml;
+		for (int i = 0; xml.size() < size; i++)
+		{
+			xml += "<stroke tool=\"pen\" width=\"1.41\">" + std::to_string(i * 7 % 1000) + " " + std::to_string(i) + "</stroke>\n";
+		}
+		xml.resize(size);
+
+		return xml;
+	}
+
+	void testEmpty()
+	{
+		CPPUNIT_ASSERT_EQUAL(string(), writeAndRead("", Z_DEFAULT_COMPRESSION, 0));
+	}
+
+	void testSingleBlock()
+	{
+		string xml = createXml(1000);
+		CPPUNIT_ASSERT(xml == writeAndRead(xml, Z_BEST_COMPRESSION, 1));
+	}
+
+	void testParallelBlocks()
+	{
+		// Not a multiple of the block size, so the last block is partial
+		string xml = createXml(10 * GZ_OUTPUT_BLOCK_SIZE + 123);
+
+		CPPUNIT_ASSERT(xml == writeAndRead(xml, Z_DEFAULT_COMPRESSION, 4));
+		CPPUNIT_ASSERT(xml == writeAndRead(xml, Z_BEST_SPEED, 1));
+		CPPUNIT_ASSERT(xml == writeAndRead(xml, 0, 3));
+	}
+
+private:
+	string filename;
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(GzOutputStreamTest);
@@ -0,0 +1,234 @@
+/*
+ * Xournal++
+ *
+ * This file is part of the Xournal UnitTests
+ *
+ * @author Xournal++ Team
+ * https://github.com/xournalpp/xournalpp
+ *
+ * @license GNU GPLv2 or later
+ */
+
+#include "model/Layer.h"
+#include "model/Stroke.h"
+#include "model/XojPage.h"
+#include "view/DocumentView.h"
+#include <config-test.h>
+
+#ifdef TEST_CHECK_SPEED
+#include "SpeedTest.cpp"
+#endif
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+#include <cstring>
+
+/**
+ * Checks that the highlighter strokes sharing a group look the same as with a group each
+ */
+class DocumentViewTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(DocumentViewTest);
+
+	CPPUNIT_TEST(testHighlighterSeparate);
+	CPPUNIT_TEST(testHighlighterOverlapping);
+	CPPUNIT_TEST(testHighlighterMixed);
+	CPPUNIT_TEST(testHighlighterZoom);
+
+#ifdef TEST_CHECK_SPEED
+	CPPUNIT_TEST(testSpeed);
+#endif
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp()
+	{
+	}
+
+	void tearDown()
+	{
+	}
+
+	static Stroke* createStroke(double x, double y, int color, int fill, StrokeTool tool)
+	{
+		Stroke* s = new Stroke();
+		s->setToolType(tool);
+		s->setColor(color);
+		s->setFill(fill);
+		s->setWidth(tool == STROKE_TOOL_HIGHLIGHTER ? 8.5 : 1.41);
+		for (int i = 0; i < 12; i++)
+		{
+			s->addPoint(Point(x + i * 3, y + 6 * std::sin(i * 0.7)));
+		}
+		return s;
+	}
+
+	static void addHighlighters(Layer* layer, int rows, int columns, double distance, int color)
+	{
+		for (int r = 0; r < rows; r++)
+		{
+			for (int c = 0; c < columns; c++)
+			{
+				layer->addElement(createStroke(10 + c * distance, 10 + r * distance, color, 128, STROKE_TOOL_HIGHLIGHTER));
+			}
+		}
+	}
+
+	static cairo_surface_t* createSurface(PageRef page, double zoom, cairo_t*& cr)
+	{
+		cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, page->getWidth() * zoom,
+															  page->getHeight() * zoom);
+		cr = cairo_create(surface);
+
+		cairo_set_source_rgb(cr, 1, 1, 1);
+		cairo_paint(cr);
+		cairo_scale(cr, zoom, zoom);
+
+		return surface;
+	}
+
+	/**
+	 * Draws the layer like DocumentView did before the groups were shared
+	 */
+	static cairo_surface_t* drawEachStroke(PageRef page, double zoom)
+	{
+		cairo_t* cr = NULL;
+		cairo_surface_t* surface = createSurface(page, zoom, cr);
+
+		DocumentView view;
+		view.setLevelOfDetail(false);
+
+		cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+		for (Element* e : *(*page->getLayers())[0]->getElements())
+		{
+			view.drawStroke(cr, (Stroke*) e);
+		}
+
+		cairo_destroy(cr);
+		cairo_surface_flush(surface);
+		return surface;
+	}
+
+	static cairo_surface_t* drawLayer(PageRef page, double zoom)
+	{
+		cairo_t* cr = NULL;
+		cairo_surface_t* surface = createSurface(page, zoom, cr);
+
+		DocumentView view;
+		view.setLevelOfDetail(false);
+		view.initDrawing(page, cr, false);
+		view.drawLayer(cr, (*page->getLayers())[0]);
+		view.finializeDrawing();
+
+		cairo_destroy(cr);
+		cairo_surface_flush(surface);
+		return surface;
+	}
+
+	static void assertSamePixels(PageRef page, double zoom)
+	{
+		cairo_surface_t* expected = drawEachStroke(page, zoom);
+		cairo_surface_t* actual = drawLayer(page, zoom);
+
+		int height = cairo_image_surface_get_height(expected);
+		int stride = cairo_image_surface_get_stride(expected);
+		CPPUNIT_ASSERT_EQUAL(height, cairo_image_surface_get_height(actual));
+		CPPUNIT_ASSERT_EQUAL(stride, cairo_image_surface_get_stride(actual));
+
+		// Something was drawn
+		cairo_t* cr = NULL;
+		cairo_surface_t* white = createSurface(page, zoom, cr);
+		cairo_destroy(cr);
+		cairo_surface_flush(white);
+		CPPUNIT_ASSERT(memcmp(cairo_image_surface_get_data(white), cairo_image_surface_get_data(expected),
+							  (size_t) stride * height) != 0);
+
+		CPPUNIT_ASSERT(memcmp(cairo_image_surface_get_data(expected), cairo_image_surface_get_data(actual),
+							  (size_t) stride * height) == 0);
+
+		cairo_surface_destroy(white);
+		cairo_surface_destroy(expected);
+		cairo_surface_destroy(actual);
+	}
+
+	void testHighlighterSeparate()
+	{
+		PageRef page = new XojPage(400, 400);
+		Layer* layer = new Layer();
+		page->addLayer(layer);
+
+		addHighlighters(layer, 6, 6, 60, 0xffff00);
+
+		assertSamePixels(page, 1);
+	}
+
+	void testHighlighterOverlapping()
+	{
+		PageRef page = new XojPage(400, 400);
+		Layer* layer = new Layer();
+		page->addLayer(layer);
+
+		// The strokes overlap their neighbours, which must be painted darker
+		addHighlighters(layer, 12, 10, 25, 0xffff00);
+
+		assertSamePixels(page, 1);
+	}
+
+	void testHighlighterMixed()
+	{
+		PageRef page = new XojPage(400, 400);
+		Layer* layer = new Layer();
+		page->addLayer(layer);
+
+		addHighlighters(layer, 3, 6, 60, 0xffff00);
+		addHighlighters(layer, 2, 6, 45, 0x00ff00);
+
+		layer->addElement(createStroke(100, 100, 0x000000, -1, STROKE_TOOL_PEN));
+		layer->addElement(createStroke(100, 120, 0x0000ff, -1, STROKE_TOOL_HIGHLIGHTER));
+		layer->addElement(createStroke(100, 140, 0xffff00, 64, STROKE_TOOL_HIGHLIGHTER));
+		layer->addElement(createStroke(140, 140, 0xffff00, 128, STROKE_TOOL_HIGHLIGHTER));
+		layer->addElement(createStroke(200, 100, 0xff0000, 80, STROKE_TOOL_PEN));
+
+		addHighlighters(layer, 4, 4, 70, 0xff00ff);
+
+		assertSamePixels(page, 1);
+	}
+
+	void testHighlighterZoom()
+	{
+		PageRef page = new XojPage(400, 400);
+		Layer* layer = new Layer();
+		page->addLayer(layer);
+
+		// The antialiasing is wider than the stroke width in document coordinates
+		addHighlighters(layer, 8, 8, 48.2, 0xffff00);
+
+		assertSamePixels(page, 0.25);
+		assertSamePixels(page, 2.5);
+	}
+
+#ifdef TEST_CHECK_SPEED
+	void testSpeed()
+	{
+		PageRef page = new XojPage(1200, 1200);
+		Layer* layer = new Layer();
+		page->addLayer(layer);
+
+		addHighlighters(layer, 20, 20, 60, 0xffff00);
+
+		SpeedTest speed;
+		speed.startTest("draw 400 highlighter strokes, a group each");
+		cairo_surface_destroy(drawEachStroke(page, 1));
+		speed.endTest();
+
+		speed.startTest("draw 400 highlighter strokes, shared groups");
+		cairo_surface_destroy(drawLayer(page, 1));
+		speed.endTest();
+	}
+#endif
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION(DocumentViewTest);